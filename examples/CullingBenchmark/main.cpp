@@ -0,0 +1,114 @@
+// Compares VisibilityCuller against a scalar per-object frustum and LOD loop.
+// Build with -march=native (or -mavx2 -mfma) to enable the 8-wide x86 path.
+
+#include <EasyVulkan/Core/ThreadPool.hpp>
+#include <EasyVulkan/Core/VisibilityCuller.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int kIterations = 20;
+const std::vector<float> kLodThresholds = {256.0f, 96.0f, 32.0f};
+
+// Best-of-N wall time in milliseconds
+double measure(const std::function<void()> &fn) {
+  double best = 1e30;
+  for (int i = 0; i < kIterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  return best;
+}
+
+void report(const char *name, size_t objects, double ms, double baselineMs, bool match) {
+  std::printf("  %-22s %8.3f ms (%7.1f M objects/s)   x%5.2f  %s\n", name, ms,
+              static_cast<double>(objects) / 1e6 / (ms / 1e3), baselineMs / ms, match ? "ok" : "MISMATCH");
+}
+
+// What an application without the culler would write: one object at a time
+void scalarCull(const std::vector<ev::BoundingVolume> &objects, const ev::CullView &view,
+                ev::CullResult &result) {
+  for (auto &list : result.lods) {
+    list.clear();
+  }
+  for (uint32_t i = 0; i < objects.size(); ++i) {
+    const ev::BoundingVolume &object = objects[i];
+    if (!view.frustum.intersects(object)) {
+      continue;
+    }
+    const float distance = std::max((object.center - view.position).length(), 1e-4f);
+    const float size = object.radius * view.pixelScale / distance;
+    uint32_t lod = 0;
+    while (lod < kLodThresholds.size() && size < kLodThresholds[lod]) {
+      ++lod;
+    }
+    result.lods[lod].push_back(i);
+  }
+}
+
+bool sameLists(const ev::CullResult &a, const ev::CullResult &b) {
+  for (uint32_t lod = 0; lod < ev::CullResult::MaxLodCount; ++lod) {
+    if (a.lods[lod] != b.lods[lod]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+  std::uniform_real_distribution<float> size(0.5f, 8.0f);
+
+  const ev::Mat4f projection = ev::Mat4f::perspective(1.0f, 16.0f / 9.0f, 0.1f, 1500.0f);
+  const ev::Vec3f eye(0.0f, 20.0f, 0.0f);
+  const ev::Mat4f view = ev::Mat4f::lookAt(eye, {300.0f, 0.0f, -400.0f}, {0.0f, 1.0f, 0.0f});
+  const ev::CullView cullView = ev::CullView::create(view, projection, eye, 1080.0f);
+
+  ev::ThreadPool pool;
+  std::printf("best of %d runs, %u worker threads\n", kIterations, pool.getThreadCount());
+
+  for (size_t objectCount : {10000u, 100000u, 1000000u}) {
+    std::vector<ev::BoundingVolume> objects(objectCount);
+    ev::VisibilityCuller serial;
+    ev::VisibilityCuller parallel(&pool);
+    serial.setLodThresholds(kLodThresholds);
+    parallel.setLodThresholds(kLodThresholds);
+    for (auto &object : objects) {
+      const ev::Vec3f center(position(rng), position(rng) * 0.05f, position(rng));
+      const ev::Vec3f half(size(rng), size(rng), size(rng));
+      object = ev::BoundingVolume::fromAabb(center - half, center + half);
+      serial.addObject(object, 4);
+      parallel.addObject(object, 4);
+    }
+
+    ev::CullResult reference, serialResult, parallelResult;
+    const double scalarMs = measure([&] { scalarCull(objects, cullView, reference); });
+    const double serialMs = measure([&] { serial.cull(cullView, serialResult); });
+    const double parallelMs = measure([&] { parallel.cull(cullView, parallelResult); });
+
+    uint32_t referenceCount = 0;
+    for (const auto &list : reference.lods) {
+      referenceCount += static_cast<uint32_t>(list.size());
+    }
+    std::printf("\n%zu objects, %u visible (LOD 0-3: %zu / %zu / %zu / %zu)\n", objectCount, referenceCount,
+                reference.lods[0].size(), reference.lods[1].size(), reference.lods[2].size(),
+                reference.lods[3].size());
+    report("scalar loop", objectCount, scalarMs, scalarMs, true);
+    report("VisibilityCuller", objectCount, serialMs, scalarMs, sameLists(reference, serialResult));
+    report("VisibilityCuller+pool", objectCount, parallelMs, scalarMs, sameLists(reference, parallelResult));
+  }
+
+  return 0;
+}
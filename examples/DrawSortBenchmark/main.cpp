@@ -0,0 +1,132 @@
+// Compares DrawQueue's radix sort against std::stable_sort on the same keys and
+// reports the binds recording needs before and after sorting. No device is
+// created: the handles below are only compared, never passed to Vulkan.
+// DrawQueue::sort() times include counting the binds of both orders.
+
+#include <EasyVulkan/Core/DrawQueue.hpp>
+#include <EasyVulkan/Core/ThreadPool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int kIterations = 20;
+constexpr uint32_t kPipelines = 48;
+constexpr uint32_t kLayouts = 4;
+constexpr uint32_t kMaterials = 1024;
+constexpr uint32_t kMeshes = 512;
+
+// Best-of-N wall time in milliseconds
+double measure(const std::function<void()> &fn) {
+  double best = 1e30;
+  for (int i = 0; i < kIterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  return best;
+}
+
+void report(const char *name, size_t draws, double ms, double baselineMs, bool match) {
+  std::printf("  %-22s %8.3f ms (%7.1f M draws/s)   x%5.2f  %s\n", name, ms,
+              static_cast<double>(draws) / 1e6 / (ms / 1e3), baselineMs / ms, match ? "ok" : "MISMATCH");
+}
+
+void reportBinds(const char *name, const ev::DrawQueueStats &stats) {
+  std::printf("  %-10s %8u binds (pipeline %u, descriptor set %u, vertex %u, index %u)\n", name,
+              stats.getStateChanges(), stats.pipelineBinds, stats.descriptorSetBinds, stats.vertexBufferBinds,
+              stats.indexBufferBinds);
+}
+
+// Distinct non-null handle for a registration id; works for pointer and uint64_t handles
+template <typename Handle> Handle fakeHandle(uint64_t id) {
+  Handle handle{};
+  std::memcpy(&handle, &id, sizeof(handle));
+  return handle;
+}
+
+void registerState(ev::DrawQueue &queue) {
+  for (uint32_t i = 0; i < kPipelines; ++i) {
+    queue.addPipeline(fakeHandle<VkPipeline>(i + 1), fakeHandle<VkPipelineLayout>(i % kLayouts + 1));
+  }
+  for (uint32_t i = 0; i < kMaterials; ++i) {
+    queue.addMaterial(fakeHandle<VkDescriptorSet>(i + 1), 1);
+  }
+  for (uint32_t i = 0; i < kMeshes; ++i) {
+    queue.addMesh({fakeHandle<VkBuffer>(2 * i + 1)}, {0}, fakeHandle<VkBuffer>(2 * i + 2), 0,
+                  VK_INDEX_TYPE_UINT16);
+  }
+}
+
+// The order a comparison sort produces for the same keys
+std::vector<uint32_t> referenceOrder(const std::vector<uint64_t> &keys) {
+  std::vector<uint32_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+  return order;
+}
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<uint32_t> pipeline(0, kPipelines - 1);
+  std::uniform_int_distribution<uint32_t> material(0, kMaterials - 1);
+  std::uniform_int_distribution<uint32_t> mesh(0, kMeshes - 1);
+  std::uniform_real_distribution<float> depth(0.5f, 2000.0f);
+  std::bernoulli_distribution blended(0.1);
+
+  ev::ThreadPool pool;
+  std::printf("best of %d runs, %u worker threads\n", kIterations, pool.getThreadCount());
+
+  for (uint32_t drawCount : {1000u, 10000u, 100000u, 1000000u}) {
+    ev::DrawQueue serial;
+    ev::DrawQueue parallel(&pool);
+    registerState(serial);
+    registerState(parallel);
+
+    std::vector<uint64_t> keys;
+    keys.reserve(drawCount);
+    for (uint32_t i = 0; i < drawCount; ++i) {
+      ev::DrawPacket packet;
+      packet.pipeline = static_cast<uint16_t>(pipeline(rng));
+      packet.material = static_cast<uint16_t>(material(rng));
+      packet.mesh = static_cast<uint16_t>(mesh(rng));
+      packet.count = 3 * 256;
+      packet.firstInstance = i;
+
+      // Pass 0 opaque, pass 1 blended back to front
+      const bool isBlended = blended(rng);
+      const float viewDepth = depth(rng);
+      serial.submit(packet, isBlended ? 1 : 0, viewDepth, isBlended);
+      parallel.submit(packet, isBlended ? 1 : 0, viewDepth, isBlended);
+
+      const uint32_t quantized = ev::DrawSortKey::quantizeDepth(viewDepth);
+      keys.push_back(isBlended ? ev::DrawSortKey::makeBackToFront(1, quantized, packet.pipeline, packet.material,
+                                                                  packet.mesh)
+                               : ev::DrawSortKey::make(0, packet.pipeline, packet.material, packet.mesh, quantized));
+    }
+
+    std::vector<uint32_t> reference;
+    const double stdMs = measure([&] { reference = referenceOrder(keys); });
+    const double serialMs = measure([&] { serial.sort(); });
+    const double parallelMs = measure([&] { parallel.sort(); });
+
+    std::printf("\n%u draws\n", drawCount);
+    report("std::stable_sort", drawCount, stdMs, stdMs, true);
+    report("DrawQueue::sort", drawCount, serialMs, stdMs, serial.getOrder() == reference);
+    report("DrawQueue::sort+pool", drawCount, parallelMs, stdMs, parallel.getOrder() == reference);
+    reportBinds("submitted", serial.getSubmittedStats());
+    reportBinds("sorted", serial.getSortedStats());
+  }
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+// Compares the SimdMath types and batched transforms against plain scalar code.
+// Build with -march=native (or -mavx2 -mfma) to enable the 8-wide x86 paths.
+
+#include <EasyVulkan/Utils/SimdMath.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kCount = 1 << 20;
+constexpr int kIterations = 20;
+
+// Best-of-N wall time in milliseconds
+double measure(const std::function<void()> &fn) {
+  double best = 1e30;
+  for (int i = 0; i < kIterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  return best;
+}
+
+void report(const char *name, double scalarMs, double simdMs, bool match) {
+  const double millions = static_cast<double>(kCount) / 1e6;
+  std::printf("%-26s scalar %8.3f ms (%7.1f M/s)   simd %8.3f ms (%7.1f M/s)   x%5.2f  %s\n",
+              name, scalarMs, millions / (scalarMs / 1e3), simdMs, millions / (simdMs / 1e3),
+              scalarMs / simdMs, match ? "ok" : "MISMATCH");
+}
+
+bool close(float a, float b) {
+  return std::fabs(a - b) <= 1e-4f * std::max(1.0f, std::fabs(a));
+}
+
+// Column-major 4x4 product written the obvious way
+void scalarMultiply(const float *a, const float *b, float *out) {
+  for (int column = 0; column < 4; ++column) {
+    for (int row = 0; row < 4; ++row) {
+      float sum = 0.0f;
+      for (int k = 0; k < 4; ++k) {
+        sum += a[k * 4 + row] * b[column * 4 + k];
+      }
+      out[column * 4 + row] = sum;
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+  const ev::Mat4f viewProjection = ev::Mat4f::perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f) *
+                                   ev::Mat4f::lookAt({0.0f, 5.0f, 20.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f});
+  float viewProjectionElements[16];
+  viewProjection.store(viewProjectionElements);
+
+  std::printf("%zu elements, best of %d runs\n\n", kCount, kIterations);
+
+  // viewProjection * model for every object
+  std::vector<ev::Mat4f> models(kCount);
+  for (auto &model : models) {
+    model = ev::Mat4f::compose({dist(rng), dist(rng), dist(rng)},
+                               ev::Quatf::fromAxisAngle({dist(rng), dist(rng), dist(rng)}, dist(rng)),
+                               {1.0f, 2.0f, 1.0f});
+  }
+  std::vector<float> scalarMatrices(kCount * 16);
+  std::vector<ev::Mat4f> simdMatrices(kCount);
+  double scalarMs = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      scalarMultiply(viewProjectionElements, models[i].data(), scalarMatrices.data() + i * 16);
+    }
+  });
+  double simdMs = measure([&] { ev::SimdMath::multiply(viewProjection, models.data(), simdMatrices.data(), kCount); });
+  bool match = true;
+  for (size_t i = 0; i < kCount && match; ++i) {
+    for (int e = 0; e < 16; ++e) {
+      match = match && close(scalarMatrices[i * 16 + e], simdMatrices[i].data()[e]);
+    }
+  }
+  report("Mat4 * Mat4", scalarMs, simdMs, match);
+
+  // Interleaved Vec3f points through scalar code vs x/y/z arrays through the batch kernel
+  std::vector<ev::Vec3f> points(kCount);
+  std::vector<float> xs(kCount), ys(kCount), zs(kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    points[i] = ev::Vec3f(dist(rng), dist(rng), dist(rng));
+    xs[i] = points[i].x;
+    ys[i] = points[i].y;
+    zs[i] = points[i].z;
+  }
+  std::vector<ev::Vec3f> scalarPoints(kCount);
+  std::vector<float> outX(kCount), outY(kCount), outZ(kCount);
+  const float *m = viewProjectionElements;
+  scalarMs = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      const ev::Vec3f &p = points[i];
+      scalarPoints[i] = ev::Vec3f(m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+                                  m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+                                  m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+    }
+  });
+  simdMs = measure([&] {
+    ev::SimdMath::transformPoints(viewProjection, xs.data(), ys.data(), zs.data(),
+                                  outX.data(), outY.data(), outZ.data(), kCount);
+  });
+  match = true;
+  for (size_t i = 0; i < kCount; ++i) {
+    match = match && close(scalarPoints[i].x, outX[i]) && close(scalarPoints[i].y, outY[i]) &&
+            close(scalarPoints[i].z, outZ[i]);
+  }
+  report("Transform points (SoA)", scalarMs, simdMs, match);
+
+  // Quaternion rotation vs the scalar matrix path
+  const ev::Quatf rotation = ev::Quatf::fromAxisAngle({1.0f, 2.0f, 3.0f}, 0.7f);
+  const ev::Mat4f rotationMatrix = ev::Mat4f::rotation(rotation);
+  float r[16];
+  rotationMatrix.store(r);
+  std::vector<ev::Vec3f> rotated(kCount);
+  scalarMs = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      const ev::Vec3f &p = points[i];
+      scalarPoints[i] = ev::Vec3f(r[0] * p.x + r[4] * p.y + r[8] * p.z,
+                                  r[1] * p.x + r[5] * p.y + r[9] * p.z,
+                                  r[2] * p.x + r[6] * p.y + r[10] * p.z);
+    }
+  });
+  simdMs = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      rotated[i] = rotation.rotate(points[i]);
+    }
+  });
+  match = true;
+  for (size_t i = 0; i < kCount; ++i) {
+    match = match && close(scalarPoints[i].x, rotated[i].x) && close(scalarPoints[i].z, rotated[i].z);
+  }
+  report("Quat rotate (AoS)", scalarMs, simdMs, match);
+
+  // Scalar Vec3f::normalized() vs Vec4a
+  std::vector<ev::Vec3f> normals(kCount);
+  scalarMs = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      scalarPoints[i] = points[i].normalized();
+    }
+  });
+  simdMs = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      normals[i] = ev::Vec4a(points[i], 0.0f).normalized3().toVec3f();
+    }
+  });
+  match = true;
+  for (size_t i = 0; i < kCount; ++i) {
+    match = match && close(scalarPoints[i].x, normals[i].x) && close(scalarPoints[i].y, normals[i].y);
+  }
+  report("Normalize Vec3 (AoS)", scalarMs, simdMs, match);
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+// Compares the PixelConversion kernels against plain scalar loops.
+// Build with -march=native (or -mavx2 -mf16c) to enable the wider x86 paths.
+
+#include <EasyVulkan/Utils/PixelConversion.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kPixels = 2048 * 2048;
+constexpr int kIterations = 20;
+
+// Best-of-N wall time in milliseconds
+double measure(const std::function<void()> &fn) {
+  double best = 1e30;
+  for (int i = 0; i < kIterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  return best;
+}
+
+void report(const char *name, size_t bytes, double scalarMs, double kernelMs, bool match) {
+  const double gb = static_cast<double>(bytes) / 1e9;
+  std::printf("%-22s scalar %8.3f ms (%6.2f GB/s)   kernel %8.3f ms (%6.2f GB/s)   x%5.2f  %s\n",
+              name, scalarMs, gb / (scalarMs / 1e3), kernelMs, gb / (kernelMs / 1e3),
+              scalarMs / kernelMs, match ? "ok" : "MISMATCH");
+}
+
+uint16_t scalarHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, 4);
+  const uint32_t sign = (bits >> 16) & 0x8000u;
+  const int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+  uint32_t mantissa = bits & 0x7FFFFFu;
+  if (((bits >> 23) & 0xFF) == 0xFF) {
+    return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+  }
+  if (exponent >= 31) {
+    return static_cast<uint16_t>(sign | 0x7C00u);
+  }
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return static_cast<uint16_t>(sign);
+    }
+    mantissa |= 0x800000u;
+    const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+    uint32_t half = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1))) {
+      ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+  }
+  uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+  const uint32_t remainder = mantissa & 0x1FFFu;
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1))) {
+    ++half;
+  }
+  return static_cast<uint16_t>(sign | half);
+}
+
+uint8_t scalarSrgb(float linear) {
+  linear = linear > 0.0f ? (linear < 1.0f ? linear : 1.0f) : 0.0f;
+  const float srgb = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+  return static_cast<uint8_t>(srgb * 255.0f + 0.5f);
+}
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> byteDist(0, 255);
+  std::uniform_real_distribution<float> floatDist(0.0f, 1.0f);
+
+  std::vector<uint8_t> rgb(kPixels * 3);
+  std::vector<uint8_t> rgba(kPixels * 4);
+  std::vector<float> floats(kPixels * 4);
+  for (auto &value : rgb) value = static_cast<uint8_t>(byteDist(rng));
+  for (auto &value : rgba) value = static_cast<uint8_t>(byteDist(rng));
+  for (auto &value : floats) value = floatDist(rng);
+
+  std::vector<uint8_t> scalarOut(kPixels * 4);
+  std::vector<uint8_t> kernelOut(kPixels * 4);
+  std::vector<uint16_t> scalarHalfOut(kPixels * 4);
+  std::vector<uint16_t> kernelHalfOut(kPixels * 4);
+
+  std::printf("%zu pixels, best of %d runs\n\n", kPixels, kIterations);
+
+  double scalarMs = measure([&] {
+    for (size_t i = 0; i < kPixels; ++i) {
+      scalarOut[i * 4 + 0] = rgb[i * 3 + 0];
+      scalarOut[i * 4 + 1] = rgb[i * 3 + 1];
+      scalarOut[i * 4 + 2] = rgb[i * 3 + 2];
+      scalarOut[i * 4 + 3] = 255;
+    }
+  });
+  double kernelMs = measure([&] { ev::PixelConversion::rgb8ToRgba8(rgb.data(), kernelOut.data(), kPixels); });
+  report("RGB8 -> RGBA8", kPixels * 7, scalarMs, kernelMs, scalarOut == kernelOut);
+
+  scalarMs = measure([&] {
+    for (size_t i = 0; i < kPixels; ++i) {
+      scalarOut[i * 4 + 0] = rgba[i * 4 + 2];
+      scalarOut[i * 4 + 1] = rgba[i * 4 + 1];
+      scalarOut[i * 4 + 2] = rgba[i * 4 + 0];
+      scalarOut[i * 4 + 3] = rgba[i * 4 + 3];
+    }
+  });
+  kernelMs = measure([&] { ev::PixelConversion::swizzleRedBlue8(rgba.data(), kernelOut.data(), kPixels); });
+  report("BGRA8 <-> RGBA8", kPixels * 8, scalarMs, kernelMs, scalarOut == kernelOut);
+
+  scalarMs = measure([&] {
+    for (size_t i = 0; i < kPixels; ++i) {
+      const uint32_t alpha = rgba[i * 4 + 3];
+      for (int c = 0; c < 3; ++c) {
+        scalarOut[i * 4 + c] = static_cast<uint8_t>((rgba[i * 4 + c] * alpha + 127) / 255);
+      }
+      scalarOut[i * 4 + 3] = static_cast<uint8_t>(alpha);
+    }
+  });
+  kernelMs = measure([&] { ev::PixelConversion::premultiplyAlpha8(rgba.data(), kernelOut.data(), kPixels); });
+  report("Premultiply RGBA8", kPixels * 8, scalarMs, kernelMs, scalarOut == kernelOut);
+
+  scalarMs = measure([&] {
+    for (size_t i = 0; i < kPixels * 4; ++i) {
+      scalarHalfOut[i] = scalarHalf(floats[i]);
+    }
+  });
+  kernelMs = measure([&] { ev::PixelConversion::float32ToFloat16(floats.data(), kernelHalfOut.data(), kPixels * 4); });
+  report("RGBA32F -> RGBA16F", kPixels * 24, scalarMs, kernelMs, scalarHalfOut == kernelHalfOut);
+
+  scalarMs = measure([&] {
+    for (size_t i = 0; i < kPixels; ++i) {
+      for (int c = 0; c < 3; ++c) {
+        scalarOut[i * 4 + c] = scalarSrgb(floats[i * 4 + c]);
+      }
+      scalarOut[i * 4 + 3] = static_cast<uint8_t>(floats[i * 4 + 3] * 255.0f + 0.5f);
+    }
+  });
+  kernelMs = measure([&] { ev::PixelConversion::linearToSrgb8(floats.data(), kernelOut.data(), kPixels); });
+  // The table may differ from the exact curve by one code
+  bool withinOne = true;
+  for (size_t i = 0; i < kPixels * 4; ++i) {
+    withinOne = withinOne && std::abs(scalarOut[i] - kernelOut[i]) <= 1;
+  }
+  report("Linear RGBA32F -> sRGB8", kPixels * 20, scalarMs, kernelMs, withinOne);
+
+  return 0;
+}
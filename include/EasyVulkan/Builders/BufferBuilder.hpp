@@ -8,6 +8,7 @@
 #pragma once
 
 #include "../Common.hpp"
+#include "../DataStructures.hpp"
 
 namespace ev {
 
@@ -136,6 +137,10 @@ public:
      * - VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT: Optimize for sequential CPU writes
      * - VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT: Optimize for random CPU access
      * - VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT: Use dedicated memory allocation
+     * 
+     * @note Host-visible buffers (host access flags, HOST_VISIBLE properties or a
+     *       CPU_* / GPU_TO_CPU usage) always get VMA_ALLOCATION_CREATE_MAPPED_BIT,
+     *       so their memory stays mapped for the buffer's lifetime.
      */
     BufferBuilder& setMemoryFlags(VmaAllocationCreateFlags flags);
 
@@ -159,6 +164,40 @@ public:
     BufferBuilder& setQueueFamilyIndices(
         const std::vector<uint32_t>& queueFamilyIndices);
 
+    /**
+     * @brief Sets the memory accounting category of the buffer
+     * @param category Category the allocation is attributed to
+     * @return Reference to this builder for method chaining
+     * 
+     * @note When left as MemoryCategory::Unspecified the ResourceManager infers
+     *       the category from the name prefix and then from the usage flags.
+     *       Only named buffers are tracked and therefore accounted.
+     */
+    BufferBuilder& setMemoryCategory(MemoryCategory category);
+
+    /**
+     * @brief Makes the buffer addressable from shaders through a 64-bit pointer
+     * @return Reference to this builder for method chaining
+     * 
+     * Adds VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT; the allocator already
+     * allocates with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT when the device has the
+     * feature. Named buffers store the address in BufferInfo::getDeviceAddress(),
+     * others can query it with ResourceUtils::getBufferDeviceAddress().
+     * 
+     * Example:
+     * @code
+     * auto sceneBuffer = bufferBuilder
+     *     .setSize(sizeof(SceneData) * objectCount)
+     *     .setUsage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+     *     .enableDeviceAddress()
+     *     .buildAndInitialize(objects.data(), sizeof(SceneData) * objectCount, "sceneData");
+     * VkDeviceAddress address = resourceManager->m_buffers["sceneData"].getDeviceAddress();
+     * @endcode
+     * 
+     * @note build() throws if VulkanDevice::isBufferDeviceAddressEnabled() is false.
+     */
+    BufferBuilder& enableDeviceAddress();
+
     /**
      * @brief Builds the buffer with current configuration
      * @param name Optional name for resource tracking
@@ -196,6 +235,16 @@ public:
      *         - Data pointer is null
      *         - Data size doesn't match buffer size
      * 
+     * With the default VMA_MEMORY_USAGE_AUTO, no required memory properties and no
+     * host access or mapped flags the buffer is allocated with
+     * VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT: if it lands in
+     * DEVICE_LOCAL | HOST_VISIBLE memory (UMA, resizable BAR) the data is written
+     * directly, otherwise it is uploaded through a staging buffer and the buffer
+     * is not mapped. Set VMA_ALLOCATION_CREATE_MAPPED_BIT or a host access flag
+     * (or an explicit memory usage) to get a persistently mapped CPU_TO_GPU buffer
+     * that can be rewritten with ResourceUtils::uploadDataToMappedBuffer().
+     * The builder's own settings are left unchanged.
+     * 
      * Example:
      * @code
      * std::vector<Vertex> vertices = {...};
@@ -226,6 +275,8 @@ private:
     VkMemoryPropertyFlags m_memoryProperties{}; ///< Memory property flags
     VkSharingMode m_sharingMode{VK_SHARING_MODE_EXCLUSIVE}; ///< Buffer sharing mode
     std::vector<uint32_t> m_queueFamilyIndices; ///< Queue families for concurrent sharing
+    MemoryCategory m_memoryCategory{MemoryCategory::Unspecified}; ///< Memory accounting category
+    bool m_deviceAddress{false};             ///< Add SHADER_DEVICE_ADDRESS usage
 
     /**
      * @brief Validates builder parameters before buffer creation
@@ -247,6 +298,9 @@ private:
      * @param allocation VMA allocation pointer for the buffer
      * @param data Pointer to data
      * @param dataSize Size of data in bytes
+     * @throws std::runtime_error if flushing the written range fails
+     * @note The range is flushed immediately rather than queued on the device,
+     *       since unnamed buffers are destroyed outside the device's knowledge.
      */
     void uploadData(
         VkBuffer buffer,
@@ -87,12 +87,42 @@ public:
      * @param binding Vertex buffer binding description
      * @param attributes Vertex attribute descriptions
      * @return Reference to this builder for method chaining
-     * @details Describes how vertex data is laid out in memory
+     * @details Describes how vertex data is laid out in memory. Replaces any
+     *          bindings set before.
      */
     GraphicsPipelineBuilder& setVertexInputState(
         const VkVertexInputBindingDescription& binding,
         const std::vector<VkVertexInputAttributeDescription>& attributes);
 
+    /**
+     * @brief Sets a vertex input state reading several vertex buffers
+     * @param bindings Vertex buffer binding descriptions
+     * @param attributes Vertex attribute descriptions of every binding
+     * @return Reference to this builder for method chaining
+     * @details Replaces any bindings set before. Use it for split vertex streams
+     *          (e.g. SplitVertexLayout) where a depth-only pipeline declares just
+     *          the position stream and so fetches only position data.
+     */
+    GraphicsPipelineBuilder& setVertexInputState(
+        const std::vector<VkVertexInputBindingDescription>& bindings,
+        const std::vector<VkVertexInputAttributeDescription>& attributes);
+
+    /**
+     * @brief Adds a vertex buffer binding and its attributes
+     * @param binding Binding description; VK_VERTEX_INPUT_RATE_INSTANCE steps once per instance
+     * @param attributes Attributes read from this binding
+     * @return Reference to this builder for method chaining
+     *
+     * @code
+     * // Per-vertex mesh data plus a per-instance transform stream
+     * builder.setVertexInputState(Vertex::getBindingDescription(), {vertexAttributes.begin(), vertexAttributes.end()})
+     *        .addVertexBinding({1, sizeof(InstanceData), VK_VERTEX_INPUT_RATE_INSTANCE}, instanceAttributes);
+     * @endcode
+     */
+    GraphicsPipelineBuilder& addVertexBinding(
+        const VkVertexInputBindingDescription& binding,
+        const std::vector<VkVertexInputAttributeDescription>& attributes);
+
 
     /**
      * @brief Sets the input assembly state
@@ -267,7 +297,7 @@ private:
     uint32_t m_subpass{0};                      ///< Subpass index
 
     // Storage for dynamic arrays
-    VkVertexInputBindingDescription m_vertexBinding;    ///< Vertex bindings
+    std::vector<VkVertexInputBindingDescription> m_vertexBindings;     ///< Vertex bindings
     std::vector<VkVertexInputAttributeDescription> m_vertexAttributes; ///< Vertex attributes
     VkViewport m_viewport{};                                          ///< Viewport state
     VkRect2D m_scissor{};                                            ///< Scissor rectangle
@@ -283,6 +313,13 @@ private:
      */
     void initializeDefaults();
 
+    /**
+     * @brief Checks that bindings and attribute locations are unique and that
+     *        every attribute reads a declared binding
+     * @throws std::runtime_error on an inconsistent vertex input state
+     */
+    void validateVertexInput() const;
+
     /**
      * @brief Creates the pipeline layout from set layouts and push constants
      * @return Created pipeline layout handle
@@ -8,7 +8,12 @@
 
 #pragma once
 
+#include "../DataStructures.hpp"
+#include "../Core/MipGenerator.hpp"
+#include "../Utils/BlockCompression.hpp"
+#include "../Utils/PixelConversion.hpp"
 #include <vulkan/vulkan.h>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -17,6 +22,34 @@ namespace ev {
 class VulkanDevice;
 class VulkanContext;
 
+/**
+ * @struct ImagePlacementPolicy
+ * @brief Heuristics deciding how an image's memory is placed
+ * @details Large images and render targets get their own VkDeviceMemory so they do
+ *          not fragment shared blocks and the driver can apply dedicated-allocation
+ *          optimisations. Priorities are only forwarded when VK_EXT_memory_priority
+ *          is enabled on the device.
+ */
+struct ImagePlacementPolicy {
+    VkDeviceSize dedicatedThreshold{16ull * 1024 * 1024}; ///< Images at least this large get dedicated memory (0 disables)
+    bool dedicatedForAttachments{true};  ///< Color/depth attachments always get dedicated memory
+    float attachmentPriority{1.0f};      ///< Memory priority of attachments and storage images
+    float defaultPriority{0.5f};         ///< Memory priority of all other images
+};
+
+/**
+ * @struct ImagePlacementDecision
+ * @brief Report of the placement chosen for the last built image
+ */
+struct ImagePlacementDecision {
+    VkDeviceSize size{0};                ///< Size from vkGetImageMemoryRequirements2
+    bool driverRequiresDedicated{false}; ///< VkMemoryDedicatedRequirements::requiresDedicatedAllocation
+    bool driverPrefersDedicated{false};  ///< VkMemoryDedicatedRequirements::prefersDedicatedAllocation
+    bool dedicated{false};               ///< Whether VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT was set
+    float priority{0.5f};                ///< Priority passed to VMA (effective only with memory priority)
+    std::string reason;                  ///< Human-readable reason for the decision
+};
+
 
 /**
  * @class ImageBuilder
@@ -46,11 +79,11 @@ class VulkanContext;
  *      .setUsage(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)
  *      .build("depthBuffer");
  *
- * // Create a cubemap
+ * // Create a cubemap (the view type follows: CUBE)
  * auto cubemap = imageBuilder
  *      .setFormat(VK_FORMAT_R8G8B8A8_SRGB)
  *      .setExtent(size, size)
- *      .setArrayLayers(6)
+ *      .setCubemap()
  *      .setUsage(VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)
  *      .build("cubemap");
  * @endcode
@@ -109,6 +142,96 @@ public:
      */
     ImageBuilder& setMipLevels(uint32_t mipLevels);
 
+    /**
+     * @brief Uses a complete mip chain down to 1x1
+     * @return Reference to this builder for method chaining
+     * 
+     * @note The level count is computed from the extent when the image is built.
+     */
+    ImageBuilder& setFullMipChain();
+
+    /**
+     * @brief Sets how buildAndInitialize() fills mip levels 1..N-1 on the GPU
+     * @param mode Generation strategy (Auto by default)
+     * @param generator Generator providing the compute downsampler (optional;
+     *        without it only the blit chain is available)
+     * @return Reference to this builder for method chaining
+     * 
+     * The required usage and create flags (TRANSFER_SRC for blits, STORAGE and
+     * MUTABLE_FORMAT for compute on sRGB formats) are added automatically, and the
+     * mips are recorded into the same command buffer as the level 0 upload.
+     * 
+     * Example:
+     * @code
+     * auto texture = imageBuilder
+     *     .setFormat(VK_FORMAT_R16G16B16A16_SFLOAT)
+     *     .setExtent(width, height)
+     *     .setFullMipChain()
+     *     .setUsage(VK_IMAGE_USAGE_SAMPLED_BIT)
+     *     .setMipGeneration(MipGenerationMode::Compute, &mipGenerator)
+     *     .buildAndInitialize(pixels, dataSize, "environment", nullptr,
+     *                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+     * @endcode
+     */
+    ImageBuilder& setMipGeneration(MipGenerationMode mode, MipGenerator* generator = nullptr);
+
+    /**
+     * @brief Compresses RGBA8 data on the CPU before buildAndInitialize() uploads it
+     * @param format Block format to store the image in
+     * @param pool Optional thread pool encoding block rows in parallel
+     * @return Reference to this builder for method chaining
+     * 
+     * The builder format must be VK_FORMAT_R8G8B8A8_UNORM or _SRGB and describes the
+     * source data; the image is created in the matching BCn format (sRGB is kept for
+     * BC1/BC7). Mip levels are filtered on the CPU, since block-compressed images
+     * cannot be blit or storage targets, and every level is uploaded in one copy.
+     * 
+     * @note Only single-layer 2D images are supported.
+     */
+    ImageBuilder& setBlockCompression(BlockFormat format, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Describes the layout of the data passed to buildAndInitialize()
+     * @param format Layout of the source pixels
+     * @param premultiplyAlpha Multiply color by alpha while converting
+     * @return Reference to this builder for method chaining
+     * 
+     * The data is converted into the image format while it is written to the staging
+     * buffer (RGB8 expansion, BGRA swizzle, float32 to float16, sRGB encoding), so
+     * callers no longer need a converted copy. See PixelConversion::isSupported()
+     * for the available pairs.
+     * 
+     * Example:
+     * @code
+     * auto texture = imageBuilder
+     *     .setFormat(VK_FORMAT_R8G8B8A8_SRGB)
+     *     .setExtent(width, height)
+     *     .setUsage(VK_IMAGE_USAGE_SAMPLED_BIT)
+     *     .setSourcePixelFormat(SourcePixelFormat::RGB8)
+     *     .buildAndInitialize(rgb.data(), rgb.size(), "albedo");
+     * @endcode
+     */
+    ImageBuilder& setSourcePixelFormat(SourcePixelFormat format, bool premultiplyAlpha = false);
+
+    /**
+     * @brief Sets the largest upload buildAndInitialize() writes from the host
+     * @param maxBytes Upload size limit in bytes (0 always uses the staging path)
+     * @return Reference to this builder for method chaining
+     * 
+     * When VK_EXT_host_image_copy is enabled on the device, uploads up to this size
+     * that need no generated mips are written with vkCopyMemoryToImageEXT after a
+     * host-side vkTransitionImageLayoutEXT: no staging buffer, command buffer or
+     * queue submission is involved, so initial loads can run on worker threads
+     * without contending for the queue. The path is only taken when the format
+     * supports host transfers, the final layout is in the device's copy
+     * destination layouts and adding VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT keeps
+     * optimal device access; otherwise the staging path is used. The default is 16 MiB.
+     * 
+     * @note build() registers named images with the ResourceManager, which is not
+     *       thread-safe; build unnamed images on worker threads.
+     */
+    ImageBuilder& setHostImageCopyLimit(VkDeviceSize maxBytes);
+
     /**
      * @brief Sets the number of array layers
      * @param arrayLayers Number of array layers (6 for cubemaps)
@@ -117,6 +240,27 @@ public:
      */
     ImageBuilder& setArrayLayers(uint32_t arrayLayers);
 
+    /**
+     * @brief Makes the image a cubemap or cubemap array
+     * @param cubeCount Number of cubes (6 layers each)
+     * @return Reference to this builder for method chaining
+     * 
+     * Sets the layer count and VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT, so build()
+     * creates a CUBE (or CUBE_ARRAY) view. The extent must be square.
+     */
+    ImageBuilder& setCubemap(uint32_t cubeCount = 1);
+
+    /**
+     * @brief Overrides the type of the view build() creates
+     * @param viewType View type
+     * @return Reference to this builder for method chaining
+     * 
+     * Without an override the view type follows the image: 1D/2D (ARRAY when there
+     * are several layers), 3D, and CUBE/CUBE_ARRAY for cube-compatible images whose
+     * layer count is a multiple of 6.
+     */
+    ImageBuilder& setViewType(VkImageViewType viewType);
+
     /**
      * @brief Sets the number of samples for multisampling
      * @param samples Number of samples per pixel
@@ -212,6 +356,63 @@ public:
      */
     ImageBuilder& setInitialLayout(VkImageLayout initialLayout);
 
+    /**
+     * @brief Adds image creation flags
+     * @param flags Image creation flags
+     * @return Reference to this builder for method chaining
+     * 
+     * The flags are ORed into the current set, so calling this before or after
+     * setCubemap() keeps VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT.
+     * 
+     * Common flags:
+     * - VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT: Image can back cube/cube-array views
+     * - VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT: Views may use a compatible format
+     * 
+     * @note Flags required by mip generation are added on top of these.
+     */
+    ImageBuilder& setCreateFlags(VkImageCreateFlags flags);
+
+    /**
+     * @brief Sets the memory accounting category of the image
+     * @param category Category the allocation is attributed to
+     * @return Reference to this builder for method chaining
+     * 
+     * @note When left as MemoryCategory::Unspecified the ResourceManager infers
+     *       the category from the name prefix and then from the usage flags.
+     */
+    ImageBuilder& setMemoryCategory(MemoryCategory category);
+
+    /**
+     * @brief Sets the placement heuristics used when allocating the image
+     * @param policy Dedicated-allocation thresholds and memory priorities
+     * @return Reference to this builder for method chaining
+     */
+    ImageBuilder& setPlacementPolicy(const ImagePlacementPolicy& policy);
+
+    /**
+     * @brief Overrides the memory priority derived from the placement policy
+     * @param priority Priority in [0, 1]; higher stays resident longer under pressure
+     * @return Reference to this builder for method chaining
+     */
+    ImageBuilder& setMemoryPriority(float priority);
+
+    /**
+     * @brief Get the placement decision made for the last built image
+     * @return Size, driver dedicated-allocation hints, chosen placement and reason
+     * 
+     * Example:
+     * @code
+     * auto builder = resourceManager->createImage();
+     * auto gbuffer = builder.setFormat(VK_FORMAT_R16G16B16A16_SFLOAT)
+     *     .setExtent(3840, 2160)
+     *     .setUsage(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)
+     *     .build("gbufferAlbedo");
+     * const auto& decision = builder.getPlacementDecision();
+     * printf("%s: %s\n", decision.dedicated ? "dedicated" : "shared", decision.reason.c_str());
+     * @endcode
+     */
+    const ImagePlacementDecision& getPlacementDecision() const { return m_placementDecision; }
+
     /**
      * @brief Builds the image with current configuration
      * @param name Optional name for resource tracking
@@ -275,6 +476,51 @@ public:
         VmaAllocation* outAllocation = nullptr,
         VkImageLayout finalImageLayout=VK_IMAGE_LAYOUT_GENERAL);
 
+    /**
+     * @brief Builds the image and uploads a list of subresource regions
+     * @param regions Slices to copy (any mip level, layer range, offset and row pitch)
+     * @param name Optional name for resource tracking
+     * @param outAllocation Optional pointer to receive VMA allocation handle
+     * @param finalImageLayout Layout every subresource is left in
+     * @return Created and initialized image info
+     * @throws std::runtime_error if:
+     *         - The list is empty or a region has no data
+     *         - A region lies outside the image's levels or layers
+     *         - Block compression is enabled (it expects one RGBA8 level)
+     * 
+     * All regions are packed into one staging buffer and recorded as a single
+     * multi-region copy in one submission. A region with a zero extent covers its
+     * whole mip level. When every region targets level 0 and the image has more
+     * levels, the rest of the chain is generated on the GPU as in
+     * buildAndInitialize(data, dataSize); otherwise the regions are expected to
+     * provide every level. setSourcePixelFormat() conversions apply per region.
+     * Uploads without generated mips may instead be written directly from the
+     * host; see setHostImageCopyLimit().
+     * 
+     * Example:
+     * @code
+     * // Cubemap with a prebuilt mip chain: one region per level, six faces each
+     * std::vector<ImageUploadRegion> regions(levelCount);
+     * for (uint32_t level = 0; level < levelCount; ++level) {
+     *     regions[level].data = faces[level].data();
+     *     regions[level].mipLevel = level;
+     *     regions[level].layerCount = 6;
+     * }
+     * auto skybox = imageBuilder
+     *     .setFormat(VK_FORMAT_R16G16B16A16_SFLOAT)
+     *     .setExtent(size, size)
+     *     .setMipLevels(levelCount)
+     *     .setCubemap()
+     *     .setUsage(VK_IMAGE_USAGE_SAMPLED_BIT)
+     *     .buildAndInitialize(regions, "skybox", nullptr, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+     * @endcode
+     */
+    ImageInfo buildAndInitialize(
+        const std::vector<ImageUploadRegion>& regions,
+        const std::string& name = "",
+        VmaAllocation* outAllocation = nullptr,
+        VkImageLayout finalImageLayout = VK_IMAGE_LAYOUT_GENERAL);
+
 
     /**
      * @brief Creates an image view for an image
@@ -305,6 +551,10 @@ public:
      *     "cubemapView"
      * );
      * @endcode
+     * 
+     * @note Every call creates a new view owned by the caller. For additional views
+     *       of a named image (single mips, layers, other formats) prefer
+     *       ResourceManager::getImageView(), which shares and cleans them up.
      */
     VkImageView createImageView(
         VkImage image,
@@ -332,6 +582,20 @@ private:
     std::vector<uint32_t> m_queueFamilyIndices; ///< Queue families for concurrent sharing
 
     VkImageLayout m_initialLayout{VK_IMAGE_LAYOUT_UNDEFINED}; ///< Initial image layout
+    MemoryCategory m_memoryCategory{MemoryCategory::Unspecified}; ///< Memory accounting category
+    ImagePlacementPolicy m_placementPolicy{};      ///< Dedicated-allocation / priority heuristics
+    float m_memoryPriority{-1.0f};                 ///< Explicit priority (negative: use policy)
+    ImagePlacementDecision m_placementDecision{};  ///< Decision made for the last image
+    VkImageCreateFlags m_createFlags{0};           ///< Image creation flags
+    bool m_fullMipChain{false};                    ///< Derive the mip count from the extent
+    MipGenerationMode m_mipGenerationMode{MipGenerationMode::Auto}; ///< Mip fill strategy
+    MipGenerator* m_mipGenerator{nullptr};         ///< Generator with the compute path (optional)
+    std::optional<BlockFormat> m_blockCompression; ///< CPU block compression of uploaded data
+    ThreadPool* m_compressionPool{nullptr};        ///< Pool used by the block encoder (optional)
+    std::optional<VkImageViewType> m_viewType;     ///< View type override (unset: derived)
+    std::optional<SourcePixelFormat> m_sourcePixelFormat; ///< Layout of uploaded data (unset: image format)
+    bool m_premultiplyAlpha{false};                ///< Premultiply alpha while converting
+    VkDeviceSize m_hostImageCopyLimit{16ull * 1024 * 1024}; ///< Largest upload written from the host
 
     /**
      * @brief Validates builder parameters before image creation
@@ -340,27 +604,88 @@ private:
     void validateParameters() const;
 
     /**
-     * @brief Creates the image using VMA
+     * @brief Creates the image and allocates its memory according to the placement policy
      * @param outAllocation Pointer to receive VMA allocation handle
+     * @param extraUsage Usage added for this image only, on top of the configured usage
      * @return Created image
-     * @throws std::runtime_error if image creation fails
+     * @throws std::runtime_error if image creation, allocation or binding fails
      */
-    VkImage createImage(VmaAllocation* outAllocation) const;
+    VkImage createImage(VmaAllocation* outAllocation, VkImageUsageFlags extraUsage);
 
     /**
-     * @brief Uploads data to an image
-     * @param imageInfo ImageInfo to upload to
-     * @param data Pointer to image data
-     * @param dataSize Size of data in bytes
-     * @param finalImageLayout Final image layout
-     * @throws std::runtime_error if data upload fails
+     * @brief build() with extra usage flags that are not stored in the builder
+     * @param name Optional name for resource tracking
+     * @param outAllocation Optional pointer to receive VMA allocation handle
+     * @param extraUsage Usage added for this image only, e.g. host transfer
+     * @return Created image info
+     */
+    ImageInfo buildImage(const std::string& name, VmaAllocation* outAllocation, VkImageUsageFlags extraUsage);
+
+    /**
+     * @brief Applies the placement policy to an image's memory requirements
+     * @param image Image whose requirements are queried with vkGetImageMemoryRequirements2
+     * @return Decision for the allocation
      */
+    ImagePlacementDecision decidePlacement(VkImage image) const;
 
+    /**
+     * @brief Copies regions and generates the remaining mips in one submission
+     * @param imageInfo ImageInfo to upload to; its layout is updated
+     * @param regions Validated regions with non-zero extents
+     * @param finalImageLayout Final image layout of every level
+     * @param mipGenerator Generator recording the mip chain
+     * @param mipMode Resolved generation mode (None when the regions hold every level)
+     * @throws std::runtime_error if data upload fails
+     */
     void uploadData(
-        ImageInfo imageInfo,
+        ImageInfo& imageInfo,
+        const std::vector<ImageUploadRegion>& regions,
+        VkImageLayout finalImageLayout,
+        MipGenerator* mipGenerator,
+        MipGenerationMode mipMode) const;
+
+    /**
+     * @brief Checks whether an upload can use VK_EXT_host_image_copy
+     * @param uploadSize Bytes written to the image
+     * @param finalImageLayout Layout the image is left in
+     * @return true if the device, format, layout and size limit allow a host copy
+     */
+    bool canUseHostImageCopy(VkDeviceSize uploadSize, VkImageLayout finalImageLayout) const;
+
+    /**
+     * @brief Transitions and fills an image from the host with VK_EXT_host_image_copy
+     * @param imageInfo ImageInfo to upload to; its layout is updated
+     * @param regions Validated regions with non-zero extents
+     * @param finalImageLayout Final image layout of every level
+     * @throws std::runtime_error if the transition or copy fails
+     */
+    void uploadDataOnHost(
+        ImageInfo& imageInfo,
+        const std::vector<ImageUploadRegion>& regions,
+        VkImageLayout finalImageLayout) const;
+
+    /**
+     * @brief View type build() creates for the current parameters
+     * @return Explicit override, or the type derived from image type, layers and flags
+     */
+    VkImageViewType resolveViewType() const;
+
+    /**
+     * @brief buildAndInitialize() path for setBlockCompression()
+     * @param data RGBA8 level 0 texels
+     * @param dataSize Size of data in bytes
+     * @param name Optional name for resource tracking
+     * @param outAllocation Optional pointer to receive VMA allocation handle
+     * @param finalImageLayout Final image layout of every level
+     * @return Created and initialized image info
+     * @throws std::runtime_error if the source format or image shape is unsupported
+     */
+    ImageInfo buildAndInitializeCompressed(
         const void* data,
         VkDeviceSize dataSize,
-        VkImageLayout finalImageLayout=VK_IMAGE_LAYOUT_GENERAL) const;
+        const std::string& name,
+        VmaAllocation* outAllocation,
+        VkImageLayout finalImageLayout);
 
     /**
      * @brief Transitions an image's layout
@@ -198,6 +198,25 @@ public:
      */
     VkSampler build(const std::string& name = "");
 
+    /**
+     * @brief Returns the shared sampler for the current configuration
+     * @return Sampler owned by ResourceManager's SamplerCache
+     * @throws std::runtime_error if parameters are invalid or sampler creation fails
+     *
+     * Builders with identical settings get the same handle and add a reference to
+     * it; vkCreateSampler only runs for settings the cache has not seen. Return the
+     * reference with SamplerCache::release() instead of destroying the sampler.
+     *
+     * Example:
+     * @code
+     * // Every material asking for trilinear repeat shares one sampler
+     * VkSampler sampler = resourceManager->createSampler()
+     *     .setAnisotropy(8.0f)
+     *     .buildShared();
+     * @endcode
+     */
+    VkSampler buildShared();
+
 private:
     VulkanDevice* m_device;                  ///< Pointer to VulkanDevice instance
     VulkanContext* m_context;                ///< Pointer to VulkanContext instance
@@ -226,6 +245,12 @@ private:
      *         - Parameter combinations are invalid
      */
     void validateParameters() const;
+
+    /**
+     * @brief Collects the builder state into a create info
+     * @return VkSamplerCreateInfo for the current configuration
+     */
+    VkSamplerCreateInfo makeCreateInfo() const;
 };
 
 } // namespace ev 
\ No newline at end of file
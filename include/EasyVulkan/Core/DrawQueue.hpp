@@ -0,0 +1,441 @@
+/**
+ * @file DrawQueue.hpp
+ * @brief Sorted draw submission for EasyVulkan framework
+ * @details This file contains the DrawQueue class which collects draw packets
+ *          tagged with 64-bit sort keys, radix-sorts them once per frame and
+ *          records them without the binds that repeat the previous draw's state.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "GeometryPool.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace ev {
+
+class ThreadPool;
+
+/**
+ * @struct DrawSortKey
+ * @brief Layout of the 64-bit keys draws are sorted by
+ * @details From the most significant bits: pass (4), pipeline (12), material (16),
+ *          mesh (16), depth (16). Ascending order groups the draws of a pass by
+ *          the most expensive state first and orders draws sharing all state front
+ *          to back. Blended passes use makeBackToFront(), which moves the depth
+ *          right below the pass so the blending order wins over state.
+ *
+ * Fields are masked to their width.
+ */
+struct DrawSortKey {
+    static constexpr uint32_t PassBits = 4;      ///< Up to 16 passes
+    static constexpr uint32_t PipelineBits = 12; ///< Up to 4096 pipelines
+    static constexpr uint32_t MaterialBits = 16; ///< Up to 65536 materials
+    static constexpr uint32_t MeshBits = 16;     ///< Up to 65536 meshes
+    static constexpr uint32_t DepthBits = 16;    ///< Quantized view depth
+    static constexpr uint32_t PassShift = 64 - PassBits;
+
+    /**
+     * @brief Builds a state-sorted key (opaque passes)
+     * @param pass Pass index, sorted first
+     * @param pipeline Pipeline index
+     * @param material Material index
+     * @param mesh Mesh index
+     * @param depth Quantized depth (see quantizeDepth()), near first
+     */
+    static constexpr uint64_t make(uint32_t pass, uint32_t pipeline, uint32_t material,
+                                   uint32_t mesh, uint32_t depth) {
+        return field(pass, PassBits, PassShift) |
+               field(pipeline, PipelineBits, PassShift - PipelineBits) |
+               field(material, MaterialBits, MeshBits + DepthBits) |
+               field(mesh, MeshBits, DepthBits) |
+               field(depth, DepthBits, 0);
+    }
+
+    /**
+     * @brief Builds a depth-sorted key (blended passes), far first
+     * @param pass Pass index, sorted first
+     * @param depth Quantized depth (see quantizeDepth())
+     * @param pipeline Pipeline index
+     * @param material Material index
+     * @param mesh Mesh index
+     */
+    static constexpr uint64_t makeBackToFront(uint32_t pass, uint32_t depth, uint32_t pipeline,
+                                              uint32_t material, uint32_t mesh) {
+        return field(pass, PassBits, PassShift) |
+               field(~depth, DepthBits, PassShift - DepthBits) |
+               field(pipeline, PipelineBits, MaterialBits + MeshBits) |
+               field(material, MaterialBits, MeshBits) |
+               field(mesh, MeshBits, 0);
+    }
+
+    /**
+     * @brief Pass of a key
+     */
+    static constexpr uint32_t getPass(uint64_t key) { return static_cast<uint32_t>(key >> PassShift); }
+
+    /**
+     * @brief Quantizes a view-space distance to DepthBits
+     * @param viewDepth Distance from the camera (negative and NaN count as 0)
+     * @return Monotonic 16-bit depth with about 0.4% relative precision
+     * @details Keeps the exponent and the top mantissa bits of the float, so
+     *          precision follows the distance and no depth range is needed.
+     */
+    static uint32_t quantizeDepth(float viewDepth) {
+        const float depth = viewDepth > 0.0f ? viewDepth : 0.0f;
+        return std::bit_cast<uint32_t>(depth) >> (32 - DepthBits - 1);
+    }
+
+private:
+    static constexpr uint64_t field(uint32_t value, uint32_t bits, uint32_t shift) {
+        return (static_cast<uint64_t>(value) & ((1ull << bits) - 1)) << shift;
+    }
+};
+
+/**
+ * @struct DrawPacket
+ * @brief One draw and the state it needs, as indices into a DrawQueue
+ * @details Per-object data is usually reached through firstInstance
+ *          (gl_InstanceIndex in the vertex shader).
+ */
+struct DrawPacket {
+    static constexpr uint16_t NoMaterial = 0xFFFF; ///< Draw binds no descriptor set
+
+    uint16_t pipeline{0};          ///< Index returned by DrawQueue::addPipeline()
+    uint16_t material{NoMaterial}; ///< Index returned by DrawQueue::addMaterial()
+    uint16_t mesh{0};              ///< Index returned by DrawQueue::addMesh()
+    uint32_t count{0};             ///< Index count (vertex count for non-indexed meshes)
+    uint32_t instanceCount{1};     ///< Number of instances
+    uint32_t firstIndex{0};        ///< First index (first vertex for non-indexed meshes)
+    int32_t vertexOffset{0};       ///< Added to every index
+    uint32_t firstInstance{0};     ///< First instance index
+
+    /**
+     * @brief Builds the packet drawing a GeometryPool mesh
+     * @param allocation Mesh inside the pool registered as mesh
+     * @param pipeline Pipeline index
+     * @param material Material index (NoMaterial for none)
+     * @param mesh Index returned by DrawQueue::addMesh(const GeometryPool&)
+     * @param instanceCount Number of instances
+     * @param firstInstance First instance index
+     */
+    static DrawPacket fromAllocation(const GeometryAllocation& allocation, uint16_t pipeline,
+                                     uint16_t material, uint16_t mesh,
+                                     uint32_t instanceCount = 1, uint32_t firstInstance = 0) {
+        DrawPacket packet;
+        packet.pipeline = pipeline;
+        packet.material = material;
+        packet.mesh = mesh;
+        packet.count = allocation.indexCount;
+        packet.instanceCount = instanceCount;
+        packet.firstIndex = allocation.firstIndex;
+        packet.vertexOffset = allocation.vertexOffset;
+        packet.firstInstance = firstInstance;
+        return packet;
+    }
+};
+
+/**
+ * @struct DrawQueueStats
+ * @brief Binds needed to record a queue in some order
+ */
+struct DrawQueueStats {
+    uint32_t drawCount{0};          ///< Draws recorded
+    uint32_t pipelineBinds{0};      ///< vkCmdBindPipeline calls
+    uint32_t descriptorSetBinds{0}; ///< vkCmdBindDescriptorSets calls
+    uint32_t vertexBufferBinds{0};  ///< vkCmdBindVertexBuffers calls
+    uint32_t indexBufferBinds{0};   ///< vkCmdBindIndexBuffer calls
+
+    /**
+     * @brief Total number of binds
+     */
+    uint32_t getStateChanges() const {
+        return pipelineBinds + descriptorSetBinds + vertexBufferBinds + indexBufferBinds;
+    }
+};
+
+/**
+ * @class DrawQueue
+ * @brief Per-frame draw packets sorted by 64-bit keys and recorded with minimal binds
+ * @details DrawQueue provides:
+ *          - Registration of pipelines, materials (descriptor sets) and meshes
+ *            (vertex/index buffer bindings), referenced by index from packets
+ *          - Keyed submission (DrawSortKey layout, or any custom 64-bit key)
+ *          - A stable LSD radix sort over the keys, 8 bits per pass, skipping
+ *            bytes all keys share and splitting large queues across a ThreadPool
+ *          - Recording through CommandUtils that skips binds matching the
+ *            previous draw, per pass or for the whole queue
+ *          - Bind counts in submission order and in sorted order
+ *
+ * Meshes with identical buffer bindings share one bind, so every mesh of a
+ * GeometryPool costs a single vertex and index buffer bind.
+ *
+ * Common usage patterns:
+ * @code
+ * DrawQueue queue(&pool);
+ * uint16_t opaque = queue.addPipeline(opaquePipeline, pipelineLayout);
+ * uint16_t stone = queue.addMaterial(stoneDescriptorSet, 1);
+ * uint16_t geometry = queue.addMesh(geometryPool);
+ *
+ * // Every frame
+ * queue.clear();
+ * for (const Object& object : visibleObjects) {
+ *     queue.submit(DrawPacket::fromAllocation(object.mesh, opaque, stone, geometry, 1, object.id),
+ *                  0, object.viewDepth);
+ * }
+ * queue.sort();
+ * queue.record(cmd, 0);
+ *
+ * LogInfo("binds: " + std::to_string(queue.getSubmittedStats().getStateChanges()) + " -> " +
+ *         std::to_string(queue.getSortedStats().getStateChanges()));
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override recordDraw() to emit per-draw push constants or another draw
+ *         command
+ */
+class DrawQueue {
+public:
+    /**
+     * @brief Constructor for DrawQueue
+     * @param pool Worker pool for large queues (optional, nullptr sorts on the caller)
+     */
+    explicit DrawQueue(ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~DrawQueue() = default;
+
+    DrawQueue(const DrawQueue&) = delete;
+    DrawQueue& operator=(const DrawQueue&) = delete;
+
+    /**
+     * @brief Registers a graphics pipeline
+     * @param pipeline Pipeline to bind
+     * @param layout Its layout, used to bind materials
+     * @return Pipeline index for packets and keys
+     * @throws std::runtime_error if 2^DrawSortKey::PipelineBits pipelines are registered
+     */
+    uint16_t addPipeline(VkPipeline pipeline, VkPipelineLayout layout);
+
+    /**
+     * @brief Registers a material
+     * @param descriptorSet Descriptor set to bind
+     * @param firstSet Set number it is bound to
+     * @return Material index for packets and keys
+     * @throws std::runtime_error if DrawPacket::NoMaterial materials are registered
+     */
+    uint16_t addMaterial(VkDescriptorSet descriptorSet, uint32_t firstSet = 0);
+
+    /**
+     * @brief Registers the buffer bindings of a mesh
+     * @param vertexBuffers Vertex buffers bound from binding 0
+     * @param offsets Offset within each vertex buffer
+     * @param indexBuffer Index buffer (VK_NULL_HANDLE for non-indexed draws)
+     * @param indexOffset Offset within the index buffer
+     * @param indexType Type of the indices
+     * @return Mesh index for packets and keys
+     * @throws std::runtime_error if buffers and offsets differ in size or 65536
+     *         meshes are registered
+     */
+    uint16_t addMesh(
+        const std::vector<VkBuffer>& vertexBuffers,
+        const std::vector<VkDeviceSize>& offsets,
+        VkBuffer indexBuffer = VK_NULL_HANDLE,
+        VkDeviceSize indexOffset = 0,
+        VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+
+    /**
+     * @brief Registers the shared buffers of a GeometryPool as one mesh
+     * @param geometry Pool whose allocations are drawn with DrawPacket::fromAllocation()
+     * @return Mesh index for packets and keys
+     */
+    uint16_t addMesh(const GeometryPool& geometry);
+
+    /**
+     * @brief Queues a draw with a custom key
+     * @param key Sort key; its top DrawSortKey::PassBits bits are the pass
+     * @param packet Draw to record
+     */
+    void submit(uint64_t key, const DrawPacket& packet);
+
+    /**
+     * @brief Queues a draw keyed by its own state
+     * @param packet Draw to record
+     * @param pass Pass index
+     * @param viewDepth Distance from the camera
+     * @param backToFront Sort by depth before state (blended passes)
+     */
+    void submit(const DrawPacket& packet, uint32_t pass, float viewDepth, bool backToFront = false);
+
+    /**
+     * @brief Sorts the queued draws by key and updates both statistics
+     * @details Equal keys keep their submission order.
+     */
+    void sort();
+
+    /**
+     * @brief Records every queued draw
+     * @param commandBuffer Command buffer inside a render pass
+     * @details Draws are recorded in the order of the last sort(); draws submitted
+     *          after it follow in submission order. State is bound again at the
+     *          start of every pass.
+     */
+    void record(VkCommandBuffer commandBuffer);
+
+    /**
+     * @brief Records the queued draws of one pass
+     * @param commandBuffer Command buffer inside the pass's render pass
+     * @param pass Pass index
+     */
+    void record(VkCommandBuffer commandBuffer, uint32_t pass);
+
+    /**
+     * @brief Removes the queued draws; registrations are kept
+     */
+    void clear();
+
+    /**
+     * @brief Sets the draw count from which sort() uses the thread pool
+     * @param drawCount Smaller queues are sorted on the calling thread
+     */
+    void setParallelThreshold(uint32_t drawCount) { m_parallelThreshold = drawCount; }
+
+    /**
+     * @brief Get the number of queued draws
+     * @return Draw count
+     */
+    uint32_t getDrawCount() const { return static_cast<uint32_t>(m_packets.size()); }
+
+    /**
+     * @brief Get the packet indices in recording order
+     * @return Indices into the submitted packets
+     */
+    const std::vector<uint32_t>& getOrder() const { return m_order; }
+
+    /**
+     * @brief Get the binds recording in submission order would need
+     * @return Statistics of the last sort()
+     */
+    const DrawQueueStats& getSubmittedStats() const { return m_submittedStats; }
+
+    /**
+     * @brief Get the binds recording in sorted order needs
+     * @return Statistics of the last sort()
+     */
+    const DrawQueueStats& getSortedStats() const { return m_sortedStats; }
+
+protected:
+    /**
+     * @brief Records the draw of one packet after its state is bound
+     * @param commandBuffer Command buffer in recording state
+     * @param packet Draw to record
+     * @param indexed Whether the packet's mesh has an index buffer
+     */
+    virtual void recordDraw(VkCommandBuffer commandBuffer, const DrawPacket& packet, bool indexed);
+
+    /**
+     * @brief A registered pipeline
+     */
+    struct PipelineEntry {
+        VkPipeline pipeline{VK_NULL_HANDLE}; ///< Pipeline handle
+        VkPipelineLayout layout{VK_NULL_HANDLE}; ///< Layout handle
+        uint32_t layoutIndex{0};             ///< Index into m_layouts, compared on switches
+    };
+
+    /**
+     * @brief A registered material
+     */
+    struct MaterialEntry {
+        VkDescriptorSet descriptorSet{VK_NULL_HANDLE}; ///< Set to bind
+        uint32_t firstSet{0};                          ///< Set number
+    };
+
+    /**
+     * @brief A distinct vertex buffer binding
+     */
+    struct VertexBinding {
+        std::vector<VkBuffer> buffers;     ///< Buffers from binding 0
+        std::vector<VkDeviceSize> offsets; ///< Offset per buffer
+    };
+
+    /**
+     * @brief A distinct index buffer binding
+     */
+    struct IndexBinding {
+        VkBuffer buffer{VK_NULL_HANDLE};         ///< Index buffer
+        VkDeviceSize offset{0};                  ///< Offset in the buffer
+        VkIndexType indexType{VK_INDEX_TYPE_UINT32}; ///< Index type
+    };
+
+    /**
+     * @brief A registered mesh, as indices of its distinct bindings
+     */
+    struct MeshEntry {
+        uint32_t vertexBinding{0}; ///< Index into m_vertexBindings
+        uint32_t indexBinding{0};  ///< Index into m_indexBindings (NoBinding if non-indexed)
+    };
+
+    static constexpr uint32_t NoBinding = 0xFFFFFFFFu; ///< Nothing bound / non-indexed
+
+    /**
+     * @brief Currently bound state while walking an order
+     */
+    struct BoundState {
+        uint32_t pipeline{NoBinding};      ///< Pipeline index
+        uint32_t layout{NoBinding};        ///< Pipeline layout index
+        uint32_t material{NoBinding};      ///< Material index
+        uint32_t vertexBinding{NoBinding}; ///< Vertex binding index
+        uint32_t indexBinding{NoBinding};  ///< Index binding index
+    };
+
+    /**
+     * @brief Records or counts the binds one packet needs and updates the state
+     * @param commandBuffer Command buffer to record into (VK_NULL_HANDLE only counts)
+     */
+    void bindPacket(VkCommandBuffer commandBuffer, const DrawPacket& packet, BoundState& state,
+                    DrawQueueStats& stats);
+
+    /**
+     * @brief Counts the binds of recording m_order, rebinding at every pass change
+     */
+    DrawQueueStats countStateChanges();
+
+    /**
+     * @brief Stable LSD radix sort of m_sortKeys, permuting m_order alongside
+     */
+    void radixSort();
+
+    /**
+     * @brief Throws if a packet references unregistered state
+     */
+    void validatePacket(const DrawPacket& packet) const;
+
+    ThreadPool* m_pool{nullptr};                  ///< Worker pool (optional)
+    uint32_t m_parallelThreshold{65536};          ///< Draw count from which the pool is used
+
+    std::vector<PipelineEntry> m_pipelines;       ///< Registered pipelines
+    std::vector<VkPipelineLayout> m_layouts;      ///< Distinct pipeline layouts
+    std::vector<MaterialEntry> m_materials;       ///< Registered materials
+    std::vector<MeshEntry> m_meshes;              ///< Registered meshes
+    std::vector<VertexBinding> m_vertexBindings;  ///< Distinct vertex bindings
+    std::vector<IndexBinding> m_indexBindings;    ///< Distinct index bindings
+
+    std::vector<DrawPacket> m_packets;            ///< Queued draws in submission order
+    std::vector<uint64_t> m_keys;                 ///< Key of each queued draw
+    std::vector<uint32_t> m_order;                ///< Packet indices in recording order
+    std::vector<uint64_t> m_sortKeys;             ///< Keys in recording order
+    std::vector<uint64_t> m_scratchKeys;          ///< Radix sort ping-pong keys
+    std::vector<uint32_t> m_scratchOrder;         ///< Radix sort ping-pong indices
+    std::vector<std::array<uint32_t, 256>> m_chunkCounts; ///< Per-chunk digit histograms
+
+    DrawQueueStats m_submittedStats;              ///< Binds in submission order
+    DrawQueueStats m_sortedStats;                 ///< Binds in sorted order
+};
+
+} // namespace ev
@@ -0,0 +1,221 @@
+/**
+ * @file GeometryPool.hpp
+ * @brief Shared vertex/index mega-buffers for EasyVulkan framework
+ * @details This file contains the GeometryPool class which packs the geometry of
+ *          many meshes into one device-local vertex buffer and one index buffer,
+ *          so every draw shares a single binding.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace ev {
+
+class VulkanDevice;
+class VulkanContext;
+
+/**
+ * @struct GeometryAllocation
+ * @brief Where a mesh lives inside a GeometryPool
+ * @details firstIndex, vertexOffset and indexCount feed vkCmdDrawIndexed or a
+ *          VkDrawIndexedIndirectCommand directly.
+ */
+struct GeometryAllocation {
+    uint32_t firstIndex{0};   ///< First index of the mesh in the index buffer
+    int32_t vertexOffset{0};  ///< Added to every index (first vertex of the mesh)
+    uint32_t indexCount{0};   ///< Number of indices
+    uint32_t vertexCount{0};  ///< Number of vertices
+    VmaVirtualAllocation vertexRange{VK_NULL_HANDLE}; ///< Sub-allocation in the vertex buffer
+    VmaVirtualAllocation indexRange{VK_NULL_HANDLE};  ///< Sub-allocation in the index buffer
+};
+
+/**
+ * @class GeometryPool
+ * @brief Device-local vertex and index mega-buffers with offset allocation
+ * @details GeometryPool provides:
+ *          - One DEVICE_LOCAL vertex buffer and one index buffer for many meshes
+ *          - Range sub-allocation (VMA virtual blocks) with free and reuse
+ *          - Batched uploads: add() stages the data, flush() copies every pending
+ *            mesh through one staging buffer in one submission
+ *          - Draw parameters ready for vkCmdDrawIndexed and indirect draws
+ *
+ * Vertex fetch reads device-local memory instead of host memory over PCIe, and
+ * one bind() serves every draw, which is what multi-draw-indirect needs.
+ *
+ * Common usage patterns:
+ * @code
+ * GeometryPool geometry(device, context, sizeof(Vertex), 4 * 1024 * 1024, 16 * 1024 * 1024);
+ *
+ * GeometryAllocation rock = geometry.add(rockVertices, rockIndices);
+ * GeometryAllocation tree = geometry.add(treeVertices, treeIndices);
+ * geometry.flush(); // one staging copy for both meshes
+ *
+ * // In the render loop
+ * geometry.bind(cmd);
+ * geometry.draw(cmd, rock);
+ * geometry.draw(cmd, tree, instanceCount);
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override recordUploadBarrier() when the buffers are read by other stages
+ *         (e.g. compute culling reading the index buffer)
+ */
+class GeometryPool {
+public:
+    /**
+     * @brief Constructor for GeometryPool
+     * @param device Pointer to VulkanDevice instance
+     * @param context Pointer to VulkanContext instance
+     * @param vertexStride Size of one vertex in bytes
+     * @param vertexCapacity Number of vertices the vertex buffer holds
+     * @param indexCapacity Number of indices the index buffer holds
+     * @param indexType VK_INDEX_TYPE_UINT32 or VK_INDEX_TYPE_UINT16
+     * @throws std::runtime_error if a pointer is null, a size is 0 or allocation fails
+     */
+    GeometryPool(
+        VulkanDevice* device,
+        VulkanContext* context,
+        uint32_t vertexStride,
+        uint32_t vertexCapacity,
+        uint32_t indexCapacity,
+        VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+
+    /**
+     * @brief Virtual destructor
+     * @details Destroys both buffers; the GPU must no longer read them.
+     */
+    virtual ~GeometryPool();
+
+    GeometryPool(const GeometryPool&) = delete;
+    GeometryPool& operator=(const GeometryPool&) = delete;
+
+    /**
+     * @brief Reserves ranges for a mesh and stages its data
+     * @param vertices vertexCount * vertexStride bytes
+     * @param vertexCount Number of vertices
+     * @param indices indexCount indices of the pool's index type
+     * @param indexCount Number of indices
+     * @return Location of the mesh; valid for drawing after flush()
+     * @throws std::runtime_error if data is missing or either buffer is full
+     */
+    GeometryAllocation add(const void* vertices, uint32_t vertexCount, const void* indices, uint32_t indexCount);
+
+    /**
+     * @brief Reserves ranges for a mesh and stages its data
+     * @param vertices Vertices; sizeof(V) must equal the pool's stride
+     * @param indices Indices; sizeof(I) must match the pool's index type
+     * @return Location of the mesh; valid for drawing after flush()
+     */
+    template <typename V, typename I>
+    GeometryAllocation add(const std::vector<V>& vertices, const std::vector<I>& indices) {
+        if (sizeof(V) != m_vertexStride || sizeof(I) != m_indexSize) {
+            throw std::runtime_error("mesh layout does not match the GeometryPool's vertex stride or index type");
+        }
+        return add(vertices.data(), static_cast<uint32_t>(vertices.size()),
+                   indices.data(), static_cast<uint32_t>(indices.size()));
+    }
+
+    /**
+     * @brief Uploads every mesh staged since the last flush
+     * @details All pending meshes share one staging buffer, one command buffer with
+     *          one multi-region copy per buffer, and one submission.
+     * @throws std::runtime_error if staging or submission fails
+     */
+    void flush();
+
+    /**
+     * @brief Releases a mesh's ranges for reuse
+     * @param allocation Location returned by add()
+     * @details The GPU must no longer draw the mesh. Pending (unflushed) meshes
+     *          must not be removed.
+     */
+    void remove(GeometryAllocation& allocation);
+
+    /**
+     * @brief Binds the vertex buffer (binding 0) and the index buffer
+     * @param commandBuffer Command buffer in recording state
+     */
+    void bind(VkCommandBuffer commandBuffer) const;
+
+    /**
+     * @brief Records an indexed draw of one mesh
+     * @param commandBuffer Command buffer with the pool bound
+     * @param allocation Mesh to draw
+     * @param instanceCount Number of instances
+     * @param firstInstance First instance index
+     */
+    void draw(VkCommandBuffer commandBuffer, const GeometryAllocation& allocation,
+              uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
+
+    /**
+     * @brief Builds the indirect command drawing one mesh
+     * @param allocation Mesh to draw
+     * @param instanceCount Number of instances
+     * @param firstInstance First instance index
+     * @return Command to write into an indirect buffer
+     */
+    static VkDrawIndexedIndirectCommand makeDrawCommand(const GeometryAllocation& allocation,
+                                                        uint32_t instanceCount = 1,
+                                                        uint32_t firstInstance = 0);
+
+    VkBuffer getVertexBuffer() const { return m_vertexBuffer; } ///< Shared vertex buffer
+    VkBuffer getIndexBuffer() const { return m_indexBuffer; }   ///< Shared index buffer
+    VkIndexType getIndexType() const { return m_indexType; }    ///< Index type of the pool
+    uint32_t getVertexStride() const { return m_vertexStride; } ///< Bytes per vertex
+
+    /**
+     * @brief Get the number of vertices currently allocated
+     * @return Vertices in use, including pending meshes
+     */
+    uint32_t getUsedVertexCount() const;
+
+    /**
+     * @brief Get the number of indices currently allocated
+     * @return Indices in use, including pending meshes
+     */
+    uint32_t getUsedIndexCount() const;
+
+protected:
+    /**
+     * @brief Makes the copies of flush() visible to their readers
+     * @param commandBuffer Upload command buffer, after the copies
+     * @details The default barrier covers vertex attribute and index reads.
+     */
+    virtual void recordUploadBarrier(VkCommandBuffer commandBuffer);
+
+    /**
+     * @brief Mesh data waiting for flush()
+     */
+    struct PendingUpload {
+        std::vector<uint8_t> vertices; ///< Copied vertex bytes
+        std::vector<uint8_t> indices;  ///< Copied index bytes
+        VkDeviceSize vertexOffset{0};  ///< Destination offset in the vertex buffer
+        VkDeviceSize indexOffset{0};   ///< Destination offset in the index buffer
+    };
+
+    VulkanDevice* m_device;                         ///< Pointer to VulkanDevice instance
+    VulkanContext* m_context;                       ///< Pointer to VulkanContext instance
+    uint32_t m_vertexStride;                        ///< Bytes per vertex
+    uint32_t m_indexSize;                           ///< Bytes per index
+    VkIndexType m_indexType;                        ///< Index type
+    VkBuffer m_vertexBuffer{VK_NULL_HANDLE};        ///< Shared vertex buffer
+    VmaAllocation m_vertexAllocation{VK_NULL_HANDLE}; ///< Its memory
+    VkBuffer m_indexBuffer{VK_NULL_HANDLE};         ///< Shared index buffer
+    VmaAllocation m_indexAllocation{VK_NULL_HANDLE}; ///< Its memory
+    VmaVirtualBlock m_vertexBlock{VK_NULL_HANDLE};  ///< Range allocator in vertices
+    VmaVirtualBlock m_indexBlock{VK_NULL_HANDLE};   ///< Range allocator in indices
+    std::vector<PendingUpload> m_pending;           ///< Meshes staged since the last flush
+
+private:
+    /**
+     * @brief Destroys the buffers and range allocators created so far
+     * @details Called by the destructor and by the constructor when creation fails
+     */
+    void cleanup();
+};
+
+} // namespace ev
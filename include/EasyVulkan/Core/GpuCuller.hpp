@@ -0,0 +1,218 @@
+/**
+ * @file GpuCuller.hpp
+ * @brief GPU-driven culling and indirect draw generation for EasyVulkan framework
+ * @details This file contains the GpuCuller class which culls objects in a compute
+ *          pass and writes the surviving draws as indirect commands, so a frame's
+ *          draw list is built without per-object CPU work.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "VisibilityCuller.hpp"
+
+#include <vector>
+
+namespace ev {
+
+class VulkanDevice;
+class VulkanContext;
+
+/**
+ * @struct GpuCullObject
+ * @brief Bounds of one object as read by the culling shader (std430)
+ */
+struct GpuCullObject {
+    Vec4f sphere{0.0f, 0.0f, 0.0f, 0.0f};  ///< xyz = center, w = sphere radius
+    Vec4f extents{0.0f, 0.0f, 0.0f, 0.0f}; ///< xyz = box half size, w unused
+};
+static_assert(sizeof(GpuCullObject) == 32, "GpuCullObject must match the std430 layout of ev_cull.glsl");
+
+/**
+ * @class GpuCuller
+ * @brief Compute frustum/Hi-Z culling producing VkDrawIndexedIndirectCommands
+ * @details GpuCuller provides:
+ *          - Device-local object bounds and per-object draw commands, updated
+ *            in-stream with only the ranges that changed
+ *          - A compute pass (shaders/ev_cull.comp) testing every object against
+ *            the frustum, optionally against a Hi-Z pyramid
+ *            (shaders/ev_cull_occlusion.comp)
+ *          - Compacted draw commands plus a count consumed by
+ *            vkCmdDrawIndexedIndirectCount
+ *          - A fallback without drawIndirectCount: every slot is written and
+ *            culled draws get zero instances
+ *
+ * The draw commands are copied unchanged, so per-object data is usually found
+ * through firstInstance (gl_InstanceIndex in the vertex shader).
+ *
+ * Common usage patterns:
+ * @code
+ * auto cullShader = resourceManager->createShaderModule()
+ *     .loadFromFile("shaders/ev_cull.comp.spv")
+ *     .build("cullShader");
+ * GpuCuller culler(device, context, maxObjects, cullShader);
+ *
+ * for (uint32_t i = 0; i < objectCount; ++i) {
+ *     culler.setObject(i, objects[i].bounds,
+ *                      GeometryPool::makeDrawCommand(objects[i].mesh, 1, i)); // firstInstance = object
+ * }
+ * culler.setObjectCount(objectCount);
+ *
+ * // Every frame, outside the render pass
+ * culler.record(cmd, projection * view);
+ *
+ * // Inside the render pass
+ * geometry.bind(cmd);
+ * culler.draw(cmd);
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override recordOutputBarrier() when the commands are read by another
+ *         stage than DRAW_INDIRECT (e.g. a second compute pass)
+ */
+class GpuCuller {
+public:
+    /**
+     * @brief Constructor for GpuCuller
+     * @param device Pointer to VulkanDevice instance
+     * @param context Pointer to VulkanContext instance
+     * @param capacity Maximum number of objects
+     * @param cullShader Compute module built from ev_cull.comp
+     * @param occlusionShader Compute module built from ev_cull_occlusion.comp (optional)
+     * @throws std::runtime_error if a pointer or the cull shader is null, capacity
+     *         is 0 or resource creation fails
+     *
+     * @note The shader modules are not owned; they may be destroyed after construction.
+     */
+    GpuCuller(
+        VulkanDevice* device,
+        VulkanContext* context,
+        uint32_t capacity,
+        VkShaderModule cullShader,
+        VkShaderModule occlusionShader = VK_NULL_HANDLE);
+
+    /**
+     * @brief Virtual destructor
+     * @details Destroys the buffers and pipelines; the GPU must no longer use them.
+     */
+    virtual ~GpuCuller();
+
+    GpuCuller(const GpuCuller&) = delete;
+    GpuCuller& operator=(const GpuCuller&) = delete;
+
+    /**
+     * @brief Sets the bounds and draw command of an object
+     * @param index Object index (< capacity)
+     * @param bounds World-space bounds
+     * @param draw Command emitted when the object is visible (instanceCount 0 skips it)
+     * @throws std::runtime_error if index is out of range
+     * @details The change is uploaded by the next record().
+     */
+    void setObject(uint32_t index, const BoundingVolume& bounds, const VkDrawIndexedIndirectCommand& draw);
+
+    /**
+     * @brief Sets how many objects, starting at index 0, are culled
+     * @param count Object count (<= capacity)
+     * @throws std::runtime_error if count exceeds the capacity
+     */
+    void setObjectCount(uint32_t count);
+
+    /**
+     * @brief Enables Hi-Z occlusion culling against a depth pyramid
+     * @param view Full mip chain view of the pyramid (VK_NULL_HANDLE disables occlusion)
+     * @param layout Layout of the pyramid when the cull pass runs
+     * @param width Width of pyramid level 0
+     * @param height Height of pyramid level 0
+     * @throws std::runtime_error if no occlusion shader was given
+     *
+     * @note Each level must hold the farthest depth (max for a [0, 1] depth range)
+     *       of the 2x2 texels below it; usually it is built from the previous
+     *       frame's depth. Call between frames: the descriptor is updated in place.
+     */
+    void setOcclusionPyramid(VkImageView view, VkImageLayout layout, uint32_t width, uint32_t height);
+
+    /**
+     * @brief Records the upload of changed objects, the cull dispatch and the output barrier
+     * @param commandBuffer Command buffer in recording state, outside a render pass
+     * @param viewProjection World to clip space of the camera
+     */
+    void record(VkCommandBuffer commandBuffer, const Mat4f& viewProjection);
+
+    /**
+     * @brief Draws the commands produced by the last record()
+     * @param commandBuffer Command buffer inside a render pass, with the graphics
+     *        pipeline and geometry bound
+     */
+    void draw(VkCommandBuffer commandBuffer) const;
+
+    /**
+     * @brief Check whether the output is compacted with a draw count
+     * @return true if drawIndirectCount is enabled on the device
+     */
+    bool isCompacting() const { return m_compact; }
+
+    VkBuffer getCommandBuffer() const { return m_commandBuffer; } ///< Output VkDrawIndexedIndirectCommands
+    VkBuffer getCountBuffer() const { return m_countBuffer; }     ///< Output draw count (uint32_t at offset 0)
+    uint32_t getCapacity() const { return m_capacity; }           ///< Maximum number of objects
+    uint32_t getObjectCount() const { return m_objectCount; }     ///< Objects culled per record()
+
+protected:
+    /**
+     * @brief Makes the cull output visible to its reader
+     * @param commandBuffer Command buffer, after the dispatch
+     * @details The default barrier covers indirect command reads.
+     */
+    virtual void recordOutputBarrier(VkCommandBuffer commandBuffer);
+
+    /**
+     * @brief Push constants of ev_cull.glsl
+     */
+    struct PushConstants {
+        float viewProjection[16]; ///< Column-major world to clip
+        float hiZSize[2];         ///< Pyramid level 0 extent
+        uint32_t objectCount;     ///< Objects to test
+        uint32_t compact;         ///< 1 = append + count, 0 = zero culled instances
+    };
+
+    /**
+     * @brief Records vkCmdUpdateBuffer calls for the dirty object range
+     */
+    void recordUploads(VkCommandBuffer commandBuffer);
+
+    /**
+     * @brief Destroys every Vulkan object created so far; null handles are skipped
+     */
+    void destroyResources();
+
+    VulkanDevice* m_device;                          ///< Pointer to VulkanDevice instance
+    VulkanContext* m_context;                        ///< Pointer to VulkanContext instance
+    uint32_t m_capacity;                             ///< Maximum number of objects
+    uint32_t m_objectCount{0};                       ///< Objects culled per record()
+    bool m_compact{false};                           ///< drawIndirectCount available
+
+    VkBuffer m_objectBuffer{VK_NULL_HANDLE};         ///< GpuCullObject per object
+    VmaAllocation m_objectAllocation{VK_NULL_HANDLE}; ///< Its memory
+    VkBuffer m_drawBuffer{VK_NULL_HANDLE};           ///< Input draw command per object
+    VmaAllocation m_drawAllocation{VK_NULL_HANDLE};  ///< Its memory
+    VkBuffer m_commandBuffer{VK_NULL_HANDLE};        ///< Output draw commands
+    VmaAllocation m_commandAllocation{VK_NULL_HANDLE}; ///< Its memory
+    VkBuffer m_countBuffer{VK_NULL_HANDLE};          ///< Output draw count
+    VmaAllocation m_countAllocation{VK_NULL_HANDLE}; ///< Its memory
+
+    std::vector<GpuCullObject> m_objects;            ///< CPU copy of the bounds
+    std::vector<VkDrawIndexedIndirectCommand> m_draws; ///< CPU copy of the input commands
+    uint32_t m_dirtyBegin{0};                        ///< First object changed since the last upload
+    uint32_t m_dirtyEnd{0};                          ///< One past the last changed object
+
+    VkDescriptorSetLayout m_setLayout{VK_NULL_HANDLE}; ///< Buffers + Hi-Z sampler
+    VkDescriptorPool m_descriptorPool{VK_NULL_HANDLE}; ///< Pool of m_descriptorSet
+    VkDescriptorSet m_descriptorSet{VK_NULL_HANDLE};   ///< The culler's single set
+    VkPipelineLayout m_pipelineLayout{VK_NULL_HANDLE}; ///< Shared by both pipelines
+    VkPipeline m_cullPipeline{VK_NULL_HANDLE};         ///< Frustum only
+    VkPipeline m_occlusionPipeline{VK_NULL_HANDLE};    ///< Frustum + Hi-Z (optional)
+    VkSampler m_hiZSampler{VK_NULL_HANDLE};            ///< Nearest, clamped, all levels
+    bool m_occlusionEnabled{false};                    ///< A pyramid is bound
+    float m_hiZSize[2]{0.0f, 0.0f};                    ///< Pyramid level 0 extent
+};
+
+} // namespace ev
@@ -0,0 +1,215 @@
+/**
+ * @file ImageDecodeQueue.hpp
+ * @brief Parallel image decoding feeding batched uploads in EasyVulkan framework
+ * @details This file contains the ImageDecodeQueue class which reads and decodes
+ *          image files on a ThreadPool straight into mapped staging buffers and
+ *          uploads finished images in batches with a single submission each.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "ImageDecoder.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+
+namespace ev {
+
+class VulkanDevice;
+class VulkanContext;
+class ThreadPool;
+
+/**
+ * @struct ImageDecodeRequest
+ * @brief One image file to decode and upload
+ */
+struct ImageDecodeRequest {
+    std::string path;       ///< File to read
+    std::string name;       ///< Name for resource tracking (optional)
+    bool srgb{true};        ///< Create 8-bit images with an _SRGB format
+    bool generateMips{true};///< Blit a full mip chain after the upload when the format allows
+    VkImageLayout finalLayout{VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}; ///< Layout after upload
+};
+
+/**
+ * @class ImageDecodeQueue
+ * @brief Decodes image files on worker threads and uploads them in batches
+ * @details ImageDecodeQueue provides:
+ *          - File reading and decoding on a ThreadPool, one job per file
+ *          - Decoding directly into persistently mapped staging buffers
+ *          - Built-in PNG and Radiance HDR decoders, extensible with addDecoder()
+ *            (e.g. a JPEG decoder wrapping libjpeg-turbo)
+ *          - Batched uploads: every finished job is copied (and mipmapped) in one
+ *            command buffer per uploadCompleted() call
+ *          - A staging byte limit that defers decoding when uploads fall behind;
+ *            deferred jobs wait in a queue, never on a pool worker
+ *
+ * Common usage patterns:
+ * @code
+ * ThreadPool pool;
+ * ImageDecodeQueue decodeQueue(device, context, &pool);
+ *
+ * // Cold load: decode everything in parallel, upload as jobs finish
+ * std::vector<ImageInfo> textures = decodeQueue.loadAll({
+ *     {"textures/albedo.png", "albedo"},
+ *     {"textures/normal.png", "normal", false},
+ *     {"textures/sky.hdr", "sky", false, false}});
+ *
+ * // Streaming: enqueue, then pick up finished images once per frame
+ * auto future = decodeQueue.enqueue({"textures/decal.png", "decal"});
+ * decodeQueue.uploadCompleted();
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override readFile() to load from archives or custom file systems
+ * @note uploadCompleted(), finish() and loadAll() submit work and must be called from
+ *       the thread that owns the single-time command pool.
+ */
+class ImageDecodeQueue {
+public:
+    /**
+     * @brief Constructor for ImageDecodeQueue
+     * @param device Pointer to VulkanDevice instance
+     * @param context Pointer to VulkanContext instance
+     * @param pool Thread pool running the decode jobs
+     * @param maxStagingBytes Staging memory decoded images may hold before decoding is deferred
+     * @throws std::runtime_error if a pointer is null
+     */
+    ImageDecodeQueue(
+        VulkanDevice* device,
+        VulkanContext* context,
+        ThreadPool* pool,
+        VkDeviceSize maxStagingBytes = 256 * 1024 * 1024);
+
+    /**
+     * @brief Virtual destructor
+     * @details Waits for running jobs and releases staging buffers of jobs that were
+     *          never uploaded; their futures receive an exception.
+     */
+    virtual ~ImageDecodeQueue();
+
+    ImageDecodeQueue(const ImageDecodeQueue&) = delete;
+    ImageDecodeQueue& operator=(const ImageDecodeQueue&) = delete;
+
+    /**
+     * @brief Registers a decoder, tried before the built-in ones
+     * @param decoder Thread-safe decoder
+     */
+    void addDecoder(std::shared_ptr<ImageDecoder> decoder);
+
+    /**
+     * @brief Starts decoding a file
+     * @param request File and image parameters
+     * @return Future receiving the image once uploadCompleted() has uploaded it
+     */
+    std::future<ImageInfo> enqueue(const ImageDecodeRequest& request);
+
+    /**
+     * @brief Uploads every decoded job in one submission
+     * @param maxJobs Upper bound on the jobs uploaded by this call
+     * @return Number of jobs uploaded (failed jobs included)
+     */
+    uint32_t uploadCompleted(uint32_t maxJobs = UINT32_MAX);
+
+    /**
+     * @brief Uploads batches until every enqueued job is done
+     */
+    void finish();
+
+    /**
+     * @brief Decodes and uploads a set of files
+     * @param requests Files to load
+     * @return Images in request order
+     * @throws std::runtime_error for the first file that failed to load
+     */
+    std::vector<ImageInfo> loadAll(const std::vector<ImageDecodeRequest>& requests);
+
+    /**
+     * @brief Get the number of jobs not yet uploaded
+     * @return Jobs decoding or waiting for upload
+     */
+    uint32_t getPendingCount() const;
+
+protected:
+    /**
+     * @brief Reads a whole file
+     * @param path File path
+     * @return File contents
+     * @throws std::runtime_error if the file cannot be read
+     */
+    virtual std::vector<uint8_t> readFile(const std::string& path) const;
+
+    /**
+     * @brief Finds the decoder for a file
+     * @param data File contents
+     * @param size File size
+     * @return Decoder, or nullptr if none accepts the signature
+     */
+    const ImageDecoder* findDecoder(const uint8_t* data, size_t size) const;
+
+    VulkanDevice* m_device;                               ///< Pointer to VulkanDevice instance
+    VulkanContext* m_context;                             ///< Pointer to VulkanContext instance
+    ThreadPool* m_pool;                                   ///< Pool running the decode jobs
+    std::vector<std::shared_ptr<ImageDecoder>> m_decoders;///< Registered decoders, in lookup order
+
+private:
+    /**
+     * @brief State of one file from enqueue() to upload
+     */
+    struct Job {
+        ImageDecodeRequest request;                  ///< Request parameters
+        std::vector<uint8_t> file;                   ///< File contents until decoded
+        const ImageDecoder* decoder{nullptr};        ///< Decoder, set once the header is read
+        DecodedImageHeader header;                   ///< Decoded dimensions and format
+        VkBuffer staging{VK_NULL_HANDLE};            ///< Staging buffer holding the pixels
+        VmaAllocation stagingAllocation{VK_NULL_HANDLE}; ///< Its allocation
+        VkDeviceSize stagingSize{0};                 ///< Bytes counted against the staging limit
+        std::exception_ptr error;                    ///< Decode failure, reported at upload
+        std::promise<ImageInfo> promise;             ///< Delivers the image
+    };
+
+    /**
+     * @brief Worker body: reads, decodes into staging and hands the job over
+     * @param job Job to run
+     */
+    void runJob(const std::shared_ptr<Job>& job);
+
+    /**
+     * @brief Releases a job's staging buffer and its share of the byte limit
+     * @param job Job whose staging buffer is destroyed
+     */
+    void releaseStaging(Job& job);
+
+    /**
+     * @brief Check whether a job of a size may take staging memory now (m_mutex held)
+     */
+    bool fitsStaging(VkDeviceSize size) const;
+
+    /**
+     * @brief Reserves staging for deferred jobs that fit and resubmits them to the pool
+     */
+    void resubmitDeferred();
+
+    /**
+     * @brief Destroys an image built for a job that failed afterwards
+     * @param image Image returned by ImageBuilder::build() (ignored if null)
+     * @param name Name it was registered under, empty if unnamed
+     */
+    void destroyImage(const ImageInfo& image, const std::string& name);
+
+    mutable std::mutex m_mutex;                        ///< Guards the members below
+    std::condition_variable m_condition;               ///< Signals finished jobs and freed staging
+    std::vector<std::shared_ptr<Job>> m_completed;     ///< Decoded jobs awaiting upload
+    std::deque<std::shared_ptr<Job>> m_deferred;       ///< Jobs waiting for staging memory, FIFO
+    uint32_t m_pendingJobs{0};                         ///< Jobs enqueued but not uploaded
+    uint32_t m_runningJobs{0};                         ///< Jobs queued or running on the pool
+    bool m_stopping{false};                            ///< Set by the destructor
+    VkDeviceSize m_stagingBytes{0};                    ///< Staging memory held by decoded jobs
+    VkDeviceSize m_maxStagingBytes;                    ///< Limit for m_stagingBytes
+};
+
+} // namespace ev
@@ -0,0 +1,104 @@
+/**
+ * @file ImageDecoder.hpp
+ * @brief Image file decoders for EasyVulkan framework
+ * @details This file contains the ImageDecoder interface and the built-in PNG and
+ *          Radiance HDR decoders. Decoding is split into a header pass and a pixel
+ *          pass so the caller can size the destination (typically mapped staging
+ *          memory) before any pixel is produced.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <cstddef>
+
+namespace ev {
+
+/**
+ * @struct DecodedImageHeader
+ * @brief Dimensions and pixel format an ImageDecoder produces for a file
+ */
+struct DecodedImageHeader {
+    uint32_t width{0};                    ///< Width in pixels
+    uint32_t height{0};                   ///< Height in pixels
+    VkFormat format{VK_FORMAT_UNDEFINED}; ///< Format of the decoded pixels (UNORM for 8-bit data)
+    uint32_t bytesPerPixel{0};            ///< Size of one decoded pixel
+
+    /**
+     * @brief Get the size of the decoded pixels
+     * @return width * height * bytesPerPixel
+     */
+    VkDeviceSize getSize() const { return static_cast<VkDeviceSize>(width) * height * bytesPerPixel; }
+};
+
+/**
+ * @class ImageDecoder
+ * @brief Interface of a file-format decoder
+ * @details decode() writes tightly packed rows front to back and never reads the
+ *          destination back, so it may point at write-combined staging memory.
+ *
+ * @note Implementations are called from several worker threads at once and must
+ *       be thread-safe.
+ */
+class ImageDecoder {
+public:
+    virtual ~ImageDecoder() = default;
+
+    /**
+     * @brief Check the file signature
+     * @param data File contents
+     * @param size File size in bytes
+     * @return true if this decoder handles the file
+     */
+    virtual bool canDecode(const uint8_t* data, size_t size) const = 0;
+
+    /**
+     * @brief Reads the dimensions and output format
+     * @param data File contents
+     * @param size File size in bytes
+     * @return Header describing decode()'s output
+     * @throws std::runtime_error if the header is invalid or unsupported
+     */
+    virtual DecodedImageHeader readHeader(const uint8_t* data, size_t size) const = 0;
+
+    /**
+     * @brief Decodes all pixels
+     * @param data File contents
+     * @param size File size in bytes
+     * @param header Header returned by readHeader()
+     * @param dst Destination of header.getSize() bytes
+     * @throws std::runtime_error on corrupt data
+     */
+    virtual void decode(const uint8_t* data, size_t size, const DecodedImageHeader& header, uint8_t* dst) const = 0;
+};
+
+/**
+ * @class PNGDecoder
+ * @brief Built-in PNG decoder producing R8G8B8A8 pixels
+ * @details Supports every colour type and bit depth of non-interlaced PNGs,
+ *          including palettes and tRNS transparency. 16-bit channels are reduced
+ *          to 8 bits.
+ */
+class PNGDecoder : public ImageDecoder {
+public:
+    bool canDecode(const uint8_t* data, size_t size) const override;
+    DecodedImageHeader readHeader(const uint8_t* data, size_t size) const override;
+    void decode(const uint8_t* data, size_t size, const DecodedImageHeader& header, uint8_t* dst) const override;
+};
+
+/**
+ * @class HDRDecoder
+ * @brief Built-in Radiance RGBE (.hdr) decoder producing R16G16B16A16_SFLOAT pixels
+ * @details Supports flat and run-length encoded scanlines in the standard
+ *          "-Y height +X width" orientation. Values above the half-float range
+ *          are clamped to 65504.
+ */
+class HDRDecoder : public ImageDecoder {
+public:
+    bool canDecode(const uint8_t* data, size_t size) const override;
+    DecodedImageHeader readHeader(const uint8_t* data, size_t size) const override;
+    void decode(const uint8_t* data, size_t size, const DecodedImageHeader& header, uint8_t* dst) const override;
+};
+
+} // namespace ev
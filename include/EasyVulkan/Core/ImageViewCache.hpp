@@ -0,0 +1,158 @@
+/**
+ * @file ImageViewCache.hpp
+ * @brief Shared image view cache for EasyVulkan framework
+ * @details This file contains the ImageViewCache class which hands out one shared
+ *          VkImageView per (image, view type, format, aspect, subresource range,
+ *          swizzle) and destroys all of an image's views together with it.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+namespace ev {
+
+class VulkanDevice;
+
+/**
+ * @struct ImageViewKey
+ * @brief Everything that distinguishes one view of an image from another
+ * @details The defaults describe a 2D view of every level and layer of a color
+ *          image. VK_REMAINING_MIP_LEVELS / VK_REMAINING_ARRAY_LAYERS are allowed.
+ */
+struct ImageViewKey {
+    VkImageViewType viewType{VK_IMAGE_VIEW_TYPE_2D};             ///< View type
+    VkFormat format{VK_FORMAT_UNDEFINED};                        ///< View format (UNDEFINED: the image's own)
+    VkImageAspectFlags aspectMask{VK_IMAGE_ASPECT_COLOR_BIT};    ///< Aspects seen through the view
+    uint32_t baseMipLevel{0};                                    ///< First mip level
+    uint32_t levelCount{VK_REMAINING_MIP_LEVELS};                ///< Number of mip levels
+    uint32_t baseArrayLayer{0};                                  ///< First array layer
+    uint32_t layerCount{VK_REMAINING_ARRAY_LAYERS};              ///< Number of array layers
+    VkComponentMapping components{VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                  VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY}; ///< Swizzle
+
+    /**
+     * @brief Key of a single-level view, e.g. the source of one downsampling pass
+     * @param mipLevel Mip level
+     * @param viewType View type
+     * @return Key covering one level and every layer
+     */
+    static ImageViewKey mip(uint32_t mipLevel, VkImageViewType viewType = VK_IMAGE_VIEW_TYPE_2D);
+
+    /**
+     * @brief Key of a single-layer view, e.g. one shadow cascade
+     * @param arrayLayer Array layer
+     * @param viewType View type
+     * @return Key covering one layer and every level
+     */
+    static ImageViewKey layer(uint32_t arrayLayer, VkImageViewType viewType = VK_IMAGE_VIEW_TYPE_2D);
+
+    bool operator==(const ImageViewKey& other) const;
+};
+
+/**
+ * @struct ImageViewKeyHash
+ * @brief Hash functor for ImageViewKey
+ */
+struct ImageViewKeyHash {
+    size_t operator()(const ImageViewKey& key) const;
+};
+
+/**
+ * @class ImageViewCache
+ * @brief Per-image cache of shared image views
+ * @details ImageViewCache provides:
+ *          - One VkImageView per distinct ImageViewKey of an image, created on first use
+ *          - Destruction of every view of an image in one call, before the image goes
+ *          - Thread-safe lookups
+ *
+ * Per-mip views for downsampling chains, per-layer views for shadow cascades and
+ * format-reinterpreting views are requested wherever they are needed instead of
+ * being created and destroyed ad hoc. ResourceManager owns one cache; views of
+ * named images are released in clearResource().
+ *
+ * Common usage patterns:
+ * @code
+ * auto* resourceManager = context->getResourceManager();
+ *
+ * // One view per level of a bloom chain
+ * for (uint32_t level = 0; level < mipLevels; ++level) {
+ *     VkImageView levelView = resourceManager->getImageView("rtBloom", ImageViewKey::mip(level));
+ *     // ... bind levelView as the storage image of pass 'level'
+ * }
+ *
+ * // Render into cascade 2 of a shadow map array
+ * VkImageView cascade = resourceManager->getImageView("shadowCascades",
+ *     ImageViewKey::layer(2));
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override createView() to add view usage or sampler YCbCr conversion info
+ */
+class ImageViewCache {
+public:
+    /**
+     * @brief Constructor for ImageViewCache
+     * @param device Pointer to VulkanDevice instance
+     */
+    explicit ImageViewCache(VulkanDevice* device);
+
+    /**
+     * @brief Virtual destructor
+     * @details Destroys every cached view; their images must still exist.
+     */
+    virtual ~ImageViewCache();
+
+    ImageViewCache(const ImageViewCache&) = delete;
+    ImageViewCache& operator=(const ImageViewCache&) = delete;
+
+    /**
+     * @brief Returns the shared view of an image for a key, creating it on first use
+     * @param image Image the view is created for
+     * @param imageFormat Format substituted when key.format is VK_FORMAT_UNDEFINED
+     * @param key View description
+     * @return Cached view; owned by the cache, do not destroy it
+     * @throws std::runtime_error if view creation fails
+     */
+    VkImageView getView(VkImage image, VkFormat imageFormat, const ImageViewKey& key);
+
+    /**
+     * @brief Destroys every cached view of an image
+     * @param image Image that is about to be destroyed
+     * @return Number of views destroyed
+     */
+    size_t releaseImage(VkImage image);
+
+    /**
+     * @brief Destroys every cached view of every image
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of cached views across all images
+     * @return View count
+     */
+    size_t getViewCount() const;
+
+protected:
+    /**
+     * @brief Creates the view for a cache miss
+     * @param image Image the view is created for
+     * @param key View description with the format resolved
+     * @return New view
+     * @throws std::runtime_error if vkCreateImageView fails
+     */
+    virtual VkImageView createView(VkImage image, const ImageViewKey& key);
+
+    using ViewMap = std::unordered_map<ImageViewKey, VkImageView, ImageViewKeyHash>;
+
+    VulkanDevice* m_device;                         ///< Pointer to VulkanDevice instance
+    mutable std::mutex m_mutex;                     ///< Guards m_views
+    std::unordered_map<VkImage, ViewMap> m_views;   ///< Views of each image by key
+};
+
+} // namespace ev
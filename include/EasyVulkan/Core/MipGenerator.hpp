@@ -0,0 +1,211 @@
+/**
+ * @file MipGenerator.hpp
+ * @brief GPU mipmap generation for EasyVulkan framework
+ * @details This file contains the MipGenerator class which records the commands
+ *          that fill mip levels 1..N-1 of an image from level 0, either with a
+ *          blit chain or with a compute downsampler.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <vector>
+
+namespace ev {
+
+class VulkanDevice;
+
+/**
+ * @enum MipGenerationMode
+ * @brief Strategy used to fill the mip chain of an uploaded image
+ */
+enum class MipGenerationMode {
+    None,    ///< Leave levels 1..N-1 untouched
+    Auto,    ///< Compute when the format allows it, otherwise blit
+    Blit,    ///< vkCmdBlitImage chain with linear filtering
+    Compute  ///< Box-filter compute downsampler (linear-space for sRGB, full float for HDR)
+};
+
+/**
+ * @class MipGenerator
+ * @brief Records GPU mip chain generation into an existing command buffer
+ * @details MipGenerator provides:
+ *          - A blit chain for formats supporting linear-filtered blits
+ *          - A compute downsampler writing up to five levels per dispatch, used for
+ *            storage-capable formats; sRGB images are filtered in linear space through
+ *            an UNORM storage alias, float formats keep full precision
+ *          - Per-level barriers so each level is read only after it was written
+ *          - Transition of every level to the requested final layout
+ *
+ * The compute path needs the SPIR-V of shaders/ev_downsample.comp, which the build
+ * compiles to ev_downsample.comp.spv when glslangValidator is available. Without it
+ * only the blit path is offered.
+ *
+ * Common usage patterns:
+ * @code
+ * auto downsampleShader = resourceManager->createShaderModule()
+ *     .loadFromFile("shaders/ev_downsample.comp.spv")
+ *     .build("downsampleShader");
+ * MipGenerator mipGenerator(device, downsampleShader);
+ *
+ * auto texture = resourceManager->createImage()
+ *     .setFormat(VK_FORMAT_R8G8B8A8_SRGB)
+ *     .setExtent(width, height)
+ *     .setFullMipChain()
+ *     .setUsage(VK_IMAGE_USAGE_SAMPLED_BIT)
+ *     .setMipGeneration(MipGenerationMode::Auto, &mipGenerator)
+ *     .buildAndInitialize(pixels, width * height * 4, "albedo", nullptr,
+ *                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override recordBlitChain()/recordComputeChain() to plug in other filters
+ */
+class MipGenerator {
+public:
+    /**
+     * @brief Description of the image whose mip chain is generated
+     */
+    struct Target {
+        VkImage image{VK_NULL_HANDLE};          ///< Image with level 0 written
+        VkFormat format{VK_FORMAT_UNDEFINED};   ///< Image format
+        VkImageType imageType{VK_IMAGE_TYPE_2D}; ///< Image type
+        VkExtent3D extent{1, 1, 1};             ///< Extent of level 0
+        uint32_t mipLevels{1};                  ///< Number of levels in the image
+        uint32_t layerCount{1};                 ///< Number of array layers
+    };
+
+    /**
+     * @brief Constructor for MipGenerator
+     * @param device Pointer to VulkanDevice instance
+     * @param downsampleShader Compute module built from ev_downsample.comp (optional)
+     * @throws std::runtime_error if device is null or pipeline creation fails
+     *
+     * @note The shader module is not owned; it may be destroyed after construction.
+     */
+    explicit MipGenerator(VulkanDevice* device, VkShaderModule downsampleShader = VK_NULL_HANDLE);
+
+    /**
+     * @brief Virtual destructor, destroys the pipeline objects and transient resources
+     */
+    virtual ~MipGenerator();
+
+    MipGenerator(const MipGenerator&) = delete;
+    MipGenerator& operator=(const MipGenerator&) = delete;
+
+    /**
+     * @brief Number of levels of a full mip chain
+     * @param width Width of level 0
+     * @param height Height of level 0
+     * @param depth Depth of level 0
+     * @return floor(log2(max(width, height, depth))) + 1
+     */
+    static uint32_t calculateMipLevels(uint32_t width, uint32_t height, uint32_t depth = 1);
+
+    /**
+     * @brief Format used for storage views of an image of the given format
+     * @param format Image format
+     * @return The UNORM alias for sRGB formats, the format itself otherwise
+     */
+    static VkFormat getStorageFormat(VkFormat format);
+
+    /**
+     * @brief Check whether the blit chain can be used for a format
+     * @param format Image format
+     * @return true if the format supports linear-filtered blits in optimal tiling
+     */
+    bool supportsBlit(VkFormat format) const;
+
+    /**
+     * @brief Check whether the compute downsampler can be used for an image
+     * @param format Image format
+     * @param imageType Image type (only 2D images are handled by the shader)
+     * @return true if a downsample pipeline exists and the format is storage-capable
+     */
+    bool supportsCompute(VkFormat format, VkImageType imageType = VK_IMAGE_TYPE_2D) const;
+
+    /**
+     * @brief Resolves a requested mode to the one that will actually be recorded
+     * @param requested Requested mode
+     * @param format Image format
+     * @param imageType Image type
+     * @return Blit, Compute or None
+     * @throws std::runtime_error if Blit is requested for an unsupported format
+     */
+    MipGenerationMode resolveMode(MipGenerationMode requested, VkFormat format,
+                                  VkImageType imageType = VK_IMAGE_TYPE_2D) const;
+
+    /**
+     * @brief Usage flags an image needs for a generation mode
+     * @param mode Resolved mode
+     * @return TRANSFER_SRC for blits, STORAGE | SAMPLED for compute
+     */
+    static VkImageUsageFlags getRequiredUsage(MipGenerationMode mode);
+
+    /**
+     * @brief Create flags an image needs for a generation mode
+     * @param mode Resolved mode
+     * @param format Image format
+     * @return MUTABLE_FORMAT | EXTENDED_USAGE when compute writes an sRGB image, 0 otherwise
+     */
+    static VkImageCreateFlags getRequiredCreateFlags(MipGenerationMode mode, VkFormat format);
+
+    /**
+     * @brief Records the generation of levels 1..N-1
+     * @param commandBuffer Command buffer in recording state
+     * @param target Image description
+     * @param mode Resolved mode (Blit or Compute)
+     * @param finalLayout Layout all levels are left in
+     * @details Expects every level to be in TRANSFER_DST_OPTIMAL with level 0 written
+     *          by a transfer. Compute resources stay alive until releaseTransientResources().
+     */
+    void record(VkCommandBuffer commandBuffer, const Target& target,
+                MipGenerationMode mode, VkImageLayout finalLayout);
+
+    /**
+     * @brief Destroys the views and descriptor pools used by recorded compute chains
+     * @details Call once the command buffers passed to record() have completed.
+     */
+    void releaseTransientResources();
+
+protected:
+    /**
+     * @brief Records the blit chain with one barrier pair per level
+     * @param commandBuffer Command buffer in recording state
+     * @param target Image description
+     * @param finalLayout Layout all levels are left in
+     */
+    virtual void recordBlitChain(VkCommandBuffer commandBuffer, const Target& target, VkImageLayout finalLayout);
+
+    /**
+     * @brief Records the compute downsampler, up to five levels per dispatch
+     * @param commandBuffer Command buffer in recording state
+     * @param target Image description
+     * @param finalLayout Layout all levels are left in
+     */
+    virtual void recordComputeChain(VkCommandBuffer commandBuffer, const Target& target, VkImageLayout finalLayout);
+
+    /**
+     * @brief Creates a single-level 2D array view for the compute path
+     * @param target Image description
+     * @param format View format
+     * @param level Mip level
+     * @param usage Usage the view is restricted to
+     * @return Created view, tracked as a transient resource
+     */
+    VkImageView createLevelView(const Target& target, VkFormat format, uint32_t level, VkImageUsageFlags usage);
+
+    static constexpr uint32_t kLevelsPerDispatch = 5; ///< Levels written by one dispatch
+
+    VulkanDevice* m_device;                                ///< Pointer to VulkanDevice instance
+    VkDescriptorSetLayout m_setLayout{VK_NULL_HANDLE};     ///< Downsampler set layout
+    VkPipelineLayout m_pipelineLayout{VK_NULL_HANDLE};     ///< Downsampler pipeline layout
+    VkPipeline m_pipeline{VK_NULL_HANDLE};                 ///< Downsampler pipeline
+    VkSampler m_sampler{VK_NULL_HANDLE};                   ///< Nearest sampler for the source level
+
+    std::vector<VkImageView> m_transientViews;             ///< Views used by recorded dispatches
+    std::vector<VkDescriptorPool> m_transientPools;        ///< Pools used by recorded dispatches
+};
+
+} // namespace ev
@@ -0,0 +1,243 @@
+/**
+ * @file ReadbackQueue.hpp
+ * @brief Asynchronous GPU-to-CPU readback channel for EasyVulkan framework
+ * @details This file contains the ReadbackQueue class which records copies into
+ *          N-buffered host-cached buffers and hands the data back to the CPU once
+ *          the frame that produced it has finished on the GPU.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <functional>
+#include <future>
+#include <vector>
+
+namespace ev {
+
+class VulkanDevice;
+
+/**
+ * @class ReadbackQueue
+ * @brief N-buffered ring of host-cached buffers for non-blocking readback
+ * @details ReadbackQueue provides:
+ *          - One persistently mapped HOST_CACHED staging buffer per frame in flight
+ *          - Recording of buffer/image copies into the current frame's buffer
+ *          - Delivery through std::future or callback when the frame's fence signals
+ *          - Automatic invalidation of non-coherent memory before delivery
+ *
+ * Results arrive N frames after they were recorded (N = frames in flight). Since
+ * the frame loop already waits on the in-flight fence of a slot before reusing it,
+ * steady-state readback adds no CPU stall.
+ *
+ * Common usage patterns:
+ * @code
+ * ReadbackQueue readback(device, MAX_FRAMES_IN_FLIGHT, 4 * 1024 * 1024);
+ *
+ * // In render loop:
+ * syncManager->waitForFences({inFlightFence});
+ * readback.beginFrame(currentFrame);          // delivers results of this slot
+ * syncManager->resetFences({inFlightFence});
+ *
+ * // While recording the frame:
+ * auto histogram = readback.readBuffer(cmd, histogramBuffer, 0, 256 * sizeof(uint32_t));
+ * readback.readBuffer(cmd, statsBuffer, 0, sizeof(Stats),
+ *     [](const void* data, VkDeviceSize size) { memcpy(&g_stats, data, size); });
+ *
+ * // Optionally, pick up results of other slots that already finished
+ * readback.poll();
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override onSlotComplete() to customise how finished slots are delivered
+ */
+class ReadbackQueue {
+public:
+    /**
+     * @brief Callback receiving read-back data
+     * @details The pointer refers to mapped memory and is only valid during the call.
+     */
+    using Callback = std::function<void(const void* data, VkDeviceSize size)>;
+
+    /**
+     * @brief Constructor for ReadbackQueue
+     * @param device Pointer to VulkanDevice instance
+     * @param framesInFlight Number of ring slots (usually MAX_FRAMES_IN_FLIGHT)
+     * @param bytesPerFrame Capacity of each slot in bytes
+     * @throws std::runtime_error if device is null, a count is 0 or allocation fails
+     */
+    ReadbackQueue(VulkanDevice* device, uint32_t framesInFlight, VkDeviceSize bytesPerFrame);
+
+    /**
+     * @brief Virtual destructor
+     * @details Destroys the ring buffers. Undelivered futures become broken promises;
+     *          call resolveAll() after the device is idle to deliver them instead.
+     */
+    virtual ~ReadbackQueue();
+
+    ReadbackQueue(const ReadbackQueue&) = delete;
+    ReadbackQueue& operator=(const ReadbackQueue&) = delete;
+
+    /**
+     * @brief Starts a new frame on the given slot
+     * @param frameIndex Frame-in-flight index (taken modulo the slot count)
+     * @param frameFence Fence signalled by this frame's submit, used by poll() (optional)
+     * @details Call right after waiting on the frame's in-flight fence and before
+     *          resetting it. Requests recorded the last time this slot was used are
+     *          delivered, then the slot is rewound.
+     */
+    void beginFrame(uint32_t frameIndex, VkFence frameFence = VK_NULL_HANDLE);
+
+    /**
+     * @brief Records a buffer-to-host copy and returns a future for the data
+     * @param commandBuffer Command buffer of the current frame
+     * @param srcBuffer Source buffer (needs VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+     * @param srcOffset Offset into the source buffer
+     * @param size Number of bytes to read back
+     * @return Future resolved with a copy of the bytes once the frame completes
+     * @throws std::runtime_error if the slot capacity is exceeded
+     *
+     * @note The caller is responsible for making prior GPU writes to srcBuffer
+     *       available to the transfer stage (e.g. a compute-to-transfer barrier).
+     */
+    std::future<std::vector<uint8_t>> readBuffer(
+        VkCommandBuffer commandBuffer,
+        VkBuffer srcBuffer,
+        VkDeviceSize srcOffset,
+        VkDeviceSize size);
+
+    /**
+     * @brief Records a buffer-to-host copy delivered through a callback
+     * @param commandBuffer Command buffer of the current frame
+     * @param srcBuffer Source buffer (needs VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+     * @param srcOffset Offset into the source buffer
+     * @param size Number of bytes to read back
+     * @param callback Invoked with a pointer into mapped memory (no extra copy)
+     * @throws std::runtime_error if the slot capacity is exceeded
+     */
+    void readBuffer(
+        VkCommandBuffer commandBuffer,
+        VkBuffer srcBuffer,
+        VkDeviceSize srcOffset,
+        VkDeviceSize size,
+        Callback callback);
+
+    /**
+     * @brief Records an image-to-host copy of one subresource delivered through a callback
+     * @param commandBuffer Command buffer of the current frame
+     * @param image Source image (needs VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+     * @param imageLayout Current layout (TRANSFER_SRC_OPTIMAL or GENERAL)
+     * @param width Width of the region to read
+     * @param height Height of the region to read
+     * @param bytesPerPixel Size of one texel of the image format
+     * @param callback Invoked with tightly packed rows
+     * @param aspectMask Image aspect to read (defaults to color)
+     * @param mipLevel Mip level to read
+     * @param arrayLayer Array layer to read
+     * @throws std::runtime_error if the slot capacity is exceeded
+     *
+     * Example:
+     * @code
+     * readback.readImage(cmd, colorImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+     *     width, height, 4,
+     *     [&](const void* pixels, VkDeviceSize size) { saveScreenshot(pixels, width, height); });
+     * @endcode
+     */
+    void readImage(
+        VkCommandBuffer commandBuffer,
+        VkImage image,
+        VkImageLayout imageLayout,
+        uint32_t width,
+        uint32_t height,
+        uint32_t bytesPerPixel,
+        Callback callback,
+        VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        uint32_t mipLevel = 0,
+        uint32_t arrayLayer = 0);
+
+    /**
+     * @brief Delivers every slot whose fence has already signalled, without blocking
+     * @return Number of requests delivered
+     */
+    uint32_t poll();
+
+    /**
+     * @brief Delivers all pending requests unconditionally
+     * @details Only call when the GPU is known to be idle (e.g. after vkDeviceWaitIdle).
+     */
+    void resolveAll();
+
+    /**
+     * @brief Get the number of ring slots
+     * @return Frames in flight the queue was created with
+     */
+    uint32_t getSlotCount() const { return static_cast<uint32_t>(m_slots.size()); }
+
+    /**
+     * @brief Get the bytes still available in the current slot
+     * @return Remaining capacity of the current frame
+     */
+    VkDeviceSize getRemainingCapacity() const;
+
+protected:
+    /**
+     * @brief A single readback request inside a slot
+     */
+    struct Request {
+        VkDeviceSize offset;                              ///< Offset in the slot buffer
+        VkDeviceSize size;                                ///< Size in bytes
+        Callback callback;                                ///< Callback target (may be empty)
+        std::shared_ptr<std::promise<std::vector<uint8_t>>> promise; ///< Future target (may be null)
+    };
+
+    /**
+     * @brief One ring slot: a host-cached buffer plus the requests recorded into it
+     */
+    struct Slot {
+        VkBuffer buffer{VK_NULL_HANDLE};          ///< Host-cached destination buffer
+        VmaAllocation allocation{VK_NULL_HANDLE}; ///< Its allocation
+        void* mappedData{nullptr};                ///< Persistent mapping
+        VkDeviceSize cursor{0};                   ///< Next free byte
+        VkFence fence{VK_NULL_HANDLE};            ///< Fence of the frame that recorded the requests
+        std::vector<Request> requests;            ///< Pending requests
+    };
+
+    /**
+     * @brief Invalidates and delivers every request of a finished slot, then rewinds it
+     * @param slot Slot whose GPU work is complete
+     * @return Number of requests delivered
+     */
+    virtual uint32_t onSlotComplete(Slot& slot);
+
+    VulkanDevice* m_device;            ///< Pointer to VulkanDevice instance
+    std::vector<Slot> m_slots;         ///< Ring slots, one per frame in flight
+    VkDeviceSize m_bytesPerFrame;      ///< Capacity of each slot
+    uint32_t m_currentSlot{0};         ///< Slot receiving new requests
+
+private:
+    /**
+     * @brief Reserves space in the current slot
+     * @param size Number of bytes
+     * @param alignment Required alignment of the returned offset
+     * @return Offset of the reserved range
+     * @throws std::runtime_error if the slot is full
+     */
+    VkDeviceSize reserve(VkDeviceSize size, VkDeviceSize alignment);
+
+    /**
+     * @brief Records the transfer-to-host barrier for a freshly written range
+     * @param commandBuffer Command buffer to record into
+     * @param offset Offset of the range in the current slot
+     * @param size Size of the range
+     */
+    void recordHostBarrier(VkCommandBuffer commandBuffer, VkDeviceSize offset, VkDeviceSize size) const;
+
+    /**
+     * @brief Destroys the slot buffers created so far
+     * @details Called by the destructor and by the constructor when a buffer fails
+     */
+    void destroyBuffers();
+};
+
+} // namespace ev
@@ -10,7 +10,11 @@
 
 #include "../Common.hpp"
 #include "../DataStructures.hpp"
+#include "ImageViewCache.hpp"
+#include "SamplerCache.hpp"
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -282,11 +286,13 @@ public:
      * @param size Size of the resource (for buffers)
      * @param usage Usage flags (for buffers)
      * @param type Vulkan object type
+     * @param category Memory accounting category (Unspecified infers it from name/usage)
      * @throws std::runtime_error if resource registration fails
      */
     virtual void registerResource(const std::string& name, uint64_t handle,
                                 VmaAllocation allocation, VkDeviceSize size, 
-                                VkBufferUsageFlags usage, VkObjectType type);
+                                VkBufferUsageFlags usage, VkObjectType type,
+                                MemoryCategory category = MemoryCategory::Unspecified);
 
     /**
      * @brief Registers a resource for tracking and debugging with VMA allocation(For Image)
@@ -298,10 +304,16 @@ public:
      * @param height Height of the image
      * @param initialLayout Initial layout of the image
      * @param type Vulkan object type
+     * @param usage Image usage flags, used to infer the category when no tag is given
+     * @param category Memory accounting category (Unspecified infers it from name/usage)
+     * @param format Image format, used for views requested through getImageView()
      * @throws std::runtime_error if resource registration fails
      */
     virtual void registerResource(const std::string& name, uint64_t handle,VkImageView imageView,
-                                    VmaAllocation allocation,  uint32_t width, uint32_t height, VkImageLayout layout, VkObjectType type);
+                                    VmaAllocation allocation,  uint32_t width, uint32_t height, VkImageLayout layout, VkObjectType type,
+                                    VkImageUsageFlags usage = 0,
+                                    MemoryCategory category = MemoryCategory::Unspecified,
+                                    VkFormat format = VK_FORMAT_UNDEFINED);
 
     /**
      * @brief Registers a resource for tracking and debugging with two handles(For Pipeline, DescriptorSet, CommandBuffer)
@@ -315,6 +327,39 @@ public:
                                 uint64_t secondaryHandle, VkObjectType type);
 
 
+    /**
+     * @brief Returns a shared view of a tracked image, creating it on first use
+     * @param imageName Name the image was built with
+     * @param key View type, format, aspect, subresource range and swizzle
+     * @return Cached view; it is destroyed with the image in clearResource()
+     * @throws std::runtime_error if the image is not tracked or view creation fails
+     * 
+     * Requesting the same key again returns the same handle, so per-mip and
+     * per-layer views can be looked up every frame instead of being kept around.
+     * 
+     * Example usage:
+     * @code
+     * // Sample level 3 of the bloom chain with a swizzled single-channel view
+     * ImageViewKey key = ImageViewKey::mip(3);
+     * key.components = {VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R,
+     *                   VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_ONE};
+     * VkImageView view = resourceManager->getImageView("rtBloom", key);
+     * @endcode
+     */
+    VkImageView getImageView(const std::string& imageName, const ImageViewKey& key);
+
+    /**
+     * @brief Get the cache holding the views returned by getImageView()
+     * @return Image view cache; usable directly for untracked images
+     */
+    ImageViewCache* getImageViewCache() { return m_imageViewCache.get(); }
+
+    /**
+     * @brief Get the cache sharing samplers created with SamplerBuilder::buildShared()
+     * @return Sampler cache; its samplers are destroyed with the ResourceManager
+     */
+    SamplerCache* getSamplerCache() { return m_samplerCache.get(); }
+
     /**
      * @brief Clears a resource from tracking
      * @param name Resource name/identifier
@@ -422,6 +467,54 @@ public:
      */
     void printMemoryUsage(bool detailed = false) const;
 
+    /**
+     * @brief Get the live-byte, high-water and allocation-count counters of a category
+     * @param category Memory category to query
+     * @return Snapshot of the category counters
+     * 
+     * The counters are maintained atomically in registerResource/clearResource, so
+     * this query is a handful of relaxed loads. Unlike getMemoryUsage() it does not
+     * walk the VMA blocks and is cheap enough to call every frame.
+     * Only named (tracked) buffers and images are accounted.
+     * 
+     * Example usage:
+     * @code
+     * auto tex = resourceManager->getMemoryCategoryStats(MemoryCategory::Textures);
+     * printf("Textures: %llu bytes in %u allocations (peak %llu)\n",
+     *        tex.liveBytes, tex.allocationCount, tex.highWaterBytes);
+     * @endcode
+     */
+    MemoryCategoryStats getMemoryCategoryStats(MemoryCategory category) const;
+
+    /**
+     * @brief Get the counters of every category, indexed by MemoryCategory
+     * @return Array with one snapshot per category
+     */
+    std::array<MemoryCategoryStats, static_cast<size_t>(MemoryCategory::Count)> getAllMemoryCategoryStats() const;
+
+    /**
+     * @brief Resets the high-water mark of every category to its current live bytes
+     */
+    void resetMemoryCategoryHighWater();
+
+    /**
+     * @brief Print per-category memory usage to the console
+     */
+    void printMemoryCategoryUsage() const;
+
+    /**
+     * @brief Infers a memory category from a resource name prefix
+     * @param name Resource name
+     * @return Matching category, or MemoryCategory::Unspecified if no prefix matched
+     * 
+     * Recognised prefixes (case-insensitive, followed by a non-letter such as '_',
+     * '.', '-' or a digit, or by the end of the name): "tex"/"texture" -> Textures,
+     * "mesh"/"vb"/"ib"/"vertex"/"index"/"geometry" -> Meshes,
+     * "rt"/"depth"/"gbuffer"/"attachment" -> RenderTargets, "staging" -> Staging,
+     * "ubo"/"uniform" -> Uniforms.
+     */
+    static MemoryCategory inferMemoryCategory(const std::string& name);
+
 
 private:
     /**
@@ -436,6 +529,34 @@ private:
      * @param type Vulkan object type
      */
     void destroyResource(uint64_t handle, VkObjectType type);
+
+    /**
+     * @brief Atomic counters of one memory category
+     */
+    struct MemoryCategoryCounters {
+        std::atomic<uint64_t> liveBytes{0};      ///< Bytes currently allocated
+        std::atomic<uint64_t> highWaterBytes{0}; ///< Peak of liveBytes
+        std::atomic<uint32_t> allocationCount{0}; ///< Number of live allocations
+    };
+
+    std::array<MemoryCategoryCounters, static_cast<size_t>(MemoryCategory::Count)> m_memoryCategoryCounters; ///< Per-category counters
+    std::unique_ptr<ImageViewCache> m_imageViewCache; ///< Shared per-image views
+    std::unique_ptr<SamplerCache> m_samplerCache;     ///< Reference-counted shared samplers
+
+    /**
+     * @brief Adds an allocation to the counters of a category
+     * @param category Resolved memory category
+     * @param allocation VMA allocation whose size is accounted
+     * @return Number of bytes accounted
+     */
+    VkDeviceSize trackAllocation(MemoryCategory category, VmaAllocation allocation);
+
+    /**
+     * @brief Removes previously accounted bytes from a category
+     * @param category Memory category the bytes were accounted to
+     * @param bytes Number of bytes returned by trackAllocation
+     */
+    void untrackAllocation(MemoryCategory category, VkDeviceSize bytes);
 };
 
 } // namespace ev
\ No newline at end of file
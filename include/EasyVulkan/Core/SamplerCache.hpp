@@ -0,0 +1,184 @@
+/**
+ * @file SamplerCache.hpp
+ * @brief Deduplicating sampler cache for EasyVulkan framework
+ * @details This file contains the SamplerCache class which shares one reference-counted
+ *          VkSampler between every request with the same VkSamplerCreateInfo state.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+namespace ev {
+
+class VulkanDevice;
+
+/**
+ * @struct SamplerKey
+ * @brief Hashable copy of the state of a VkSamplerCreateInfo
+ * @details Floats are compared by value, so 0.0f and -0.0f share a sampler. pNext
+ *          chains are not part of the key.
+ */
+struct SamplerKey {
+    VkSamplerCreateFlags flags{0};                                     ///< Create flags
+    VkFilter magFilter{VK_FILTER_LINEAR};                              ///< Magnification filter
+    VkFilter minFilter{VK_FILTER_LINEAR};                              ///< Minification filter
+    VkSamplerMipmapMode mipmapMode{VK_SAMPLER_MIPMAP_MODE_LINEAR};     ///< Mipmap mode
+    VkSamplerAddressMode addressModeU{VK_SAMPLER_ADDRESS_MODE_REPEAT}; ///< U addressing
+    VkSamplerAddressMode addressModeV{VK_SAMPLER_ADDRESS_MODE_REPEAT}; ///< V addressing
+    VkSamplerAddressMode addressModeW{VK_SAMPLER_ADDRESS_MODE_REPEAT}; ///< W addressing
+    float mipLodBias{0.0f};                                            ///< LOD bias
+    VkBool32 anisotropyEnable{VK_FALSE};                               ///< Anisotropic filtering
+    float maxAnisotropy{1.0f};                                         ///< Anisotropy level
+    VkBool32 compareEnable{VK_FALSE};                                  ///< Depth compare
+    VkCompareOp compareOp{VK_COMPARE_OP_NEVER};                        ///< Compare operation
+    float minLod{0.0f};                                                ///< Minimum LOD
+    float maxLod{VK_LOD_CLAMP_NONE};                                   ///< Maximum LOD
+    VkBorderColor borderColor{VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK}; ///< Border color
+    VkBool32 unnormalizedCoordinates{VK_FALSE};                        ///< Texel coordinates
+
+    /**
+     * @brief Captures the key state of a create info
+     * @param createInfo Sampler create info
+     * @return Key of the sampler
+     */
+    static SamplerKey fromCreateInfo(const VkSamplerCreateInfo& createInfo);
+
+    /**
+     * @brief Rebuilds the create info the key was taken from
+     * @return VkSamplerCreateInfo without pNext
+     */
+    VkSamplerCreateInfo toCreateInfo() const;
+
+    bool operator==(const SamplerKey& other) const;
+};
+
+/**
+ * @struct SamplerKeyHash
+ * @brief Hash functor for SamplerKey
+ */
+struct SamplerKeyHash {
+    size_t operator()(const SamplerKey& key) const;
+};
+
+/**
+ * @class SamplerCache
+ * @brief Reference-counted cache of shared samplers
+ * @details SamplerCache provides:
+ *          - One VkSampler per distinct sampler state, however many materials ask for it
+ *          - Reference counting: the sampler is destroyed when its last user releases it
+ *          - The number of cached samplers, to compare against
+ *            VkPhysicalDeviceLimits::maxSamplerAllocationCount
+ *          - Thread-safe acquire/release
+ *
+ * Devices cap the number of live samplers (often at 4000), while material systems
+ * tend to create a near-identical sampler per material. Going through the cache
+ * keeps the count at the number of distinct states instead.
+ *
+ * Common usage patterns:
+ * @code
+ * // Usually reached through SamplerBuilder::buildShared()
+ * VkSampler sampler = resourceManager->createSampler()
+ *     .setAnisotropy(16.0f)
+ *     .buildShared();
+ * // ... every material with the same settings gets the same handle
+ *
+ * // When the material goes away
+ * SamplerCache* samplers = resourceManager->getSamplerCache();
+ * samplers->release(sampler);
+ *
+ * LogInfo("Samplers: " + std::to_string(samplers->getCachedSamplerCount()) + " / " +
+ *         std::to_string(samplers->getSamplerLimit()));
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override createSampler() to attach pNext structures (e.g. reduction mode)
+ */
+class SamplerCache {
+public:
+    /**
+     * @brief Constructor for SamplerCache
+     * @param device Pointer to VulkanDevice instance
+     * @throws std::runtime_error if device is null
+     */
+    explicit SamplerCache(VulkanDevice* device);
+
+    /**
+     * @brief Virtual destructor
+     * @details Destroys every cached sampler regardless of its reference count.
+     */
+    virtual ~SamplerCache();
+
+    SamplerCache(const SamplerCache&) = delete;
+    SamplerCache& operator=(const SamplerCache&) = delete;
+
+    /**
+     * @brief Returns the shared sampler for a create info and adds a reference
+     * @param createInfo Sampler state (pNext is ignored)
+     * @return Shared sampler; pass it to release() instead of destroying it
+     * @throws std::runtime_error if sampler creation fails
+     */
+    VkSampler acquire(const VkSamplerCreateInfo& createInfo);
+
+    /**
+     * @brief Drops one reference, destroying the sampler with the last one
+     * @param sampler Sampler returned by acquire()
+     * @return true if the sampler was known to the cache
+     */
+    bool release(VkSampler sampler);
+
+    /**
+     * @brief Destroys every cached sampler
+     * @details Handles still held by callers become invalid.
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of distinct samplers currently alive in the cache
+     * @return Cached sampler count
+     * @note Samplers created outside the cache (SamplerBuilder::build()) are not
+     *       included, although they count against getSamplerLimit() as well.
+     */
+    size_t getCachedSamplerCount() const;
+
+    /**
+     * @brief Get the number of acquire() calls not yet released
+     * @return Total reference count
+     */
+    size_t getReferenceCount() const;
+
+    /**
+     * @brief Get the device's limit on live samplers
+     * @return VkPhysicalDeviceLimits::maxSamplerAllocationCount
+     */
+    uint32_t getSamplerLimit() const { return m_samplerLimit; }
+
+protected:
+    /**
+     * @brief Creates the sampler for a cache miss
+     * @param key Sampler state
+     * @return New sampler
+     * @throws std::runtime_error if vkCreateSampler fails
+     */
+    virtual VkSampler createSampler(const SamplerKey& key);
+
+    /**
+     * @brief One shared sampler and its users
+     */
+    struct Entry {
+        VkSampler sampler{VK_NULL_HANDLE}; ///< Shared sampler
+        uint32_t references{0};            ///< Outstanding acquire() calls
+    };
+
+    VulkanDevice* m_device;                                          ///< Pointer to VulkanDevice instance
+    uint32_t m_samplerLimit{0};                                      ///< maxSamplerAllocationCount
+    mutable std::mutex m_mutex;                                      ///< Guards the maps below
+    std::unordered_map<SamplerKey, Entry, SamplerKeyHash> m_entries; ///< Samplers by state
+    std::unordered_map<VkSampler, SamplerKey> m_keys;                ///< State of each sampler, for release()
+};
+
+} // namespace ev
@@ -0,0 +1,192 @@
+/**
+ * @file StagingRing.hpp
+ * @brief Per-frame upload staging ring for EasyVulkan framework
+ * @details This file contains the StagingRing class which sub-allocates upload
+ *          space from N-buffered, persistently mapped buffers and records partial
+ *          (dirty-rectangle) image updates into the caller's frame command buffer.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <vector>
+
+namespace ev {
+
+class VulkanDevice;
+
+/**
+ * @struct StagingAllocation
+ * @brief A range of the current frame's staging buffer
+ */
+struct StagingAllocation {
+    VkBuffer buffer{VK_NULL_HANDLE}; ///< Staging buffer of the current slot
+    VkDeviceSize offset{0};          ///< Offset of the range in the buffer
+    VkDeviceSize size{0};            ///< Size of the range
+    void* mappedData{nullptr};       ///< Host pointer to the start of the range
+};
+
+/**
+ * @struct ImageUpdateTarget
+ * @brief One subresource of an image updated from a CPU-side copy
+ * @details pixels holds the whole mip level; only the dirty rectangles are read.
+ */
+struct ImageUpdateTarget {
+    VkImage image{VK_NULL_HANDLE};                ///< Image to update
+    VkFormat format{VK_FORMAT_UNDEFINED};         ///< Image format (block-compressed allowed)
+    VkExtent2D extent{0, 0};                      ///< Extent of the mip level
+    uint32_t mipLevel{0};                         ///< Mip level to update
+    uint32_t arrayLayer{0};                       ///< Array layer to update
+    VkImageLayout layout{VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}; ///< Layout before and after the update
+    const void* pixels{nullptr};                  ///< CPU copy of the whole level
+    uint32_t rowLength{0};                        ///< Row pitch of pixels in texels (0 = extent.width)
+};
+
+/**
+ * @class StagingRing
+ * @brief N-buffered ring of upload buffers for non-blocking transfers
+ * @details StagingRing provides:
+ *          - One persistently mapped staging buffer per frame in flight
+ *          - Linear sub-allocation rewound when the frame's slot comes around again
+ *          - Dirty-rectangle image updates: only changed texels are packed, copied
+ *            with one multi-region vkCmdCopyBufferToImage, and only the updated
+ *            mip level and layer are transitioned
+ *
+ * Nothing is submitted or waited on; the copies run as part of the caller's frame.
+ * Upload bandwidth therefore scales with the number of changed texels rather than
+ * with the texture size.
+ *
+ * Common usage patterns:
+ * @code
+ * StagingRing staging(device, MAX_FRAMES_IN_FLIGHT, 8 * 1024 * 1024);
+ *
+ * // In render loop, after waiting on the frame's in-flight fence:
+ * staging.beginFrame(currentFrame);
+ *
+ * // Push the parts of a UI atlas that changed this frame
+ * ImageUpdateTarget atlasTarget;
+ * atlasTarget.image = atlas.image;
+ * atlasTarget.format = VK_FORMAT_R8G8B8A8_UNORM;
+ * atlasTarget.extent = {2048, 2048};
+ * atlasTarget.pixels = atlasPixels.data();
+ * staging.updateImage(cmd, atlasTarget, {{{128, 64}, {32, 32}}, {{900, 12}, {240, 18}}});
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override onSlotReset() to track per-frame upload statistics
+ */
+class StagingRing {
+public:
+    /**
+     * @brief Constructor for StagingRing
+     * @param device Pointer to VulkanDevice instance
+     * @param framesInFlight Number of ring slots (usually MAX_FRAMES_IN_FLIGHT)
+     * @param bytesPerFrame Capacity of each slot in bytes
+     * @throws std::runtime_error if device is null, a count is 0 or allocation fails
+     */
+    StagingRing(VulkanDevice* device, uint32_t framesInFlight, VkDeviceSize bytesPerFrame);
+
+    /**
+     * @brief Virtual destructor
+     * @details Destroys the ring buffers; the GPU must no longer read them.
+     */
+    virtual ~StagingRing();
+
+    StagingRing(const StagingRing&) = delete;
+    StagingRing& operator=(const StagingRing&) = delete;
+
+    /**
+     * @brief Starts a new frame on the given slot
+     * @param frameIndex Frame-in-flight index (taken modulo the slot count)
+     * @details Call after waiting on the frame's in-flight fence; the slot's
+     *          previous contents are no longer read by the GPU and it is rewound.
+     */
+    void beginFrame(uint32_t frameIndex);
+
+    /**
+     * @brief Reserves space in the current slot
+     * @param size Number of bytes
+     * @param alignment Required alignment of the offset
+     * @return Range to write; call flush() on it before the frame is submitted
+     * @throws std::runtime_error if the slot is full
+     */
+    StagingAllocation allocate(VkDeviceSize size, VkDeviceSize alignment = 16);
+
+    /**
+     * @brief Checks whether allocate() would succeed
+     * @param size Number of bytes
+     * @param alignment Required alignment of the offset
+     * @return true if the current slot has room for the aligned range
+     */
+    bool canAllocate(VkDeviceSize size, VkDeviceSize alignment = 16) const;
+
+    /**
+     * @brief Makes host writes to a range visible to the device
+     * @param allocation Range returned by allocate()
+     * @details A no-op on HOST_COHERENT memory.
+     */
+    void flush(const StagingAllocation& allocation);
+
+    /**
+     * @brief Records an update of the dirty rectangles of one image subresource
+     * @param commandBuffer Command buffer of the current frame
+     * @param target Image subresource and its CPU-side copy
+     * @param dirtyRects Rectangles to upload, in texels of the mip level
+     * @return Number of bytes packed into the ring
+     * @throws std::runtime_error if the format is unknown or the slot is full
+     *
+     * Rectangles are clipped to the level and, for block-compressed formats,
+     * expanded to block boundaries. Each is packed tightly (bufferRowLength set to
+     * its own width) into the ring; one barrier moves the mip level/layer to
+     * TRANSFER_DST_OPTIMAL, one multi-region copy writes them, and one barrier
+     * returns it to target.layout.
+     */
+    VkDeviceSize updateImage(
+        VkCommandBuffer commandBuffer,
+        const ImageUpdateTarget& target,
+        const std::vector<VkRect2D>& dirtyRects);
+
+    /**
+     * @brief Get the number of ring slots
+     * @return Frames in flight the ring was created with
+     */
+    uint32_t getSlotCount() const { return static_cast<uint32_t>(m_slots.size()); }
+
+    /**
+     * @brief Get the bytes still available in the current slot
+     * @return Remaining capacity of the current frame
+     */
+    VkDeviceSize getRemainingCapacity() const;
+
+protected:
+    /**
+     * @brief One ring slot: a host-visible buffer and its fill level
+     */
+    struct Slot {
+        VkBuffer buffer{VK_NULL_HANDLE};          ///< Staging buffer
+        VmaAllocation allocation{VK_NULL_HANDLE}; ///< Its allocation
+        void* mappedData{nullptr};                ///< Persistent mapping
+        VkDeviceSize cursor{0};                   ///< Next free byte
+    };
+
+    /**
+     * @brief Called when a slot is rewound by beginFrame()
+     * @param slot Slot about to be reused; cursor still holds last frame's usage
+     */
+    virtual void onSlotReset(Slot& /*slot*/) {}
+
+    VulkanDevice* m_device;        ///< Pointer to VulkanDevice instance
+    std::vector<Slot> m_slots;     ///< Ring slots, one per frame in flight
+    VkDeviceSize m_bytesPerFrame;  ///< Capacity of each slot
+    uint32_t m_currentSlot{0};     ///< Slot receiving new allocations
+
+private:
+    /**
+     * @brief Destroys the slot buffers created so far
+     * @details Called by the destructor and by the constructor when a buffer fails
+     */
+    void destroyBuffers();
+};
+
+} // namespace ev
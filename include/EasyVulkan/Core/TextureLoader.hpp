@@ -0,0 +1,233 @@
+/**
+ * @file TextureLoader.hpp
+ * @brief Compressed texture asset loading for EasyVulkan framework
+ * @details This file contains the KTX2 container description, the transcoder
+ *          interface for supercompressed payloads, and the TextureLoader class
+ *          which selects a device-supported block format, transcodes mip levels
+ *          on worker threads and uploads the whole chain in one submission.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ev {
+
+class VulkanDevice;
+class VulkanContext;
+
+/**
+ * @enum KTX2Supercompression
+ * @brief supercompressionScheme values of a KTX2 header
+ */
+enum class KTX2Supercompression : uint32_t {
+    None = 0,      ///< Level data is stored as-is
+    BasisLZ = 1,   ///< Basis Universal ETC1S with global codebooks
+    Zstandard = 2, ///< Zstandard-compressed levels
+    ZLIB = 3       ///< Deflate-compressed levels
+};
+
+/**
+ * @enum KTX2Payload
+ * @brief Kind of texel data stored in a KTX2 file
+ */
+enum class KTX2Payload {
+    Native, ///< A Vulkan format (vkFormat != VK_FORMAT_UNDEFINED)
+    ETC1S,  ///< Basis Universal ETC1S (BasisLZ)
+    UASTC   ///< Basis Universal UASTC
+};
+
+/**
+ * @struct KTX2Level
+ * @brief Entry of the KTX2 level index
+ */
+struct KTX2Level {
+    VkDeviceSize byteOffset{0};             ///< Offset of the level in the file
+    VkDeviceSize byteLength{0};             ///< Stored (possibly supercompressed) size
+    VkDeviceSize uncompressedByteLength{0}; ///< Size after supercompression is removed
+};
+
+/**
+ * @struct KTX2Texture
+ * @brief Parsed KTX2 container; owns the file bytes
+ * @details Dimensions are normalised: height, depth, layerCount and levelCount
+ *          are at least 1. Levels are indexed from the base level down.
+ */
+struct KTX2Texture {
+    VkFormat vkFormat{VK_FORMAT_UNDEFINED};  ///< Stored format (UNDEFINED for Basis payloads)
+    uint32_t typeSize{1};                    ///< Size of the data type for endianness conversion
+    uint32_t width{0};                       ///< Width of level 0
+    uint32_t height{1};                      ///< Height of level 0
+    uint32_t depth{1};                       ///< Depth of level 0
+    uint32_t layerCount{1};                  ///< Array layers
+    uint32_t faceCount{1};                   ///< 6 for cubemaps
+    uint32_t levelCount{1};                  ///< Mip levels present in the file
+    KTX2Supercompression supercompression{KTX2Supercompression::None}; ///< Supercompression scheme
+    KTX2Payload payload{KTX2Payload::Native};///< Kind of texel data
+    bool srgb{false};                        ///< DFD transfer function is sRGB
+    bool hasAlpha{false};                    ///< Basis payload carries an alpha channel
+    std::vector<KTX2Level> levels;           ///< Level index
+    VkDeviceSize sgdByteOffset{0};           ///< Supercompression global data offset
+    VkDeviceSize sgdByteLength{0};           ///< Supercompression global data size
+    std::vector<uint8_t> fileData;           ///< Whole file contents
+
+    /**
+     * @brief Get the stored bytes of a level (all layers and faces)
+     * @param level Mip level
+     * @return Pointer into fileData
+     */
+    const uint8_t* getLevelData(uint32_t level) const { return fileData.data() + levels[level].byteOffset; }
+
+    /**
+     * @brief Get the supercompression global data (BasisLZ codebooks)
+     * @return Pointer into fileData, or nullptr if absent
+     */
+    const uint8_t* getGlobalData() const { return sgdByteLength ? fileData.data() + sgdByteOffset : nullptr; }
+};
+
+/**
+ * @class TextureTranscoder
+ * @brief Interface turning supercompressed or universal payloads into GPU formats
+ * @details The library has no built-in Basis Universal, Zstandard or zlib decoder.
+ *          Applications wrap the decoder they ship (e.g. basisu_transcoder) in this
+ *          interface and register it with TextureLoader::setTranscoder().
+ *
+ * @note transcodeLevel() is called concurrently for different levels and must be
+ *       thread-safe.
+ */
+class TextureTranscoder {
+public:
+    virtual ~TextureTranscoder() = default;
+
+    /**
+     * @brief Check whether a texture can be transcoded to a format
+     * @param texture Parsed container
+     * @param target Candidate Vulkan format
+     * @return true if transcodeLevel() can produce target
+     */
+    virtual bool supports(const KTX2Texture& texture, VkFormat target) const = 0;
+
+    /**
+     * @brief Transcodes one level, all layers and faces
+     * @param texture Parsed container
+     * @param level Mip level
+     * @param target Vulkan format chosen by TextureLoader
+     * @return Tightly packed blocks in KTX2 order (layer, face, z-slice)
+     * @throws std::runtime_error on corrupt data
+     */
+    virtual std::vector<uint8_t> transcodeLevel(const KTX2Texture& texture, uint32_t level, VkFormat target) const = 0;
+};
+
+/**
+ * @class TextureLoader
+ * @brief Loads KTX2 textures with all mip levels and layers in block-compressed formats
+ * @details TextureLoader provides:
+ *          - KTX2 container parsing (level index, DFD color model, sRGB and alpha)
+ *          - Direct upload of native BCn/ASTC/ETC2 payloads without CPU conversion
+ *          - Target format selection from device support (BC7, ASTC, ETC2, BC1/BC3)
+ *          - Transcoding of Basis/supercompressed levels on worker threads
+ *          - One staging buffer and one multi-region copy for the whole chain
+ *
+ * Common usage patterns:
+ * @code
+ * TextureLoader loader(device, context);
+ * loader.setTranscoder(std::make_shared<MyBasisTranscoder>());
+ *
+ * ImageInfo albedo = loader.loadKTX2("textures/albedo.ktx2", "albedo");
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override selectFormat() to change the format preference order
+ */
+class TextureLoader {
+public:
+    /**
+     * @brief Constructor for TextureLoader
+     * @param device Pointer to VulkanDevice instance
+     * @param context Pointer to VulkanContext instance
+     * @throws std::runtime_error if either pointer is null
+     */
+    TextureLoader(VulkanDevice* device, VulkanContext* context);
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~TextureLoader() = default;
+
+    /**
+     * @brief Registers the transcoder used for Basis and supercompressed payloads
+     * @param transcoder Thread-safe transcoder (may be null to disable)
+     */
+    void setTranscoder(std::shared_ptr<TextureTranscoder> transcoder) { m_transcoder = std::move(transcoder); }
+
+    /**
+     * @brief Parses a KTX2 file held in memory
+     * @param fileData File contents; moved into the returned texture
+     * @return Parsed texture
+     * @throws std::runtime_error if the identifier, index or DFD is invalid
+     */
+    static KTX2Texture parseKTX2(std::vector<uint8_t> fileData);
+
+    /**
+     * @brief Reads and parses a KTX2 file
+     * @param filename Path to the .ktx2 file
+     * @return Parsed texture
+     * @throws std::runtime_error if the file cannot be read or is invalid
+     */
+    static KTX2Texture readKTX2File(const std::string& filename);
+
+    /**
+     * @brief Chooses the Vulkan format a texture is uploaded in
+     * @param texture Parsed texture
+     * @return Stored format for native payloads, otherwise the best format that both
+     *         the device samples and the transcoder produces
+     * @throws std::runtime_error if no usable format exists
+     */
+    virtual VkFormat selectFormat(const KTX2Texture& texture) const;
+
+    /**
+     * @brief Loads a KTX2 file into a new sampled image
+     * @param filename Path to the .ktx2 file
+     * @param name Optional name for resource tracking
+     * @param finalLayout Layout of the image after upload
+     * @return Created image info
+     * @throws std::runtime_error on read, parse, transcode or upload failure
+     */
+    ImageInfo loadKTX2(
+        const std::string& filename,
+        const std::string& name = "",
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    /**
+     * @brief Creates a sampled image from a parsed KTX2 texture and uploads every level
+     * @param texture Parsed texture
+     * @param name Optional name for resource tracking
+     * @param finalLayout Layout of the image after upload
+     * @return Created image info
+     * @throws std::runtime_error on transcode or upload failure
+     */
+    ImageInfo uploadKTX2(
+        const KTX2Texture& texture,
+        const std::string& name = "",
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+protected:
+    /**
+     * @brief Transcodes all levels in parallel
+     * @param texture Parsed texture
+     * @param target Format selected by selectFormat()
+     * @return One buffer per level
+     * @throws std::runtime_error if no transcoder is set or a level has the wrong size
+     */
+    std::vector<std::vector<uint8_t>> transcodeLevels(const KTX2Texture& texture, VkFormat target) const;
+
+    VulkanDevice* m_device;                          ///< Pointer to VulkanDevice instance
+    VulkanContext* m_context;                        ///< Pointer to VulkanContext instance
+    std::shared_ptr<TextureTranscoder> m_transcoder; ///< Basis/supercompression transcoder
+};
+
+} // namespace ev
@@ -0,0 +1,363 @@
+/**
+ * @file TextureStreamer.hpp
+ * @brief Mip streaming for large texture sets in EasyVulkan framework
+ * @details This file contains the TextureStreamer class which makes only the
+ *          low-resolution mip tail of a texture resident at creation and streams
+ *          finer levels in later frames, driven by a per-texture desired mip and
+ *          limited by a per-frame upload budget.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ev {
+
+class VulkanDevice;
+class VulkanContext;
+class ThreadPool;
+class ReadbackQueue;
+class StagingRing;
+
+/**
+ * @brief Handle of a texture owned by a TextureStreamer
+ */
+using StreamingTextureHandle = uint32_t;
+
+/**
+ * @brief Value of a StreamingTextureHandle that refers to no texture
+ */
+constexpr StreamingTextureHandle InvalidStreamingTexture = UINT32_MAX;
+
+/**
+ * @struct StreamingTextureDesc
+ * @brief Describes a streamed texture and where its levels come from
+ */
+struct StreamingTextureDesc {
+    VkFormat format{VK_FORMAT_UNDEFINED}; ///< Image format (block-compressed formats are supported)
+    uint32_t width{0};                    ///< Width of level 0
+    uint32_t height{0};                   ///< Height of level 0
+    uint32_t mipLevels{0};                ///< Level count (0 = full chain)
+    /**
+     * Returns the tightly packed texels of one level. Called on worker threads
+     * (or std::async) for streamed levels, so it must be thread-safe.
+     */
+    std::function<std::vector<uint8_t>(uint32_t mipLevel)> loadLevel;
+    std::string name;                     ///< Debug name
+};
+
+/**
+ * @struct TextureStreamerConfig
+ * @brief Limits and tuning of a TextureStreamer
+ */
+struct TextureStreamerConfig {
+    uint32_t framesInFlight{2};                         ///< Frames the GPU may lag behind the CPU
+    VkDeviceSize uploadBudgetPerFrame{16 * 1024 * 1024}; ///< Staging bytes uploaded per update()
+    uint32_t tailMaxDimension{128};                     ///< Levels this size or smaller are loaded at creation
+    uint32_t maxPendingLoads{16};                       ///< Level loads in flight at once
+    uint32_t maxTextures{4096};                         ///< Entries of the GPU feedback buffer
+};
+
+/**
+ * @struct TextureStreamerStats
+ * @brief Counters of the last update()
+ */
+struct TextureStreamerStats {
+    VkDeviceSize bytesUploaded{0};   ///< Bytes copied to images
+    uint32_t levelsUploaded{0};      ///< Levels made resident
+    uint32_t pendingLoads{0};        ///< Loads still running on worker threads
+    uint32_t texturesWaiting{0};     ///< Textures whose desired mip is not resident yet
+};
+
+/**
+ * @class TextureStreamer
+ * @brief Streams mip levels of textures on demand within a per-frame budget
+ * @details TextureStreamer provides:
+ *          - Images created with their whole mip chain, with only the tail uploaded
+ *          - A desired mip per texture, from CPU screen-size estimates or GPU feedback
+ *          - Level loads on a ThreadPool (or std::async) and uploads recorded into
+ *            the frame's command buffer from a StagingRing
+ *          - A per-frame upload byte budget, spent on the textures furthest from
+ *            their desired mip first
+ *          - Views whose baseMipLevel is the finest resident level, so sampling never
+ *            reads a level that has not been uploaded
+ *
+ * Levels become resident one at a time from coarse to fine. Each time a level
+ * lands a new view is created; the callback set with setViewChangedCallback()
+ * receives it so descriptors can be rewritten. Retired views are destroyed once
+ * the frames that may use them have completed.
+ *
+ * GPU feedback: shaders write the absolute mip they would like to sample into
+ * getFeedbackBuffer() (one uint per handle), e.g.
+ * @code
+ * // layout(set = 0, binding = 5) buffer Feedback { uint wantedMip[]; };
+ * vec2 texels = uv * vec2(fullResolution);
+ * float lod = 0.5 * log2(max(dot(dFdx(texels), dFdx(texels)), dot(dFdy(texels), dFdy(texels))));
+ * atomicMin(wantedMip[textureHandle], uint(max(lod, 0.0)));
+ * @endcode
+ * and recordFeedback() reads the buffer back through a ReadbackQueue and clears it.
+ *
+ * Common usage patterns:
+ * @code
+ * TextureStreamer streamer(device, context, {}, &threadPool);
+ * streamer.setViewChangedCallback([&](StreamingTextureHandle handle, VkImageView view) {
+ *     bindless.update(handle, view);
+ * });
+ *
+ * StreamingTextureDesc desc;
+ * desc.format = VK_FORMAT_BC7_SRGB_BLOCK;
+ * desc.width = desc.height = 8192;
+ * desc.loadLevel = [file](uint32_t level) { return file->readLevel(level); };
+ * StreamingTextureHandle terrain = streamer.createTexture(desc);
+ *
+ * // In render loop, after waiting on the frame's fence:
+ * readback.beginFrame(currentFrame);                     // delivers GPU feedback
+ * streamer.requestScreenSize(terrain, projectedPixels);  // or CPU estimates
+ * streamer.update(commandBuffer, currentFrame);          // before any draw samples
+ * ...
+ * streamer.recordFeedback(commandBuffer, readback);      // after the draws
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override getPriority() to change which textures receive the budget first
+ * @note Memory for the whole chain is allocated up front so the VkImage never
+ *       changes; streaming saves load time, host memory and upload bandwidth.
+ */
+class TextureStreamer {
+public:
+    /**
+     * @brief Receives the new view of a texture after its resident range changed
+     */
+    using ViewChangedCallback = std::function<void(StreamingTextureHandle handle, VkImageView view)>;
+
+    /**
+     * @brief Constructor for TextureStreamer
+     * @param device Pointer to VulkanDevice instance
+     * @param context Pointer to VulkanContext instance
+     * @param config Budget and limits
+     * @param pool Thread pool running level loads (nullptr = std::async)
+     * @throws std::runtime_error if a pointer is null, a limit is 0 or allocation fails
+     */
+    TextureStreamer(
+        VulkanDevice* device,
+        VulkanContext* context,
+        const TextureStreamerConfig& config = {},
+        ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Virtual destructor
+     * @details Waits for running loads and destroys every texture, view and staging
+     *          buffer. The GPU must no longer use them.
+     */
+    virtual ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    /**
+     * @brief Creates a texture and uploads its mip tail
+     * @param desc Texture description
+     * @return Handle of the new texture
+     * @throws std::runtime_error if the description is invalid or creation fails
+     *
+     * The tail (every level no larger than tailMaxDimension, and at least the last
+     * level) is loaded synchronously; the image is in SHADER_READ_ONLY_OPTIMAL.
+     */
+    StreamingTextureHandle createTexture(const StreamingTextureDesc& desc);
+
+    /**
+     * @brief Destroys a texture once the frames in flight are done with it
+     * @param handle Texture handle
+     */
+    void destroyTexture(StreamingTextureHandle handle);
+
+    /**
+     * @brief Requests a mip level for this frame
+     * @param handle Texture handle
+     * @param mipLevel Finest level wanted (the smallest request of a frame wins)
+     */
+    void requestMip(StreamingTextureHandle handle, uint32_t mipLevel);
+
+    /**
+     * @brief Requests the level matching a projected on-screen size
+     * @param handle Texture handle
+     * @param screenPixels Largest on-screen extent of the texture in pixels
+     * @param bias Added to the computed level (positive = coarser)
+     */
+    void requestScreenSize(StreamingTextureHandle handle, float screenPixels, float bias = 0.0f);
+
+    /**
+     * @brief Level whose size best matches an on-screen size
+     * @param width Width of level 0
+     * @param height Height of level 0
+     * @param screenPixels Largest on-screen extent in pixels
+     * @param bias Added to the computed level
+     * @return floor(log2(max(width, height) / screenPixels) + bias), at least 0
+     */
+    static uint32_t computeDesiredMip(uint32_t width, uint32_t height, float screenPixels, float bias = 0.0f);
+
+    /**
+     * @brief Starts loads and records uploads for the current frame
+     * @param commandBuffer Frame command buffer, before any pass that samples the textures
+     * @param frameIndex Frame-in-flight index (taken modulo framesInFlight)
+     * @details Call once per frame after waiting on the frame's in-flight fence. It
+     *          applies this frame's requests, destroys retired objects, launches loads,
+     *          and copies finished loads into their images until the budget is spent.
+     */
+    void update(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+    /**
+     * @brief Reads back and clears the GPU feedback buffer
+     * @param commandBuffer Frame command buffer, after the passes writing feedback
+     * @param readback Queue delivering the values; they are applied as requestMip()
+     *        calls when the frame completes
+     * @details The readback may outlive the streamer: callbacks delivered after
+     *          destruction are ignored.
+     */
+    void recordFeedback(VkCommandBuffer commandBuffer, ReadbackQueue& readback);
+
+    /**
+     * @brief Sets the callback receiving new views
+     * @param callback Called from update() for every texture whose view changed
+     */
+    void setViewChangedCallback(ViewChangedCallback callback) { m_viewChanged = std::move(callback); }
+
+    /**
+     * @brief Get the feedback storage buffer (one uint per handle, UINT32_MAX = no request)
+     * @return Buffer handle
+     */
+    VkBuffer getFeedbackBuffer() const { return m_feedbackBuffer; }
+
+    /**
+     * @brief Get the image of a texture
+     * @param handle Texture handle
+     * @return Image holding the whole chain
+     */
+    VkImage getImage(StreamingTextureHandle handle) const;
+
+    /**
+     * @brief Get the current view of a texture
+     * @param handle Texture handle
+     * @return View covering the resident levels only
+     */
+    VkImageView getImageView(StreamingTextureHandle handle) const;
+
+    /**
+     * @brief Get the finest resident level of a texture
+     * @param handle Texture handle
+     * @return Mip level the current view starts at
+     */
+    uint32_t getResidentMip(StreamingTextureHandle handle) const;
+
+    /**
+     * @brief Get the counters of the last update()
+     * @return Statistics
+     */
+    const TextureStreamerStats& getStats() const { return m_stats; }
+
+protected:
+    /**
+     * @brief Streaming state of one texture
+     */
+    struct Texture {
+        bool alive{false};                          ///< Slot is in use
+        uint32_t generation{0};                     ///< Bumped each time the slot is freed
+        StreamingTextureDesc desc;                  ///< Creation description
+        uint32_t mipLevels{0};                      ///< Levels of the image
+        VkImage image{VK_NULL_HANDLE};              ///< Image with the whole chain
+        VmaAllocation allocation{VK_NULL_HANDLE};   ///< Its allocation
+        VkImageView view{VK_NULL_HANDLE};           ///< View over the resident levels
+        uint32_t residentMip{0};                    ///< Finest uploaded level
+        uint32_t desiredMip{0};                     ///< Level the texture should reach
+        uint32_t requestedMip{UINT32_MAX};          ///< Smallest request of the current frame
+        uint32_t loadingMip{UINT32_MAX};            ///< Level being loaded (UINT32_MAX = none)
+        std::future<std::vector<uint8_t>> load;     ///< Result of the running load
+    };
+
+    /**
+     * @brief Orders textures competing for loads and the upload budget
+     * @param texture Texture with desiredMip < residentMip
+     * @return Larger values are served first (default: residentMip - desiredMip)
+     */
+    virtual float getPriority(const Texture& texture) const;
+
+    VulkanDevice* m_device;                ///< Pointer to VulkanDevice instance
+    VulkanContext* m_context;              ///< Pointer to VulkanContext instance
+    TextureStreamerConfig m_config;        ///< Budget and limits
+    ThreadPool* m_pool;                    ///< Pool running loads (optional)
+    std::vector<Texture> m_textures;       ///< Texture slots, indexed by handle
+    std::vector<StreamingTextureHandle> m_freeHandles; ///< Reusable slots
+
+private:
+    /**
+     * @brief Object destroyed once the frame that retired it has completed
+     */
+    struct Retired {
+        uint64_t frame{0};                         ///< update() count at retirement
+        VkImageView view{VK_NULL_HANDLE};          ///< View to destroy
+        VkImage image{VK_NULL_HANDLE};             ///< Image to destroy
+        VkBuffer buffer{VK_NULL_HANDLE};           ///< Staging buffer to destroy
+        VmaAllocation allocation{VK_NULL_HANDLE};  ///< Allocation of image or buffer
+    };
+
+    /**
+     * @brief Creates a view starting at a level
+     * @param texture Texture to create the view for
+     * @param baseMip First level of the view
+     * @return New view
+     * @throws std::runtime_error if view creation fails
+     */
+    VkImageView createView(const Texture& texture, uint32_t baseMip) const;
+
+    /**
+     * @brief Records the copy of one level and switches the texture to the new view
+     * @param commandBuffer Frame command buffer
+     * @param handle Texture handle
+     * @param level Level being made resident
+     * @param buffer Staging buffer holding the level
+     * @param offset Offset of the level in buffer
+     */
+    void recordLevelUpload(
+        VkCommandBuffer commandBuffer,
+        StreamingTextureHandle handle,
+        uint32_t level,
+        VkBuffer buffer,
+        VkDeviceSize offset);
+
+    /**
+     * @brief Destroys retired objects whose frames have completed
+     * @param all Destroy everything regardless of age
+     */
+    void collectRetired(bool all);
+
+    /**
+     * @brief Throws if a handle does not name a live texture
+     * @param handle Texture handle
+     * @return The texture
+     */
+    const Texture& getTexture(StreamingTextureHandle handle) const;
+
+    /**
+     * @brief Throws if a handle does not name a live texture
+     * @param handle Texture handle
+     * @return The texture
+     */
+    Texture& getTexture(StreamingTextureHandle handle);
+
+    std::unique_ptr<StagingRing> m_staging;            ///< Upload ring, one budget-sized slot per frame
+    std::shared_ptr<TextureStreamer*> m_self;          ///< Expires on destruction; feedback callbacks hold weak refs
+    std::vector<Retired> m_retired;                    ///< Objects awaiting destruction
+    uint64_t m_frameCount{0};                          ///< Number of update() calls
+    VkBuffer m_feedbackBuffer{VK_NULL_HANDLE};         ///< GPU feedback storage buffer
+    VmaAllocation m_feedbackAllocation{VK_NULL_HANDLE};///< Its allocation
+    ViewChangedCallback m_viewChanged;                 ///< View change notification
+    TextureStreamerStats m_stats;                      ///< Counters of the last update()
+};
+
+} // namespace ev
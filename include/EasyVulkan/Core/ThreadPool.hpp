@@ -0,0 +1,107 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Fixed-size worker pool for CPU-side asset work in EasyVulkan framework
+ * @details This file contains the ThreadPool class used to spread texture
+ *          compression, decoding and conversion across cores.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ev {
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads consuming a FIFO task queue
+ * @details ThreadPool provides:
+ *          - submit() returning a std::future for the task result
+ *          - parallelFor() splitting an index range into chunks across workers
+ *          - Orderly shutdown: queued tasks finish before the destructor returns
+ *
+ * Common usage patterns:
+ * @code
+ * ThreadPool pool;   // one worker per hardware thread
+ *
+ * auto pixels = pool.submit([&] { return decodePng(bytes); });
+ *
+ * pool.parallelFor(blockRows, [&](uint32_t begin, uint32_t end) {
+ *     for (uint32_t row = begin; row < end; ++row) {
+ *         encodeRow(row);
+ *     }
+ * });
+ * @endcode
+ *
+ * @note parallelFor() blocks until the range is done; do not call it from a
+ *       worker of the same pool.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Constructor for ThreadPool
+     * @param threadCount Number of workers (0 = std::thread::hardware_concurrency())
+     */
+    explicit ThreadPool(uint32_t threadCount = 0);
+
+    /**
+     * @brief Destructor, finishes queued tasks and joins the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task
+     * @param task Callable without arguments
+     * @return Future holding the task result or exception
+     */
+    template<typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        m_condition.notify_one();
+        return future;
+    }
+
+    /**
+     * @brief Runs body over [0, count) in chunks on the workers and waits
+     * @param count Number of indices
+     * @param body Called with a half-open sub-range [begin, end)
+     * @throws Rethrows the first exception raised by body
+     */
+    void parallelFor(uint32_t count, const std::function<void(uint32_t begin, uint32_t end)>& body);
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker count
+     */
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+private:
+    /**
+     * @brief Worker loop: pops and runs tasks until shutdown
+     */
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;         ///< Worker threads
+    std::queue<std::function<void()>> m_tasks;  ///< Pending tasks
+    std::mutex m_mutex;                         ///< Guards m_tasks and m_stopping
+    std::condition_variable m_condition;        ///< Signals new tasks or shutdown
+    bool m_stopping{false};                     ///< Set by the destructor
+};
+
+} // namespace ev
@@ -0,0 +1,161 @@
+/**
+ * @file UniformRing.hpp
+ * @brief Per-frame dynamic uniform ring for EasyVulkan framework
+ * @details This file contains the UniformRing class which sub-allocates per-draw
+ *          uniform data from one persistently mapped buffer and hands out the
+ *          dynamic offsets used with a single UNIFORM_BUFFER_DYNAMIC descriptor.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <type_traits>
+
+namespace ev {
+
+class VulkanDevice;
+
+/**
+ * @class UniformRing
+ * @brief N-buffered ring of uniform data addressed through dynamic offsets
+ * @details UniformRing provides:
+ *          - One persistently mapped buffer split into a slot per frame in flight
+ *          - push<T>() copying per-object data and returning its dynamic offset,
+ *            aligned to minUniformBufferOffsetAlignment
+ *          - A fixed descriptor range, so one descriptor set serves every push
+ *
+ * Per-object uniforms then cost one memcpy and one dynamic offset instead of a
+ * buffer and a descriptor set each. All slots live in the same VkBuffer, so the
+ * descriptor set never has to be rewritten when the frame index changes.
+ *
+ * Common usage patterns:
+ * @code
+ * UniformRing uniforms(device, MAX_FRAMES_IN_FLIGHT, 1024 * 1024, sizeof(ObjectUniforms));
+ *
+ * // Once: a dynamic uniform buffer descriptor covering one element
+ * auto objectSet = resourceManager->createDescriptorSet()
+ *     .addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_VERTEX_BIT)
+ *     .addBufferDescriptor(0, uniforms.getBuffer(), 0, uniforms.getRange(),
+ *                          VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+ *     .buildWithLayout("objectSet");
+ *
+ * // Every frame, after waiting on the frame's in-flight fence:
+ * uniforms.beginFrame(currentFrame);
+ * for (const auto& object : objects) {
+ *     uint32_t offset = uniforms.push(object.uniforms);
+ *     CommandUtils::bindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout,
+ *                                      1, {objectSet}, {offset});
+ *     vkCmdDrawIndexed(cmd, object.indexCount, 1, 0, 0, 0);
+ * }
+ * device->flushMappedRanges(); // no-op on HOST_COHERENT memory
+ * @endcode
+ *
+ * @note Inheritance:
+ *       - Override onSlotReset() to track per-frame uniform usage
+ */
+class UniformRing {
+public:
+    /**
+     * @brief Constructor for UniformRing
+     * @param device Pointer to VulkanDevice instance
+     * @param framesInFlight Number of ring slots (usually MAX_FRAMES_IN_FLIGHT)
+     * @param bytesPerFrame Capacity of each slot in bytes (rounded up to the alignment)
+     * @param range Descriptor range: the largest element pushed (rounded up to the alignment)
+     * @throws std::runtime_error if device is null, a size is 0, the aligned range
+     *         exceeds maxUniformBufferRange, the ring exceeds 4 GiB of 32-bit
+     *         dynamic offsets or allocation fails
+     */
+    UniformRing(VulkanDevice* device, uint32_t framesInFlight, VkDeviceSize bytesPerFrame, VkDeviceSize range);
+
+    /**
+     * @brief Virtual destructor
+     * @details Destroys the ring buffer; the GPU must no longer read it.
+     */
+    virtual ~UniformRing();
+
+    UniformRing(const UniformRing&) = delete;
+    UniformRing& operator=(const UniformRing&) = delete;
+
+    /**
+     * @brief Starts a new frame on the given slot
+     * @param frameIndex Frame-in-flight index (taken modulo the slot count)
+     * @details Call after waiting on the frame's in-flight fence; the slot's
+     *          previous contents are no longer read by the GPU and it is rewound.
+     */
+    void beginFrame(uint32_t frameIndex);
+
+    /**
+     * @brief Copies data into the current slot
+     * @param data Source bytes
+     * @param size Number of bytes (at most getRange())
+     * @return Dynamic offset of the data in getBuffer()
+     * @throws std::runtime_error if size exceeds the range or the slot is full
+     *
+     * On non-coherent memory the written range is queued on the device and
+     * flushed by the next VulkanDevice::flushMappedRanges() call.
+     */
+    uint32_t push(const void* data, VkDeviceSize size);
+
+    /**
+     * @brief Copies one object into the current slot
+     * @param value Uniform block contents
+     * @return Dynamic offset of the object in getBuffer()
+     */
+    template <typename T>
+    uint32_t push(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "uniform data must be trivially copyable");
+        return push(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Get the ring buffer
+     * @return Buffer to reference from the UNIFORM_BUFFER_DYNAMIC descriptor
+     */
+    VkBuffer getBuffer() const { return m_buffer; }
+
+    /**
+     * @brief Get the descriptor range
+     * @return Range to write into the descriptor (offset 0)
+     */
+    VkDeviceSize getRange() const { return m_range; }
+
+    /**
+     * @brief Get the alignment of the returned offsets
+     * @return minUniformBufferOffsetAlignment of the device
+     */
+    VkDeviceSize getAlignment() const { return m_alignment; }
+
+    /**
+     * @brief Get the number of ring slots
+     * @return Frames in flight the ring was created with
+     */
+    uint32_t getSlotCount() const { return m_slotCount; }
+
+    /**
+     * @brief Get the bytes still available in the current slot
+     * @return Remaining capacity of the current frame
+     */
+    VkDeviceSize getRemainingCapacity() const { return m_bytesPerFrame - m_cursor; }
+
+protected:
+    /**
+     * @brief Called when a slot is rewound by beginFrame()
+     * @param slot Slot about to be reused
+     * @param bytesUsed Bytes pushed during the previous frame
+     */
+    virtual void onSlotReset(uint32_t /*slot*/, VkDeviceSize /*bytesUsed*/) {}
+
+    VulkanDevice* m_device;                   ///< Pointer to VulkanDevice instance
+    VkBuffer m_buffer{VK_NULL_HANDLE};        ///< Ring buffer holding every slot
+    VmaAllocation m_allocation{VK_NULL_HANDLE}; ///< Its allocation
+    uint8_t* m_mappedData{nullptr};           ///< Persistent mapping
+    uint32_t m_slotCount;                     ///< Number of slots
+    VkDeviceSize m_alignment{256};            ///< minUniformBufferOffsetAlignment
+    VkDeviceSize m_bytesPerFrame;             ///< Capacity of each slot
+    VkDeviceSize m_range;                     ///< Descriptor range
+    uint32_t m_currentSlot{0};                ///< Slot receiving new pushes
+    VkDeviceSize m_cursor{0};                 ///< Next free byte within the current slot
+};
+
+} // namespace ev
@@ -8,7 +8,8 @@
 #pragma once
 
 #include "../Common.hpp"
- 
+
+#include <mutex>
 
 namespace ev {
 
@@ -88,6 +89,12 @@ public:
      */
     VkDevice getLogicalDevice() const { return m_device; }
 
+    /**
+     * @brief Get the core features enabled on the logical device
+     * @return VkPhysicalDeviceFeatures passed to vkCreateDevice
+     */
+    const VkPhysicalDeviceFeatures& getEnabledFeatures() const { return m_deviceFeatures; }
+
     /**
      * @brief Get the VMA allocator handle
      * @return VmaAllocator Memory allocator handle
@@ -108,6 +115,81 @@ public:
      */
     VkSurfaceKHR getSurface() const { return m_surface; }
 
+    /**
+     * @brief Check whether VK_EXT_memory_priority was enabled on the logical device
+     * @return true if allocation priorities are forwarded to the driver
+     */
+    bool isMemoryPriorityEnabled() const { return m_memoryPriorityEnabled; }
+
+    /**
+     * @brief Check whether the bufferDeviceAddress feature was enabled on the logical device
+     * @return true if buffers can be created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+     */
+    bool isBufferDeviceAddressEnabled() const { return m_bufferDeviceAddressEnabled; }
+
+    /**
+     * @brief Check whether vkCmdDrawIndirectCount/vkCmdDrawIndexedIndirectCount can be used
+     * @return true if VK_KHR_draw_indirect_count was enabled on a Vulkan 1.2+ device
+     */
+    bool isDrawIndirectCountEnabled() const { return m_drawIndirectCountEnabled; }
+
+    /**
+     * @brief Check whether VK_EXT_host_image_copy was enabled on the logical device
+     * @return true if images can be written from the host without a command buffer
+     */
+    bool isHostImageCopyEnabled() const { return m_hostImageCopyEnabled; }
+
+    /**
+     * @brief Check whether a host image copy can write an image in the given layout
+     * @param layout Destination layout of vkCopyMemoryToImageEXT
+     * @return true if the layout is in VkPhysicalDeviceHostImageCopyPropertiesEXT::pCopyDstLayouts
+     */
+    bool isHostImageCopyLayoutSupported(VkImageLayout layout) const;
+
+    /**
+     * @brief Check whether the selected physical device supports a device extension
+     * @param extensionName Extension name, e.g. VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME
+     * @return true if the extension is reported by vkEnumerateDeviceExtensionProperties
+     */
+    bool isDeviceExtensionSupported(const char* extensionName);
+
+    /**
+     * @brief Records a host write to a persistently mapped allocation for a later flush
+     * @param allocation VMA allocation that was written through its mapped pointer
+     * @param offset Offset of the written range, relative to the allocation
+     * @param size Size of the written range in bytes
+     * @details Ranges written to the same allocation are merged into one covering range.
+     *          Writes to HOST_COHERENT memory are ignored since they need no flush.
+     *          Meant for rings whose allocation lives as long as the device (UniformRing);
+     *          the generic upload helpers flush immediately instead. Thread-safe.
+     * @warning Only the raw handle is stored. Whoever frees the allocation must call
+     *          cancelMappedFlush() first (ResourceManager and ResourceUtils::destroyBuffer()
+     *          do), otherwise the next flushMappedRanges() touches freed memory.
+     */
+    void queueMappedFlush(VmaAllocation allocation, VkDeviceSize offset, VkDeviceSize size);
+
+    /**
+     * @brief Drops a pending flush, e.g. because the allocation is about to be destroyed
+     * @param allocation VMA allocation to forget
+     */
+    void cancelMappedFlush(VmaAllocation allocation);
+
+    /**
+     * @brief Flushes every queued range with a single vmaFlushAllocations call
+     * @throws std::runtime_error if the flush fails
+     * @details Call once per frame before submitting work that reads the written memory.
+     *          Single-time command helpers call it automatically before submitting.
+     * 
+     * Example:
+     * @code
+     * uint32_t offset = uniforms.push(ubo); // UniformRing queues the range
+     * // ... more pushes ...
+     * device->flushMappedRanges();
+     * vkQueueSubmit(queue, 1, &submitInfo, fence);
+     * @endcode
+     */
+    void flushMappedRanges();
+
 #if !defined(__OHOS__)
     /**
      * @brief Initializes the device by selecting physical device and creating logical device
@@ -255,9 +337,29 @@ private:
      */
     std::vector<const char*> getRequiredDeviceExtensions();
 
+    /**
+     * @brief Appends an extension to a list unless it is already present
+     * @param extensions Extension list passed to vkCreateDevice
+     * @param extensionName Extension to enable
+     */
+    static void enableExtension(std::vector<const char*>& extensions, const char* extensionName);
+
     // Device customization options
     VkPhysicalDeviceFeatures m_deviceFeatures{};
     std::vector<const char*> m_additionalExtensions;
+    std::set<std::string> m_supportedExtensions; ///< Cached device extension names
+    bool m_memoryPriorityEnabled{false};         ///< VK_EXT_memory_priority enabled
+    bool m_bufferDeviceAddressEnabled{false};    ///< bufferDeviceAddress feature enabled
+    bool m_drawIndirectCountEnabled{false};      ///< VK_KHR_draw_indirect_count enabled
+    bool m_hostImageCopyEnabled{false};          ///< VK_EXT_host_image_copy enabled
+    std::vector<VkImageLayout> m_hostImageCopyDstLayouts; ///< Layouts host copies may write
+
+    // Pending non-coherent flushes, one merged range per allocation
+    std::mutex m_pendingFlushMutex;                              ///< Guards the pending flush lists
+    std::unordered_map<VmaAllocation, size_t> m_pendingFlushIndex; ///< Allocation -> index in the lists below
+    std::vector<VmaAllocation> m_pendingFlushAllocations;        ///< Allocations to flush
+    std::vector<VkDeviceSize> m_pendingFlushOffsets;             ///< Range begin per allocation
+    std::vector<VkDeviceSize> m_pendingFlushSizes;               ///< Range size per allocation
 };
 
 } // namespace ev 
\ No newline at end of file
@@ -10,6 +10,9 @@
 #include "Common.hpp"
 #include <cmath>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace ev {
 
@@ -201,6 +204,361 @@ struct SimpleVertex {
 };
 
 
+/* -------------------------------------------------------------------------- */
+/*                           Compact vertex formats                           */
+/* -------------------------------------------------------------------------- */
+/**
+ * @struct Half4
+ * @brief Four IEEE 754 half floats (VK_FORMAT_R16G16B16A16_SFLOAT)
+ */
+struct Half4 {
+    uint16_t x, y, z, w;
+};
+
+/**
+ * @struct Snorm16x4
+ * @brief Four signed normalized 16-bit values (VK_FORMAT_R16G16B16A16_SNORM)
+ */
+struct Snorm16x4 {
+    int16_t x, y, z, w;
+};
+
+/**
+ * @struct Snorm16x2
+ * @brief Two signed normalized 16-bit values (VK_FORMAT_R16G16_SNORM)
+ * @details Holds octahedral-encoded unit normals in 32 bits.
+ */
+struct Snorm16x2 {
+    int16_t x, y;
+};
+
+/**
+ * @struct Unorm16x2
+ * @brief Two unsigned normalized 16-bit values (VK_FORMAT_R16G16_UNORM)
+ */
+struct Unorm16x2 {
+    uint16_t x, y;
+};
+
+/**
+ * @struct Unorm8x4
+ * @brief Four unsigned normalized 8-bit values (VK_FORMAT_R8G8B8A8_UNORM)
+ */
+struct Unorm8x4 {
+    uint8_t x, y, z, w;
+};
+
+/**
+ * @struct VertexFormat
+ * @brief Maps a vertex member type to its VkFormat
+ * @details Specialize it to use custom member types with VertexLayout.
+ */
+template<typename T>
+struct VertexFormat {
+    static_assert(sizeof(T) == 0, "no VertexFormat specialization for this member type");
+};
+
+template<> struct VertexFormat<float> { static constexpr VkFormat value = VK_FORMAT_R32_SFLOAT; };
+template<> struct VertexFormat<Vec2<float>> { static constexpr VkFormat value = VK_FORMAT_R32G32_SFLOAT; };
+template<> struct VertexFormat<Vec3<float>> { static constexpr VkFormat value = VK_FORMAT_R32G32B32_SFLOAT; };
+template<> struct VertexFormat<Vec4<float>> { static constexpr VkFormat value = VK_FORMAT_R32G32B32A32_SFLOAT; };
+template<> struct VertexFormat<int32_t> { static constexpr VkFormat value = VK_FORMAT_R32_SINT; };
+template<> struct VertexFormat<Vec2<int>> { static constexpr VkFormat value = VK_FORMAT_R32G32_SINT; };
+template<> struct VertexFormat<Vec3<int>> { static constexpr VkFormat value = VK_FORMAT_R32G32B32_SINT; };
+template<> struct VertexFormat<Vec4<int>> { static constexpr VkFormat value = VK_FORMAT_R32G32B32A32_SINT; };
+template<> struct VertexFormat<uint32_t> { static constexpr VkFormat value = VK_FORMAT_R32_UINT; };
+template<> struct VertexFormat<Vec2<unsigned int>> { static constexpr VkFormat value = VK_FORMAT_R32G32_UINT; };
+template<> struct VertexFormat<Vec3<unsigned int>> { static constexpr VkFormat value = VK_FORMAT_R32G32B32_UINT; };
+template<> struct VertexFormat<Vec4<unsigned int>> { static constexpr VkFormat value = VK_FORMAT_R32G32B32A32_UINT; };
+template<> struct VertexFormat<Half4> { static constexpr VkFormat value = VK_FORMAT_R16G16B16A16_SFLOAT; };
+template<> struct VertexFormat<Snorm16x4> { static constexpr VkFormat value = VK_FORMAT_R16G16B16A16_SNORM; };
+template<> struct VertexFormat<Snorm16x2> { static constexpr VkFormat value = VK_FORMAT_R16G16_SNORM; };
+template<> struct VertexFormat<Unorm16x2> { static constexpr VkFormat value = VK_FORMAT_R16G16_UNORM; };
+template<> struct VertexFormat<Unorm8x4> { static constexpr VkFormat value = VK_FORMAT_R8G8B8A8_UNORM; };
+
+/**
+ * @struct VertexLayout
+ * @brief Generates vertex input descriptions from a list of members
+ * @tparam V Vertex type (default constructible)
+ * @tparam Members Pointers to the members of V, in shader location order
+ * @details Formats come from VertexFormat of each member's type and locations
+ *          are assigned consecutively, so the struct definition is the only place
+ *          describing the layout.
+ *
+ * @code
+ * struct SkinnedVertex {
+ *     Vec3f position;
+ *     Snorm16x2 normal;
+ *     Unorm8x4 joints;
+ *     Unorm8x4 weights;
+ * };
+ * using SkinnedLayout = VertexLayout<SkinnedVertex, &SkinnedVertex::position, &SkinnedVertex::normal,
+ *                                    &SkinnedVertex::joints, &SkinnedVertex::weights>;
+ *
+ * auto binding = SkinnedLayout::getBindingDescription();
+ * auto attributes = SkinnedLayout::getAttributeDescriptions();
+ * @endcode
+ */
+template<typename V, auto... Members>
+struct VertexLayout {
+    static constexpr uint32_t attributeCount = sizeof...(Members); ///< One attribute per member
+
+    /**
+     * @brief Get the binding description of the layout
+     * @param binding Binding number
+     * @param inputRate Per-vertex or per-instance stepping
+     * @return Binding with stride sizeof(V)
+     */
+    static VkVertexInputBindingDescription getBindingDescription(
+        uint32_t binding = 0,
+        VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX) {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding = binding;
+        bindingDescription.stride = sizeof(V);
+        bindingDescription.inputRate = inputRate;
+        return bindingDescription;
+    }
+
+    /**
+     * @brief Get the attribute descriptions of the layout
+     * @param binding Binding the attributes read from
+     * @param firstLocation Shader location of the first member
+     * @return One description per member, at consecutive locations
+     */
+    static std::array<VkVertexInputAttributeDescription, sizeof...(Members)> getAttributeDescriptions(
+        uint32_t binding = 0,
+        uint32_t firstLocation = 0) {
+        std::array<VkVertexInputAttributeDescription, sizeof...(Members)> attributeDescriptions{};
+        uint32_t index = 0;
+        ((attributeDescriptions[index] = makeAttribute<Members>(binding, firstLocation + index), ++index), ...);
+        return attributeDescriptions;
+    }
+
+private:
+    template<typename T>
+    struct MemberType;
+
+    template<typename C, typename M>
+    struct MemberType<M C::*> {
+        using Class = C;
+        using Type = M;
+    };
+
+    template<auto Member>
+    static VkVertexInputAttributeDescription makeAttribute(uint32_t binding, uint32_t location) {
+        using Traits = MemberType<decltype(Member)>;
+        static_assert(std::is_base_of_v<typename Traits::Class, V>, "member does not belong to the vertex type");
+
+        // Offset measured on a real object, unlike offsetof it works with member pointers
+        const V vertex{};
+        const auto* base = reinterpret_cast<const unsigned char*>(&vertex);
+        const auto* member = reinterpret_cast<const unsigned char*>(&(vertex.*Member));
+
+        VkVertexInputAttributeDescription attribute{};
+        attribute.binding = binding;
+        attribute.location = location;
+        attribute.format = VertexFormat<typename Traits::Type>::value;
+        attribute.offset = static_cast<uint32_t>(member - base);
+        return attribute;
+    }
+};
+
+/**
+ * @struct CompactVertex
+ * @brief 20-byte vertex with half-float positions
+ * @details Positions are stored after per-mesh normalization (see
+ *          VertexQuantization::PositionQuantization) with w = 1; the vertex shader
+ *          rebuilds them as position.xyz * scale + offset. Normals are octahedral
+ *          encoded, texture coordinates are UNORM16 in [0, 1] and colors RGBA8.
+ *          Fill it with VertexQuantization::packVertices().
+ */
+struct CompactVertex {
+    Half4 position;     ///< Normalized position, w = 1
+    Snorm16x2 normal;   ///< Octahedral-encoded unit normal
+    Unorm16x2 texCoord; ///< Texture coordinates in [0, 1]
+    Unorm8x4 color;     ///< Vertex color (RGBA)
+
+    using Layout = VertexLayout<CompactVertex, &CompactVertex::position, &CompactVertex::normal,
+                                &CompactVertex::texCoord, &CompactVertex::color>;
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        return Layout::getBindingDescription();
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions() {
+        return Layout::getAttributeDescriptions();
+    }
+};
+
+/**
+ * @struct QuantizedVertex
+ * @brief 20-byte vertex with SNORM16 positions
+ * @details Same layout as CompactVertex, but positions are 16-bit signed
+ *          normalized values: uniform precision over the mesh bounds (1/32767 of
+ *          the half extent) instead of half-float precision that drops away from
+ *          the origin.
+ */
+struct QuantizedVertex {
+    Snorm16x4 position; ///< Normalized position, w = 1
+    Snorm16x2 normal;   ///< Octahedral-encoded unit normal
+    Unorm16x2 texCoord; ///< Texture coordinates in [0, 1]
+    Unorm8x4 color;     ///< Vertex color (RGBA)
+
+    using Layout = VertexLayout<QuantizedVertex, &QuantizedVertex::position, &QuantizedVertex::normal,
+                                &QuantizedVertex::texCoord, &QuantizedVertex::color>;
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        return Layout::getBindingDescription();
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions() {
+        return Layout::getAttributeDescriptions();
+    }
+};
+
+static_assert(sizeof(CompactVertex) == 20, "CompactVertex must stay tightly packed");
+static_assert(sizeof(QuantizedVertex) == 20, "QuantizedVertex must stay tightly packed");
+
+/**
+ * @struct SplitVertexLayout
+ * @brief Vertex input for positions and remaining attributes in separate buffers
+ * @tparam PositionLayout VertexLayout of the position stream (binding 0)
+ * @tparam AttributeLayout VertexLayout of the attribute stream (binding 1)
+ * @details Locations continue from the position stream into the attribute
+ *          stream, so shaders written for the interleaved vertex work unchanged.
+ *          Depth and shadow pipelines declare only the position stream and fetch
+ *          a fraction of the vertex data.
+ *
+ * @code
+ * auto attributes = SplitVertex::getAttributeDescriptions();
+ * auto depthAttributes = SplitVertex::getPositionAttributeDescriptions();
+ *
+ * auto opaque = resourceManager->createGraphicsPipeline()
+ *     .setVertexInputState(SplitVertex::getBindingDescriptions(), {attributes.begin(), attributes.end()})
+ *     ...
+ * auto depthOnly = resourceManager->createGraphicsPipeline()
+ *     .setVertexInputState(SplitVertex::getPositionBindingDescription(),
+ *                          {depthAttributes.begin(), depthAttributes.end()})
+ *     ...
+ *
+ * CommandUtils::bindVertexBuffers(cmd, 0, {positionBuffer, attributeBuffer}, {0, 0}); // opaque pass
+ * CommandUtils::bindVertexBuffers(cmd, 0, {positionBuffer}, {0});                   // depth pass
+ * @endcode
+ */
+template<typename PositionLayout, typename AttributeLayout>
+struct SplitVertexLayout {
+    static constexpr uint32_t positionBinding = 0;  ///< Binding of the position stream
+    static constexpr uint32_t attributeBinding = 1; ///< Binding of the attribute stream
+    static constexpr uint32_t attributeCount = PositionLayout::attributeCount + AttributeLayout::attributeCount; ///< Attributes of both streams
+
+    /**
+     * @brief Get the binding of the position stream alone
+     * @return Per-vertex binding 0
+     */
+    static VkVertexInputBindingDescription getPositionBindingDescription() {
+        return PositionLayout::getBindingDescription(positionBinding);
+    }
+
+    /**
+     * @brief Get the attributes of the position stream alone
+     * @return Position attributes from location 0
+     */
+    static std::array<VkVertexInputAttributeDescription, PositionLayout::attributeCount> getPositionAttributeDescriptions() {
+        return PositionLayout::getAttributeDescriptions(positionBinding, 0);
+    }
+
+    /**
+     * @brief Get the bindings of both streams
+     * @return Position binding 0 and attribute binding 1, both per vertex
+     */
+    static std::vector<VkVertexInputBindingDescription> getBindingDescriptions() {
+        return {PositionLayout::getBindingDescription(positionBinding),
+                AttributeLayout::getBindingDescription(attributeBinding)};
+    }
+
+    /**
+     * @brief Get the attributes of both streams
+     * @return Position attributes followed by the attribute stream at the next locations
+     */
+    static std::array<VkVertexInputAttributeDescription, attributeCount> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, attributeCount> attributeDescriptions{};
+        const auto positions = PositionLayout::getAttributeDescriptions(positionBinding, 0);
+        const auto attributes = AttributeLayout::getAttributeDescriptions(attributeBinding, PositionLayout::attributeCount);
+        std::copy(positions.begin(), positions.end(), attributeDescriptions.begin());
+        std::copy(attributes.begin(), attributes.end(), attributeDescriptions.begin() + positions.size());
+        return attributeDescriptions;
+    }
+};
+
+/**
+ * @struct VertexPosition
+ * @brief Position stream of a split Vertex (12 bytes)
+ */
+struct VertexPosition {
+    Vec3<float> position; ///< Vertex position in 3D space
+
+    using Layout = VertexLayout<VertexPosition, &VertexPosition::position>;
+};
+
+/**
+ * @struct VertexAttributes
+ * @brief Attribute stream of a split Vertex (36 bytes)
+ */
+struct VertexAttributes {
+    Vec3<float> normal;   ///< Vertex normal for lighting calculations
+    Vec2<float> texCoord; ///< Texture coordinates
+    Vec4<float> color;    ///< Vertex color (RGBA)
+
+    using Layout = VertexLayout<VertexAttributes, &VertexAttributes::normal,
+                                &VertexAttributes::texCoord, &VertexAttributes::color>;
+};
+
+/**
+ * @struct QuantizedPosition
+ * @brief Position stream of a split QuantizedVertex (8 bytes)
+ */
+struct QuantizedPosition {
+    Snorm16x4 position; ///< Normalized position, w = 1
+
+    using Layout = VertexLayout<QuantizedPosition, &QuantizedPosition::position>;
+};
+
+/**
+ * @struct CompactAttributes
+ * @brief Attribute stream of a split QuantizedVertex (12 bytes)
+ */
+struct CompactAttributes {
+    Snorm16x2 normal;   ///< Octahedral-encoded unit normal
+    Unorm16x2 texCoord; ///< Texture coordinates in [0, 1]
+    Unorm8x4 color;     ///< Vertex color (RGBA)
+
+    using Layout = VertexLayout<CompactAttributes, &CompactAttributes::normal,
+                                &CompactAttributes::texCoord, &CompactAttributes::color>;
+};
+
+/// Vertex split into a float position stream and an attribute stream (locations as Vertex)
+using SplitVertex = SplitVertexLayout<VertexPosition::Layout, VertexAttributes::Layout>;
+
+/// QuantizedVertex split into a SNORM16 position stream and an attribute stream
+using SplitQuantizedVertex = SplitVertexLayout<QuantizedPosition::Layout, CompactAttributes::Layout>;
+
+/**
+ * @brief Splits interleaved vertices into a position and an attribute stream
+ * @param src Source vertices
+ * @param count Number of vertices
+ * @param positions Destination position stream
+ * @param attributes Destination attribute stream
+ */
+inline void splitVertexStreams(const Vertex* src, size_t count, VertexPosition* positions, VertexAttributes* attributes) {
+    for (size_t i = 0; i < count; ++i) {
+        positions[i].position = src[i].position;
+        attributes[i].normal = src[i].normal;
+        attributes[i].texCoord = src[i].texCoord;
+        attributes[i].color = src[i].color;
+    }
+}
+
+
 /* -------------------------------------------------------------------------- */
 /*                              Other common data                             */
 /* -------------------------------------------------------------------------- */
@@ -220,6 +578,49 @@ struct PipelineInfo {
     VkPipelineLayout pipelineLayout; ///< Pipeline layout handle
 };
 
+/**
+ * @brief Memory accounting category of a tracked buffer or image
+ * @details Used by ResourceManager to attribute allocation bytes to subsystems.
+ *          Unspecified means "infer from the resource name or usage flags".
+ */
+enum class MemoryCategory : uint32_t {
+    Unspecified = 0, ///< No explicit tag, inferred at registration time
+    Textures,        ///< Sampled images
+    Meshes,          ///< Vertex/index/geometry buffers
+    RenderTargets,   ///< Color/depth attachments and storage images
+    Staging,         ///< Host-visible transfer source buffers
+    Uniforms,        ///< Uniform buffers
+    Other,           ///< Everything that matched no other category
+    Count            ///< Number of categories (not a valid tag)
+};
+
+/**
+ * @brief Returns a printable name for a memory category
+ * @param category Memory category
+ * @return Static string such as "textures" or "rt-targets"
+ */
+inline const char* memoryCategoryName(MemoryCategory category) {
+    switch (category) {
+        case MemoryCategory::Unspecified:   return "unspecified";
+        case MemoryCategory::Textures:      return "textures";
+        case MemoryCategory::Meshes:        return "meshes";
+        case MemoryCategory::RenderTargets: return "rt-targets";
+        case MemoryCategory::Staging:       return "staging";
+        case MemoryCategory::Uniforms:      return "uniforms";
+        case MemoryCategory::Other:         return "other";
+        default:                            return "invalid";
+    }
+}
+
+/**
+ * @brief Snapshot of the memory counters of one category
+ */
+struct MemoryCategoryStats {
+    VkDeviceSize liveBytes{0};      ///< Bytes currently allocated by live resources
+    VkDeviceSize highWaterBytes{0}; ///< Largest value liveBytes has reached
+    uint32_t allocationCount{0};    ///< Number of live allocations
+};
+
 /**
  * @brief Structure to image and its view
  */
@@ -230,6 +631,25 @@ struct ImageInfo {
     uint32_t width; ///< Width of the image
     uint32_t height; ///< Height of the image
     VkImageLayout layout; ///< Layout of the image
+    VkFormat format{VK_FORMAT_UNDEFINED}; ///< Format of the image
+    MemoryCategory category{MemoryCategory::Unspecified}; ///< Memory accounting category
+    VkDeviceSize allocationSize{0}; ///< Bytes accounted to the category
+};
+
+/**
+ * @brief One block of texels to copy into an image subresource range
+ * @details rowLength and imageHeight follow VkBufferImageCopy semantics and are
+ *          measured in texels; 0 means tightly packed. Cube faces count as layers.
+ */
+struct ImageUploadRegion {
+    const void* data{nullptr};  ///< Source texels (layerCount slices, each depth deep)
+    uint32_t mipLevel{0};       ///< Destination mip level
+    uint32_t baseArrayLayer{0}; ///< First destination array layer
+    uint32_t layerCount{1};     ///< Number of consecutive layers in data
+    VkOffset3D offset{0, 0, 0}; ///< Destination offset in texels
+    VkExtent3D extent{0, 0, 0}; ///< Extent of the region in texels
+    uint32_t rowLength{0};      ///< Source row pitch in texels (0 = extent.width)
+    uint32_t imageHeight{0};    ///< Source slice height in texels (0 = extent.height)
 };
 
 /**
@@ -240,6 +660,15 @@ struct BufferInfo {
     VmaAllocation allocation; ///< VMA allocation handle
     VkDeviceSize size; ///< Size of the buffer
     VkBufferUsageFlags usage; ///< Buffer usage flags
+    MemoryCategory category{MemoryCategory::Unspecified}; ///< Memory accounting category
+    VkDeviceSize allocationSize{0}; ///< Bytes accounted to the category
+    VkDeviceAddress deviceAddress{0}; ///< GPU address (0 without SHADER_DEVICE_ADDRESS usage)
+
+    /**
+     * @brief Get the 64-bit GPU address of the buffer
+     * @return Address to pass to shaders (e.g. through push constants), or 0
+     */
+    VkDeviceAddress getDeviceAddress() const { return deviceAddress; }
 };
 
 /**
@@ -0,0 +1,166 @@
+/**
+ * @file BlockCompression.hpp
+ * @brief CPU block-compression encoders for EasyVulkan framework
+ * @details This file contains BC1/BC4/BC5/BC7 encoders for textures generated
+ *          at runtime (lightmaps, decals, UI atlases), so they can be stored
+ *          compressed instead of as RGBA8.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+namespace ev {
+
+class ThreadPool;
+
+/**
+ * @enum BlockFormat
+ * @brief Block-compressed formats produced by the CPU encoder
+ */
+enum class BlockFormat {
+    BC1, ///< RGB, 4 bpp
+    BC4, ///< Single channel (red), 4 bpp
+    BC5, ///< Two channels (red, green), 8 bpp - normal maps
+    BC7  ///< RGBA, 8 bpp (mode 6: one subset, 4-bit indices)
+};
+
+/**
+ * @namespace BlockCompression
+ * @brief Namespace containing block-compression utilities
+ * @details Provides functionality for:
+ *          - Encoding single 4x4 blocks
+ *          - Encoding whole RGBA8 images, optionally across a ThreadPool
+ *          - Building RGBA8 mip levels for compressed uploads
+ *
+ * The per-block bounds and index projection use SSE2 on x86-64 and NEON on
+ * AArch64, with a scalar fallback elsewhere.
+ *
+ * Common usage patterns:
+ * @code
+ * ThreadPool pool;
+ * std::vector<uint8_t> bc7 = BlockCompression::compressImage(
+ *     lightmap.data(), width, height, BlockFormat::BC7, &pool);
+ *
+ * // Or let ImageBuilder compress during upload
+ * auto texture = resourceManager->createImage()
+ *     .setFormat(VK_FORMAT_R8G8B8A8_SRGB)
+ *     .setExtent(width, height)
+ *     .setFullMipChain()
+ *     .setUsage(VK_IMAGE_USAGE_SAMPLED_BIT)
+ *     .setBlockCompression(BlockFormat::BC7, &pool)
+ *     .buildAndInitialize(lightmap.data(), width * height * 4, "lightmap");
+ * @endcode
+ */
+namespace BlockCompression {
+
+/**
+ * @brief Vulkan format of a block format
+ * @param format Block format
+ * @param srgb Select the sRGB variant where one exists (BC1, BC7)
+ * @return Matching VkFormat
+ */
+VkFormat toVkFormat(BlockFormat format, bool srgb = false);
+
+/**
+ * @brief Size of one encoded block
+ * @param format Block format
+ * @return 8 for BC1/BC4, 16 for BC5/BC7
+ */
+uint32_t getBlockSize(BlockFormat format);
+
+/**
+ * @brief Size of an encoded image
+ * @param format Block format
+ * @param width Width in texels
+ * @param height Height in texels
+ * @return Bytes for ceil(width/4) x ceil(height/4) blocks
+ */
+VkDeviceSize getCompressedSize(BlockFormat format, uint32_t width, uint32_t height);
+
+/**
+ * @brief Encodes a 4x4 block as BC1 (opaque, four-color mode)
+ * @param rgba 16 RGBA8 texels, row-major
+ * @param out 8 output bytes
+ */
+void encodeBlockBC1(const uint8_t* rgba, uint8_t* out);
+
+/**
+ * @brief Encodes one channel of a 4x4 block as BC4
+ * @param rgba 16 RGBA8 texels, row-major
+ * @param channel Channel to encode (0 = red, 1 = green, ...)
+ * @param out 8 output bytes
+ */
+void encodeBlockBC4(const uint8_t* rgba, uint32_t channel, uint8_t* out);
+
+/**
+ * @brief Encodes red and green of a 4x4 block as BC5
+ * @param rgba 16 RGBA8 texels, row-major
+ * @param out 16 output bytes
+ */
+void encodeBlockBC5(const uint8_t* rgba, uint8_t* out);
+
+/**
+ * @brief Encodes a 4x4 block as BC7 mode 6
+ * @param rgba 16 RGBA8 texels, row-major
+ * @param out 16 output bytes
+ */
+void encodeBlockBC7(const uint8_t* rgba, uint8_t* out);
+
+/**
+ * @brief Encodes an RGBA8 image
+ * @param rgba Source texels, tightly packed rows
+ * @param width Width in texels
+ * @param height Height in texels
+ * @param format Block format
+ * @param out Destination of getCompressedSize() bytes
+ * @param pool Optional pool encoding block rows in parallel
+ *
+ * Edge blocks of non-multiple-of-4 images replicate the last row/column.
+ */
+void compressImage(
+    const uint8_t* rgba,
+    uint32_t width,
+    uint32_t height,
+    BlockFormat format,
+    uint8_t* out,
+    ThreadPool* pool = nullptr);
+
+/**
+ * @brief Encodes an RGBA8 image into a new vector
+ * @param rgba Source texels, tightly packed rows
+ * @param width Width in texels
+ * @param height Height in texels
+ * @param format Block format
+ * @param pool Optional pool encoding block rows in parallel
+ * @return Encoded blocks
+ */
+std::vector<uint8_t> compressImage(
+    const uint8_t* rgba,
+    uint32_t width,
+    uint32_t height,
+    BlockFormat format,
+    ThreadPool* pool = nullptr);
+
+/**
+ * @brief Halves an RGBA8 image with a 2x2 box filter
+ * @param rgba Source texels
+ * @param width Source width
+ * @param height Source height
+ * @param srgb Filter in linear space and re-encode as sRGB
+ * @param out Receives max(width/2,1) x max(height/2,1) texels
+ *
+ * Block-compressed formats cannot be blit or storage targets, so their mips are
+ * built on the CPU before encoding.
+ */
+void downsampleRGBA8(
+    const uint8_t* rgba,
+    uint32_t width,
+    uint32_t height,
+    bool srgb,
+    std::vector<uint8_t>& out);
+
+} // namespace BlockCompression
+} // namespace ev
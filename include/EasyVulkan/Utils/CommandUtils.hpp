@@ -278,6 +278,148 @@ void drawIndexed(
     int32_t vertexOffset,
     uint32_t firstInstance);
 
+/**
+ * @brief Records a non-indexed indirect draw
+ * @param commandBuffer The command buffer to record the command into
+ * @param buffer Buffer holding VkDrawIndirectCommand structures
+ * @param offset Byte offset of the first command (multiple of 4)
+ * @param drawCount Number of draws to execute
+ * @param stride Byte stride between commands (default: tightly packed)
+ * @throws std::runtime_error if command buffer validation fails
+ *
+ * @note drawCount above 1 needs the multiDrawIndirect feature.
+ */
+void drawIndirect(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    uint32_t drawCount,
+    uint32_t stride = sizeof(VkDrawIndirectCommand));
+
+/**
+ * @brief Records an indexed indirect draw
+ * @param commandBuffer The command buffer to record the command into
+ * @param buffer Buffer holding VkDrawIndexedIndirectCommand structures
+ * @param offset Byte offset of the first command (multiple of 4)
+ * @param drawCount Number of draws to execute
+ * @param stride Byte stride between commands (default: tightly packed)
+ * @throws std::runtime_error if command buffer validation fails
+ *
+ * Example:
+ * @code
+ * // Commands filled by the CPU or a compute pass
+ * CommandUtils::drawIndexedIndirect(cmdBuffer, indirectBuffer, 0, meshCount);
+ * @endcode
+ *
+ * @note drawCount above 1 needs the multiDrawIndirect feature.
+ */
+void drawIndexedIndirect(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    uint32_t drawCount,
+    uint32_t stride = sizeof(VkDrawIndexedIndirectCommand));
+
+/**
+ * @brief Records a non-indexed indirect draw whose count is read from a buffer
+ * @param commandBuffer The command buffer to record the command into
+ * @param buffer Buffer holding VkDrawIndirectCommand structures
+ * @param offset Byte offset of the first command
+ * @param countBuffer Buffer holding the draw count as a uint32_t
+ * @param countBufferOffset Byte offset of the count
+ * @param maxDrawCount Upper bound on the number of draws
+ * @param stride Byte stride between commands (default: tightly packed)
+ * @throws std::runtime_error if command buffer validation fails
+ *
+ * @note Requires the drawIndirectCount feature
+ *       (VulkanDevice::isDrawIndirectCountEnabled()).
+ */
+void drawIndirectCount(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkBuffer countBuffer,
+    VkDeviceSize countBufferOffset,
+    uint32_t maxDrawCount,
+    uint32_t stride = sizeof(VkDrawIndirectCommand));
+
+/**
+ * @brief Records an indexed indirect draw whose count is read from a buffer
+ * @param commandBuffer The command buffer to record the command into
+ * @param buffer Buffer holding VkDrawIndexedIndirectCommand structures
+ * @param offset Byte offset of the first command
+ * @param countBuffer Buffer holding the draw count as a uint32_t
+ * @param countBufferOffset Byte offset of the count
+ * @param maxDrawCount Upper bound on the number of draws
+ * @param stride Byte stride between commands (default: tightly packed)
+ * @throws std::runtime_error if command buffer validation fails
+ *
+ * Example:
+ * @code
+ * // Commands and count written by a culling compute pass
+ * CommandUtils::drawIndexedIndirectCount(
+ *     cmdBuffer,
+ *     drawCommands, 0,
+ *     drawCount, 0,
+ *     objectCount  // at most one draw per object
+ * );
+ * @endcode
+ *
+ * @note Requires the drawIndirectCount feature
+ *       (VulkanDevice::isDrawIndirectCountEnabled()).
+ */
+void drawIndexedIndirectCount(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkBuffer countBuffer,
+    VkDeviceSize countBufferOffset,
+    uint32_t maxDrawCount,
+    uint32_t stride = sizeof(VkDrawIndexedIndirectCommand));
+
+// Compute Commands
+/**
+ * @brief Records a compute dispatch
+ * @param commandBuffer The command buffer to record the command into
+ * @param groupCountX Number of workgroups in X
+ * @param groupCountY Number of workgroups in Y
+ * @param groupCountZ Number of workgroups in Z
+ * @throws std::runtime_error if command buffer validation fails
+ *
+ * Example:
+ * @code
+ * CommandUtils::bindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+ * CommandUtils::dispatch(cmdBuffer, CommandUtils::groupCount(elementCount, 64), 1, 1);
+ * @endcode
+ */
+void dispatch(
+    VkCommandBuffer commandBuffer,
+    uint32_t groupCountX,
+    uint32_t groupCountY = 1,
+    uint32_t groupCountZ = 1);
+
+/**
+ * @brief Records a compute dispatch whose group counts are read from a buffer
+ * @param commandBuffer The command buffer to record the command into
+ * @param buffer Buffer holding a VkDispatchIndirectCommand
+ * @param offset Byte offset of the command (multiple of 4)
+ * @throws std::runtime_error if command buffer validation fails
+ */
+void dispatchIndirect(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset = 0);
+
+/**
+ * @brief Number of workgroups covering a number of invocations
+ * @param invocationCount Total invocations needed
+ * @param groupSize Local size of the shader along the same axis
+ * @return ceil(invocationCount / groupSize)
+ */
+inline uint32_t groupCount(uint32_t invocationCount, uint32_t groupSize) {
+    return (invocationCount + groupSize - 1) / groupSize;
+}
+
 // Render Pass Commands
 /**
  * Begins a render pass instance.
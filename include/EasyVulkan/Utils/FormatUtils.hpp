@@ -0,0 +1,148 @@
+/**
+ * @file FormatUtils.hpp
+ * @brief Utility functions for Vulkan format properties in EasyVulkan framework
+ * @details This file contains utilities for reasoning about image formats:
+ *          - Texel block dimensions and sizes (uncompressed and block-compressed)
+ *          - Byte sizes of subresources and buffer rows
+ *          - sRGB / compression classification
+ *          - Device support queries
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vector>
+
+namespace ev {
+
+class VulkanDevice;
+
+/**
+ * @struct FormatInfo
+ * @brief Texel block layout of a format
+ * @details Uncompressed formats have a 1x1 block whose size is the texel size.
+ */
+struct FormatInfo {
+    uint32_t blockWidth{1};    ///< Block width in texels
+    uint32_t blockHeight{1};   ///< Block height in texels
+    uint32_t bytesPerBlock{0}; ///< Size of one block in bytes (0 for unknown formats)
+};
+
+/**
+ * @namespace FormatUtils
+ * @brief Namespace containing format inspection utilities
+ * @details Provides functionality for:
+ *          - Looking up texel block dimensions and sizes
+ *          - Computing block-aligned copy sizes
+ *          - Checking format support on a device
+ *
+ * Common usage patterns:
+ * @code
+ * // Size of mip level 3 of a BC7 texture
+ * VkDeviceSize size = FormatUtils::getImageSize(
+ *     VK_FORMAT_BC7_SRGB_BLOCK,
+ *     std::max(width >> 3, 1u),
+ *     std::max(height >> 3, 1u)
+ * );
+ *
+ * // Pick the first sampleable format from a preference list
+ * VkFormat format = FormatUtils::findSupportedFormat(
+ *     device,
+ *     {VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_R8G8B8A8_UNORM},
+ *     VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT
+ * );
+ * @endcode
+ */
+namespace FormatUtils {
+
+/**
+ * @brief Get the texel block layout of a format
+ * @param format Vulkan format
+ * @return Block dimensions and size; bytesPerBlock is 0 for unsupported formats
+ */
+FormatInfo getFormatInfo(VkFormat format);
+
+/**
+ * @brief Check whether a format is block-compressed (BC, ETC2/EAC or ASTC)
+ * @param format Vulkan format
+ * @return true if the block is larger than one texel
+ */
+bool isCompressed(VkFormat format);
+
+/**
+ * @brief Check whether a format stores sRGB-encoded color
+ * @param format Vulkan format
+ * @return true for *_SRGB formats
+ */
+bool isSrgb(VkFormat format);
+
+/**
+ * @brief Check whether a format has a depth and/or stencil aspect
+ * @param format Vulkan format
+ * @return true for depth/stencil formats
+ */
+bool isDepthStencil(VkFormat format);
+
+/**
+ * @brief Size in bytes of one row of blocks
+ * @param format Vulkan format
+ * @param width Width in texels
+ * @return ceil(width / blockWidth) * bytesPerBlock
+ */
+VkDeviceSize getRowPitch(VkFormat format, uint32_t width);
+
+/**
+ * @brief Size in bytes of a tightly packed image region
+ * @param format Vulkan format
+ * @param width Width in texels
+ * @param height Height in texels
+ * @param depth Depth in texels
+ * @return Size of all block rows of all slices
+ */
+VkDeviceSize getImageSize(VkFormat format, uint32_t width, uint32_t height, uint32_t depth = 1);
+
+/**
+ * @brief Bytes a VkBufferImageCopy-style region reads, from its first to its last texel
+ * @param format Vulkan format
+ * @param extent Extent of the copied region in texels
+ * @param rowLength Row pitch in texels (0 = extent.width)
+ * @param imageHeight Slice height in texels (0 = extent.height)
+ * @param layerCount Number of consecutive array layers
+ * @return Footprint of the region; the padding after its last row is not included
+ * @details With rowLength > width or imageHeight > height the source is padded, but
+ *          the last row of the last slice only holds width texels. Sizing a copy
+ *          as getImageSize(rowLength, imageHeight) would read past its end.
+ */
+VkDeviceSize getCopyFootprint(VkFormat format, const VkExtent3D& extent, uint32_t rowLength,
+                              uint32_t imageHeight, uint32_t layerCount = 1);
+
+/**
+ * @brief Required alignment of VkBufferImageCopy::bufferOffset for a format
+ * @param format Vulkan format
+ * @return Least common multiple of the block size and 4
+ */
+VkDeviceSize getCopyOffsetAlignment(VkFormat format);
+
+/**
+ * @brief Check whether the device supports a format with the given optimal-tiling features
+ * @param device Pointer to VulkanDevice instance
+ * @param format Vulkan format
+ * @param features Required VkFormatFeatureFlags
+ * @return true if all features are supported
+ */
+bool isFormatSupported(VulkanDevice* device, VkFormat format, VkFormatFeatureFlags features);
+
+/**
+ * @brief Returns the first candidate supporting the given optimal-tiling features
+ * @param device Pointer to VulkanDevice instance
+ * @param candidates Formats in order of preference
+ * @param features Required VkFormatFeatureFlags
+ * @return Supported format, or VK_FORMAT_UNDEFINED if none qualifies
+ */
+VkFormat findSupportedFormat(
+    VulkanDevice* device,
+    const std::vector<VkFormat>& candidates,
+    VkFormatFeatureFlags features);
+
+} // namespace FormatUtils
+} // namespace ev
@@ -4,6 +4,7 @@
  * @details This file contains utilities for managing Vulkan memory, including:
  *          - Memory type selection
  *          - Memory mapping and data transfer
+ *          - Persistent mapping and non-coherent flush/invalidate handling
  *          - Memory requirements querying
  *          - VMA (Vulkan Memory Allocator) integration
  */
@@ -11,6 +12,7 @@
 #pragma once
 
 #include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
 #include <vector>
 
 namespace ev {
@@ -96,12 +98,38 @@ uint32_t findMemoryType(
     uint32_t typeFilter,
     VkMemoryPropertyFlags properties);
 
+/**
+ * @brief Returns the persistent mapping of an allocation
+ * @param device Pointer to VulkanDevice instance
+ * @param allocation VMA allocation handle
+ * @return Mapped pointer, or nullptr if the allocation was not created with
+ *         VMA_ALLOCATION_CREATE_MAPPED_BIT (or is not host visible)
+ */
+void* getMappedData(
+    VulkanDevice* device,
+    VmaAllocation allocation);
+
+/**
+ * @brief Checks whether an allocation landed in host-visible memory
+ * @param device Pointer to VulkanDevice instance
+ * @param allocation VMA allocation handle
+ * @return true if the allocation's memory type is HOST_VISIBLE
+ * 
+ * Use it after creating an allocation with
+ * VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT to decide between
+ * writing directly and going through a staging buffer.
+ */
+bool isHostVisible(
+    VulkanDevice* device,
+    VmaAllocation allocation);
+
 /**
  * @brief Maps memory and copies data to it
  * @param device Pointer to VulkanDevice instance
  * @param allocation VMA allocation handle
  * @param data Pointer to source data
  * @param size Size of data in bytes
+ * @param offset Offset in bytes from the start of the allocation
  * @throws std::runtime_error if:
  *         - Memory mapping fails
  *         - Data pointer is null
@@ -128,12 +156,17 @@ uint32_t findMemoryType(
  *     sizeof(UniformBufferObject)
  * );
  * @endcode
+ * 
+ * @note Persistently mapped allocations are written through the cached pointer;
+ *       unmapped allocations fall back to map, copy, unmap. Either way the range
+ *       is flushed before returning (a no-op on HOST_COHERENT memory).
  */
 void mapAndCopyData(
     VulkanDevice* device,
     VmaAllocation allocation,
     const void* data,
-    VkDeviceSize size);
+    VkDeviceSize size,
+    VkDeviceSize offset = 0);
 
 /**
  * @brief Maps memory and retrieves data from it
@@ -141,6 +174,7 @@ void mapAndCopyData(
  * @param allocation VMA allocation handle
  * @param data Pointer to destination buffer
  * @param size Size of data in bytes
+ * @param offset Offset in bytes from the start of the allocation
  * @throws std::runtime_error if:
  *         - Memory mapping fails
  *         - Data pointer is null
@@ -167,12 +201,16 @@ void mapAndCopyData(
  *     results.size() * sizeof(float)
  * );
  * @endcode
+ * 
+ * @note The range is invalidated before reading, so host-cached (non-coherent)
+ *       readback memory returns what the GPU wrote.
  */
 void mapAndRetrieveData(
     VulkanDevice* device,
     VmaAllocation allocation,
     void* data,
-    VkDeviceSize size);
+    VkDeviceSize size,
+    VkDeviceSize offset = 0);
 
 /**
  * @brief Gets memory requirements for a buffer
@@ -0,0 +1,175 @@
+/**
+ * @file PixelConversion.hpp
+ * @brief Pixel-format conversion kernels for EasyVulkan framework
+ * @details This file contains the conversions applied to image data on its way
+ *          into staging memory: RGB8 expansion, BGRA/RGBA swizzles, float32 to
+ *          float16, linear/sRGB encoding and alpha premultiplication.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace ev {
+
+/**
+ * @enum SourcePixelFormat
+ * @brief Layouts of CPU-side pixel data accepted by the converter
+ */
+enum class SourcePixelFormat {
+    RGBA8,   ///< 4 x uint8, red first
+    BGRA8,   ///< 4 x uint8, blue first (Windows DIBs, many video decoders)
+    RGB8,    ///< 3 x uint8, no alpha
+    RGBA16F, ///< 4 x half float
+    RGBA32F  ///< 4 x float, linear
+};
+
+/**
+ * @namespace PixelConversion
+ * @brief Namespace containing pixel-format conversion utilities
+ * @details Provides functionality for:
+ *          - Single-purpose kernels working on tightly packed pixel runs
+ *          - A dispatcher converting a SourcePixelFormat into a VkFormat
+ *
+ * The kernels use SSE2 on x86-64 (SSSE3, F16C and AVX2 paths when the compiler
+ * targets them, e.g. with -DEV_SIMD_ARCH=AVX2) and NEON on AArch64, with a
+ * scalar fallback elsewhere. Every
+ * kernel writes its destination front to back and never reads it, so the
+ * destination may be write-combined staging memory. Unless noted otherwise,
+ * source and destination must not overlap.
+ *
+ * Common usage patterns:
+ * @code
+ * // Convert straight into a mapped staging buffer
+ * PixelConversion::convert(rgbPixels, SourcePixelFormat::RGB8,
+ *                          mappedStaging, VK_FORMAT_R8G8B8A8_SRGB, width * height);
+ *
+ * // Or let ImageBuilder convert during upload
+ * auto texture = resourceManager->createImage()
+ *     .setFormat(VK_FORMAT_R16G16B16A16_SFLOAT)
+ *     .setExtent(width, height)
+ *     .setUsage(VK_IMAGE_USAGE_SAMPLED_BIT)
+ *     .setSourcePixelFormat(SourcePixelFormat::RGBA32F)
+ *     .buildAndInitialize(floatPixels.data(), floatPixels.size() * sizeof(float), "sky");
+ * @endcode
+ */
+namespace PixelConversion {
+
+/**
+ * @brief Size of one source pixel
+ * @param format Source layout
+ * @return Bytes per pixel
+ */
+uint32_t getPixelSize(SourcePixelFormat format);
+
+/**
+ * @brief Checks whether convert() handles a pair of formats
+ * @param source Source layout
+ * @param destination Destination format
+ * @param premultiplyAlpha Whether alpha premultiplication is requested
+ * @return true if the conversion is available
+ *
+ * Supported destinations:
+ * - RGBA8 / BGRA8 / RGB8: R8G8B8A8 and B8G8R8A8, UNORM or SRGB; R32G32B32A32_SFLOAT
+ *   and R16G16B16A16_SFLOAT (the source is decoded from sRGB to linear)
+ * - RGBA32F: R32G32B32A32_SFLOAT, R16G16B16A16_SFLOAT, R8G8B8A8 and B8G8R8A8
+ *   (SRGB formats are encoded with the sRGB curve)
+ * - RGBA16F: R16G16B16A16_SFLOAT, without premultiplication
+ */
+bool isSupported(SourcePixelFormat source, VkFormat destination, bool premultiplyAlpha = false);
+
+/**
+ * @brief Converts a run of pixels
+ * @param src Source pixels
+ * @param srcFormat Source layout
+ * @param dst Destination, pixelCount texels of dstFormat
+ * @param dstFormat Destination format
+ * @param pixelCount Number of pixels
+ * @param premultiplyAlpha Multiply color by alpha (in the stored encoding)
+ * @throws std::runtime_error if the conversion is not supported
+ *
+ * Conversions needing several kernels run them over small chunks that stay in
+ * the L1 cache, so no intermediate image is allocated.
+ */
+void convert(
+    const void* src,
+    SourcePixelFormat srcFormat,
+    void* dst,
+    VkFormat dstFormat,
+    size_t pixelCount,
+    bool premultiplyAlpha = false);
+
+/**
+ * @brief Expands RGB8 to RGBA8 with opaque alpha
+ * @param src pixelCount * 3 bytes
+ * @param dst pixelCount * 4 bytes
+ * @param pixelCount Number of pixels
+ */
+void rgb8ToRgba8(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+
+/**
+ * @brief Swaps the red and blue channels of 4-byte pixels (RGBA <-> BGRA)
+ * @param src Source pixels
+ * @param dst Destination pixels (may equal src)
+ * @param pixelCount Number of pixels
+ */
+void swizzleRedBlue8(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+
+/**
+ * @brief Multiplies the color channels of RGBA8/BGRA8 pixels by alpha
+ * @param src Source pixels
+ * @param dst Destination pixels (may equal src)
+ * @param pixelCount Number of pixels
+ *
+ * Results are rounded exactly: round(c * a / 255).
+ */
+void premultiplyAlpha8(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+
+/**
+ * @brief Converts floats to half floats with round-to-nearest-even
+ * @param src Source values
+ * @param dst Destination values
+ * @param count Number of values (not pixels)
+ *
+ * Values beyond the half range become infinity; NaN stays NaN.
+ */
+void float32ToFloat16(const float* src, uint16_t* dst, size_t count);
+
+/**
+ * @brief Converts one float to a half float
+ * @param value Value to convert
+ * @return IEEE 754 binary16 bits
+ */
+uint16_t float32ToFloat16(float value);
+
+/**
+ * @brief Converts floats in [0, 1] to 8-bit UNORM
+ * @param src Source values, clamped to [0, 1]
+ * @param dst Destination values
+ * @param count Number of values (not pixels)
+ */
+void floatToUnorm8(const float* src, uint8_t* dst, size_t count);
+
+/**
+ * @brief Encodes linear RGBA floats as sRGB RGBA8
+ * @param src pixelCount * 4 floats
+ * @param dst pixelCount * 4 bytes
+ * @param pixelCount Number of pixels
+ *
+ * Color goes through a 16K-entry table of the sRGB curve (within one code of
+ * the exact result); alpha is stored linearly.
+ */
+void linearToSrgb8(const float* src, uint8_t* dst, size_t pixelCount);
+
+/**
+ * @brief Decodes sRGB RGBA8 into linear RGBA floats
+ * @param src pixelCount * 4 bytes
+ * @param dst pixelCount * 4 floats
+ * @param pixelCount Number of pixels
+ */
+void srgb8ToLinear(const uint8_t* src, float* dst, size_t pixelCount);
+
+} // namespace PixelConversion
+} // namespace ev
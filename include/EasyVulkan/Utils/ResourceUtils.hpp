@@ -130,6 +130,23 @@ VkBuffer createBuffer(
     VkMemoryPropertyFlags properties,
     VmaAllocation* outAllocation = nullptr);
 
+/**
+ * @brief Destroys a buffer and drops any flush still queued for its allocation
+ * @param device Pointer to VulkanDevice instance
+ * @param buffer Buffer to destroy (may be VK_NULL_HANDLE)
+ * @param allocation VMA allocation of the buffer (may be VK_NULL_HANDLE)
+ * 
+ * Allocations written through VulkanDevice::queueMappedFlush() may still have a
+ * range pending for VulkanDevice::flushMappedRanges(). Destroying them with this
+ * function (or calling VulkanDevice::cancelMappedFlush() before vmaDestroyBuffer)
+ * ensures the next flush never touches a freed allocation. Buffers owned by
+ * ResourceManager are handled by ResourceManager itself.
+ */
+void destroyBuffer(
+    VulkanDevice* device,
+    VkBuffer buffer,
+    VmaAllocation allocation);
+
 /**
  * @brief Creates an image with automatic memory allocation
  * @param device Pointer to VulkanDevice instance
@@ -329,6 +346,46 @@ void uploadDataToImage(
     uint32_t width, 
     uint32_t height);
 
+/**
+ * @brief Uploads any number of subresource regions in a single submission
+ * @param device Pointer to VulkanDevice instance
+ * @param commandPool Command pool for the transfer command buffer
+ * @param image Destination image
+ * @param format Image format, used for block-aligned size and offset math
+ * @param regions Regions to copy (any mip level / layer, compressed or not)
+ * @param oldLayout Current layout of the whole image
+ * @param newLayout Layout the whole image is left in
+ * @throws std::runtime_error if the list is empty, a region has no data or the
+ *         format is unknown
+ * 
+ * All regions are packed into one staging buffer at block-aligned offsets and
+ * copied with one vkCmdCopyBufferToImage. Each region's source footprint is
+ * rowLength x imageHeight x depth texels per layer, rounded up to whole blocks.
+ * 
+ * Example:
+ * @code
+ * // Upload a prebuilt BC7 mip chain
+ * std::vector<ImageUploadRegion> regions;
+ * for (uint32_t level = 0; level < levelCount; ++level) {
+ *     ImageUploadRegion region;
+ *     region.data = mips[level].data();
+ *     region.mipLevel = level;
+ *     region.extent = {std::max(width >> level, 1u), std::max(height >> level, 1u), 1};
+ *     regions.push_back(region);
+ * }
+ * uploadImageRegions(device, commandPool, image, VK_FORMAT_BC7_SRGB_BLOCK, regions,
+ *     VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+ * @endcode
+ */
+void uploadImageRegions(
+    VulkanDevice* device,
+    VkCommandPool commandPool,
+    VkImage image,
+    VkFormat format,
+    const std::vector<ImageUploadRegion>& regions,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout);
+
 /**
  * @brief Uploads data to a buffer at a specific offset
  * @param buffer Buffer to upload to
@@ -338,6 +395,9 @@ void uploadDataToImage(
  * @param dataSize Size of data in bytes
  * @param offset Offset in bytes from the start of the buffer
  * 
+ * Persistently mapped allocations are written through their cached pointer; others
+ * are mapped and unmapped on the spot. The range is flushed before returning.
+ * 
  * Example:
  * @code
  * // Upload vertex data to a buffer
@@ -360,6 +420,40 @@ void uploadDataToBuffer(
     VkDeviceSize dataSize,
     VkDeviceSize offset); 
 
+/**
+ * @brief Uploads data to a buffer, writing directly when its memory is host visible
+ * @param device Pointer to VulkanDevice instance
+ * @param commandPool Command pool to allocate the temporary copy command buffer from
+ * @param buffer Destination buffer (needs VK_BUFFER_USAGE_TRANSFER_DST_BIT for the staging path)
+ * @param allocation VMA allocation of the destination buffer
+ * @param data Pointer to data
+ * @param dataSize Size of data in bytes
+ * @param offset Offset in bytes from the start of the buffer
+ * @return true if the data was written directly, false if a staging copy was used
+ * @throws std::runtime_error if the staging buffer or copy submission fails
+ * 
+ * On UMA devices and resizable-BAR systems buffers created with
+ * VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT usually land in
+ * DEVICE_LOCAL | HOST_VISIBLE memory; the data is then copied through the mapped
+ * pointer and flushed before returning, saving the staging buffer, the copy and
+ * the queue submit. Otherwise a temporary staging buffer and vkCmdCopyBuffer are used.
+ * 
+ * Example:
+ * @code
+ * bool direct = uploadDataToDeviceBuffer(
+ *     device, pool, vertexBuffer, vertexAllocation,
+ *     vertices.data(), vertices.size() * sizeof(Vertex));
+ * @endcode
+ */
+bool uploadDataToDeviceBuffer(
+    VulkanDevice* device,
+    VkCommandPool commandPool,
+    VkBuffer buffer,
+    VmaAllocation allocation,
+    const void* data,
+    VkDeviceSize dataSize,
+    VkDeviceSize offset = 0);
+
 /**
  * @brief Uploads data to a buffer(Mapped) at a specific offset
  * @param buffer Buffer to upload to
@@ -368,6 +462,11 @@ void uploadDataToBuffer(
  * @param data Pointer to data
  * @param dataSize Size of data in bytes
  * @param offset Offset in bytes from the start of the buffer
+ * @throws std::runtime_error if the allocation is not persistently mapped
+ * 
+ * @note The written range is flushed before returning (a no-op on HOST_COHERENT
+ *       memory). Per-frame uniform data is better pushed through a UniformRing,
+ *       whose writes are batched into VulkanDevice::flushMappedRanges().
  */
 void uploadDataToMappedBuffer(
     VkBuffer buffer,
@@ -377,6 +476,22 @@ void uploadDataToMappedBuffer(
     VkDeviceSize dataSize,
     VkDeviceSize offset);
 
+/**
+ * @brief Gets the GPU address of a buffer
+ * @param device Pointer to VulkanDevice instance
+ * @param buffer Buffer created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+ * @return 64-bit address shaders can dereference (GL_EXT_buffer_reference)
+ * @throws std::runtime_error if the bufferDeviceAddress feature is not enabled
+ * 
+ * Example:
+ * @code
+ * struct PushConstants { VkDeviceAddress instances; uint32_t count; };
+ * PushConstants push{ResourceUtils::getBufferDeviceAddress(device, instanceBuffer), instanceCount};
+ * vkCmdPushConstants(cmd, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+ * @endcode
+ */
+VkDeviceAddress getBufferDeviceAddress(VulkanDevice* device, VkBuffer buffer);
+
 
 /**
  * @brief Transitions an image's layout using a temporary command buffer
@@ -490,6 +605,25 @@ void transitionImageLayoutWithInfo(
     ImageInfo &imageInfo,
     VkImageLayout newLayout);
 
+/**
+ * @brief Pipeline stages and access types that use an image in a given layout
+ * @param layout Image layout
+ * @param outStage Receives the stages that access the image in this layout
+ * @param outAccess Receives the access types used in this layout
+ *
+ * Used to fill the source or destination half of a barrier when the other half
+ * is known, e.g. when releasing a freshly uploaded image to its final layout:
+ * @code
+ * VkPipelineStageFlags dstStage;
+ * VkAccessFlags dstAccess;
+ * ResourceUtils::getLayoutStageAndAccess(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, dstStage, dstAccess);
+ * @endcode
+ */
+void getLayoutStageAndAccess(
+    VkImageLayout layout,
+    VkPipelineStageFlags& outStage,
+    VkAccessFlags& outAccess);
+
 
 
 } // namespace ResourceUtils
@@ -0,0 +1,571 @@
+/**
+ * @file SimdMath.hpp
+ * @brief SIMD vector, matrix and quaternion types for EasyVulkan framework
+ * @details This file contains the aligned Vec4a, Mat4f and Quatf types used for
+ *          CPU-side transforms, plus batched transforms over structure-of-arrays
+ *          data. They complement the scalar Vec2/Vec3/Vec4 templates, which stay
+ *          the storage types of vertex and uniform layouts.
+ */
+
+#pragma once
+
+#include "../DataStructures.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EV_SIMD_SSE2 1
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#define EV_SIMD_SSE41 1
+#endif
+#if defined(__FMA__)
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define EV_SIMD_NEON 1
+#endif
+
+namespace ev {
+
+struct Quatf;
+
+/**
+ * @struct Vec4a
+ * @brief 16-byte aligned four-float vector held in a SIMD register
+ * @details Uses SSE2 (SSE4.1 where available) on x86-64, NEON on AArch64 and
+ *          four floats elsewhere. Converts to and from Vec3f/Vec4f, so the scalar
+ *          types remain the interface of vertex and uniform data while the math
+ *          runs in registers.
+ */
+struct alignas(16) Vec4a {
+#if defined(EV_SIMD_SSE2)
+    using Native = __m128;
+#elif defined(EV_SIMD_NEON)
+    using Native = float32x4_t;
+#else
+    struct Native { float lanes[4]; };
+#endif
+
+    Native v; ///< Register contents: x, y, z, w
+
+    Vec4a() : Vec4a(0.0f, 0.0f, 0.0f, 0.0f) {}
+
+    explicit Vec4a(Native native) : v(native) {}
+
+    Vec4a(float x, float y, float z, float w) {
+#if defined(EV_SIMD_SSE2)
+        v = _mm_setr_ps(x, y, z, w);
+#elif defined(EV_SIMD_NEON)
+        const float lanes[4] = {x, y, z, w};
+        v = vld1q_f32(lanes);
+#else
+        v = Native{{x, y, z, w}};
+#endif
+    }
+
+    Vec4a(const Vec4<float>& value) : Vec4a(value.x, value.y, value.z, value.w) {}
+    Vec4a(const Vec3<float>& value, float w) : Vec4a(value.x, value.y, value.z, w) {}
+
+    /**
+     * @brief Broadcasts a scalar to every lane
+     * @param value Lane value
+     * @return (value, value, value, value)
+     */
+    static Vec4a splat(float value) {
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_set1_ps(value));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vdupq_n_f32(value));
+#else
+        return Vec4a(value, value, value, value);
+#endif
+    }
+
+    /**
+     * @brief Loads four floats (no alignment requirement)
+     * @param source Four floats
+     * @return Loaded vector
+     */
+    static Vec4a load(const float* source) {
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_loadu_ps(source));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vld1q_f32(source));
+#else
+        return Vec4a(source[0], source[1], source[2], source[3]);
+#endif
+    }
+
+    /**
+     * @brief Stores four floats (no alignment requirement)
+     * @param destination Four floats
+     */
+    void store(float* destination) const {
+#if defined(EV_SIMD_SSE2)
+        _mm_storeu_ps(destination, v);
+#elif defined(EV_SIMD_NEON)
+        vst1q_f32(destination, v);
+#else
+        for (int i = 0; i < 4; ++i) destination[i] = v.lanes[i];
+#endif
+    }
+
+    /**
+     * @brief Broadcasts one lane to every lane
+     * @tparam Lane Lane index (0-3)
+     */
+    template<int Lane>
+    Vec4a splatLane() const {
+        static_assert(Lane >= 0 && Lane < 4, "lane index out of range");
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vdupq_laneq_f32(v, Lane));
+#else
+        return splat(v.lanes[Lane]);
+#endif
+    }
+
+    /**
+     * @brief Reads one lane
+     * @tparam Lane Lane index (0-3)
+     */
+    template<int Lane>
+    float lane() const {
+        static_assert(Lane >= 0 && Lane < 4, "lane index out of range");
+#if defined(EV_SIMD_SSE2)
+        return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)));
+#elif defined(EV_SIMD_NEON)
+        return vgetq_lane_f32(v, Lane);
+#else
+        return v.lanes[Lane];
+#endif
+    }
+
+    float x() const { return lane<0>(); } ///< First lane
+    float y() const { return lane<1>(); } ///< Second lane
+    float z() const { return lane<2>(); } ///< Third lane
+    float w() const { return lane<3>(); } ///< Fourth lane
+
+    /**
+     * @brief Replaces the w lane
+     * @param value New w
+     * @return (x, y, z, value)
+     */
+    Vec4a withW(float value) const {
+#if defined(EV_SIMD_SSE41)
+        return Vec4a(_mm_blend_ps(v, _mm_set1_ps(value), 0x8));
+#elif defined(EV_SIMD_SSE2)
+        // (z, value, w, value) supplies the upper half of (x, y, z, value)
+        const __m128 zw = _mm_unpackhi_ps(v, _mm_set1_ps(value));
+        return Vec4a(_mm_shuffle_ps(v, zw, _MM_SHUFFLE(1, 0, 1, 0)));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vsetq_lane_f32(value, v, 3));
+#else
+        Vec4a result = *this;
+        result.v.lanes[3] = value;
+        return result;
+#endif
+    }
+
+    Vec4<float> toVec4f() const {
+        alignas(16) float lanes[4];
+        store(lanes);
+        return Vec4<float>(lanes[0], lanes[1], lanes[2], lanes[3]);
+    }
+
+    Vec3<float> toVec3f() const {
+        alignas(16) float lanes[4];
+        store(lanes);
+        return Vec3<float>(lanes[0], lanes[1], lanes[2]);
+    }
+
+    Vec4a operator+(const Vec4a& other) const {
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_add_ps(v, other.v));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vaddq_f32(v, other.v));
+#else
+        return Vec4a(v.lanes[0] + other.v.lanes[0], v.lanes[1] + other.v.lanes[1],
+                     v.lanes[2] + other.v.lanes[2], v.lanes[3] + other.v.lanes[3]);
+#endif
+    }
+
+    Vec4a operator-(const Vec4a& other) const {
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_sub_ps(v, other.v));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vsubq_f32(v, other.v));
+#else
+        return Vec4a(v.lanes[0] - other.v.lanes[0], v.lanes[1] - other.v.lanes[1],
+                     v.lanes[2] - other.v.lanes[2], v.lanes[3] - other.v.lanes[3]);
+#endif
+    }
+
+    Vec4a operator*(const Vec4a& other) const {
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_mul_ps(v, other.v));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vmulq_f32(v, other.v));
+#else
+        return Vec4a(v.lanes[0] * other.v.lanes[0], v.lanes[1] * other.v.lanes[1],
+                     v.lanes[2] * other.v.lanes[2], v.lanes[3] * other.v.lanes[3]);
+#endif
+    }
+
+    Vec4a operator/(const Vec4a& other) const {
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_div_ps(v, other.v));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vdivq_f32(v, other.v));
+#else
+        return Vec4a(v.lanes[0] / other.v.lanes[0], v.lanes[1] / other.v.lanes[1],
+                     v.lanes[2] / other.v.lanes[2], v.lanes[3] / other.v.lanes[3]);
+#endif
+    }
+
+    Vec4a operator*(float scalar) const { return *this * splat(scalar); }
+    Vec4a operator/(float scalar) const { return *this / splat(scalar); }
+    Vec4a operator-() const { return Vec4a() - *this; }
+
+    Vec4a& operator+=(const Vec4a& other) { return *this = *this + other; }
+    Vec4a& operator-=(const Vec4a& other) { return *this = *this - other; }
+    Vec4a& operator*=(const Vec4a& other) { return *this = *this * other; }
+    Vec4a& operator*=(float scalar) { return *this = *this * scalar; }
+
+    /**
+     * @brief Computes a * b + c per lane (fused where the target has FMA)
+     */
+    static Vec4a multiplyAdd(const Vec4a& a, const Vec4a& b, const Vec4a& c) {
+#if defined(EV_SIMD_SSE2) && defined(__FMA__)
+        return Vec4a(_mm_fmadd_ps(a.v, b.v, c.v));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vfmaq_f32(c.v, a.v, b.v));
+#else
+        return a * b + c;
+#endif
+    }
+
+    static Vec4a min(const Vec4a& a, const Vec4a& b) {
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_min_ps(a.v, b.v));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vminq_f32(a.v, b.v));
+#else
+        return Vec4a(std::fmin(a.v.lanes[0], b.v.lanes[0]), std::fmin(a.v.lanes[1], b.v.lanes[1]),
+                     std::fmin(a.v.lanes[2], b.v.lanes[2]), std::fmin(a.v.lanes[3], b.v.lanes[3]));
+#endif
+    }
+
+    static Vec4a max(const Vec4a& a, const Vec4a& b) {
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_max_ps(a.v, b.v));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vmaxq_f32(a.v, b.v));
+#else
+        return Vec4a(std::fmax(a.v.lanes[0], b.v.lanes[0]), std::fmax(a.v.lanes[1], b.v.lanes[1]),
+                     std::fmax(a.v.lanes[2], b.v.lanes[2]), std::fmax(a.v.lanes[3], b.v.lanes[3]));
+#endif
+    }
+
+    static Vec4a abs(const Vec4a& a) {
+#if defined(EV_SIMD_SSE2)
+        return Vec4a(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v));
+#elif defined(EV_SIMD_NEON)
+        return Vec4a(vabsq_f32(a.v));
+#else
+        return Vec4a(std::fabs(a.v.lanes[0]), std::fabs(a.v.lanes[1]),
+                     std::fabs(a.v.lanes[2]), std::fabs(a.v.lanes[3]));
+#endif
+    }
+
+    /**
+     * @brief Sum of the four lanes
+     */
+    float horizontalSum() const {
+#if defined(EV_SIMD_SSE2)
+        const __m128 pairs = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_movehl_ps(pairs, pairs)));
+#elif defined(EV_SIMD_NEON)
+        return vaddvq_f32(v);
+#else
+        return (v.lanes[0] + v.lanes[1]) + (v.lanes[2] + v.lanes[3]);
+#endif
+    }
+
+    static float dot(const Vec4a& a, const Vec4a& b) { return (a * b).horizontalSum(); }
+
+    /// Dot product of x, y, z (w ignored)
+    static float dot3(const Vec4a& a, const Vec4a& b) { return (a * b).withW(0.0f).horizontalSum(); }
+
+    /// Cross product of x, y, z; w of the result is 0
+    static Vec4a cross3(const Vec4a& a, const Vec4a& b) {
+#if defined(EV_SIMD_SSE2)
+        // a.yzx * b.zxy - a.zxy * b.yzx, computed with one shuffle per operand
+        const __m128 aYzx = _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 bYzx = _mm_shuffle_ps(b.v, b.v, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 c = _mm_sub_ps(_mm_mul_ps(a.v, bYzx), _mm_mul_ps(aYzx, b.v));
+        return Vec4a(_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1))).withW(0.0f);
+#else
+        const Vec3<float> result = a.toVec3f().cross(b.toVec3f());
+        return Vec4a(result, 0.0f);
+#endif
+    }
+
+    float length3() const { return std::sqrt(dot3(*this, *this)); } ///< Length of x, y, z
+    float length() const { return std::sqrt(dot(*this, *this)); }   ///< Length of all four lanes
+
+    /// x, y, z scaled to unit length (w kept); zero stays zero
+    Vec4a normalized3() const {
+        const float len = length3();
+        return len > 0.0f ? (*this * (1.0f / len)).withW(w()) : *this;
+    }
+
+    /// All four lanes scaled to unit length; zero stays zero
+    Vec4a normalized() const {
+        const float len = length();
+        return len > 0.0f ? *this * (1.0f / len) : *this;
+    }
+
+    static Vec4a lerp(const Vec4a& a, const Vec4a& b, float t) { return multiplyAdd(b - a, splat(t), a); }
+};
+
+/**
+ * @struct Mat4f
+ * @brief Column-major 4x4 float matrix of four Vec4a columns
+ * @details Memory layout matches GLSL mat4 (std140/std430 and push constants), so
+ *          data() can be copied into uniform buffers as is. Projection helpers use
+ *          Vulkan conventions: depth in [0, 1] and +Y pointing down in clip space.
+ */
+struct alignas(16) Mat4f {
+    Vec4a columns[4]; ///< Columns 0-3
+
+    /// Identity matrix
+    Mat4f()
+        : columns{Vec4a(1.0f, 0.0f, 0.0f, 0.0f), Vec4a(0.0f, 1.0f, 0.0f, 0.0f),
+                  Vec4a(0.0f, 0.0f, 1.0f, 0.0f), Vec4a(0.0f, 0.0f, 0.0f, 1.0f)} {}
+
+    Mat4f(const Vec4a& c0, const Vec4a& c1, const Vec4a& c2, const Vec4a& c3) : columns{c0, c1, c2, c3} {}
+
+    static Mat4f identity() { return Mat4f(); }
+
+    /**
+     * @brief Loads a matrix from 16 column-major floats
+     * @param source Column-major elements
+     */
+    static Mat4f load(const float* source) {
+        return Mat4f(Vec4a::load(source), Vec4a::load(source + 4), Vec4a::load(source + 8), Vec4a::load(source + 12));
+    }
+
+    /**
+     * @brief Stores the matrix as 16 column-major floats
+     * @param destination Column-major elements
+     */
+    void store(float* destination) const {
+        for (int c = 0; c < 4; ++c) columns[c].store(destination + c * 4);
+    }
+
+    /// Pointer to the 16 column-major elements
+    const float* data() const { return reinterpret_cast<const float*>(columns); }
+
+    static Mat4f translation(const Vec3<float>& offset) {
+        Mat4f result;
+        result.columns[3] = Vec4a(offset, 1.0f);
+        return result;
+    }
+
+    static Mat4f scale(const Vec3<float>& factors) {
+        return Mat4f(Vec4a(factors.x, 0.0f, 0.0f, 0.0f), Vec4a(0.0f, factors.y, 0.0f, 0.0f),
+                     Vec4a(0.0f, 0.0f, factors.z, 0.0f), Vec4a(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    /**
+     * @brief Rotation matrix of a unit quaternion
+     */
+    static Mat4f rotation(const Quatf& rotation);
+
+    /**
+     * @brief Translation * rotation * scale
+     */
+    static Mat4f compose(const Vec3<float>& translation, const Quatf& rotation, const Vec3<float>& scale);
+
+    /**
+     * @brief Right-handed perspective projection for Vulkan
+     * @param fovY Vertical field of view in radians
+     * @param aspect Width / height
+     * @param zNear Near plane distance (> 0)
+     * @param zFar Far plane distance
+     * @return Projection mapping depth to [0, 1] with +Y down
+     */
+    static Mat4f perspective(float fovY, float aspect, float zNear, float zFar);
+
+    /**
+     * @brief Right-handed orthographic projection for Vulkan
+     * @return Projection mapping [zNear, zFar] to depth [0, 1] with +Y down
+     */
+    static Mat4f orthographic(float left, float right, float bottom, float top, float zNear, float zFar);
+
+    /**
+     * @brief Right-handed view matrix
+     * @param eye Camera position
+     * @param target Point looked at
+     * @param up Up direction
+     */
+    static Mat4f lookAt(const Vec3<float>& eye, const Vec3<float>& target, const Vec3<float>& up);
+
+    Vec4a operator*(const Vec4a& vector) const {
+        Vec4a result = columns[0] * vector.splatLane<0>();
+        result = Vec4a::multiplyAdd(columns[1], vector.splatLane<1>(), result);
+        result = Vec4a::multiplyAdd(columns[2], vector.splatLane<2>(), result);
+        return Vec4a::multiplyAdd(columns[3], vector.splatLane<3>(), result);
+    }
+
+    Mat4f operator*(const Mat4f& other) const {
+        return Mat4f(*this * other.columns[0], *this * other.columns[1],
+                     *this * other.columns[2], *this * other.columns[3]);
+    }
+
+    /// Transforms a point (w = 1) without perspective division
+    Vec3<float> transformPoint(const Vec3<float>& point) const { return (*this * Vec4a(point, 1.0f)).toVec3f(); }
+
+    /// Transforms a direction (w = 0)
+    Vec3<float> transformVector(const Vec3<float>& vector) const { return (*this * Vec4a(vector, 0.0f)).toVec3f(); }
+
+    Mat4f transposed() const;
+
+    /**
+     * @brief General inverse
+     * @return Inverse, or identity if the matrix is singular
+     */
+    Mat4f inverse() const;
+};
+
+/**
+ * @struct Quatf
+ * @brief Rotation quaternion stored as (x, y, z, w) in a Vec4a
+ */
+struct alignas(16) Quatf {
+    Vec4a xyzw; ///< Vector part in x, y, z and scalar part in w
+
+    /// Identity rotation
+    Quatf() : xyzw(0.0f, 0.0f, 0.0f, 1.0f) {}
+    Quatf(float x, float y, float z, float w) : xyzw(x, y, z, w) {}
+    explicit Quatf(const Vec4a& value) : xyzw(value) {}
+
+    /**
+     * @brief Rotation around an axis
+     * @param axis Rotation axis (normalized internally)
+     * @param radians Angle, counter-clockwise looking down the axis
+     */
+    static Quatf fromAxisAngle(const Vec3<float>& axis, float radians) {
+        const float half = radians * 0.5f;
+        const Vec4a unitAxis = Vec4a(axis, 0.0f).normalized3();
+        return Quatf((unitAxis * std::sin(half)).withW(std::cos(half)));
+    }
+
+    /// Hamilton product: applies other first, then this
+    Quatf operator*(const Quatf& other) const {
+        const Vec4a& a = xyzw;
+        const Vec4a& b = other.xyzw;
+        Vec4a result = Vec4a::multiplyAdd(a.splatLane<3>(), b, b.splatLane<3>() * a) + Vec4a::cross3(a, b);
+        return Quatf(result.withW(a.w() * b.w() - Vec4a::dot3(a, b)));
+    }
+
+    Quatf conjugate() const { return Quatf((-xyzw).withW(xyzw.w())); }
+
+    Quatf normalized() const { return Quatf(xyzw.normalized()); }
+
+    /// Rotates a vector by this unit quaternion
+    Vec3<float> rotate(const Vec3<float>& vector) const {
+        // v + 2w(q x v) + 2 q x (q x v)
+        const Vec4a v(vector, 0.0f);
+        const Vec4a t = Vec4a::cross3(xyzw, v) * 2.0f;
+        return (v + t * xyzw.splatLane<3>() + Vec4a::cross3(xyzw, t)).toVec3f();
+    }
+
+    /**
+     * @brief Spherical interpolation along the shorter arc
+     * @param a Rotation at t = 0
+     * @param b Rotation at t = 1
+     * @param t Interpolation factor in [0, 1]
+     */
+    static Quatf slerp(const Quatf& a, const Quatf& b, float t);
+
+    /// Normalized linear interpolation along the shorter arc (cheaper than slerp)
+    static Quatf nlerp(const Quatf& a, const Quatf& b, float t) {
+        const Vec4a target = Vec4a::dot(a.xyzw, b.xyzw) < 0.0f ? -b.xyzw : b.xyzw;
+        return Quatf(Vec4a::lerp(a.xyzw, target, t).normalized());
+    }
+};
+
+/**
+ * @namespace SimdMath
+ * @brief Batched transforms over structure-of-arrays data
+ * @details The kernels process 8 points per iteration with AVX2 (fused
+ *          multiply-add with FMA), 4 with SSE2 or NEON, and fall back to scalar
+ *          code elsewhere. The AVX2 and FMA paths are compiled only when the
+ *          build targets them (-DEV_SIMD_ARCH=AVX2 or native). Input and output
+ *          arrays may be the same.
+ *
+ * Common usage patterns:
+ * @code
+ * // Positions of many objects kept as separate x/y/z arrays
+ * SimdMath::transformPoints(viewProjection, xs.data(), ys.data(), zs.data(),
+ *                           outX.data(), outY.data(), outZ.data(), xs.size());
+ * @endcode
+ */
+namespace SimdMath {
+
+/**
+ * @brief Transforms points (w = 1) without perspective division
+ * @param matrix Transform
+ * @param x Input x components
+ * @param y Input y components
+ * @param z Input z components
+ * @param outX Output x components
+ * @param outY Output y components
+ * @param outZ Output z components
+ * @param count Number of points
+ */
+void transformPoints(const Mat4f& matrix, const float* x, const float* y, const float* z,
+                     float* outX, float* outY, float* outZ, size_t count);
+
+/**
+ * @brief Transforms directions (w = 0)
+ * @param matrix Transform (translation is ignored)
+ * @param x Input x components
+ * @param y Input y components
+ * @param z Input z components
+ * @param outX Output x components
+ * @param outY Output y components
+ * @param outZ Output z components
+ * @param count Number of directions
+ */
+void transformVectors(const Mat4f& matrix, const float* x, const float* y, const float* z,
+                      float* outX, float* outY, float* outZ, size_t count);
+
+/**
+ * @brief Transforms interleaved points (w = 1)
+ * @param matrix Transform
+ * @param points Input points
+ * @param out Output points (may equal points)
+ * @param count Number of points
+ */
+void transformPoints(const Mat4f& matrix, const Vec3<float>* points, Vec3<float>* out, size_t count);
+
+/**
+ * @brief Multiplies many matrices by one matrix
+ * @param left Left operand shared by every product
+ * @param right Right operands
+ * @param out left * right[i] (may equal right)
+ * @param count Number of matrices
+ * @details Typical use: viewProjection * model for every object of a frame.
+ */
+void multiply(const Mat4f& left, const Mat4f* right, Mat4f* out, size_t count);
+
+} // namespace SimdMath
+} // namespace ev
@@ -0,0 +1,183 @@
+/**
+ * @file VertexQuantization.hpp
+ * @brief Vertex compression kernels for EasyVulkan framework
+ * @details This file contains the packers converting float vertex data into the
+ *          compact layouts of DataStructures.hpp: normalized half-float or SNORM16
+ *          positions, octahedral normals, UNORM16 texture coordinates and RGBA8
+ *          colors.
+ */
+
+#pragma once
+
+#include "../DataStructures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ev {
+
+/**
+ * @namespace VertexQuantization
+ * @brief Namespace containing vertex compression utilities
+ * @details Provides functionality for:
+ *          - Per-mesh position quantization parameters
+ *          - Octahedral normal encoding and decoding
+ *          - Stream packers for positions, normals, texture coordinates and colors
+ *          - packVertices() converting whole Vertex arrays to CompactVertex or
+ *            QuantizedVertex
+ *
+ * The packers use SSE2 on x86-64 (F16C for half floats when the compiler targets
+ * it) with a scalar fallback elsewhere; both round to nearest-even and give the
+ * same results. Destinations are written front to back, so they may be mapped
+ * staging memory.
+ *
+ * Shader side, with the quantization in a push constant:
+ * @code
+ * layout(location = 0) in vec4 inPosition;  // R16G16B16A16_SFLOAT or _SNORM
+ * layout(location = 1) in vec2 inNormal;    // R16G16_SNORM, octahedral
+ *
+ * vec3 position = inPosition.xyz * pc.scale.xyz + pc.offset.xyz;
+ * vec3 normal = vec3(inNormal, 1.0 - abs(inNormal.x) - abs(inNormal.y));
+ * float t = max(-normal.z, 0.0);
+ * normal.xy += mix(vec2(t), vec2(-t), greaterThanEqual(normal.xy, vec2(0.0)));
+ * normal = normalize(normal);
+ * @endcode
+ *
+ * Common usage patterns:
+ * @code
+ * auto quantization = VertexQuantization::computePositionQuantization(vertices.data(), vertices.size());
+ * std::vector<QuantizedVertex> packed(vertices.size());
+ * VertexQuantization::packVertices(vertices.data(), packed.data(), vertices.size(), quantization);
+ *
+ * // 20 bytes per vertex instead of 48
+ * GeometryAllocation mesh = geometry.add(packed, indices);
+ *
+ * auto attributes = QuantizedVertex::getAttributeDescriptions();
+ * auto pipeline = resourceManager->createGraphicsPipeline()
+ *     .setVertexInputState(QuantizedVertex::getBindingDescription(),
+ *                          {attributes.begin(), attributes.end()})
+ *     ...
+ * @endcode
+ */
+namespace VertexQuantization {
+
+/**
+ * @struct PositionQuantization
+ * @brief Per-mesh mapping between stored and object-space positions
+ * @details Stored positions are (position - offset) / scale, in [-1, 1] on every
+ *          axis; the shader reverses it with stored * scale + offset. Both vectors
+ *          are vec4s (w unused) so the struct matches std140 and push constant
+ *          layouts.
+ */
+struct PositionQuantization {
+    Vec4f offset{0.0f, 0.0f, 0.0f, 0.0f}; ///< Center of the mesh bounds
+    Vec4f scale{1.0f, 1.0f, 1.0f, 0.0f};  ///< Half extent of the bounds per axis
+};
+
+/**
+ * @brief Computes the quantization covering a mesh
+ * @param vertices Mesh vertices
+ * @param count Number of vertices
+ * @return Center and half extent of the bounding box (flat axes get scale 1)
+ */
+PositionQuantization computePositionQuantization(const Vertex* vertices, size_t count);
+
+/**
+ * @brief Encodes a unit normal with the octahedral mapping
+ * @param normal Normal (need not be normalized; zero maps to +Z)
+ * @return Two SNORM16 components
+ */
+Snorm16x2 encodeOctahedral(const Vec3f& normal);
+
+/**
+ * @brief Decodes an octahedral normal
+ * @param encoded Value returned by encodeOctahedral()
+ * @return Unit normal
+ */
+Vec3f decodeOctahedral(const Snorm16x2& encoded);
+
+/**
+ * @brief Rebuilds an object-space position from its stored form
+ * @param position Stored SNORM16 position
+ * @param quantization Quantization the position was packed with
+ * @return Position in object space
+ */
+Vec3f dequantizePosition(const Snorm16x4& position, const PositionQuantization& quantization);
+
+/**
+ * @brief Packs positions as normalized half floats (w = 1)
+ * @param src Source positions
+ * @param dst Destination positions
+ * @param count Number of positions
+ * @param quantization Per-mesh quantization
+ */
+void packPositions(const Vec3f* src, Half4* dst, size_t count, const PositionQuantization& quantization);
+
+/**
+ * @brief Packs positions as SNORM16 (w = 1)
+ * @param src Source positions
+ * @param dst Destination positions
+ * @param count Number of positions
+ * @param quantization Per-mesh quantization; positions outside it are clamped
+ */
+void packPositions(const Vec3f* src, Snorm16x4* dst, size_t count, const PositionQuantization& quantization);
+
+/**
+ * @brief Packs normals with the octahedral mapping
+ * @param src Source normals
+ * @param dst Destination normals
+ * @param count Number of normals
+ */
+void packNormals(const Vec3f* src, Snorm16x2* dst, size_t count);
+
+/**
+ * @brief Packs texture coordinates as UNORM16
+ * @param src Source coordinates, clamped to [0, 1]
+ * @param dst Destination coordinates
+ * @param count Number of coordinates
+ *
+ * Tiling coordinates beyond [0, 1] need a scale applied in the shader.
+ */
+void packTexCoords(const Vec2f* src, Unorm16x2* dst, size_t count);
+
+/**
+ * @brief Packs RGBA colors as UNORM8
+ * @param src Source colors, clamped to [0, 1]
+ * @param dst Destination colors
+ * @param count Number of colors
+ */
+void packColors(const Vec4f* src, Unorm8x4* dst, size_t count);
+
+/**
+ * @brief Converts vertices to the half-float compact layout
+ * @param src Source vertices
+ * @param dst Destination vertices
+ * @param count Number of vertices
+ * @param quantization Per-mesh quantization of the positions
+ */
+void packVertices(const Vertex* src, CompactVertex* dst, size_t count, const PositionQuantization& quantization);
+
+/**
+ * @brief Converts vertices to the SNORM16 compact layout
+ * @param src Source vertices
+ * @param dst Destination vertices
+ * @param count Number of vertices
+ * @param quantization Per-mesh quantization of the positions
+ */
+void packVertices(const Vertex* src, QuantizedVertex* dst, size_t count, const PositionQuantization& quantization);
+
+/**
+ * @brief Converts vertices to split SNORM16 position and attribute streams
+ * @param src Source vertices
+ * @param positions Destination position stream
+ * @param attributes Destination attribute stream
+ * @param count Number of vertices
+ * @param quantization Per-mesh quantization of the positions
+ * @details Produces the buffers read through SplitQuantizedVertex: 8 bytes per
+ *          vertex for position-only passes, 20 bytes for full shading.
+ */
+void packVertexStreams(const Vertex* src, QuantizedPosition* positions, CompactAttributes* attributes,
+                       size_t count, const PositionQuantization& quantization);
+
+} // namespace VertexQuantization
+} // namespace ev
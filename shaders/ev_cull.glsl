@@ -0,0 +1,109 @@
+// Shared body of ev_cull.comp and ev_cull_occlusion.comp, used by ev::GpuCuller.
+// One invocation tests one object against the frustum (and, with
+// EV_CULL_OCCLUSION, against a Hi-Z depth pyramid) and emits its draw command.
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+struct CullObject {
+    vec4 sphere;  // xyz = center, w = radius
+    vec4 extents; // xyz = box half size
+};
+
+// Matches VkDrawIndexedIndirectCommand (20 bytes in std430)
+struct DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Objects { CullObject objects[]; };
+layout(std430, set = 0, binding = 1) readonly buffer Draws { DrawCommand draws[]; };
+layout(std430, set = 0, binding = 2) writeonly buffer Commands { DrawCommand commands[]; };
+layout(std430, set = 0, binding = 3) buffer Count { uint drawCount; };
+
+#ifdef EV_CULL_OCCLUSION
+// Farthest depth of each texel's footprint, one mip per 2x2 reduction
+layout(set = 0, binding = 4) uniform sampler2D hiZ;
+#endif
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection; // World to clip space, Vulkan depth range [0, 1]
+    vec2 hiZSize;        // Extent of Hi-Z level 0 in texels
+    uint objectCount;    // Objects to test
+    uint compact;        // 1: append visible draws and count them, 0: keep slots, zero instances
+} pc;
+
+vec4 matrixRow(int r) {
+    return vec4(pc.viewProjection[0][r], pc.viewProjection[1][r], pc.viewProjection[2][r], pc.viewProjection[3][r]);
+}
+
+bool insideFrustum(vec3 center, vec3 extents, float radius) {
+    vec4 r0 = matrixRow(0), r1 = matrixRow(1), r2 = matrixRow(2), r3 = matrixRow(3);
+    vec4 planes[6] = vec4[6](r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2);
+    for (int i = 0; i < 6; ++i) {
+        vec4 plane = planes[i] / length(planes[i].xyz);
+        float distance = dot(plane.xyz, center) + plane.w;
+        // Culled when the sphere or the box lies fully behind the plane
+        float reach = min(radius, dot(abs(plane.xyz), extents));
+        if (distance + reach < 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef EV_CULL_OCCLUSION
+bool occluded(vec3 center, vec3 extents) {
+    vec3 lo = vec3(1.0e30);
+    vec3 hi = vec3(-1.0e30);
+    for (int i = 0; i < 8; ++i) {
+        vec3 corner = center + extents * vec3((i & 1) != 0 ? 1.0 : -1.0,
+                                              (i & 2) != 0 ? 1.0 : -1.0,
+                                              (i & 4) != 0 ? 1.0 : -1.0);
+        vec4 clip = pc.viewProjection * vec4(corner, 1.0);
+        // Boxes reaching behind the camera cannot be bounded on screen
+        if (clip.w <= 0.0) {
+            return false;
+        }
+        vec3 ndc = clip.xyz / clip.w;
+        lo = min(lo, ndc);
+        hi = max(hi, ndc);
+    }
+
+    vec2 uvMin = clamp(lo.xy * 0.5 + 0.5, 0.0, 1.0);
+    vec2 uvMax = clamp(hi.xy * 0.5 + 0.5, 0.0, 1.0);
+    // At this level the rectangle spans at most 2x2 texels, so four taps cover it
+    vec2 size = (uvMax - uvMin) * pc.hiZSize;
+    float level = ceil(log2(max(max(size.x, size.y), 1.0)));
+    float farthest = max(max(textureLod(hiZ, uvMin, level).r, textureLod(hiZ, vec2(uvMax.x, uvMin.y), level).r),
+                         max(textureLod(hiZ, vec2(uvMin.x, uvMax.y), level).r, textureLod(hiZ, uvMax, level).r));
+    return lo.z > farthest;
+}
+#endif
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= pc.objectCount) {
+        return;
+    }
+
+    CullObject object = objects[index];
+    bool visible = insideFrustum(object.sphere.xyz, object.extents.xyz, object.sphere.w);
+#ifdef EV_CULL_OCCLUSION
+    visible = visible && !occluded(object.sphere.xyz, object.extents.xyz);
+#endif
+
+    DrawCommand draw = draws[index];
+    if (pc.compact != 0u) {
+        if (visible && draw.instanceCount > 0u) {
+            commands[atomicAdd(drawCount, 1u)] = draw;
+        }
+    } else {
+        if (!visible) {
+            draw.instanceCount = 0u;
+        }
+        commands[index] = draw;
+    }
+}
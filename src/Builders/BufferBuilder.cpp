@@ -4,6 +4,7 @@
 #include "EasyVulkan/Core/ResourceManager.hpp"
 #include "EasyVulkan/Core/VulkanContext.hpp"
 #include "EasyVulkan/Core/VulkanDevice.hpp"
+#include "EasyVulkan/Utils/ResourceUtils.hpp"
 
 #include <stdexcept>
 
@@ -49,6 +50,16 @@ BufferBuilder &BufferBuilder::setQueueFamilyIndices(
   return *this;
 }
 
+BufferBuilder &BufferBuilder::setMemoryCategory(MemoryCategory category) {
+  m_memoryCategory = category;
+  return *this;
+}
+
+BufferBuilder &BufferBuilder::enableDeviceAddress() {
+  m_deviceAddress = true;
+  return *this;
+}
+
 void BufferBuilder::validateParameters() const {
   if (m_size == 0) {
     LogError("Buffer size must be greater than 0");
@@ -61,6 +72,13 @@ void BufferBuilder::validateParameters() const {
   }
 
 
+  if ((m_usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) &&
+      !m_device->isBufferDeviceAddressEnabled()) {
+    LogError("Buffer device address requested but the feature is not enabled");
+    throw std::runtime_error(
+        "Buffer device address requested but the feature is not enabled");
+  }
+
   if (m_sharingMode == VK_SHARING_MODE_CONCURRENT &&
       m_queueFamilyIndices.empty()) {
     LogError("Queue family indices must be specified for concurrent sharing mode");
@@ -90,6 +108,30 @@ VkBuffer BufferBuilder::createBuffer(VmaAllocation *outAllocation) const {
     allocInfo.requiredFlags = m_memoryProperties;
   }
 
+  // Keep host-visible allocations persistently mapped so writes go through a
+  // cached pointer instead of a map/unmap pair per upload
+  const VmaAllocationCreateFlags hostAccessFlags =
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+  const bool autoUsage = m_memoryUsage == VMA_MEMORY_USAGE_AUTO ||
+                         m_memoryUsage == VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE ||
+                         m_memoryUsage == VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+  if (autoUsage) {
+    if ((m_memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) &&
+        !(allocInfo.flags & hostAccessFlags)) {
+      allocInfo.flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+    }
+    if (allocInfo.flags & hostAccessFlags) {
+      allocInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    }
+  } else if (m_memoryUsage == VMA_MEMORY_USAGE_CPU_ONLY ||
+             m_memoryUsage == VMA_MEMORY_USAGE_CPU_TO_GPU ||
+             m_memoryUsage == VMA_MEMORY_USAGE_GPU_TO_CPU ||
+             m_memoryUsage == VMA_MEMORY_USAGE_CPU_COPY ||
+             (m_memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) {
+    allocInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+  }
+
   VkBuffer buffer;
   VmaAllocation allocation;
 
@@ -110,19 +152,34 @@ void BufferBuilder::uploadData(VkBuffer buffer, VmaAllocation *allocation,
   VmaAllocationInfo allocInfo;
   vmaGetAllocationInfo(m_device->getAllocator(), *allocation, &allocInfo);
   memcpy(allocInfo.pMappedData, data, static_cast<size_t>(dataSize));
+
+  // Flush now: an unnamed buffer can be freed by the caller without the device
+  // knowing, so nothing may stay queued for it. No-op on coherent memory.
+  if (vmaFlushAllocation(m_device->getAllocator(), *allocation, 0, dataSize) !=
+      VK_SUCCESS) {
+    throw std::runtime_error("failed to flush buffer data!");
+  }
 }
 
 
 VkBuffer BufferBuilder::build(const std::string &name,
                               VmaAllocation *outAllocation) {
 
+  if (m_deviceAddress) {
+    m_usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+  }
   validateParameters();
-  VkBuffer buffer = createBuffer(outAllocation);
+  VmaAllocation allocation = VK_NULL_HANDLE;
+  VkBuffer buffer = createBuffer(&allocation);
+  if (outAllocation) {
+    *outAllocation = allocation;
+  }
 
   // Register the buffer for resource tracking if a name is provided
   if (!name.empty()) {
     m_context->getResourceManager()->registerResource(
-        name, reinterpret_cast<uint64_t>(buffer),*outAllocation, m_size, m_usage, VK_OBJECT_TYPE_BUFFER);
+        name, reinterpret_cast<uint64_t>(buffer), allocation, m_size, m_usage,
+        VK_OBJECT_TYPE_BUFFER, m_memoryCategory);
   }
 
   return buffer;
@@ -140,18 +197,45 @@ VkBuffer BufferBuilder::buildAndInitialize(const void *data,
   if (!outAllocation) {
     outAllocation = &localAllocation;
   }
-  
-  // Set usage to VMA_MEMORY_USAGE_CPU_TO_GPU
-  m_memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
 
-  // Set flags to VMA_ALLOCATION_CREATE_MAPPED_BIT
-  m_memoryFlags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+  // Work on a copy so the upload flags don't leak into later builds
+  BufferBuilder builder(*this);
+
+  const bool autoUsage = m_memoryUsage == VMA_MEMORY_USAGE_AUTO ||
+                         m_memoryUsage == VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE ||
+                         m_memoryUsage == VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+  const VmaAllocationCreateFlags hostAccessFlags =
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT |
+      VMA_ALLOCATION_CREATE_MAPPED_BIT;
+  if (autoUsage && m_memoryProperties == 0 && !(m_memoryFlags & hostAccessFlags)) {
+    // No host access requested: let VMA pick device-local memory and map it
+    // when it is host visible (UMA, resizable BAR); otherwise fall back to a
+    // staging copy
+    builder.m_usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    builder.m_memoryFlags |=
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT |
+        VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VkBuffer buffer = builder.build(name, outAllocation);
+    ResourceUtils::uploadDataToDeviceBuffer(
+        m_device,
+        m_context->getCommandPoolManager()->getSingleTimeCommandPool(), buffer,
+        *outAllocation, data, dataSize);
+    return buffer;
+  }
+
+  // Host access requested: keep the buffer host visible and persistently
+  // mapped so it can be rewritten with ResourceUtils::uploadDataToMappedBuffer()
+  builder.m_memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+  builder.m_memoryFlags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
   // Create the buffer
-  VkBuffer buffer = build(name, outAllocation);
+  VkBuffer buffer = builder.build(name, outAllocation);
 
   // Upload the data
-  uploadData(buffer, outAllocation, data, dataSize);
+  builder.uploadData(buffer, outAllocation, data, dataSize);
 
   return buffer;
 }
@@ -2,7 +2,9 @@
 #include "EasyVulkan/Core/VulkanDevice.hpp"
 #include "EasyVulkan/Core/VulkanContext.hpp"
 #include "EasyVulkan/Core/ResourceManager.hpp"
+#include <set>
 #include <stdexcept>
+#include <string>
 
 namespace ev {
 
@@ -97,17 +99,26 @@ GraphicsPipelineBuilder& GraphicsPipelineBuilder::setVertexInputState(
     const VkVertexInputBindingDescription& binding,
     const std::vector<VkVertexInputAttributeDescription>& attributes) {
     
-
-    m_vertexBinding = binding;
+    m_vertexBindings = {binding};
     m_vertexAttributes = attributes;
+    return *this;
+}
 
+GraphicsPipelineBuilder& GraphicsPipelineBuilder::setVertexInputState(
+    const std::vector<VkVertexInputBindingDescription>& bindings,
+    const std::vector<VkVertexInputAttributeDescription>& attributes) {
 
-    m_vertexInputState.vertexBindingDescriptionCount = 1;
-    m_vertexInputState.pVertexBindingDescriptions = &m_vertexBinding;
-    m_vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
-    m_vertexInputState.pVertexAttributeDescriptions = m_vertexAttributes.data();
+    m_vertexBindings = bindings;
+    m_vertexAttributes = attributes;
+    return *this;
+}
 
+GraphicsPipelineBuilder& GraphicsPipelineBuilder::addVertexBinding(
+    const VkVertexInputBindingDescription& binding,
+    const std::vector<VkVertexInputAttributeDescription>& attributes) {
 
+    m_vertexBindings.push_back(binding);
+    m_vertexAttributes.insert(m_vertexAttributes.end(), attributes.begin(), attributes.end());
     return *this;
 }
 
@@ -221,6 +232,26 @@ GraphicsPipelineBuilder& GraphicsPipelineBuilder::addPushConstantRange(
     return *this;
 }
 
+void GraphicsPipelineBuilder::validateVertexInput() const {
+    std::set<uint32_t> bindings;
+    for (const auto& binding : m_vertexBindings) {
+        if (!bindings.insert(binding.binding).second) {
+            throw std::runtime_error("vertex binding " + std::to_string(binding.binding) + " declared twice");
+        }
+    }
+
+    std::set<uint32_t> locations;
+    for (const auto& attribute : m_vertexAttributes) {
+        if (bindings.count(attribute.binding) == 0) {
+            throw std::runtime_error("vertex attribute at location " + std::to_string(attribute.location) +
+                                     " reads undeclared binding " + std::to_string(attribute.binding));
+        }
+        if (!locations.insert(attribute.location).second) {
+            throw std::runtime_error("vertex attribute location " + std::to_string(attribute.location) + " used twice");
+        }
+    }
+}
+
 VkPipelineLayout GraphicsPipelineBuilder::createPipelineLayout() {
     VkPipelineLayoutCreateInfo layoutInfo{};
     layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -249,6 +280,13 @@ VkPipeline GraphicsPipelineBuilder::build(const std::string& name) {
         throw std::runtime_error("Render pass not specified");
     }
 
+    // Pointers are taken here, after every binding has been added
+    validateVertexInput();
+    m_vertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(m_vertexBindings.size());
+    m_vertexInputState.pVertexBindingDescriptions = m_vertexBindings.data();
+    m_vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(m_vertexAttributes.size());
+    m_vertexInputState.pVertexAttributeDescriptions = m_vertexAttributes.data();
+
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     pipelineInfo.stageCount = static_cast<uint32_t>(m_shaderStages.size());
@@ -6,7 +6,13 @@
 #include "EasyVulkan/Core/ResourceManager.hpp"
 #include "EasyVulkan/Core/CommandPoolManager.hpp"
 #include "EasyVulkan/Builders/BufferBuilder.hpp"
+#include "EasyVulkan/Utils/MemoryUtils.hpp"
 #include "EasyVulkan/Utils/ResourceUtils.hpp"
+#include "EasyVulkan/Utils/BlockCompression.hpp"
+#include "EasyVulkan/Utils/FormatUtils.hpp"
+#include "EasyVulkan/Utils/PixelConversion.hpp"
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 
@@ -38,11 +44,50 @@ ImageBuilder& ImageBuilder::setMipLevels(uint32_t mipLevels) {
     return *this;
 }
 
+ImageBuilder& ImageBuilder::setFullMipChain() {
+    m_fullMipChain = true;
+    return *this;
+}
+
+ImageBuilder& ImageBuilder::setMipGeneration(MipGenerationMode mode, MipGenerator* generator) {
+    m_mipGenerationMode = mode;
+    m_mipGenerator = generator;
+    return *this;
+}
+
+ImageBuilder& ImageBuilder::setBlockCompression(BlockFormat format, ThreadPool* pool) {
+    m_blockCompression = format;
+    m_compressionPool = pool;
+    return *this;
+}
+
+ImageBuilder& ImageBuilder::setSourcePixelFormat(SourcePixelFormat format, bool premultiplyAlpha) {
+    m_sourcePixelFormat = format;
+    m_premultiplyAlpha = premultiplyAlpha;
+    return *this;
+}
+
+ImageBuilder& ImageBuilder::setHostImageCopyLimit(VkDeviceSize maxBytes) {
+    m_hostImageCopyLimit = maxBytes;
+    return *this;
+}
+
 ImageBuilder& ImageBuilder::setArrayLayers(uint32_t arrayLayers) {
     m_arrayLayers = arrayLayers;
     return *this;
 }
 
+ImageBuilder& ImageBuilder::setCubemap(uint32_t cubeCount) {
+    m_arrayLayers = 6 * cubeCount;
+    m_createFlags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+    return *this;
+}
+
+ImageBuilder& ImageBuilder::setViewType(VkImageViewType viewType) {
+    m_viewType = viewType;
+    return *this;
+}
+
 ImageBuilder& ImageBuilder::setSamples(VkSampleCountFlagBits samples) {
     m_samples = samples;
     return *this;
@@ -90,6 +135,26 @@ ImageBuilder& ImageBuilder::setInitialLayout(VkImageLayout initialLayout) {
     return *this;
 }
 
+ImageBuilder& ImageBuilder::setCreateFlags(VkImageCreateFlags flags) {
+    m_createFlags |= flags;
+    return *this;
+}
+
+ImageBuilder& ImageBuilder::setMemoryCategory(MemoryCategory category) {
+    m_memoryCategory = category;
+    return *this;
+}
+
+ImageBuilder& ImageBuilder::setPlacementPolicy(const ImagePlacementPolicy& policy) {
+    m_placementPolicy = policy;
+    return *this;
+}
+
+ImageBuilder& ImageBuilder::setMemoryPriority(float priority) {
+    m_memoryPriority = priority;
+    return *this;
+}
+
 void ImageBuilder::validateParameters() const {
     if (m_format == VK_FORMAT_UNDEFINED) {
         throw std::runtime_error("Image format must be specified");
@@ -103,14 +168,78 @@ void ImageBuilder::validateParameters() const {
         throw std::runtime_error("Image usage flags must be specified");
     }
 
+    if (m_arrayLayers == 0) {
+        throw std::runtime_error("Image must have at least one array layer");
+    }
+
+    if ((m_createFlags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT) && m_extent.width != m_extent.height) {
+        throw std::runtime_error("Cube-compatible images must be square");
+    }
+
     if (m_sharingMode == VK_SHARING_MODE_CONCURRENT && m_queueFamilyIndices.empty()) {
         throw std::runtime_error("Queue family indices must be specified for concurrent sharing mode");
     }
 }
 
-VkImage ImageBuilder::createImage(VmaAllocation* outAllocation) const {
+ImagePlacementDecision ImageBuilder::decidePlacement(VkImage image) const {
+    VkMemoryDedicatedRequirements dedicatedReqs{};
+    dedicatedReqs.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+    VkMemoryRequirements2 memReqs{};
+    memReqs.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    memReqs.pNext = &dedicatedReqs;
+
+    VkImageMemoryRequirementsInfo2 reqInfo{};
+    reqInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+    reqInfo.image = image;
+
+    vkGetImageMemoryRequirements2(m_device->getLogicalDevice(), &reqInfo, &memReqs);
+
+    ImagePlacementDecision decision;
+    decision.size = memReqs.memoryRequirements.size;
+    decision.driverRequiresDedicated = dedicatedReqs.requiresDedicatedAllocation == VK_TRUE;
+    decision.driverPrefersDedicated = dedicatedReqs.prefersDedicatedAllocation == VK_TRUE;
+
+    const bool isAttachment = (m_usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                          VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) != 0;
+    const bool isRenderTarget = isAttachment || (m_usage & VK_IMAGE_USAGE_STORAGE_BIT);
+
+    if (m_memoryFlags & VMA_ALLOCATION_CREATE_NEVER_ALLOCATE_BIT) {
+        decision.reason = "never-allocate requested, placement left to VMA";
+    } else if (m_memoryFlags & VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT) {
+        decision.dedicated = true;
+        decision.reason = "dedicated memory requested by caller";
+    } else if (decision.driverRequiresDedicated) {
+        decision.dedicated = true;
+        decision.reason = "driver requires dedicated allocation";
+    } else if (isAttachment && m_placementPolicy.dedicatedForAttachments) {
+        decision.dedicated = true;
+        decision.reason = "attachment";
+    } else if (m_placementPolicy.dedicatedThreshold > 0 &&
+               decision.size >= m_placementPolicy.dedicatedThreshold) {
+        decision.dedicated = true;
+        decision.reason = "size at or above dedicated threshold";
+    } else if (decision.driverPrefersDedicated) {
+        decision.dedicated = true;
+        decision.reason = "driver prefers dedicated allocation";
+    } else {
+        decision.reason = "sub-allocated from shared block";
+    }
+
+    if (m_memoryPriority >= 0.0f) {
+        decision.priority = m_memoryPriority;
+    } else {
+        decision.priority = isRenderTarget ? m_placementPolicy.attachmentPriority
+                                           : m_placementPolicy.defaultPriority;
+    }
+
+    return decision;
+}
+
+VkImage ImageBuilder::createImage(VmaAllocation* outAllocation, VkImageUsageFlags extraUsage) {
     VkImageCreateInfo imageInfo{};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.flags = m_createFlags;
     imageInfo.imageType = m_imageType;
     imageInfo.format = m_format;
     imageInfo.extent = m_extent;
@@ -118,7 +247,7 @@ VkImage ImageBuilder::createImage(VmaAllocation* outAllocation) const {
     imageInfo.arrayLayers = m_arrayLayers;
     imageInfo.samples = m_samples;
     imageInfo.tiling = m_tiling;
-    imageInfo.usage = m_usage;
+    imageInfo.usage = m_usage | extraUsage;
     imageInfo.sharingMode = m_sharingMode;
     imageInfo.initialLayout = m_initialLayout;
 
@@ -127,17 +256,39 @@ VkImage ImageBuilder::createImage(VmaAllocation* outAllocation) const {
         imageInfo.pQueueFamilyIndices = m_queueFamilyIndices.data();
     }
 
+    VkImage image;
+    if (vkCreateImage(m_device->getLogicalDevice(), &imageInfo, nullptr, &image) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create image!");
+    }
+
+    m_placementDecision = decidePlacement(image);
+
     VmaAllocationCreateInfo allocInfo{};
     allocInfo.usage = m_memoryUsage;
     allocInfo.flags = m_memoryFlags;
     if (m_memoryProperties) {
         allocInfo.requiredFlags = m_memoryProperties;
     }
+    if (m_placementDecision.dedicated) {
+        allocInfo.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+    }
+    // Ignored by VMA unless VK_EXT_memory_priority is enabled
+    allocInfo.priority = m_placementDecision.priority;
+
+    VmaAllocation allocation;
+    if (vmaAllocateMemoryForImage(m_device->getAllocator(), image, &allocInfo, &allocation, nullptr) != VK_SUCCESS) {
+        vkDestroyImage(m_device->getLogicalDevice(), image, nullptr);
+        throw std::runtime_error("failed to allocate image memory!");
+    }
 
+    if (vmaBindImageMemory(m_device->getAllocator(), allocation, image) != VK_SUCCESS) {
+        vmaFreeMemory(m_device->getAllocator(), allocation);
+        vkDestroyImage(m_device->getLogicalDevice(), image, nullptr);
+        throw std::runtime_error("failed to bind image memory!");
+    }
 
-    VkImage image;
-    if (vmaCreateImage(m_device->getAllocator(), &imageInfo, &allocInfo, &image, outAllocation, nullptr) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create image!");
+    if (outAllocation) {
+        *outAllocation = allocation;
     }
 
     return image;
@@ -220,88 +371,309 @@ void ImageBuilder::transitionImageLayout(
 }
 
 void ImageBuilder::uploadData(
-    ImageInfo imageInfo,
-    const void* data,
-    VkDeviceSize dataSize,
-    VkImageLayout finalImageLayout) const {
+    ImageInfo& imageInfo,
+    const std::vector<ImageUploadRegion>& regions,
+    VkImageLayout finalImageLayout,
+    MipGenerator* mipGenerator,
+    MipGenerationMode mipMode) const {
     
+    const VkDeviceSize alignment = FormatUtils::getCopyOffsetAlignment(m_format);
+
+    // Lay the regions out back to back at block-aligned offsets
+    std::vector<VkBufferImageCopy> copies(regions.size());
+    std::vector<VkDeviceSize> sizes(regions.size());
+    VkDeviceSize stagingSize = 0;
+    for (size_t i = 0; i < regions.size(); ++i) {
+        const ImageUploadRegion& region = regions[i];
+
+        stagingSize = (stagingSize + alignment - 1) / alignment * alignment;
+        // Converted data is sized by the image format, not by the source
+        sizes[i] = FormatUtils::getCopyFootprint(m_format, region.extent, region.rowLength,
+                                                 region.imageHeight, region.layerCount);
+
+        VkBufferImageCopy& copy = copies[i];
+        copy.bufferOffset = stagingSize;
+        copy.bufferRowLength = region.rowLength;
+        copy.bufferImageHeight = region.imageHeight;
+        copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy.imageSubresource.mipLevel = region.mipLevel;
+        copy.imageSubresource.baseArrayLayer = region.baseArrayLayer;
+        copy.imageSubresource.layerCount = region.layerCount;
+        copy.imageOffset = region.offset;
+        copy.imageExtent = region.extent;
+
+        stagingSize += sizes[i];
+    }
+
     // Create staging buffer
     VkBuffer stagingBuffer;
     VmaAllocation stagingAllocation;
 
     BufferBuilder stagingBuilder(m_device,m_context);
     stagingBuffer = stagingBuilder
-        .setSize(dataSize)
+        .setSize(stagingSize)
         .setUsage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
         .setMemoryUsage(VMA_MEMORY_USAGE_CPU_ONLY)
         .setMemoryFlags(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
         .build("", &stagingAllocation);
 
-    // Copy data to staging buffer
-    void* mappedData;
-    vmaMapMemory(m_device->getAllocator(), stagingAllocation, &mappedData);
-    memcpy(mappedData, data, static_cast<size_t>(dataSize));
-    vmaUnmapMemory(m_device->getAllocator(), stagingAllocation);
-
-    // Transition image layout for copy
-    ev::ResourceUtils::transitionImageLayoutWithInfo(m_device, m_context->getCommandPoolManager()->getSingleTimeCommandPool(), imageInfo, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    // Write every region (converting if requested) through one mapping
+    VmaAllocator allocator = m_device->getAllocator();
+    void* mappedData = MemoryUtils::getMappedData(m_device, stagingAllocation);
+    const bool persistent = mappedData != nullptr;
+    if (!persistent && vmaMapMemory(allocator, stagingAllocation, &mappedData) != VK_SUCCESS) {
+        vmaDestroyBuffer(allocator, stagingBuffer, stagingAllocation);
+        throw std::runtime_error("failed to map staging memory");
+    }
+    for (size_t i = 0; i < regions.size(); ++i) {
+        uint8_t* destination = static_cast<uint8_t*>(mappedData) + copies[i].bufferOffset;
+        if (m_sourcePixelFormat) {
+            // Source and image texels share the layout, so the footprint converts 1:1
+            const size_t pixelCount = static_cast<size_t>(sizes[i] / FormatUtils::getFormatInfo(m_format).bytesPerBlock);
+            PixelConversion::convert(regions[i].data, *m_sourcePixelFormat, destination, m_format, pixelCount, m_premultiplyAlpha);
+        } else {
+            std::memcpy(destination, regions[i].data, static_cast<size_t>(sizes[i]));
+        }
+    }
+    vmaFlushAllocation(allocator, stagingAllocation, 0, stagingSize);
+    if (!persistent) {
+        vmaUnmapMemory(allocator, stagingAllocation);
+    }
 
-    // Copy buffer to image
+    // Copy, mip generation and the final transition share one command buffer
     auto cmdPool = m_context->getCommandPoolManager();
     VkCommandBuffer cmdBuffer = cmdPool->beginSingleTimeCommands();
 
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = m_arrayLayers;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = m_extent;
+    // Every level goes to TRANSFER_DST: the regions fill some, the mip chain the others
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = imageInfo.layout;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = imageInfo.image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = m_mipLevels;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = m_arrayLayers;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(
+        cmdBuffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        0, nullptr,
+        0, nullptr,
+        1, &barrier);
 
     vkCmdCopyBufferToImage(
         cmdBuffer,
         stagingBuffer,
         imageInfo.image,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        1,
-        &region);
+        static_cast<uint32_t>(copies.size()),
+        copies.data());
+
+    // Fill the missing levels (if any) and leave every level in the final layout
+    MipGenerator::Target target;
+    target.image = imageInfo.image;
+    target.format = m_format;
+    target.imageType = m_imageType;
+    target.extent = m_extent;
+    target.mipLevels = m_mipLevels;
+    target.layerCount = m_arrayLayers;
+    mipGenerator->record(cmdBuffer, target, mipMode, finalImageLayout);
 
     cmdPool->endSingleTimeCommands(cmdBuffer);
+    mipGenerator->releaseTransientResources();
 
-    // Transition image layout for shader access
-    ev::ResourceUtils::transitionImageLayoutWithInfo(m_device, m_context->getCommandPoolManager()->getSingleTimeCommandPool(), imageInfo, finalImageLayout);
-
+    imageInfo.layout = finalImageLayout;
 
     // Cleanup staging buffer
-    vmaDestroyBuffer(m_device->getAllocator(), stagingBuffer, stagingAllocation);
+    vmaDestroyBuffer(allocator, stagingBuffer, stagingAllocation);
+}
+
+bool ImageBuilder::canUseHostImageCopy(VkDeviceSize uploadSize, VkImageLayout finalImageLayout) const {
+#if defined(VK_EXT_host_image_copy)
+    if (!m_device->isHostImageCopyEnabled() || m_hostImageCopyLimit == 0 || uploadSize > m_hostImageCopyLimit) {
+        return false;
+    }
+    if (m_samples != VK_SAMPLE_COUNT_1_BIT || !m_device->isHostImageCopyLayoutSupported(finalImageLayout)) {
+        return false;
+    }
+
+    // The format must allow host transfers with this tiling
+    VkFormatProperties3 formatProperties3{};
+    formatProperties3.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_3;
+    VkFormatProperties2 formatProperties2{};
+    formatProperties2.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    formatProperties2.pNext = &formatProperties3;
+    vkGetPhysicalDeviceFormatProperties2(m_device->getPhysicalDevice(), m_format, &formatProperties2);
+    const VkFormatFeatureFlags2 features = m_tiling == VK_IMAGE_TILING_LINEAR
+        ? formatProperties3.linearTilingFeatures
+        : formatProperties3.optimalTilingFeatures;
+    if (!(features & VK_FORMAT_FEATURE_2_HOST_IMAGE_TRANSFER_BIT_EXT)) {
+        return false;
+    }
+
+    // Host transfer usage may force a layout the GPU samples more slowly; keep the queue path then
+    VkHostImageCopyDevicePerformanceQueryEXT performanceQuery{};
+    performanceQuery.sType = VK_STRUCTURE_TYPE_HOST_IMAGE_COPY_DEVICE_PERFORMANCE_QUERY_EXT;
+    VkImageFormatProperties2 imageFormatProperties{};
+    imageFormatProperties.sType = VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2;
+    imageFormatProperties.pNext = &performanceQuery;
+
+    VkPhysicalDeviceImageFormatInfo2 formatInfo{};
+    formatInfo.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2;
+    formatInfo.format = m_format;
+    formatInfo.type = m_imageType;
+    formatInfo.tiling = m_tiling;
+    formatInfo.usage = m_usage | VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT;
+    formatInfo.flags = m_createFlags;
+    if (vkGetPhysicalDeviceImageFormatProperties2(m_device->getPhysicalDevice(), &formatInfo,
+                                                  &imageFormatProperties) != VK_SUCCESS) {
+        return false;
+    }
+    return performanceQuery.optimalDeviceAccess == VK_TRUE;
+#else
+    (void)uploadSize;
+    (void)finalImageLayout;
+    return false;
+#endif
+}
+
+void ImageBuilder::uploadDataOnHost(
+    ImageInfo& imageInfo,
+    const std::vector<ImageUploadRegion>& regions,
+    VkImageLayout finalImageLayout) const {
+#if defined(VK_EXT_host_image_copy)
+    VkDevice device = m_device->getLogicalDevice();
+    auto transitionImageLayout = reinterpret_cast<PFN_vkTransitionImageLayoutEXT>(
+        vkGetDeviceProcAddr(device, "vkTransitionImageLayoutEXT"));
+    auto copyMemoryToImage = reinterpret_cast<PFN_vkCopyMemoryToImageEXT>(
+        vkGetDeviceProcAddr(device, "vkCopyMemoryToImageEXT"));
+    if (!transitionImageLayout || !copyMemoryToImage) {
+        throw std::runtime_error("VK_EXT_host_image_copy entry points are not available");
+    }
+
+    // The image is fresh, so the host transition needs no synchronization with the GPU
+    VkHostImageLayoutTransitionInfoEXT transition{};
+    transition.sType = VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO_EXT;
+    transition.image = imageInfo.image;
+    transition.oldLayout = imageInfo.layout;
+    transition.newLayout = finalImageLayout;
+    transition.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, m_mipLevels, 0, m_arrayLayers};
+    if (transitionImageLayout(device, 1, &transition) != VK_SUCCESS) {
+        throw std::runtime_error("failed to transition image layout on the host");
+    }
+
+    // Converted regions need a CPU copy in the image format; others are read in place
+    std::vector<std::vector<uint8_t>> converted(m_sourcePixelFormat ? regions.size() : 0);
+    std::vector<VkMemoryToImageCopyEXT> copies(regions.size());
+    for (size_t i = 0; i < regions.size(); ++i) {
+        const ImageUploadRegion& region = regions[i];
+        const void* source = region.data;
+        if (m_sourcePixelFormat) {
+            converted[i].resize(static_cast<size_t>(FormatUtils::getCopyFootprint(
+                m_format, region.extent, region.rowLength, region.imageHeight, region.layerCount)));
+            const size_t pixelCount = converted[i].size() / FormatUtils::getFormatInfo(m_format).bytesPerBlock;
+            PixelConversion::convert(region.data, *m_sourcePixelFormat, converted[i].data(), m_format, pixelCount, m_premultiplyAlpha);
+            source = converted[i].data();
+        }
+
+        VkMemoryToImageCopyEXT& copy = copies[i];
+        copy.sType = VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY_EXT;
+        copy.pHostPointer = source;
+        copy.memoryRowLength = region.rowLength;
+        copy.memoryImageHeight = region.imageHeight;
+        copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy.imageSubresource.mipLevel = region.mipLevel;
+        copy.imageSubresource.baseArrayLayer = region.baseArrayLayer;
+        copy.imageSubresource.layerCount = region.layerCount;
+        copy.imageOffset = region.offset;
+        copy.imageExtent = region.extent;
+    }
+
+    VkCopyMemoryToImageInfoEXT copyInfo{};
+    copyInfo.sType = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO_EXT;
+    copyInfo.dstImage = imageInfo.image;
+    copyInfo.dstImageLayout = finalImageLayout;
+    copyInfo.regionCount = static_cast<uint32_t>(copies.size());
+    copyInfo.pRegions = copies.data();
+    if (copyMemoryToImage(device, &copyInfo) != VK_SUCCESS) {
+        throw std::runtime_error("failed to copy memory to image on the host");
+    }
+
+    imageInfo.layout = finalImageLayout;
+#else
+    (void)imageInfo;
+    (void)regions;
+    (void)finalImageLayout;
+    throw std::runtime_error("VK_EXT_host_image_copy is not available in these Vulkan headers");
+#endif
+}
+
+VkImageViewType ImageBuilder::resolveViewType() const {
+    if (m_viewType) {
+        return *m_viewType;
+    }
+
+    switch (m_imageType) {
+        case VK_IMAGE_TYPE_1D:
+            return m_arrayLayers > 1 ? VK_IMAGE_VIEW_TYPE_1D_ARRAY : VK_IMAGE_VIEW_TYPE_1D;
+        case VK_IMAGE_TYPE_3D:
+            return VK_IMAGE_VIEW_TYPE_3D;
+        default:
+            if ((m_createFlags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT) && m_arrayLayers % 6 == 0) {
+                return m_arrayLayers == 6 ? VK_IMAGE_VIEW_TYPE_CUBE : VK_IMAGE_VIEW_TYPE_CUBE_ARRAY;
+            }
+            return m_arrayLayers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+    }
 }
 
 ImageInfo ImageBuilder::build(
     const std::string& name,
     VmaAllocation* outAllocation) {
+    return buildImage(name, outAllocation, 0);
+}
+
+ImageInfo ImageBuilder::buildImage(
+    const std::string& name,
+    VmaAllocation* outAllocation,
+    VkImageUsageFlags extraUsage) {
     
     VmaAllocation localAllocation;
     outAllocation = &localAllocation;
 
     validateParameters();
 
+    if (m_fullMipChain) {
+        m_mipLevels = MipGenerator::calculateMipLevels(m_extent.width, m_extent.height, m_extent.depth);
+    }
+
     ImageInfo imageInfo;
-    VkImage image = createImage(&imageInfo.allocation);
-    VkImageView imageView = createImageView(image, VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT, name);
+    VkImage image = createImage(&imageInfo.allocation, extraUsage);
+    VkImageView imageView = createImageView(image, resolveViewType(), VK_IMAGE_ASPECT_COLOR_BIT, name);
     
     imageInfo.image = image;
     imageInfo.imageView = imageView;
     imageInfo.width = m_extent.width;
     imageInfo.height = m_extent.height;
     imageInfo.layout = m_initialLayout;
+    imageInfo.format = m_format;
 
     // Register the image for resource tracking if a name is provided
     if (!name.empty()) {
         m_context->getResourceManager()->registerResource(
-            name, reinterpret_cast<uint64_t>(image), imageView, imageInfo.allocation, m_extent.width, m_extent.height, m_initialLayout, VK_OBJECT_TYPE_IMAGE);
+            name, reinterpret_cast<uint64_t>(image), imageView, imageInfo.allocation, m_extent.width, m_extent.height, m_initialLayout, VK_OBJECT_TYPE_IMAGE,
+            m_usage | extraUsage, m_memoryCategory, m_format);
+
+        if (m_placementDecision.dedicated) {
+            LogDebug("Image '" + name + "' (" + std::to_string(m_placementDecision.size) +
+                     " bytes) placed in dedicated memory: " + m_placementDecision.reason);
+        }
     }
 
     outAllocation = &imageInfo.allocation;
@@ -320,20 +692,189 @@ ImageInfo ImageBuilder::buildAndInitialize(
     if (!data || dataSize == 0) {
         throw std::runtime_error("Invalid data or data size");
     }
-    
+
+    if (m_sourcePixelFormat) {
+        if (m_blockCompression) {
+            throw std::runtime_error("Source pixel conversion cannot be combined with block compression");
+        }
+        if (!PixelConversion::isSupported(*m_sourcePixelFormat, m_format, m_premultiplyAlpha)) {
+            throw std::runtime_error("Unsupported source pixel conversion for image format " + std::to_string(m_format));
+        }
+        const VkDeviceSize sourceSize = static_cast<VkDeviceSize>(m_extent.width) * m_extent.height *
+                                        m_extent.depth * m_arrayLayers * PixelConversion::getPixelSize(*m_sourcePixelFormat);
+        if (dataSize < sourceSize) {
+            throw std::runtime_error("Data size is smaller than the source image");
+        }
+    } else if (!m_blockCompression &&
+               dataSize < FormatUtils::getImageSize(m_format, m_extent.width, m_extent.height, m_extent.depth) * m_arrayLayers) {
+        throw std::runtime_error("Data size is smaller than the image");
+    }
+
+    if (m_blockCompression) {
+        return buildAndInitializeCompressed(data, dataSize, name, outAllocation, finalImageLayout);
+    }
+
+    // Level 0 of every layer; the region path generates the rest of the chain
+    ImageUploadRegion region;
+    region.data = data;
+    region.layerCount = m_arrayLayers;
+    region.extent = m_extent;
+    return buildAndInitialize(std::vector<ImageUploadRegion>{region}, name, outAllocation, finalImageLayout);
+}
+
+ImageInfo ImageBuilder::buildAndInitialize(
+    const std::vector<ImageUploadRegion>& regions,
+    const std::string& name,
+    VmaAllocation* outAllocation,
+    VkImageLayout finalImageLayout) {
+
+    if (regions.empty()) {
+        throw std::runtime_error("No image regions to upload");
+    }
+    if (m_blockCompression) {
+        throw std::runtime_error("Block compression requires a single RGBA8 level; use buildAndInitialize(data, dataSize)");
+    }
+    if (m_sourcePixelFormat && !PixelConversion::isSupported(*m_sourcePixelFormat, m_format, m_premultiplyAlpha)) {
+        throw std::runtime_error("Unsupported source pixel conversion for image format " + std::to_string(m_format));
+    }
 
     // Add transfer destination usage flag
-    m_usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    m_usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
-    // Create the image
-    ImageInfo imageInfo = build(name, outAllocation);
+    if (m_fullMipChain) {
+        m_mipLevels = MipGenerator::calculateMipLevels(m_extent.width, m_extent.height, m_extent.depth);
+    }
 
-    // Upload the data
-    uploadData(imageInfo, data, dataSize, finalImageLayout);
+    // Resolve whole-level regions and check every region against the image
+    std::vector<ImageUploadRegion> resolved(regions);
+    bool providesMips = false;
+    for (ImageUploadRegion& region : resolved) {
+        if (!region.data) {
+            throw std::runtime_error("Image upload region has no data");
+        }
+        if (region.mipLevel >= m_mipLevels) {
+            throw std::runtime_error("Image upload region targets mip level " + std::to_string(region.mipLevel) +
+                                     " of an image with " + std::to_string(m_mipLevels));
+        }
+        if (region.layerCount == 0 || region.baseArrayLayer + region.layerCount > m_arrayLayers) {
+            throw std::runtime_error("Image upload region layers exceed the image's array layers");
+        }
+        if (region.extent.width == 0 || region.extent.height == 0 || region.extent.depth == 0) {
+            region.offset = {0, 0, 0};
+            region.extent = {
+                std::max(m_extent.width >> region.mipLevel, 1u),
+                std::max(m_extent.height >> region.mipLevel, 1u),
+                std::max(m_extent.depth >> region.mipLevel, 1u)};
+        }
+        providesMips = providesMips || region.mipLevel > 0;
+    }
+
+    // Uploads that need no generated mips can skip staging and the queue entirely
+    const bool generatesMips = m_mipLevels > 1 && !providesMips;
+    if (!generatesMips) {
+        VkDeviceSize uploadSize = 0;
+        for (const ImageUploadRegion& region : resolved) {
+            uploadSize += FormatUtils::getCopyFootprint(m_format, region.extent, region.rowLength,
+                                                        region.imageHeight, region.layerCount);
+        }
+        if (canUseHostImageCopy(uploadSize, finalImageLayout)) {
+            // Only this image gets host transfer usage, the builder keeps its own
+#if defined(VK_EXT_host_image_copy)
+            ImageInfo imageInfo = buildImage(name, outAllocation, VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT);
+#else
+            ImageInfo imageInfo = build(name, outAllocation);
+#endif
+            uploadDataOnHost(imageInfo, resolved, finalImageLayout);
+            return imageInfo;
+        }
+    }
+
+    MipGenerator blitGenerator(m_device);
+    MipGenerator* mipGenerator = m_mipGenerator ? m_mipGenerator : &blitGenerator;
+
+    // Level-0-only uploads get the rest of the chain generated; full chains are copied as is
+    MipGenerationMode mipMode = MipGenerationMode::None;
+    if (generatesMips) {
+        mipMode = mipGenerator->resolveMode(m_mipGenerationMode, m_format, m_imageType);
+        m_usage |= MipGenerator::getRequiredUsage(mipMode);
+        m_createFlags |= MipGenerator::getRequiredCreateFlags(mipMode, m_format);
+    }
 
+    ImageInfo imageInfo = build(name, outAllocation);
+    uploadData(imageInfo, resolved, finalImageLayout, mipGenerator, mipMode);
 
     return imageInfo;
+}
 
+ImageInfo ImageBuilder::buildAndInitializeCompressed(
+    const void* data,
+    VkDeviceSize dataSize,
+    const std::string& name,
+    VmaAllocation* outAllocation,
+    VkImageLayout finalImageLayout) {
+
+    if (m_format != VK_FORMAT_R8G8B8A8_UNORM && m_format != VK_FORMAT_R8G8B8A8_SRGB) {
+        throw std::runtime_error("Block compression requires R8G8B8A8 source data");
+    }
+    if (m_imageType != VK_IMAGE_TYPE_2D || m_extent.depth != 1 || m_arrayLayers != 1) {
+        throw std::runtime_error("Block compression supports single-layer 2D images only");
+    }
+    if (dataSize < static_cast<VkDeviceSize>(m_extent.width) * m_extent.height * 4) {
+        throw std::runtime_error("Data size is smaller than the RGBA8 image");
+    }
+
+    const bool srgb = m_format == VK_FORMAT_R8G8B8A8_SRGB;
+    if (m_fullMipChain) {
+        m_mipLevels = MipGenerator::calculateMipLevels(m_extent.width, m_extent.height, 1);
+    }
+
+    // Filter and encode every level up front; the GPU cannot blit into BCn images
+    std::vector<std::vector<uint8_t>> levels(m_mipLevels);
+    std::vector<uint8_t> current;
+    std::vector<uint8_t> next;
+    const uint8_t* source = static_cast<const uint8_t*>(data);
+    uint32_t width = m_extent.width;
+    uint32_t height = m_extent.height;
+    for (uint32_t level = 0; level < m_mipLevels; ++level) {
+        levels[level] = BlockCompression::compressImage(source, width, height, *m_blockCompression, m_compressionPool);
+        if (level + 1 < m_mipLevels) {
+            BlockCompression::downsampleRGBA8(source, width, height, srgb, next);
+            current.swap(next);
+            source = current.data();
+            width = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+        }
+    }
+
+    const VkFormat sourceFormat = m_format;
+    m_format = BlockCompression::toVkFormat(*m_blockCompression, srgb);
+    m_usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    m_fullMipChain = false;
+
+    ImageInfo imageInfo = build(name, outAllocation);
+    m_format = sourceFormat;
+
+    std::vector<ImageUploadRegion> regions(m_mipLevels);
+    for (uint32_t level = 0; level < m_mipLevels; ++level) {
+        regions[level].data = levels[level].data();
+        regions[level].mipLevel = level;
+        regions[level].extent = {
+            std::max(m_extent.width >> level, 1u),
+            std::max(m_extent.height >> level, 1u),
+            1};
+    }
+
+    ResourceUtils::uploadImageRegions(
+        m_device,
+        m_context->getCommandPoolManager()->getSingleTimeCommandPool(),
+        imageInfo.image,
+        BlockCompression::toVkFormat(*m_blockCompression, srgb),
+        regions,
+        imageInfo.layout,
+        finalImageLayout);
+    imageInfo.layout = finalImageLayout;
+
+    return imageInfo;
 }
 
 VkImageView ImageBuilder::createImageView(
@@ -104,9 +104,7 @@ void SamplerBuilder::validateParameters() const {
     }
 }
 
-VkSampler SamplerBuilder::build(const std::string& name) {
-    validateParameters();
-
+VkSamplerCreateInfo SamplerBuilder::makeCreateInfo() const {
     VkSamplerCreateInfo samplerInfo{};
     samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
     samplerInfo.magFilter = m_magFilter;
@@ -124,6 +122,13 @@ VkSampler SamplerBuilder::build(const std::string& name) {
     samplerInfo.maxLod = m_maxLod;
     samplerInfo.borderColor = m_borderColor;
     samplerInfo.unnormalizedCoordinates = m_unnormalizedCoordinates;
+    return samplerInfo;
+}
+
+VkSampler SamplerBuilder::build(const std::string& name) {
+    validateParameters();
+
+    VkSamplerCreateInfo samplerInfo = makeCreateInfo();
 
     VkSampler sampler;
     if (vkCreateSampler(m_device->getLogicalDevice(), &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
@@ -139,4 +144,9 @@ VkSampler SamplerBuilder::build(const std::string& name) {
     return sampler;
 }
 
-} // namespace ev 
\ No newline at end of file
+VkSampler SamplerBuilder::buildShared() {
+    validateParameters();
+    return m_context->getResourceManager()->getSamplerCache()->acquire(makeCreateInfo());
+}
+
+} // namespace ev
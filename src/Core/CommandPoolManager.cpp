@@ -76,6 +76,9 @@ VkCommandBuffer CommandPoolManager::beginSingleTimeCommands() {
 void CommandPoolManager::endSingleTimeCommands(VkCommandBuffer commandBuffer) {
     vkEndCommandBuffer(commandBuffer);
 
+    // Make pending host writes (e.g. staging data) visible before the GPU reads them
+    m_device->flushMappedRanges();
+
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.commandBufferCount = 1;
@@ -0,0 +1,334 @@
+#include "EasyVulkan/Core/DrawQueue.hpp"
+#include "EasyVulkan/Core/ThreadPool.hpp"
+#include "EasyVulkan/Utils/CommandUtils.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace ev {
+
+namespace {
+
+constexpr uint32_t RadixBits = 8;
+constexpr uint32_t RadixBuckets = 1u << RadixBits;
+constexpr uint32_t RadixPasses = 64 / RadixBits;
+
+// Smallest key range worth handing to a worker
+constexpr uint32_t MinChunkSize = 8192;
+
+inline uint32_t digitOf(uint64_t key, uint32_t pass) {
+    return static_cast<uint32_t>(key >> (pass * RadixBits)) & (RadixBuckets - 1);
+}
+
+} // namespace
+
+DrawQueue::DrawQueue(ThreadPool* pool) : m_pool(pool) {}
+
+uint16_t DrawQueue::addPipeline(VkPipeline pipeline, VkPipelineLayout layout) {
+    if (m_pipelines.size() >= (1u << DrawSortKey::PipelineBits)) {
+        throw std::runtime_error("DrawQueue: at most " + std::to_string(1u << DrawSortKey::PipelineBits) +
+                                 " pipelines can be registered");
+    }
+
+    PipelineEntry entry;
+    entry.pipeline = pipeline;
+    entry.layout = layout;
+    auto it = std::find(m_layouts.begin(), m_layouts.end(), layout);
+    entry.layoutIndex = static_cast<uint32_t>(it - m_layouts.begin());
+    if (it == m_layouts.end()) {
+        m_layouts.push_back(layout);
+    }
+    m_pipelines.push_back(entry);
+    return static_cast<uint16_t>(m_pipelines.size() - 1);
+}
+
+uint16_t DrawQueue::addMaterial(VkDescriptorSet descriptorSet, uint32_t firstSet) {
+    if (m_materials.size() >= DrawPacket::NoMaterial) {
+        throw std::runtime_error("DrawQueue: at most " + std::to_string(DrawPacket::NoMaterial) +
+                                 " materials can be registered");
+    }
+    m_materials.push_back({descriptorSet, firstSet});
+    return static_cast<uint16_t>(m_materials.size() - 1);
+}
+
+uint16_t DrawQueue::addMesh(
+    const std::vector<VkBuffer>& vertexBuffers,
+    const std::vector<VkDeviceSize>& offsets,
+    VkBuffer indexBuffer,
+    VkDeviceSize indexOffset,
+    VkIndexType indexType) {
+
+    if (vertexBuffers.size() != offsets.size()) {
+        throw std::runtime_error("DrawQueue: vertex buffer and offset counts differ");
+    }
+    if (m_meshes.size() >= (1u << DrawSortKey::MeshBits)) {
+        throw std::runtime_error("DrawQueue: at most " + std::to_string(1u << DrawSortKey::MeshBits) +
+                                 " meshes can be registered");
+    }
+
+    // Meshes sharing buffers share a binding, so switching between them binds nothing
+    MeshEntry mesh;
+    auto vertexIt = std::find_if(m_vertexBindings.begin(), m_vertexBindings.end(),
+                                 [&](const VertexBinding& binding) {
+                                     return binding.buffers == vertexBuffers && binding.offsets == offsets;
+                                 });
+    mesh.vertexBinding = static_cast<uint32_t>(vertexIt - m_vertexBindings.begin());
+    if (vertexIt == m_vertexBindings.end()) {
+        m_vertexBindings.push_back({vertexBuffers, offsets});
+    }
+
+    mesh.indexBinding = NoBinding;
+    if (indexBuffer != VK_NULL_HANDLE) {
+        auto indexIt = std::find_if(m_indexBindings.begin(), m_indexBindings.end(),
+                                    [&](const IndexBinding& binding) {
+                                        return binding.buffer == indexBuffer && binding.offset == indexOffset &&
+                                               binding.indexType == indexType;
+                                    });
+        mesh.indexBinding = static_cast<uint32_t>(indexIt - m_indexBindings.begin());
+        if (indexIt == m_indexBindings.end()) {
+            m_indexBindings.push_back({indexBuffer, indexOffset, indexType});
+        }
+    }
+
+    m_meshes.push_back(mesh);
+    return static_cast<uint16_t>(m_meshes.size() - 1);
+}
+
+uint16_t DrawQueue::addMesh(const GeometryPool& geometry) {
+    return addMesh({geometry.getVertexBuffer()}, {0}, geometry.getIndexBuffer(), 0, geometry.getIndexType());
+}
+
+void DrawQueue::submit(uint64_t key, const DrawPacket& packet) {
+    validatePacket(packet);
+    m_order.push_back(static_cast<uint32_t>(m_packets.size()));
+    m_packets.push_back(packet);
+    m_keys.push_back(key);
+}
+
+void DrawQueue::submit(const DrawPacket& packet, uint32_t pass, float viewDepth, bool backToFront) {
+    const uint32_t depth = DrawSortKey::quantizeDepth(viewDepth);
+    submit(backToFront
+               ? DrawSortKey::makeBackToFront(pass, depth, packet.pipeline, packet.material, packet.mesh)
+               : DrawSortKey::make(pass, packet.pipeline, packet.material, packet.mesh, depth),
+           packet);
+}
+
+void DrawQueue::sort() {
+    const uint32_t drawCount = getDrawCount();
+    std::iota(m_order.begin(), m_order.end(), 0u);
+    m_submittedStats = countStateChanges();
+
+    m_sortKeys.assign(m_keys.begin(), m_keys.end());
+    if (drawCount > 1) {
+        radixSort();
+    }
+    m_sortedStats = countStateChanges();
+}
+
+void DrawQueue::radixSort() {
+    const uint32_t drawCount = getDrawCount();
+    m_scratchKeys.resize(drawCount);
+    m_scratchOrder.resize(drawCount);
+
+    uint32_t chunkCount = 1;
+    if (m_pool && drawCount >= m_parallelThreshold) {
+        chunkCount = std::clamp(drawCount / MinChunkSize, 1u, m_pool->getThreadCount() * 4);
+    }
+    const uint32_t chunkSize = (drawCount + chunkCount - 1) / chunkCount;
+    chunkCount = (drawCount + chunkSize - 1) / chunkSize;
+    auto forEachChunk = [&](const std::function<void(uint32_t chunk, uint32_t begin, uint32_t end)>& body) {
+        auto run = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t c = begin; c < end; ++c) {
+                body(c, c * chunkSize, std::min((c + 1) * chunkSize, drawCount));
+            }
+        };
+        if (chunkCount > 1) {
+            m_pool->parallelFor(chunkCount, run);
+        } else {
+            run(0, 1);
+        }
+    };
+
+    // Histograms of every byte in one read; a byte all keys share needs no pass
+    std::array<std::array<uint32_t, RadixBuckets>, RadixPasses> totals{};
+    for (uint64_t key : m_sortKeys) {
+        for (uint32_t pass = 0; pass < RadixPasses; ++pass) {
+            ++totals[pass][digitOf(key, pass)];
+        }
+    }
+
+    m_chunkCounts.resize(chunkCount);
+    for (uint32_t pass = 0; pass < RadixPasses; ++pass) {
+        if (totals[pass][digitOf(m_sortKeys[0], pass)] == drawCount) {
+            continue;
+        }
+
+        const uint64_t* srcKeys = m_sortKeys.data();
+        const uint32_t* srcOrder = m_order.data();
+        uint64_t* dstKeys = m_scratchKeys.data();
+        uint32_t* dstOrder = m_scratchOrder.data();
+
+        if (chunkCount > 1) {
+            forEachChunk([&](uint32_t chunk, uint32_t begin, uint32_t end) {
+                std::array<uint32_t, RadixBuckets>& counts = m_chunkCounts[chunk];
+                counts.fill(0);
+                for (uint32_t i = begin; i < end; ++i) {
+                    ++counts[digitOf(srcKeys[i], pass)];
+                }
+            });
+        } else {
+            m_chunkCounts[0] = totals[pass];
+        }
+
+        // Bucket b of chunk c starts after all smaller buckets and after bucket b
+        // of the earlier chunks, which keeps the sort stable
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < RadixBuckets; ++bucket) {
+            for (uint32_t c = 0; c < chunkCount; ++c) {
+                const uint32_t count = m_chunkCounts[c][bucket];
+                m_chunkCounts[c][bucket] = offset;
+                offset += count;
+            }
+        }
+
+        forEachChunk([&](uint32_t chunk, uint32_t begin, uint32_t end) {
+            std::array<uint32_t, RadixBuckets>& offsets = m_chunkCounts[chunk];
+            for (uint32_t i = begin; i < end; ++i) {
+                const uint32_t dst = offsets[digitOf(srcKeys[i], pass)]++;
+                dstKeys[dst] = srcKeys[i];
+                dstOrder[dst] = srcOrder[i];
+            }
+        });
+
+        m_sortKeys.swap(m_scratchKeys);
+        m_order.swap(m_scratchOrder);
+    }
+}
+
+void DrawQueue::record(VkCommandBuffer commandBuffer) {
+    BoundState state;
+    DrawQueueStats stats;
+    uint32_t pass = NoBinding;
+    for (uint32_t index : m_order) {
+        const uint32_t packetPass = DrawSortKey::getPass(m_keys[index]);
+        if (packetPass != pass) {
+            pass = packetPass;
+            state = BoundState{};
+        }
+        bindPacket(commandBuffer, m_packets[index], state, stats);
+    }
+}
+
+void DrawQueue::record(VkCommandBuffer commandBuffer, uint32_t pass) {
+    BoundState state;
+    DrawQueueStats stats;
+    for (uint32_t index : m_order) {
+        if (DrawSortKey::getPass(m_keys[index]) == pass) {
+            bindPacket(commandBuffer, m_packets[index], state, stats);
+        }
+    }
+}
+
+void DrawQueue::clear() {
+    m_packets.clear();
+    m_keys.clear();
+    m_order.clear();
+    m_sortKeys.clear();
+}
+
+void DrawQueue::recordDraw(VkCommandBuffer commandBuffer, const DrawPacket& packet, bool indexed) {
+    if (indexed) {
+        CommandUtils::drawIndexed(commandBuffer, packet.count, packet.instanceCount, packet.firstIndex,
+                                  packet.vertexOffset, packet.firstInstance);
+    } else {
+        CommandUtils::draw(commandBuffer, packet.count, packet.instanceCount, packet.firstIndex,
+                           packet.firstInstance);
+    }
+}
+
+void DrawQueue::bindPacket(VkCommandBuffer commandBuffer, const DrawPacket& packet, BoundState& state,
+                           DrawQueueStats& stats) {
+    const PipelineEntry& pipeline = m_pipelines[packet.pipeline];
+    if (packet.pipeline != state.pipeline) {
+        state.pipeline = packet.pipeline;
+        ++stats.pipelineBinds;
+        if (commandBuffer != VK_NULL_HANDLE) {
+            CommandUtils::bindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.pipeline);
+        }
+        // Sets bound through another layout may be disturbed, so rebind the material
+        if (pipeline.layoutIndex != state.layout) {
+            state.layout = pipeline.layoutIndex;
+            state.material = NoBinding;
+        }
+    }
+
+    if (packet.material != DrawPacket::NoMaterial && packet.material != state.material) {
+        state.material = packet.material;
+        ++stats.descriptorSetBinds;
+        if (commandBuffer != VK_NULL_HANDLE) {
+            const MaterialEntry& material = m_materials[packet.material];
+            CommandUtils::bindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.layout,
+                                             material.firstSet, {material.descriptorSet});
+        }
+    }
+
+    const MeshEntry& mesh = m_meshes[packet.mesh];
+    if (mesh.vertexBinding != state.vertexBinding) {
+        state.vertexBinding = mesh.vertexBinding;
+        const VertexBinding& binding = m_vertexBindings[mesh.vertexBinding];
+        if (!binding.buffers.empty()) {
+            ++stats.vertexBufferBinds;
+            if (commandBuffer != VK_NULL_HANDLE) {
+                CommandUtils::bindVertexBuffers(commandBuffer, 0, binding.buffers, binding.offsets);
+            }
+        }
+    }
+    if (mesh.indexBinding != NoBinding && mesh.indexBinding != state.indexBinding) {
+        state.indexBinding = mesh.indexBinding;
+        ++stats.indexBufferBinds;
+        if (commandBuffer != VK_NULL_HANDLE) {
+            const IndexBinding& binding = m_indexBindings[mesh.indexBinding];
+            CommandUtils::bindIndexBuffer(commandBuffer, binding.buffer, binding.offset, binding.indexType);
+        }
+    }
+
+    ++stats.drawCount;
+    if (commandBuffer != VK_NULL_HANDLE) {
+        recordDraw(commandBuffer, packet, mesh.indexBinding != NoBinding);
+    }
+}
+
+DrawQueueStats DrawQueue::countStateChanges() {
+    BoundState state;
+    DrawQueueStats stats;
+    uint32_t pass = NoBinding;
+    for (uint32_t index : m_order) {
+        const uint32_t packetPass = DrawSortKey::getPass(m_keys[index]);
+        if (packetPass != pass) {
+            pass = packetPass;
+            state = BoundState{};
+        }
+        bindPacket(VK_NULL_HANDLE, m_packets[index], state, stats);
+    }
+    return stats;
+}
+
+void DrawQueue::validatePacket(const DrawPacket& packet) const {
+    if (packet.pipeline >= m_pipelines.size()) {
+        throw std::runtime_error("DrawQueue: packet references unregistered pipeline " +
+                                 std::to_string(packet.pipeline));
+    }
+    if (packet.material != DrawPacket::NoMaterial && packet.material >= m_materials.size()) {
+        throw std::runtime_error("DrawQueue: packet references unregistered material " +
+                                 std::to_string(packet.material));
+    }
+    if (packet.mesh >= m_meshes.size()) {
+        throw std::runtime_error("DrawQueue: packet references unregistered mesh " +
+                                 std::to_string(packet.mesh));
+    }
+}
+
+} // namespace ev
@@ -0,0 +1,272 @@
+#include "EasyVulkan/Core/GeometryPool.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+#include "EasyVulkan/Core/VulkanContext.hpp"
+#include "EasyVulkan/Core/CommandPoolManager.hpp"
+#include "EasyVulkan/Builders/BufferBuilder.hpp"
+#include "EasyVulkan/Utils/MemoryUtils.hpp"
+
+#include <cstring>
+
+namespace ev {
+
+namespace {
+
+VkBuffer createDeviceBuffer(VulkanDevice* device, VkDeviceSize size, VkBufferUsageFlags usage, VmaAllocation* outAllocation) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    VkBuffer buffer;
+    if (vmaCreateBuffer(device->getAllocator(), &bufferInfo, &allocInfo, &buffer, outAllocation, nullptr) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create geometry pool buffer!");
+    }
+    return buffer;
+}
+
+VmaVirtualBlock createRangeAllocator(VkDeviceSize capacity) {
+    VmaVirtualBlockCreateInfo blockInfo{};
+    blockInfo.size = capacity;
+
+    VmaVirtualBlock block;
+    if (vmaCreateVirtualBlock(&blockInfo, &block) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create geometry pool range allocator!");
+    }
+    return block;
+}
+
+} // namespace
+
+GeometryPool::GeometryPool(
+    VulkanDevice* device,
+    VulkanContext* context,
+    uint32_t vertexStride,
+    uint32_t vertexCapacity,
+    uint32_t indexCapacity,
+    VkIndexType indexType)
+    : m_device(device)
+    , m_context(context)
+    , m_vertexStride(vertexStride)
+    , m_indexSize(indexType == VK_INDEX_TYPE_UINT16 ? 2u : 4u)
+    , m_indexType(indexType) {
+
+    if (!m_device || !m_context) {
+        throw std::runtime_error("GeometryPool requires a valid device and context");
+    }
+    if (vertexStride == 0 || vertexCapacity == 0 || indexCapacity == 0) {
+        throw std::runtime_error("GeometryPool needs a non-zero stride and capacities");
+    }
+    if (indexType != VK_INDEX_TYPE_UINT16 && indexType != VK_INDEX_TYPE_UINT32) {
+        throw std::runtime_error("GeometryPool supports 16- and 32-bit indices only");
+    }
+
+    // Ranges are counted in elements, so offsets are vertex and index numbers
+    try {
+        m_vertexBlock = createRangeAllocator(vertexCapacity);
+        m_indexBlock = createRangeAllocator(indexCapacity);
+        m_vertexBuffer = createDeviceBuffer(m_device, static_cast<VkDeviceSize>(vertexCapacity) * vertexStride,
+                                            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, &m_vertexAllocation);
+        m_indexBuffer = createDeviceBuffer(m_device, static_cast<VkDeviceSize>(indexCapacity) * m_indexSize,
+                                           VK_BUFFER_USAGE_INDEX_BUFFER_BIT, &m_indexAllocation);
+    } catch (...) {
+        // The destructor does not run for a failed constructor
+        cleanup();
+        throw;
+    }
+}
+
+GeometryPool::~GeometryPool() {
+    cleanup();
+}
+
+void GeometryPool::cleanup() {
+    if (m_vertexBuffer != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(m_device->getAllocator(), m_vertexBuffer, m_vertexAllocation);
+    }
+    if (m_indexBuffer != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(m_device->getAllocator(), m_indexBuffer, m_indexAllocation);
+    }
+    // Live meshes die with the pool; the blocks must be empty before destruction
+    if (m_vertexBlock != VK_NULL_HANDLE) {
+        vmaClearVirtualBlock(m_vertexBlock);
+        vmaDestroyVirtualBlock(m_vertexBlock);
+    }
+    if (m_indexBlock != VK_NULL_HANDLE) {
+        vmaClearVirtualBlock(m_indexBlock);
+        vmaDestroyVirtualBlock(m_indexBlock);
+    }
+    m_vertexBuffer = VK_NULL_HANDLE;
+    m_indexBuffer = VK_NULL_HANDLE;
+    m_vertexBlock = VK_NULL_HANDLE;
+    m_indexBlock = VK_NULL_HANDLE;
+}
+
+GeometryAllocation GeometryPool::add(const void* vertices, uint32_t vertexCount, const void* indices, uint32_t indexCount) {
+    if (!vertices || !indices || vertexCount == 0 || indexCount == 0) {
+        throw std::runtime_error("GeometryPool::add needs vertices and indices");
+    }
+
+    GeometryAllocation allocation;
+    VkDeviceSize vertexOffset = 0;
+    VkDeviceSize indexOffset = 0;
+
+    VmaVirtualAllocationCreateInfo rangeInfo{};
+    rangeInfo.size = vertexCount;
+    if (vmaVirtualAllocate(m_vertexBlock, &rangeInfo, &allocation.vertexRange, &vertexOffset) != VK_SUCCESS) {
+        LogError("GeometryPool vertex buffer is full");
+        throw std::runtime_error("GeometryPool vertex buffer is full");
+    }
+    rangeInfo.size = indexCount;
+    if (vmaVirtualAllocate(m_indexBlock, &rangeInfo, &allocation.indexRange, &indexOffset) != VK_SUCCESS) {
+        vmaVirtualFree(m_vertexBlock, allocation.vertexRange);
+        LogError("GeometryPool index buffer is full");
+        throw std::runtime_error("GeometryPool index buffer is full");
+    }
+
+    allocation.firstIndex = static_cast<uint32_t>(indexOffset);
+    allocation.vertexOffset = static_cast<int32_t>(vertexOffset);
+    allocation.indexCount = indexCount;
+    allocation.vertexCount = vertexCount;
+
+    // Keep a copy so callers may free their arrays before flush()
+    PendingUpload upload;
+    upload.vertexOffset = vertexOffset * m_vertexStride;
+    upload.indexOffset = indexOffset * m_indexSize;
+    upload.vertices.resize(static_cast<size_t>(vertexCount) * m_vertexStride);
+    upload.indices.resize(static_cast<size_t>(indexCount) * m_indexSize);
+    std::memcpy(upload.vertices.data(), vertices, upload.vertices.size());
+    std::memcpy(upload.indices.data(), indices, upload.indices.size());
+    m_pending.push_back(std::move(upload));
+
+    return allocation;
+}
+
+void GeometryPool::flush() {
+    if (m_pending.empty()) {
+        return;
+    }
+
+    // Vertices then indices of every pending mesh, back to back in one staging buffer
+    VkDeviceSize stagingSize = 0;
+    for (const PendingUpload& upload : m_pending) {
+        stagingSize += upload.vertices.size() + upload.indices.size();
+    }
+
+    // Reserved up front so nothing below can throw while the staging memory is mapped
+    std::vector<VkBufferCopy> vertexCopies;
+    std::vector<VkBufferCopy> indexCopies;
+    vertexCopies.reserve(m_pending.size());
+    indexCopies.reserve(m_pending.size());
+
+    VmaAllocation stagingAllocation;
+    BufferBuilder stagingBuilder(m_device, m_context);
+    VkBuffer stagingBuffer = stagingBuilder
+        .setSize(stagingSize)
+        .setUsage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+        .setMemoryUsage(VMA_MEMORY_USAGE_CPU_ONLY)
+        .setMemoryFlags(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
+        .build("", &stagingAllocation);
+
+    VmaAllocator allocator = m_device->getAllocator();
+    void* mappedData = MemoryUtils::getMappedData(m_device, stagingAllocation);
+    const bool persistent = mappedData != nullptr;
+    if (!persistent && vmaMapMemory(allocator, stagingAllocation, &mappedData) != VK_SUCCESS) {
+        vmaDestroyBuffer(allocator, stagingBuffer, stagingAllocation);
+        throw std::runtime_error("failed to map geometry staging memory");
+    }
+    uint8_t* mapped = static_cast<uint8_t*>(mappedData);
+
+    VkDeviceSize cursor = 0;
+    for (const PendingUpload& upload : m_pending) {
+        std::memcpy(mapped + cursor, upload.vertices.data(), upload.vertices.size());
+        vertexCopies.push_back({cursor, upload.vertexOffset, upload.vertices.size()});
+        cursor += upload.vertices.size();
+
+        std::memcpy(mapped + cursor, upload.indices.data(), upload.indices.size());
+        indexCopies.push_back({cursor, upload.indexOffset, upload.indices.size()});
+        cursor += upload.indices.size();
+    }
+    vmaFlushAllocation(allocator, stagingAllocation, 0, stagingSize);
+    if (!persistent) {
+        vmaUnmapMemory(allocator, stagingAllocation);
+    }
+
+    // The staging buffer is tracked nowhere else, release it if the submit fails
+    try {
+        auto cmdPool = m_context->getCommandPoolManager();
+        VkCommandBuffer cmdBuffer = cmdPool->beginSingleTimeCommands();
+        vkCmdCopyBuffer(cmdBuffer, stagingBuffer, m_vertexBuffer,
+                        static_cast<uint32_t>(vertexCopies.size()), vertexCopies.data());
+        vkCmdCopyBuffer(cmdBuffer, stagingBuffer, m_indexBuffer,
+                        static_cast<uint32_t>(indexCopies.size()), indexCopies.data());
+        recordUploadBarrier(cmdBuffer);
+        cmdPool->endSingleTimeCommands(cmdBuffer);
+    } catch (...) {
+        vmaDestroyBuffer(allocator, stagingBuffer, stagingAllocation);
+        throw;
+    }
+
+    vmaDestroyBuffer(allocator, stagingBuffer, stagingAllocation);
+    m_pending.clear();
+}
+
+void GeometryPool::remove(GeometryAllocation& allocation) {
+    if (allocation.vertexRange != VK_NULL_HANDLE) {
+        vmaVirtualFree(m_vertexBlock, allocation.vertexRange);
+    }
+    if (allocation.indexRange != VK_NULL_HANDLE) {
+        vmaVirtualFree(m_indexBlock, allocation.indexRange);
+    }
+    allocation = GeometryAllocation{};
+}
+
+void GeometryPool::bind(VkCommandBuffer commandBuffer) const {
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_vertexBuffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer, 0, m_indexType);
+}
+
+void GeometryPool::draw(VkCommandBuffer commandBuffer, const GeometryAllocation& allocation,
+                        uint32_t instanceCount, uint32_t firstInstance) const {
+    vkCmdDrawIndexed(commandBuffer, allocation.indexCount, instanceCount,
+                     allocation.firstIndex, allocation.vertexOffset, firstInstance);
+}
+
+VkDrawIndexedIndirectCommand GeometryPool::makeDrawCommand(const GeometryAllocation& allocation,
+                                                           uint32_t instanceCount,
+                                                           uint32_t firstInstance) {
+    VkDrawIndexedIndirectCommand command{};
+    command.indexCount = allocation.indexCount;
+    command.instanceCount = instanceCount;
+    command.firstIndex = allocation.firstIndex;
+    command.vertexOffset = allocation.vertexOffset;
+    command.firstInstance = firstInstance;
+    return command;
+}
+
+uint32_t GeometryPool::getUsedVertexCount() const {
+    VmaStatistics stats{};
+    vmaGetVirtualBlockStatistics(m_vertexBlock, &stats);
+    return static_cast<uint32_t>(stats.allocationBytes);
+}
+
+uint32_t GeometryPool::getUsedIndexCount() const {
+    VmaStatistics stats{};
+    vmaGetVirtualBlockStatistics(m_indexBlock, &stats);
+    return static_cast<uint32_t>(stats.allocationBytes);
+}
+
+void GeometryPool::recordUploadBarrier(VkCommandBuffer commandBuffer) {
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+} // namespace ev
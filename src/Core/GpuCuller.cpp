@@ -0,0 +1,361 @@
+#include "EasyVulkan/Core/GpuCuller.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+#include "EasyVulkan/Core/VulkanContext.hpp"
+#include "EasyVulkan/Builders/ComputePipelineBuilder.hpp"
+#include "EasyVulkan/Utils/CommandUtils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace ev {
+
+namespace {
+
+// Local size of ev_cull.glsl
+constexpr uint32_t kGroupSize = 64;
+
+// vkCmdUpdateBuffer writes at most this many bytes per call
+constexpr VkDeviceSize kMaxUpdateSize = 65536;
+
+VkBuffer createDeviceBuffer(VulkanDevice* device, VkDeviceSize size, VkBufferUsageFlags usage, VmaAllocation* outAllocation) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    VkBuffer buffer;
+    if (vmaCreateBuffer(device->getAllocator(), &bufferInfo, &allocInfo, &buffer, outAllocation, nullptr) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create GPU culler buffer!");
+    }
+    return buffer;
+}
+
+void updateBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size, const void* data) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (VkDeviceSize done = 0; done < size; done += kMaxUpdateSize) {
+        const VkDeviceSize chunk = std::min(kMaxUpdateSize, size - done);
+        vkCmdUpdateBuffer(commandBuffer, buffer, offset + done, chunk, bytes + done);
+    }
+}
+
+} // namespace
+
+GpuCuller::GpuCuller(
+    VulkanDevice* device,
+    VulkanContext* context,
+    uint32_t capacity,
+    VkShaderModule cullShader,
+    VkShaderModule occlusionShader)
+    : m_device(device)
+    , m_context(context)
+    , m_capacity(capacity) {
+
+    if (!m_device || !m_context) {
+        throw std::runtime_error("GpuCuller requires a valid device and context");
+    }
+    if (capacity == 0) {
+        throw std::runtime_error("GpuCuller needs a non-zero capacity");
+    }
+    if (cullShader == VK_NULL_HANDLE) {
+        throw std::runtime_error("GpuCuller requires the ev_cull.comp shader module");
+    }
+
+    m_compact = m_device->isDrawIndirectCountEnabled();
+    if (!m_compact) {
+        LogWarning("drawIndirectCount is not enabled, GpuCuller falls back to zero-instance draws");
+    }
+    if (!m_device->getEnabledFeatures().multiDrawIndirect) {
+        LogWarning("multiDrawIndirect is not enabled, GpuCuller::draw() needs it for more than one draw");
+    }
+
+    m_objects.resize(capacity);
+    m_draws.resize(capacity);
+
+    try {
+        m_objectBuffer = createDeviceBuffer(m_device, sizeof(GpuCullObject) * static_cast<VkDeviceSize>(capacity),
+                                            0, &m_objectAllocation);
+        m_drawBuffer = createDeviceBuffer(m_device, sizeof(VkDrawIndexedIndirectCommand) * static_cast<VkDeviceSize>(capacity),
+                                          0, &m_drawAllocation);
+        m_commandBuffer = createDeviceBuffer(m_device, sizeof(VkDrawIndexedIndirectCommand) * static_cast<VkDeviceSize>(capacity),
+                                             VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, &m_commandAllocation);
+        m_countBuffer = createDeviceBuffer(m_device, sizeof(uint32_t), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, &m_countAllocation);
+
+        VkDevice logicalDevice = m_device->getLogicalDevice();
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+        if (vkCreateSampler(logicalDevice, &samplerInfo, nullptr, &m_hiZSampler) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create GPU culler sampler!");
+        }
+
+        // Binding 4 is only read by the occlusion pipeline; it stays unwritten until
+        // setOcclusionPyramid()
+        std::array<VkDescriptorSetLayoutBinding, 5> bindings{};
+        for (uint32_t i = 0; i < 4; ++i) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        bindings[4].binding = 4;
+        bindings[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[4].descriptorCount = 1;
+        bindings[4].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+        setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setLayoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        setLayoutInfo.pBindings = bindings.data();
+        if (vkCreateDescriptorSetLayout(logicalDevice, &setLayoutInfo, nullptr, &m_setLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create GPU culler descriptor set layout!");
+        }
+
+        std::array<VkDescriptorPoolSize, 2> poolSizes{};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSizes[0].descriptorCount = 4;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[1].descriptorCount = 1;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        if (vkCreateDescriptorPool(logicalDevice, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create GPU culler descriptor pool!");
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = m_descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &m_setLayout;
+        if (vkAllocateDescriptorSets(logicalDevice, &allocInfo, &m_descriptorSet) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate GPU culler descriptor set!");
+        }
+
+        const std::array<VkBuffer, 4> buffers = {m_objectBuffer, m_drawBuffer, m_commandBuffer, m_countBuffer};
+        std::array<VkDescriptorBufferInfo, 4> bufferInfos{};
+        std::array<VkWriteDescriptorSet, 4> writes{};
+        for (uint32_t i = 0; i < 4; ++i) {
+            bufferInfos[i].buffer = buffers[i];
+            bufferInfos[i].offset = 0;
+            bufferInfos[i].range = VK_WHOLE_SIZE;
+
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = m_descriptorSet;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &bufferInfos[i];
+        }
+        vkUpdateDescriptorSets(logicalDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+        // The builder creates the layout with the first pipeline; the second reuses it
+        ComputePipelineBuilder cullBuilder(m_device, m_context);
+        m_cullPipeline = cullBuilder
+            .setShaderStage(cullShader)
+            .setDescriptorSetLayouts({m_setLayout})
+            .addPushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, sizeof(PushConstants))
+            .build();
+        m_pipelineLayout = cullBuilder.getPipelineLayout();
+
+        if (occlusionShader != VK_NULL_HANDLE) {
+            m_occlusionPipeline = ComputePipelineBuilder(m_device, m_context)
+                .setShaderStage(occlusionShader)
+                .setLayout(m_pipelineLayout)
+                .build();
+        }
+    } catch (...) {
+        destroyResources();
+        throw;
+    }
+}
+
+GpuCuller::~GpuCuller() {
+    destroyResources();
+}
+
+void GpuCuller::destroyResources() {
+    VkDevice logicalDevice = m_device->getLogicalDevice();
+    if (m_occlusionPipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(logicalDevice, m_occlusionPipeline, nullptr);
+    }
+    if (m_cullPipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(logicalDevice, m_cullPipeline, nullptr);
+    }
+    if (m_pipelineLayout != VK_NULL_HANDLE) {
+        vkDestroyPipelineLayout(logicalDevice, m_pipelineLayout, nullptr);
+    }
+    if (m_descriptorPool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(logicalDevice, m_descriptorPool, nullptr);
+    }
+    if (m_setLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(logicalDevice, m_setLayout, nullptr);
+    }
+    if (m_hiZSampler != VK_NULL_HANDLE) {
+        vkDestroySampler(logicalDevice, m_hiZSampler, nullptr);
+    }
+
+    const std::array<std::pair<VkBuffer, VmaAllocation>, 4> buffers = {{
+        {m_objectBuffer, m_objectAllocation},
+        {m_drawBuffer, m_drawAllocation},
+        {m_commandBuffer, m_commandAllocation},
+        {m_countBuffer, m_countAllocation},
+    }};
+    for (const auto& [buffer, allocation] : buffers) {
+        if (buffer != VK_NULL_HANDLE) {
+            vmaDestroyBuffer(m_device->getAllocator(), buffer, allocation);
+        }
+    }
+}
+
+void GpuCuller::setObject(uint32_t index, const BoundingVolume& bounds, const VkDrawIndexedIndirectCommand& draw) {
+    if (index >= m_capacity) {
+        throw std::runtime_error("GpuCuller object index " + std::to_string(index) + " exceeds the capacity");
+    }
+
+    GpuCullObject& object = m_objects[index];
+    object.sphere = Vec4f(bounds.center.x, bounds.center.y, bounds.center.z, bounds.radius);
+    object.extents = Vec4f(bounds.extents.x, bounds.extents.y, bounds.extents.z, 0.0f);
+    m_draws[index] = draw;
+
+    if (m_dirtyBegin == m_dirtyEnd) {
+        m_dirtyBegin = index;
+        m_dirtyEnd = index + 1;
+    } else {
+        m_dirtyBegin = std::min(m_dirtyBegin, index);
+        m_dirtyEnd = std::max(m_dirtyEnd, index + 1);
+    }
+}
+
+void GpuCuller::setObjectCount(uint32_t count) {
+    if (count > m_capacity) {
+        throw std::runtime_error("GpuCuller object count exceeds the capacity");
+    }
+    m_objectCount = count;
+}
+
+void GpuCuller::setOcclusionPyramid(VkImageView view, VkImageLayout layout, uint32_t width, uint32_t height) {
+    if (view == VK_NULL_HANDLE) {
+        m_occlusionEnabled = false;
+        return;
+    }
+    if (m_occlusionPipeline == VK_NULL_HANDLE) {
+        throw std::runtime_error("GpuCuller was created without the ev_cull_occlusion.comp shader");
+    }
+
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.sampler = m_hiZSampler;
+    imageInfo.imageView = view;
+    imageInfo.imageLayout = layout;
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = m_descriptorSet;
+    write.dstBinding = 4;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(m_device->getLogicalDevice(), 1, &write, 0, nullptr);
+
+    m_hiZSize[0] = static_cast<float>(width);
+    m_hiZSize[1] = static_cast<float>(height);
+    m_occlusionEnabled = true;
+}
+
+void GpuCuller::record(VkCommandBuffer commandBuffer, const Mat4f& viewProjection) {
+    CommandUtils::validateCommandBuffer(commandBuffer);
+
+    // The previous frame's cull pass and indirect draws must be done with the
+    // buffers before they are overwritten; the cull pass also wrote the command
+    // and count buffers, so the fill and the new dispatch need its writes ordered
+    VkMemoryBarrier reuseBarrier{};
+    reuseBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    reuseBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    reuseBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    CommandUtils::pipelineBarrier(commandBuffer,
+                                  VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                                  VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                                  {reuseBarrier});
+
+    recordUploads(commandBuffer);
+    if (m_compact) {
+        vkCmdFillBuffer(commandBuffer, m_countBuffer, 0, sizeof(uint32_t), 0);
+    }
+
+    VkMemoryBarrier uploadBarrier{};
+    uploadBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    uploadBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    uploadBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    CommandUtils::pipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                  VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, {uploadBarrier});
+
+    if (m_objectCount > 0) {
+        PushConstants constants{};
+        viewProjection.store(constants.viewProjection);
+        constants.hiZSize[0] = m_hiZSize[0];
+        constants.hiZSize[1] = m_hiZSize[1];
+        constants.objectCount = m_objectCount;
+        constants.compact = m_compact ? 1u : 0u;
+
+        const VkPipeline pipeline = m_occlusionEnabled ? m_occlusionPipeline : m_cullPipeline;
+        CommandUtils::bindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        CommandUtils::bindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0,
+                                         {m_descriptorSet});
+        CommandUtils::pushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                                    sizeof(PushConstants), &constants);
+        CommandUtils::dispatch(commandBuffer, CommandUtils::groupCount(m_objectCount, kGroupSize));
+    }
+
+    recordOutputBarrier(commandBuffer);
+}
+
+void GpuCuller::draw(VkCommandBuffer commandBuffer) const {
+    if (m_objectCount == 0) {
+        return;
+    }
+    if (m_compact) {
+        CommandUtils::drawIndexedIndirectCount(commandBuffer, m_commandBuffer, 0, m_countBuffer, 0, m_objectCount);
+    } else {
+        CommandUtils::drawIndexedIndirect(commandBuffer, m_commandBuffer, 0, m_objectCount);
+    }
+}
+
+void GpuCuller::recordUploads(VkCommandBuffer commandBuffer) {
+    if (m_dirtyBegin == m_dirtyEnd) {
+        return;
+    }
+
+    const VkDeviceSize count = m_dirtyEnd - m_dirtyBegin;
+    updateBuffer(commandBuffer, m_objectBuffer, m_dirtyBegin * sizeof(GpuCullObject),
+                 count * sizeof(GpuCullObject), &m_objects[m_dirtyBegin]);
+    updateBuffer(commandBuffer, m_drawBuffer, m_dirtyBegin * sizeof(VkDrawIndexedIndirectCommand),
+                 count * sizeof(VkDrawIndexedIndirectCommand), &m_draws[m_dirtyBegin]);
+
+    m_dirtyBegin = 0;
+    m_dirtyEnd = 0;
+}
+
+void GpuCuller::recordOutputBarrier(VkCommandBuffer commandBuffer) {
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    CommandUtils::pipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                  VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, {barrier});
+}
+
+} // namespace ev
@@ -0,0 +1,369 @@
+#include "EasyVulkan/Core/ImageDecodeQueue.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+#include "EasyVulkan/Core/VulkanContext.hpp"
+#include "EasyVulkan/Core/CommandPoolManager.hpp"
+#include "EasyVulkan/Core/MipGenerator.hpp"
+#include "EasyVulkan/Core/ResourceManager.hpp"
+#include "EasyVulkan/Core/ThreadPool.hpp"
+#include "EasyVulkan/Builders/ImageBuilder.hpp"
+#include "EasyVulkan/Utils/CommandUtils.hpp"
+#include "EasyVulkan/Utils/ResourceUtils.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace ev {
+
+ImageDecodeQueue::ImageDecodeQueue(
+    VulkanDevice* device,
+    VulkanContext* context,
+    ThreadPool* pool,
+    VkDeviceSize maxStagingBytes)
+    : m_device(device)
+    , m_context(context)
+    , m_pool(pool)
+    , m_maxStagingBytes(maxStagingBytes) {
+
+    if (!m_device || !m_context || !m_pool) {
+        throw std::runtime_error("ImageDecodeQueue requires a valid device, context and thread pool");
+    }
+
+    m_decoders.push_back(std::make_shared<PNGDecoder>());
+    m_decoders.push_back(std::make_shared<HDRDecoder>());
+}
+
+ImageDecodeQueue::~ImageDecodeQueue() {
+    std::vector<std::shared_ptr<Job>> abandoned;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_condition.notify_all();
+        // Queued jobs still reference this object
+        m_condition.wait(lock, [this]() { return m_runningJobs == 0; });
+        abandoned.swap(m_completed);
+        abandoned.insert(abandoned.end(), m_deferred.begin(), m_deferred.end());
+        m_deferred.clear();
+    }
+
+    for (auto& job : abandoned) {
+        releaseStaging(*job);
+        job->promise.set_exception(std::make_exception_ptr(
+            std::runtime_error("ImageDecodeQueue destroyed before '" + job->request.path + "' was uploaded")));
+    }
+}
+
+void ImageDecodeQueue::addDecoder(std::shared_ptr<ImageDecoder> decoder) {
+    if (decoder) {
+        m_decoders.insert(m_decoders.begin(), std::move(decoder));
+    }
+}
+
+std::future<ImageInfo> ImageDecodeQueue::enqueue(const ImageDecodeRequest& request) {
+    auto job = std::make_shared<Job>();
+    job->request = request;
+    std::future<ImageInfo> future = job->promise.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pendingJobs;
+        ++m_runningJobs;
+    }
+    m_pool->submit([this, job]() { runJob(job); });
+    return future;
+}
+
+std::vector<uint8_t> ImageDecodeQueue::readFile(const std::string& path) const {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open image file: " + path);
+    }
+
+    const std::streamsize size = file.tellg();
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), size)) {
+        throw std::runtime_error("failed to read image file: " + path);
+    }
+    return data;
+}
+
+const ImageDecoder* ImageDecodeQueue::findDecoder(const uint8_t* data, size_t size) const {
+    for (const auto& decoder : m_decoders) {
+        if (decoder->canDecode(data, size)) {
+            return decoder.get();
+        }
+    }
+    return nullptr;
+}
+
+void ImageDecodeQueue::runJob(const std::shared_ptr<Job>& job) {
+    try {
+        if (!job->decoder) {
+            job->file = readFile(job->request.path);
+            job->decoder = findDecoder(job->file.data(), job->file.size());
+            if (!job->decoder) {
+                throw std::runtime_error("no decoder for image file: " + job->request.path);
+            }
+            job->header = job->decoder->readHeader(job->file.data(), job->file.size());
+        }
+        const VkDeviceSize size = job->header.getSize();
+
+        // Resubmitted jobs arrive with their staging bytes already reserved
+        if (job->stagingSize == 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopping) {
+                throw std::runtime_error("ImageDecodeQueue destroyed");
+            }
+            // Park the job instead of the worker: a blocked worker could starve
+            // parallelFor() callers on the same pool
+            if (!m_deferred.empty() || !fitsStaging(size)) {
+                m_deferred.push_back(job);
+                --m_runningJobs;
+                m_condition.notify_all();
+                return;
+            }
+            m_stagingBytes += size;
+            job->stagingSize = size;
+        }
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                          VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        VmaAllocationInfo info{};
+        if (vmaCreateBuffer(m_device->getAllocator(), &bufferInfo, &allocInfo,
+                            &job->staging, &job->stagingAllocation, &info) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create decode staging buffer for " + job->request.path);
+        }
+
+        // Pixels go straight into the mapped staging memory
+        job->decoder->decode(job->file.data(), job->file.size(), job->header, static_cast<uint8_t*>(info.pMappedData));
+        vmaFlushAllocation(m_device->getAllocator(), job->stagingAllocation, 0, size);
+    } catch (...) {
+        job->error = std::current_exception();
+        releaseStaging(*job);
+    }
+    job->file = {};
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completed.push_back(job);
+        --m_runningJobs;
+    }
+    m_condition.notify_all();
+}
+
+bool ImageDecodeQueue::fitsStaging(VkDeviceSize size) const {
+    // An image larger than the limit still runs alone
+    return m_stagingBytes == 0 || m_stagingBytes + size <= m_maxStagingBytes;
+}
+
+void ImageDecodeQueue::resubmitDeferred() {
+    std::vector<std::shared_ptr<Job>> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        while (!m_stopping && !m_deferred.empty()) {
+            const std::shared_ptr<Job>& job = m_deferred.front();
+            const VkDeviceSize size = job->header.getSize();
+            if (!fitsStaging(size)) {
+                break;
+            }
+            m_stagingBytes += size;
+            job->stagingSize = size;
+            ready.push_back(job);
+            m_deferred.pop_front();
+            ++m_runningJobs;
+        }
+    }
+    for (auto& job : ready) {
+        m_pool->submit([this, job]() { runJob(job); });
+    }
+}
+
+void ImageDecodeQueue::releaseStaging(Job& job) {
+    if (job.staging != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(m_device->getAllocator(), job.staging, job.stagingAllocation);
+        job.staging = VK_NULL_HANDLE;
+        job.stagingAllocation = VK_NULL_HANDLE;
+    }
+    if (job.stagingSize != 0) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stagingBytes -= job.stagingSize;
+        }
+        job.stagingSize = 0;
+        m_condition.notify_all();
+        resubmitDeferred();
+    }
+}
+
+void ImageDecodeQueue::destroyImage(const ImageInfo& image, const std::string& name) {
+    if (image.image == VK_NULL_HANDLE) {
+        return;
+    }
+    if (!name.empty()) {
+        m_context->getResourceManager()->clearResource(name, VK_OBJECT_TYPE_IMAGE);
+        return;
+    }
+    if (image.imageView != VK_NULL_HANDLE) {
+        vkDestroyImageView(m_device->getLogicalDevice(), image.imageView, nullptr);
+    }
+    vmaDestroyImage(m_device->getAllocator(), image.image, image.allocation);
+}
+
+uint32_t ImageDecodeQueue::uploadCompleted(uint32_t maxJobs) {
+    std::vector<std::shared_ptr<Job>> batch;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const size_t count = std::min<size_t>(maxJobs, m_completed.size());
+        batch.assign(m_completed.begin(), m_completed.begin() + count);
+        m_completed.erase(m_completed.begin(), m_completed.begin() + count);
+    }
+    if (batch.empty()) {
+        return 0;
+    }
+
+    VkCommandPool commandPool = m_context->getCommandPoolManager()->getSingleTimeCommandPool();
+    VkCommandBuffer commandBuffer = CommandUtils::beginSingleTimeCommands(m_device, commandPool);
+    MipGenerator mipGenerator(m_device);
+    std::vector<ImageInfo> images(batch.size());
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Job& job = *batch[i];
+        if (job.error) {
+            continue;
+        }
+
+        try {
+            VkFormat format = job.header.format;
+            if (format == VK_FORMAT_R8G8B8A8_UNORM && job.request.srgb) {
+                format = VK_FORMAT_R8G8B8A8_SRGB;
+            }
+            const bool generateMips = job.request.generateMips && mipGenerator.supportsBlit(format);
+
+            ImageBuilder builder(m_device, m_context);
+            builder.setFormat(format)
+                .setExtent(job.header.width, job.header.height)
+                .setUsage(VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                          (generateMips ? MipGenerator::getRequiredUsage(MipGenerationMode::Blit) : 0))
+                .setMemoryCategory(MemoryCategory::Textures);
+            if (generateMips) {
+                builder.setFullMipChain();
+            }
+            images[i] = builder.build(job.request.name);
+
+            MipGenerator::Target target;
+            target.image = images[i].image;
+            target.format = format;
+            target.extent = {job.header.width, job.header.height, 1};
+            target.mipLevels = generateMips ? MipGenerator::calculateMipLevels(job.header.width, job.header.height) : 1;
+
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = target.image;
+            barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, 1};
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            VkBufferImageCopy copy{};
+            copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            copy.imageExtent = target.extent;
+            vkCmdCopyBufferToImage(commandBuffer, job.staging, target.image,
+                                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+
+            if (target.mipLevels > 1) {
+                mipGenerator.record(commandBuffer, target, MipGenerationMode::Blit, job.request.finalLayout);
+            } else {
+                VkPipelineStageFlags dstStage;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.newLayout = job.request.finalLayout;
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                ResourceUtils::getLayoutStageAndAccess(job.request.finalLayout, dstStage, barrier.dstAccessMask);
+                vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+                                     0, 0, nullptr, 0, nullptr, 1, &barrier);
+            }
+            images[i].layout = job.request.finalLayout;
+        } catch (...) {
+            job.error = std::current_exception();
+        }
+    }
+
+    // One submission for the whole batch
+    try {
+        CommandUtils::endSingleTimeCommands(m_device, commandPool, commandBuffer);
+    } catch (...) {
+        for (auto& job : batch) {
+            if (!job->error) {
+                job->error = std::current_exception();
+            }
+        }
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Job& job = *batch[i];
+        releaseStaging(job);
+        if (job.error) {
+            // Failed after build(); the submission has completed, so nothing references it
+            destroyImage(images[i], job.request.name);
+            job.promise.set_exception(job.error);
+        } else {
+            job.promise.set_value(images[i]);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingJobs -= static_cast<uint32_t>(batch.size());
+    }
+    m_condition.notify_all();
+    return static_cast<uint32_t>(batch.size());
+}
+
+void ImageDecodeQueue::finish() {
+    for (;;) {
+        uploadCompleted();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_pendingJobs == 0) {
+            return;
+        }
+        m_condition.wait(lock, [this]() { return !m_completed.empty() || m_pendingJobs == 0; });
+    }
+}
+
+std::vector<ImageInfo> ImageDecodeQueue::loadAll(const std::vector<ImageDecodeRequest>& requests) {
+    std::vector<std::future<ImageInfo>> futures;
+    futures.reserve(requests.size());
+    for (const auto& request : requests) {
+        futures.push_back(enqueue(request));
+    }
+
+    finish();
+
+    std::vector<ImageInfo> images;
+    images.reserve(futures.size());
+    for (auto& future : futures) {
+        images.push_back(future.get());
+    }
+    return images;
+}
+
+uint32_t ImageDecodeQueue::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pendingJobs;
+}
+
+} // namespace ev
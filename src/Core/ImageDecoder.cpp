@@ -0,0 +1,718 @@
+#include "EasyVulkan/Core/ImageDecoder.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace ev {
+
+namespace {
+
+// ------------------------------------------------------------------------------
+// Inflate (RFC 1950/1951)
+// ------------------------------------------------------------------------------
+
+/**
+ * @brief LSB-first bit reader over a byte range; reads past the end yield zeros
+ */
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    uint32_t peek(uint32_t count) {
+        refill();
+        return static_cast<uint32_t>(m_bits & ((1ull << count) - 1));
+    }
+
+    void consume(uint32_t count) {
+        m_bits >>= count;
+        m_bitCount -= count;
+    }
+
+    uint32_t read(uint32_t count) {
+        if (count == 0) {
+            return 0;
+        }
+        const uint32_t value = peek(count);
+        consume(count);
+        return value;
+    }
+
+    void alignToByte() { consume(m_bitCount & 7); }
+
+    bool overrun() const { return m_position > m_size + 8; }
+
+private:
+    void refill() {
+        while (m_bitCount <= 56) {
+            const uint64_t byte = m_position < m_size ? m_data[m_position] : 0;
+            ++m_position;
+            m_bits |= byte << m_bitCount;
+            m_bitCount += 8;
+        }
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_position{0};
+    uint64_t m_bits{0};
+    uint32_t m_bitCount{0};
+};
+
+/**
+ * @brief Canonical Huffman table with a 9-bit lookup for short codes
+ */
+class Huffman {
+public:
+    static constexpr uint32_t FastBits = 9;
+
+    void build(const uint8_t* lengths, uint32_t count) {
+        std::memset(m_counts, 0, sizeof(m_counts));
+        std::memset(m_fast, 0, sizeof(m_fast));
+        for (uint32_t i = 0; i < count; ++i) {
+            ++m_counts[lengths[i]];
+        }
+        m_counts[0] = 0;
+
+        uint16_t offsets[16];
+        offsets[1] = 0;
+        for (uint32_t len = 1; len < 15; ++len) {
+            offsets[len + 1] = static_cast<uint16_t>(offsets[len] + m_counts[len]);
+        }
+
+        uint32_t nextCode[16];
+        uint32_t code = 0;
+        for (uint32_t len = 1; len < 16; ++len) {
+            code = (code + m_counts[len - 1]) << 1;
+            nextCode[len] = code;
+        }
+
+        for (uint32_t symbol = 0; symbol < count; ++symbol) {
+            const uint32_t len = lengths[symbol];
+            if (len == 0) {
+                continue;
+            }
+            m_symbols[offsets[len]++] = static_cast<uint16_t>(symbol);
+
+            const uint32_t symbolCode = nextCode[len]++;
+            if (len <= FastBits) {
+                uint32_t reversed = 0;
+                for (uint32_t bit = 0; bit < len; ++bit) {
+                    reversed |= ((symbolCode >> bit) & 1u) << (len - 1 - bit);
+                }
+                for (uint32_t fill = reversed; fill < (1u << FastBits); fill += 1u << len) {
+                    m_fast[fill] = static_cast<uint16_t>((len << 9) | symbol);
+                }
+            }
+        }
+    }
+
+    uint32_t decode(BitReader& reader) const {
+        const uint16_t entry = m_fast[reader.peek(FastBits)];
+        if (entry != 0) {
+            reader.consume(entry >> 9);
+            return entry & 0x1ff;
+        }
+
+        // Codes longer than FastBits, walked bit by bit
+        int32_t code = 0;
+        int32_t first = 0;
+        int32_t index = 0;
+        for (uint32_t len = 1; len < 16; ++len) {
+            code |= static_cast<int32_t>(reader.read(1));
+            const int32_t count = m_counts[len];
+            if (code - count < first) {
+                return m_symbols[index + (code - first)];
+            }
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        throw std::runtime_error("invalid Huffman code in deflate stream");
+    }
+
+private:
+    uint16_t m_counts[16]{};
+    uint16_t m_symbols[288]{};
+    uint16_t m_fast[1u << FastBits]{};
+};
+
+constexpr uint16_t kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t kDistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                        8193, 12289, 16385, 24577};
+constexpr uint8_t kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/**
+ * @brief Inflates a zlib stream into a buffer of known size
+ */
+void inflateZlib(const uint8_t* data, size_t size, uint8_t* out, size_t outSize) {
+    if (size < 2 || (data[0] & 0x0f) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20)) {
+        throw std::runtime_error("invalid zlib header");
+    }
+
+    BitReader reader(data + 2, size - 2);
+    size_t written = 0;
+    Huffman literals;
+    Huffman distances;
+
+    bool lastBlock = false;
+    while (!lastBlock) {
+        lastBlock = reader.read(1) != 0;
+        const uint32_t type = reader.read(2);
+
+        if (type == 0) {
+            reader.alignToByte();
+            const uint32_t length = reader.read(16);
+            const uint32_t inverse = reader.read(16);
+            if ((length ^ 0xffff) != inverse || written + length > outSize) {
+                throw std::runtime_error("invalid stored deflate block");
+            }
+            for (uint32_t i = 0; i < length; ++i) {
+                out[written++] = static_cast<uint8_t>(reader.read(8));
+            }
+            continue;
+        }
+
+        if (type == 1) {
+            uint8_t lengths[288 + 30];
+            std::memset(lengths, 8, 144);
+            std::memset(lengths + 144, 9, 112);
+            std::memset(lengths + 256, 7, 24);
+            std::memset(lengths + 280, 8, 8);
+            std::memset(lengths + 288, 5, 30);
+            literals.build(lengths, 288);
+            distances.build(lengths + 288, 30);
+        } else if (type == 2) {
+            static constexpr uint8_t kOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+            const uint32_t literalCount = reader.read(5) + 257;
+            const uint32_t distanceCount = reader.read(5) + 1;
+            const uint32_t codeLengthCount = reader.read(4) + 4;
+
+            uint8_t codeLengthLengths[19] = {};
+            for (uint32_t i = 0; i < codeLengthCount; ++i) {
+                codeLengthLengths[kOrder[i]] = static_cast<uint8_t>(reader.read(3));
+            }
+            Huffman codeLengths;
+            codeLengths.build(codeLengthLengths, 19);
+
+            uint8_t lengths[288 + 32] = {};
+            uint32_t index = 0;
+            while (index < literalCount + distanceCount) {
+                const uint32_t symbol = codeLengths.decode(reader);
+                if (symbol < 16) {
+                    lengths[index++] = static_cast<uint8_t>(symbol);
+                    continue;
+                }
+                uint32_t repeat;
+                uint8_t value = 0;
+                if (symbol == 16) {
+                    if (index == 0) {
+                        throw std::runtime_error("invalid deflate code lengths");
+                    }
+                    value = lengths[index - 1];
+                    repeat = 3 + reader.read(2);
+                } else if (symbol == 17) {
+                    repeat = 3 + reader.read(3);
+                } else {
+                    repeat = 11 + reader.read(7);
+                }
+                if (index + repeat > literalCount + distanceCount) {
+                    throw std::runtime_error("invalid deflate code lengths");
+                }
+                std::memset(lengths + index, value, repeat);
+                index += repeat;
+            }
+            literals.build(lengths, literalCount);
+            distances.build(lengths + literalCount, distanceCount);
+        } else {
+            throw std::runtime_error("invalid deflate block type");
+        }
+
+        for (;;) {
+            const uint32_t symbol = literals.decode(reader);
+            if (symbol < 256) {
+                if (written >= outSize) {
+                    throw std::runtime_error("deflate stream exceeds the expected size");
+                }
+                out[written++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+            if (symbol == 256) {
+                break;
+            }
+            if (symbol > 285) {
+                throw std::runtime_error("invalid deflate length symbol");
+            }
+
+            const uint32_t lengthIndex = symbol - 257;
+            const size_t length = kLengthBase[lengthIndex] + reader.read(kLengthExtra[lengthIndex]);
+            const uint32_t distanceSymbol = distances.decode(reader);
+            if (distanceSymbol >= 30) {
+                throw std::runtime_error("invalid deflate distance symbol");
+            }
+            const size_t distance = kDistanceBase[distanceSymbol] + reader.read(kDistanceExtra[distanceSymbol]);
+            if (distance > written || written + length > outSize) {
+                throw std::runtime_error("invalid deflate back-reference");
+            }
+
+            // Byte-wise copy: the source may overlap the destination
+            const uint8_t* source = out + written - distance;
+            for (size_t i = 0; i < length; ++i) {
+                out[written + i] = source[i];
+            }
+            written += length;
+        }
+
+        if (reader.overrun()) {
+            throw std::runtime_error("truncated deflate stream");
+        }
+    }
+
+    if (written != outSize) {
+        throw std::runtime_error("deflate stream is shorter than expected");
+    }
+}
+
+// ------------------------------------------------------------------------------
+// PNG
+// ------------------------------------------------------------------------------
+
+constexpr uint8_t kPngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+uint32_t readBigEndian32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+struct PngInfo {
+    uint32_t width{0};
+    uint32_t height{0};
+    uint32_t bitDepth{0};
+    uint32_t colorType{0};
+    uint32_t channels{0};
+    std::vector<uint8_t> idat;
+    uint8_t palette[256][4]{};
+    uint32_t paletteSize{0};
+    bool hasColorKey{false};
+    uint16_t colorKey[3]{};
+};
+
+/**
+ * @brief Walks the chunk list; IDAT and the palette are only gathered when requested
+ */
+PngInfo parsePng(const uint8_t* data, size_t size, bool readPixels) {
+    if (size < 8 || std::memcmp(data, kPngSignature, 8) != 0) {
+        throw std::runtime_error("not a PNG file");
+    }
+
+    PngInfo info;
+    size_t offset = 8;
+    bool haveHeader = false;
+    while (offset + 12 <= size) {
+        const uint32_t length = readBigEndian32(data + offset);
+        const uint8_t* type = data + offset + 4;
+        const uint8_t* chunk = data + offset + 8;
+        if (length > size - offset - 12) {
+            throw std::runtime_error("truncated PNG chunk");
+        }
+
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            if (length < 13) {
+                throw std::runtime_error("invalid PNG header");
+            }
+            info.width = readBigEndian32(chunk);
+            info.height = readBigEndian32(chunk + 4);
+            info.bitDepth = chunk[8];
+            info.colorType = chunk[9];
+            if (chunk[10] != 0 || chunk[11] != 0) {
+                throw std::runtime_error("unsupported PNG compression or filter method");
+            }
+            if (chunk[12] != 0) {
+                throw std::runtime_error("interlaced PNGs are not supported");
+            }
+            switch (info.colorType) {
+                case 0: info.channels = 1; break;
+                case 2: info.channels = 3; break;
+                case 3: info.channels = 1; break;
+                case 4: info.channels = 2; break;
+                case 6: info.channels = 4; break;
+                default: throw std::runtime_error("invalid PNG colour type");
+            }
+            const bool validDepth = info.colorType == 0 || info.colorType == 3
+                ? (info.bitDepth == 1 || info.bitDepth == 2 || info.bitDepth == 4 || info.bitDepth == 8 ||
+                   (info.bitDepth == 16 && info.colorType == 0))
+                : (info.bitDepth == 8 || info.bitDepth == 16);
+            if (!validDepth || info.width == 0 || info.height == 0) {
+                throw std::runtime_error("invalid PNG dimensions or bit depth");
+            }
+            haveHeader = true;
+            if (!readPixels) {
+                return info;
+            }
+        } else if (std::memcmp(type, "PLTE", 4) == 0) {
+            info.paletteSize = std::min<uint32_t>(length / 3, 256);
+            for (uint32_t i = 0; i < info.paletteSize; ++i) {
+                info.palette[i][0] = chunk[i * 3];
+                info.palette[i][1] = chunk[i * 3 + 1];
+                info.palette[i][2] = chunk[i * 3 + 2];
+                info.palette[i][3] = 255;
+            }
+        } else if (std::memcmp(type, "tRNS", 4) == 0) {
+            if (info.colorType == 3) {
+                for (uint32_t i = 0; i < std::min<uint32_t>(length, 256); ++i) {
+                    info.palette[i][3] = chunk[i];
+                }
+            } else if (info.colorType == 0 && length >= 2) {
+                info.hasColorKey = true;
+                info.colorKey[0] = static_cast<uint16_t>((chunk[0] << 8) | chunk[1]);
+            } else if (info.colorType == 2 && length >= 6) {
+                info.hasColorKey = true;
+                for (int c = 0; c < 3; ++c) {
+                    info.colorKey[c] = static_cast<uint16_t>((chunk[c * 2] << 8) | chunk[c * 2 + 1]);
+                }
+            }
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            info.idat.insert(info.idat.end(), chunk, chunk + length);
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        offset += 12 + static_cast<size_t>(length);
+    }
+
+    if (!haveHeader) {
+        throw std::runtime_error("PNG has no IHDR chunk");
+    }
+    if (info.colorType == 3 && info.paletteSize == 0) {
+        throw std::runtime_error("palette PNG has no PLTE chunk");
+    }
+    return info;
+}
+
+uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    const int p = static_cast<int>(a) + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+void unfilterRow(uint8_t filter, uint8_t* row, const uint8_t* previous, size_t rowBytes, size_t bpp) {
+    switch (filter) {
+        case 0:
+            break;
+        case 1:
+            for (size_t i = bpp; i < rowBytes; ++i) {
+                row[i] = static_cast<uint8_t>(row[i] + row[i - bpp]);
+            }
+            break;
+        case 2:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                row[i] = static_cast<uint8_t>(row[i] + previous[i]);
+            }
+            break;
+        case 3:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                const uint32_t left = i >= bpp ? row[i - bpp] : 0;
+                row[i] = static_cast<uint8_t>(row[i] + ((left + previous[i]) >> 1));
+            }
+            break;
+        case 4:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                const uint8_t left = i >= bpp ? row[i - bpp] : 0;
+                const uint8_t upperLeft = i >= bpp ? previous[i - bpp] : 0;
+                row[i] = static_cast<uint8_t>(row[i] + paeth(left, previous[i], upperLeft));
+            }
+            break;
+        default:
+            throw std::runtime_error("invalid PNG filter type");
+    }
+}
+
+// ------------------------------------------------------------------------------
+// Radiance HDR
+// ------------------------------------------------------------------------------
+
+/**
+ * @brief Parses the text header; returns the offset of the first scanline
+ */
+size_t parseHdrHeader(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height) {
+    auto readLine = [&](size_t& offset) {
+        std::string line;
+        while (offset < size && data[offset] != '\n') {
+            line.push_back(static_cast<char>(data[offset++]));
+        }
+        if (offset >= size) {
+            throw std::runtime_error("truncated Radiance HDR header");
+        }
+        ++offset;
+        return line;
+    };
+
+    size_t offset = 0;
+    const std::string magic = readLine(offset);
+    if (magic != "#?RADIANCE" && magic != "#?RGBE") {
+        throw std::runtime_error("not a Radiance HDR file");
+    }
+    for (;;) {
+        const std::string line = readLine(offset);
+        if (line.empty()) {
+            break;
+        }
+        if (line.rfind("FORMAT=", 0) == 0 && line != "FORMAT=32-bit_rle_rgbe") {
+            throw std::runtime_error("unsupported Radiance HDR format: " + line);
+        }
+    }
+
+    const std::string resolution = readLine(offset);
+    char yAxis[3] = {};
+    char xAxis[3] = {};
+    if (std::sscanf(resolution.c_str(), "%2s %u %2s %u", yAxis, &height, xAxis, &width) != 4 ||
+        std::strcmp(yAxis, "-Y") != 0 || std::strcmp(xAxis, "+X") != 0 || width == 0 || height == 0) {
+        throw std::runtime_error("unsupported Radiance HDR orientation: " + resolution);
+    }
+    return offset;
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const float magnitude = std::fabs(value);
+
+    if (!(magnitude < 65504.0f)) {
+        return static_cast<uint16_t>(sign | 0x7bff);
+    }
+    if (magnitude < 6.103515625e-05f) {
+        // Subnormal half: multiples of 2^-24
+        return static_cast<uint16_t>(sign | static_cast<uint16_t>(std::lround(magnitude * 16777216.0f)));
+    }
+
+    std::memcpy(&bits, &magnitude, sizeof(bits));
+    const uint32_t exponent = ((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffff;
+    uint32_t half = (exponent << 10) | (mantissa >> 13);
+    // Round to nearest even
+    const uint32_t remainder = mantissa & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+        ++half;
+    }
+    return static_cast<uint16_t>(sign | std::min<uint32_t>(half, 0x7bff));
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------
+// PNGDecoder
+// ------------------------------------------------------------------------------
+
+bool PNGDecoder::canDecode(const uint8_t* data, size_t size) const {
+    return size >= 8 && std::memcmp(data, kPngSignature, 8) == 0;
+}
+
+DecodedImageHeader PNGDecoder::readHeader(const uint8_t* data, size_t size) const {
+    const PngInfo info = parsePng(data, size, false);
+
+    DecodedImageHeader header;
+    header.width = info.width;
+    header.height = info.height;
+    header.format = VK_FORMAT_R8G8B8A8_UNORM;
+    header.bytesPerPixel = 4;
+    return header;
+}
+
+void PNGDecoder::decode(const uint8_t* data, size_t size, const DecodedImageHeader& header, uint8_t* dst) const {
+    const PngInfo info = parsePng(data, size, true);
+    if (info.width != header.width || info.height != header.height) {
+        throw std::runtime_error("PNG header does not match the decode request");
+    }
+
+    const size_t bitsPerPixel = static_cast<size_t>(info.channels) * info.bitDepth;
+    const size_t rowBytes = (info.width * bitsPerPixel + 7) / 8;
+    const size_t bpp = std::max<size_t>(bitsPerPixel / 8, 1);
+
+    std::vector<uint8_t> filtered(static_cast<size_t>(info.height) * (rowBytes + 1));
+    inflateZlib(info.idat.data(), info.idat.size(), filtered.data(), filtered.size());
+
+    // Rows are unfiltered in place and expanded into a local RGBA row, so the
+    // destination is only ever written sequentially
+    std::vector<uint8_t> zeroRow(rowBytes, 0);
+    std::vector<uint8_t> rgba(static_cast<size_t>(info.width) * 4);
+    const uint8_t* previous = zeroRow.data();
+    const uint32_t maxSample = (1u << std::min(info.bitDepth, 8u)) - 1;
+
+    for (uint32_t y = 0; y < info.height; ++y) {
+        uint8_t* line = filtered.data() + static_cast<size_t>(y) * (rowBytes + 1);
+        uint8_t* row = line + 1;
+        unfilterRow(line[0], row, previous, rowBytes, bpp);
+        previous = row;
+
+        // Common 8-bit RGBA/RGB layouts skip the per-sample path
+        if (info.bitDepth == 8 && info.colorType == 6) {
+            std::memcpy(dst + static_cast<size_t>(y) * rgba.size(), row, rgba.size());
+            continue;
+        }
+        if (info.bitDepth == 8 && info.colorType == 2 && !info.hasColorKey) {
+            for (uint32_t x = 0; x < info.width; ++x) {
+                std::memcpy(rgba.data() + static_cast<size_t>(x) * 4, row + static_cast<size_t>(x) * 3, 3);
+                rgba[static_cast<size_t>(x) * 4 + 3] = 255;
+            }
+            std::memcpy(dst + static_cast<size_t>(y) * rgba.size(), rgba.data(), rgba.size());
+            continue;
+        }
+
+        for (uint32_t x = 0; x < info.width; ++x) {
+            uint16_t samples[4] = {0, 0, 0, 0};
+            for (uint32_t c = 0; c < info.channels; ++c) {
+                const size_t sampleIndex = static_cast<size_t>(x) * info.channels + c;
+                if (info.bitDepth == 16) {
+                    samples[c] = static_cast<uint16_t>((row[sampleIndex * 2] << 8) | row[sampleIndex * 2 + 1]);
+                } else if (info.bitDepth == 8) {
+                    samples[c] = row[sampleIndex];
+                } else {
+                    const size_t bit = sampleIndex * info.bitDepth;
+                    const uint32_t shift = 8 - info.bitDepth - static_cast<uint32_t>(bit & 7);
+                    samples[c] = static_cast<uint16_t>((row[bit >> 3] >> shift) & maxSample);
+                }
+            }
+
+            uint8_t* out = rgba.data() + static_cast<size_t>(x) * 4;
+            auto toByte = [&](uint16_t sample) {
+                if (info.bitDepth == 16) {
+                    return static_cast<uint8_t>(sample >> 8);
+                }
+                return static_cast<uint8_t>(sample * 255 / maxSample);
+            };
+
+            switch (info.colorType) {
+                case 0:
+                    out[0] = out[1] = out[2] = toByte(samples[0]);
+                    out[3] = info.hasColorKey && samples[0] == info.colorKey[0] ? 0 : 255;
+                    break;
+                case 2:
+                    out[0] = toByte(samples[0]);
+                    out[1] = toByte(samples[1]);
+                    out[2] = toByte(samples[2]);
+                    out[3] = info.hasColorKey && samples[0] == info.colorKey[0] &&
+                             samples[1] == info.colorKey[1] && samples[2] == info.colorKey[2] ? 0 : 255;
+                    break;
+                case 3:
+                    if (samples[0] >= info.paletteSize) {
+                        throw std::runtime_error("PNG palette index out of range");
+                    }
+                    std::memcpy(out, info.palette[samples[0]], 4);
+                    break;
+                case 4:
+                    out[0] = out[1] = out[2] = toByte(samples[0]);
+                    out[3] = toByte(samples[1]);
+                    break;
+                case 6:
+                    out[0] = toByte(samples[0]);
+                    out[1] = toByte(samples[1]);
+                    out[2] = toByte(samples[2]);
+                    out[3] = toByte(samples[3]);
+                    break;
+            }
+        }
+
+        std::memcpy(dst + static_cast<size_t>(y) * rgba.size(), rgba.data(), rgba.size());
+    }
+}
+
+// ------------------------------------------------------------------------------
+// HDRDecoder
+// ------------------------------------------------------------------------------
+
+bool HDRDecoder::canDecode(const uint8_t* data, size_t size) const {
+    return (size >= 10 && std::memcmp(data, "#?RADIANCE", 10) == 0) ||
+           (size >= 6 && std::memcmp(data, "#?RGBE", 6) == 0);
+}
+
+DecodedImageHeader HDRDecoder::readHeader(const uint8_t* data, size_t size) const {
+    DecodedImageHeader header;
+    parseHdrHeader(data, size, header.width, header.height);
+    header.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+    header.bytesPerPixel = 8;
+    return header;
+}
+
+void HDRDecoder::decode(const uint8_t* data, size_t size, const DecodedImageHeader& header, uint8_t* dst) const {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    size_t offset = parseHdrHeader(data, size, width, height);
+    if (width != header.width || height != header.height) {
+        throw std::runtime_error("HDR header does not match the decode request");
+    }
+
+    std::vector<uint8_t> rgbe(static_cast<size_t>(width) * 4);
+    std::vector<uint16_t> halves(static_cast<size_t>(width) * 4);
+
+    for (uint32_t y = 0; y < height; ++y) {
+        if (offset + 4 > size) {
+            throw std::runtime_error("truncated Radiance HDR scanline");
+        }
+
+        const bool runLength = width >= 8 && width < 32768 && data[offset] == 2 && data[offset + 1] == 2 &&
+                               ((data[offset + 2] << 8) | data[offset + 3]) == static_cast<int>(width);
+        if (runLength) {
+            // Each of the four components is stored as its own run-length stream
+            offset += 4;
+            for (uint32_t c = 0; c < 4; ++c) {
+                uint32_t x = 0;
+                while (x < width) {
+                    if (offset >= size) {
+                        throw std::runtime_error("truncated Radiance HDR scanline");
+                    }
+                    uint32_t count = data[offset++];
+                    if (count > 128) {
+                        count -= 128;
+                        if (x + count > width || offset >= size) {
+                            throw std::runtime_error("invalid Radiance HDR run");
+                        }
+                        const uint8_t value = data[offset++];
+                        for (uint32_t i = 0; i < count; ++i) {
+                            rgbe[(x++) * 4 + c] = value;
+                        }
+                    } else {
+                        if (count == 0 || x + count > width || offset + count > size) {
+                            throw std::runtime_error("invalid Radiance HDR run");
+                        }
+                        for (uint32_t i = 0; i < count; ++i) {
+                            rgbe[(x++) * 4 + c] = data[offset++];
+                        }
+                    }
+                }
+            }
+        } else {
+            const size_t bytes = rgbe.size();
+            if (offset + bytes > size) {
+                throw std::runtime_error("truncated Radiance HDR scanline");
+            }
+            std::memcpy(rgbe.data(), data + offset, bytes);
+            offset += bytes;
+        }
+
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint8_t* pixel = rgbe.data() + static_cast<size_t>(x) * 4;
+            const float scale = pixel[3] ? std::ldexp(1.0f, static_cast<int>(pixel[3]) - (128 + 8)) : 0.0f;
+            halves[x * 4 + 0] = floatToHalf(pixel[0] * scale);
+            halves[x * 4 + 1] = floatToHalf(pixel[1] * scale);
+            halves[x * 4 + 2] = floatToHalf(pixel[2] * scale);
+            halves[x * 4 + 3] = 0x3c00; // 1.0
+        }
+
+        const size_t rowSize = halves.size() * sizeof(uint16_t);
+        std::memcpy(dst + static_cast<size_t>(y) * rowSize, halves.data(), rowSize);
+    }
+}
+
+} // namespace ev
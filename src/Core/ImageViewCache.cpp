@@ -0,0 +1,150 @@
+#include "EasyVulkan/Core/ImageViewCache.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+namespace ev {
+
+namespace {
+
+void hashCombine(size_t& seed, uint64_t value) {
+    seed ^= std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+} // namespace
+
+ImageViewKey ImageViewKey::mip(uint32_t mipLevel, VkImageViewType viewType) {
+    ImageViewKey key;
+    key.viewType = viewType;
+    key.baseMipLevel = mipLevel;
+    key.levelCount = 1;
+    return key;
+}
+
+ImageViewKey ImageViewKey::layer(uint32_t arrayLayer, VkImageViewType viewType) {
+    ImageViewKey key;
+    key.viewType = viewType;
+    key.baseArrayLayer = arrayLayer;
+    key.layerCount = 1;
+    return key;
+}
+
+bool ImageViewKey::operator==(const ImageViewKey& other) const {
+    return viewType == other.viewType &&
+           format == other.format &&
+           aspectMask == other.aspectMask &&
+           baseMipLevel == other.baseMipLevel &&
+           levelCount == other.levelCount &&
+           baseArrayLayer == other.baseArrayLayer &&
+           layerCount == other.layerCount &&
+           components.r == other.components.r &&
+           components.g == other.components.g &&
+           components.b == other.components.b &&
+           components.a == other.components.a;
+}
+
+size_t ImageViewKeyHash::operator()(const ImageViewKey& key) const {
+    size_t seed = 0;
+    hashCombine(seed, (static_cast<uint64_t>(key.viewType) << 32) | static_cast<uint32_t>(key.format));
+    hashCombine(seed, key.aspectMask);
+    hashCombine(seed, (static_cast<uint64_t>(key.baseMipLevel) << 32) | key.levelCount);
+    hashCombine(seed, (static_cast<uint64_t>(key.baseArrayLayer) << 32) | key.layerCount);
+    hashCombine(seed, (static_cast<uint64_t>(key.components.r) << 48) |
+                      (static_cast<uint64_t>(key.components.g) << 32) |
+                      (static_cast<uint64_t>(key.components.b) << 16) |
+                      static_cast<uint64_t>(key.components.a));
+    return seed;
+}
+
+ImageViewCache::ImageViewCache(VulkanDevice* device)
+    : m_device(device) {
+    if (!m_device) {
+        throw std::runtime_error("ImageViewCache requires a valid device");
+    }
+}
+
+ImageViewCache::~ImageViewCache() {
+    clear();
+}
+
+VkImageView ImageViewCache::getView(VkImage image, VkFormat imageFormat, const ImageViewKey& key) {
+    if (image == VK_NULL_HANDLE) {
+        throw std::runtime_error("cannot create a view of a null image");
+    }
+
+    ImageViewKey resolved = key;
+    if (resolved.format == VK_FORMAT_UNDEFINED) {
+        resolved.format = imageFormat;
+    }
+    if (resolved.format == VK_FORMAT_UNDEFINED) {
+        throw std::runtime_error("image view key has no format and the image format is unknown");
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ViewMap& views = m_views[image];
+    auto it = views.find(resolved);
+    if (it != views.end()) {
+        return it->second;
+    }
+
+    VkImageView view = createView(image, resolved);
+    views.emplace(resolved, view);
+    return view;
+}
+
+size_t ImageViewCache::releaseImage(VkImage image) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_views.find(image);
+    if (it == m_views.end()) {
+        return 0;
+    }
+
+    const size_t count = it->second.size();
+    for (const auto& pair : it->second) {
+        vkDestroyImageView(m_device->getLogicalDevice(), pair.second, nullptr);
+    }
+    m_views.erase(it);
+    return count;
+}
+
+void ImageViewCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& image : m_views) {
+        for (const auto& pair : image.second) {
+            vkDestroyImageView(m_device->getLogicalDevice(), pair.second, nullptr);
+        }
+    }
+    m_views.clear();
+}
+
+size_t ImageViewCache::getViewCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& image : m_views) {
+        count += image.second.size();
+    }
+    return count;
+}
+
+VkImageView ImageViewCache::createView(VkImage image, const ImageViewKey& key) {
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image;
+    viewInfo.viewType = key.viewType;
+    viewInfo.format = key.format;
+    viewInfo.components = key.components;
+    viewInfo.subresourceRange.aspectMask = key.aspectMask;
+    viewInfo.subresourceRange.baseMipLevel = key.baseMipLevel;
+    viewInfo.subresourceRange.levelCount = key.levelCount;
+    viewInfo.subresourceRange.baseArrayLayer = key.baseArrayLayer;
+    viewInfo.subresourceRange.layerCount = key.layerCount;
+
+    VkImageView view;
+    if (vkCreateImageView(m_device->getLogicalDevice(), &viewInfo, nullptr, &view) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create cached image view!");
+    }
+    return view;
+}
+
+} // namespace ev
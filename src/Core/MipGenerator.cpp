@@ -0,0 +1,498 @@
+#include "EasyVulkan/Core/MipGenerator.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+#include "EasyVulkan/Utils/ResourceUtils.hpp"
+
+#include <stdexcept>
+
+namespace ev {
+
+namespace {
+
+/**
+ * @brief Push constants of ev_downsample.comp
+ */
+struct DownsamplePushConstants {
+    int32_t srcSize[2];  ///< Extent of the source level
+    uint32_t levelCount; ///< Levels written by the dispatch
+    uint32_t srgb;       ///< Non-zero when storage views alias an sRGB format
+};
+
+void recordImageBarrier(
+    VkCommandBuffer commandBuffer,
+    VkImage image,
+    uint32_t baseLevel,
+    uint32_t levelCount,
+    uint32_t layerCount,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    VkPipelineStageFlags srcStage,
+    VkAccessFlags srcAccess,
+    VkPipelineStageFlags dstStage,
+    VkAccessFlags dstAccess) {
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = baseLevel;
+    barrier.subresourceRange.levelCount = levelCount;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = layerCount;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        srcStage, dstStage,
+        0,
+        0, nullptr,
+        0, nullptr,
+        1, &barrier);
+}
+
+uint32_t levelExtent(uint32_t extent, uint32_t level) {
+    return std::max(extent >> level, 1u);
+}
+
+} // namespace
+
+MipGenerator::MipGenerator(VulkanDevice* device, VkShaderModule downsampleShader)
+    : m_device(device) {
+
+    if (!m_device) {
+        throw std::runtime_error("MipGenerator requires a valid device");
+    }
+    if (downsampleShader == VK_NULL_HANDLE) {
+        return;
+    }
+    // The shader writes through storage images declared without a format qualifier
+    if (!m_device->getEnabledFeatures().shaderStorageImageWriteWithoutFormat) {
+        LogWarning("shaderStorageImageWriteWithoutFormat is not enabled, compute mip generation disabled");
+        return;
+    }
+
+    VkDevice logicalDevice = m_device->getLogicalDevice();
+
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_NEAREST;
+    samplerInfo.minFilter = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    if (vkCreateSampler(logicalDevice, &samplerInfo, nullptr, &m_sampler) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create mip generation sampler!");
+    }
+
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    bindings[1].descriptorCount = kLevelsPerDispatch;
+    bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    setLayoutInfo.pBindings = bindings.data();
+    if (vkCreateDescriptorSetLayout(logicalDevice, &setLayoutInfo, nullptr, &m_setLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create mip generation descriptor set layout!");
+    }
+
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(DownsamplePushConstants);
+
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &m_setLayout;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushConstantRange;
+    if (vkCreatePipelineLayout(logicalDevice, &layoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create mip generation pipeline layout!");
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = downsampleShader;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = m_pipelineLayout;
+    if (vkCreateComputePipelines(logicalDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create mip generation pipeline!");
+    }
+}
+
+MipGenerator::~MipGenerator() {
+    releaseTransientResources();
+
+    VkDevice logicalDevice = m_device->getLogicalDevice();
+    if (m_pipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(logicalDevice, m_pipeline, nullptr);
+    }
+    if (m_pipelineLayout != VK_NULL_HANDLE) {
+        vkDestroyPipelineLayout(logicalDevice, m_pipelineLayout, nullptr);
+    }
+    if (m_setLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(logicalDevice, m_setLayout, nullptr);
+    }
+    if (m_sampler != VK_NULL_HANDLE) {
+        vkDestroySampler(logicalDevice, m_sampler, nullptr);
+    }
+}
+
+uint32_t MipGenerator::calculateMipLevels(uint32_t width, uint32_t height, uint32_t depth) {
+    uint32_t maxExtent = std::max({width, height, depth});
+    uint32_t levels = 1;
+    while (maxExtent > 1) {
+        maxExtent >>= 1;
+        ++levels;
+    }
+    return levels;
+}
+
+VkFormat MipGenerator::getStorageFormat(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_R8_SRGB:                  return VK_FORMAT_R8_UNORM;
+        case VK_FORMAT_R8G8_SRGB:                return VK_FORMAT_R8G8_UNORM;
+        case VK_FORMAT_R8G8B8A8_SRGB:            return VK_FORMAT_R8G8B8A8_UNORM;
+        case VK_FORMAT_B8G8R8A8_SRGB:            return VK_FORMAT_B8G8R8A8_UNORM;
+        case VK_FORMAT_A8B8G8R8_SRGB_PACK32:     return VK_FORMAT_A8B8G8R8_UNORM_PACK32;
+        default:                                 return format;
+    }
+}
+
+bool MipGenerator::supportsBlit(VkFormat format) const {
+    VkFormatProperties properties;
+    vkGetPhysicalDeviceFormatProperties(m_device->getPhysicalDevice(), format, &properties);
+
+    const VkFormatFeatureFlags required = VK_FORMAT_FEATURE_BLIT_SRC_BIT |
+                                          VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                          VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    return (properties.optimalTilingFeatures & required) == required;
+}
+
+bool MipGenerator::supportsCompute(VkFormat format, VkImageType imageType) const {
+    if (m_pipeline == VK_NULL_HANDLE || imageType != VK_IMAGE_TYPE_2D) {
+        return false;
+    }
+
+    VkFormatProperties sampledProperties;
+    vkGetPhysicalDeviceFormatProperties(m_device->getPhysicalDevice(), format, &sampledProperties);
+    VkFormatProperties storageProperties;
+    vkGetPhysicalDeviceFormatProperties(m_device->getPhysicalDevice(), getStorageFormat(format), &storageProperties);
+
+    return (sampledProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) &&
+           (storageProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT);
+}
+
+MipGenerationMode MipGenerator::resolveMode(
+    MipGenerationMode requested,
+    VkFormat format,
+    VkImageType imageType) const {
+
+    switch (requested) {
+        case MipGenerationMode::None:
+            return MipGenerationMode::None;
+
+        case MipGenerationMode::Compute:
+            if (supportsCompute(format, imageType)) {
+                return MipGenerationMode::Compute;
+            }
+            LogWarning("Compute mip generation unavailable for format " + std::to_string(format) + ", falling back to blits");
+            [[fallthrough]];
+
+        case MipGenerationMode::Blit:
+            if (!supportsBlit(format)) {
+                throw std::runtime_error("format does not support linear blits for mip generation!");
+            }
+            return MipGenerationMode::Blit;
+
+        case MipGenerationMode::Auto:
+        default:
+            if (supportsCompute(format, imageType)) {
+                return MipGenerationMode::Compute;
+            }
+            if (supportsBlit(format)) {
+                return MipGenerationMode::Blit;
+            }
+            LogWarning("No GPU mip generation path for format " + std::to_string(format) + ", mip levels left undefined");
+            return MipGenerationMode::None;
+    }
+}
+
+VkImageUsageFlags MipGenerator::getRequiredUsage(MipGenerationMode mode) {
+    switch (mode) {
+        case MipGenerationMode::Blit:
+            return VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        case MipGenerationMode::Compute:
+            return VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        default:
+            return 0;
+    }
+}
+
+VkImageCreateFlags MipGenerator::getRequiredCreateFlags(MipGenerationMode mode, VkFormat format) {
+    // sRGB formats are rarely storage-capable: write through an UNORM alias instead
+    if (mode == MipGenerationMode::Compute && getStorageFormat(format) != format) {
+        return VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT | VK_IMAGE_CREATE_EXTENDED_USAGE_BIT;
+    }
+    return 0;
+}
+
+void MipGenerator::record(
+    VkCommandBuffer commandBuffer,
+    const Target& target,
+    MipGenerationMode mode,
+    VkImageLayout finalLayout) {
+
+    if (target.mipLevels <= 1 || mode == MipGenerationMode::None) {
+        VkPipelineStageFlags finalStage;
+        VkAccessFlags finalAccess;
+        ResourceUtils::getLayoutStageAndAccess(finalLayout, finalStage, finalAccess);
+        recordImageBarrier(commandBuffer, target.image, 0, target.mipLevels, target.layerCount,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, finalLayout,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                           finalStage, finalAccess);
+        return;
+    }
+
+    if (mode == MipGenerationMode::Compute) {
+        recordComputeChain(commandBuffer, target, finalLayout);
+    } else {
+        recordBlitChain(commandBuffer, target, finalLayout);
+    }
+}
+
+void MipGenerator::recordBlitChain(
+    VkCommandBuffer commandBuffer,
+    const Target& target,
+    VkImageLayout finalLayout) {
+
+    VkPipelineStageFlags finalStage;
+    VkAccessFlags finalAccess;
+    ResourceUtils::getLayoutStageAndAccess(finalLayout, finalStage, finalAccess);
+
+    for (uint32_t level = 1; level < target.mipLevels; ++level) {
+        // The previous level was written by the upload copy or the previous blit
+        recordImageBarrier(commandBuffer, target.image, level - 1, 1, target.layerCount,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+        VkImageBlit blit{};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = level - 1;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = target.layerCount;
+        blit.srcOffsets[1] = {
+            static_cast<int32_t>(levelExtent(target.extent.width, level - 1)),
+            static_cast<int32_t>(levelExtent(target.extent.height, level - 1)),
+            static_cast<int32_t>(levelExtent(target.extent.depth, level - 1))};
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.mipLevel = level;
+        blit.dstSubresource.baseArrayLayer = 0;
+        blit.dstSubresource.layerCount = target.layerCount;
+        blit.dstOffsets[1] = {
+            static_cast<int32_t>(levelExtent(target.extent.width, level)),
+            static_cast<int32_t>(levelExtent(target.extent.height, level)),
+            static_cast<int32_t>(levelExtent(target.extent.depth, level))};
+
+        vkCmdBlitImage(
+            commandBuffer,
+            target.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            target.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1, &blit,
+            VK_FILTER_LINEAR);
+
+        // The previous level is complete
+        recordImageBarrier(commandBuffer, target.image, level - 1, 1, target.layerCount,
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, finalLayout,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                           finalStage, finalAccess);
+    }
+
+    recordImageBarrier(commandBuffer, target.image, target.mipLevels - 1, 1, target.layerCount,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, finalLayout,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                       finalStage, finalAccess);
+}
+
+VkImageView MipGenerator::createLevelView(
+    const Target& target,
+    VkFormat format,
+    uint32_t level,
+    VkImageUsageFlags usage) {
+
+    // Keeps the sRGB view from inheriting the STORAGE usage of the UNORM alias
+    VkImageViewUsageCreateInfo usageInfo{};
+    usageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO;
+    usageInfo.usage = usage;
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.pNext = &usageInfo;
+    viewInfo.image = target.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+    viewInfo.format = format;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.baseMipLevel = level;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = target.layerCount;
+
+    VkImageView view;
+    if (vkCreateImageView(m_device->getLogicalDevice(), &viewInfo, nullptr, &view) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create mip level view!");
+    }
+    m_transientViews.push_back(view);
+    return view;
+}
+
+void MipGenerator::recordComputeChain(
+    VkCommandBuffer commandBuffer,
+    const Target& target,
+    VkImageLayout finalLayout) {
+
+    VkDevice logicalDevice = m_device->getLogicalDevice();
+    const VkFormat storageFormat = getStorageFormat(target.format);
+    const uint32_t dispatchCount = (target.mipLevels - 1 + kLevelsPerDispatch - 1) / kLevelsPerDispatch;
+
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSizes[0].descriptorCount = dispatchCount;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    poolSizes[1].descriptorCount = dispatchCount * kLevelsPerDispatch;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = dispatchCount;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+
+    VkDescriptorPool pool;
+    if (vkCreateDescriptorPool(logicalDevice, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create mip generation descriptor pool!");
+    }
+    m_transientPools.push_back(pool);
+
+    // Level 0 becomes the first source; the other levels are overwritten entirely
+    recordImageBarrier(commandBuffer, target.image, 0, 1, target.layerCount,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    recordImageBarrier(commandBuffer, target.image, 1, target.mipLevels - 1, target.layerCount,
+                       VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+
+    for (uint32_t srcLevel = 0; srcLevel + 1 < target.mipLevels;) {
+        const uint32_t levelCount = std::min(kLevelsPerDispatch, target.mipLevels - 1 - srcLevel);
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = pool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &m_setLayout;
+
+        VkDescriptorSet descriptorSet;
+        if (vkAllocateDescriptorSets(logicalDevice, &allocInfo, &descriptorSet) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate mip generation descriptor set!");
+        }
+
+        VkDescriptorImageInfo srcInfo{};
+        srcInfo.sampler = m_sampler;
+        srcInfo.imageView = createLevelView(target, target.format, srcLevel, VK_IMAGE_USAGE_SAMPLED_BIT);
+        srcInfo.imageLayout = srcLevel == 0 ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+
+        // Unused slots repeat the last level; the shader never writes them
+        std::array<VkDescriptorImageInfo, kLevelsPerDispatch> dstInfos{};
+        for (uint32_t i = 0; i < kLevelsPerDispatch; ++i) {
+            dstInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+            dstInfos[i].imageView = i < levelCount
+                ? createLevelView(target, storageFormat, srcLevel + 1 + i, VK_IMAGE_USAGE_STORAGE_BIT)
+                : dstInfos[levelCount - 1].imageView;
+        }
+
+        std::array<VkWriteDescriptorSet, 2> writes{};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = descriptorSet;
+        writes[0].dstBinding = 0;
+        writes[0].descriptorCount = 1;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo = &srcInfo;
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = descriptorSet;
+        writes[1].dstBinding = 1;
+        writes[1].descriptorCount = kLevelsPerDispatch;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo = dstInfos.data();
+        vkUpdateDescriptorSets(logicalDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+        DownsamplePushConstants pushConstants{};
+        pushConstants.srcSize[0] = static_cast<int32_t>(levelExtent(target.extent.width, srcLevel));
+        pushConstants.srcSize[1] = static_cast<int32_t>(levelExtent(target.extent.height, srcLevel));
+        pushConstants.levelCount = levelCount;
+        pushConstants.srgb = storageFormat != target.format ? 1u : 0u;
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout,
+                                0, 1, &descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                           0, sizeof(pushConstants), &pushConstants);
+
+        // Each 16x16 workgroup produces a 16x16 tile of the first written level
+        const uint32_t groupsX = (levelExtent(target.extent.width, srcLevel + 1) + 15) / 16;
+        const uint32_t groupsY = (levelExtent(target.extent.height, srcLevel + 1) + 15) / 16;
+        vkCmdDispatch(commandBuffer, groupsX, groupsY, target.layerCount);
+
+        srcLevel += levelCount;
+
+        // The last written level is the source of the next dispatch
+        if (srcLevel + 1 < target.mipLevels) {
+            recordImageBarrier(commandBuffer, target.image, srcLevel, 1, target.layerCount,
+                               VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+        }
+    }
+
+    VkPipelineStageFlags finalStage;
+    VkAccessFlags finalAccess;
+    ResourceUtils::getLayoutStageAndAccess(finalLayout, finalStage, finalAccess);
+
+    recordImageBarrier(commandBuffer, target.image, 0, 1, target.layerCount,
+                       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, finalLayout,
+                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                       finalStage, finalAccess);
+    recordImageBarrier(commandBuffer, target.image, 1, target.mipLevels - 1, target.layerCount,
+                       VK_IMAGE_LAYOUT_GENERAL, finalLayout,
+                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                       finalStage, finalAccess);
+}
+
+void MipGenerator::releaseTransientResources() {
+    VkDevice logicalDevice = m_device->getLogicalDevice();
+    for (VkImageView view : m_transientViews) {
+        vkDestroyImageView(logicalDevice, view, nullptr);
+    }
+    for (VkDescriptorPool pool : m_transientPools) {
+        vkDestroyDescriptorPool(logicalDevice, pool, nullptr);
+    }
+    m_transientViews.clear();
+    m_transientPools.clear();
+}
+
+} // namespace ev
@@ -0,0 +1,227 @@
+#include "EasyVulkan/Core/ReadbackQueue.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+namespace ev {
+
+ReadbackQueue::ReadbackQueue(VulkanDevice* device, uint32_t framesInFlight, VkDeviceSize bytesPerFrame)
+    : m_device(device)
+    , m_bytesPerFrame(bytesPerFrame) {
+
+    if (!m_device) {
+        throw std::runtime_error("ReadbackQueue requires a valid device");
+    }
+    if (framesInFlight == 0 || bytesPerFrame == 0) {
+        throw std::runtime_error("ReadbackQueue needs at least one slot and a non-zero capacity");
+    }
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = bytesPerFrame;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    // Random host access makes VMA prefer HOST_CACHED memory types
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT |
+                      VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+
+    m_slots.resize(framesInFlight);
+    for (auto& slot : m_slots) {
+        VmaAllocationInfo info{};
+        if (vmaCreateBuffer(m_device->getAllocator(), &bufferInfo, &allocInfo,
+                            &slot.buffer, &slot.allocation, &info) != VK_SUCCESS) {
+            destroyBuffers();
+            throw std::runtime_error("failed to create readback buffer!");
+        }
+        slot.mappedData = info.pMappedData;
+    }
+}
+
+ReadbackQueue::~ReadbackQueue() {
+    destroyBuffers();
+}
+
+void ReadbackQueue::destroyBuffers() {
+    for (auto& slot : m_slots) {
+        if (slot.buffer != VK_NULL_HANDLE) {
+            vmaDestroyBuffer(m_device->getAllocator(), slot.buffer, slot.allocation);
+            slot.buffer = VK_NULL_HANDLE;
+        }
+    }
+}
+
+void ReadbackQueue::beginFrame(uint32_t frameIndex, VkFence frameFence) {
+    m_currentSlot = frameIndex % static_cast<uint32_t>(m_slots.size());
+    Slot& slot = m_slots[m_currentSlot];
+
+    // The caller has waited on this slot's fence, so its previous requests are done
+    onSlotComplete(slot);
+    slot.fence = frameFence;
+}
+
+VkDeviceSize ReadbackQueue::reserve(VkDeviceSize size, VkDeviceSize alignment) {
+    Slot& slot = m_slots[m_currentSlot];
+
+    VkDeviceSize offset = (slot.cursor + alignment - 1) / alignment * alignment;
+    if (offset + size > m_bytesPerFrame) {
+        LogError("ReadbackQueue slot capacity exceeded");
+        throw std::runtime_error("ReadbackQueue slot capacity exceeded");
+    }
+
+    slot.cursor = offset + size;
+    return offset;
+}
+
+void ReadbackQueue::recordHostBarrier(VkCommandBuffer commandBuffer, VkDeviceSize offset, VkDeviceSize size) const {
+    VkBufferMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = m_slots[m_currentSlot].buffer;
+    barrier.offset = offset;
+    barrier.size = size;
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        0, nullptr,
+        1, &barrier,
+        0, nullptr);
+}
+
+std::future<std::vector<uint8_t>> ReadbackQueue::readBuffer(
+    VkCommandBuffer commandBuffer,
+    VkBuffer srcBuffer,
+    VkDeviceSize srcOffset,
+    VkDeviceSize size) {
+
+    auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+    auto future = promise->get_future();
+
+    VkDeviceSize offset = reserve(size, 16);
+
+    VkBufferCopy region{};
+    region.srcOffset = srcOffset;
+    region.dstOffset = offset;
+    region.size = size;
+    vkCmdCopyBuffer(commandBuffer, srcBuffer, m_slots[m_currentSlot].buffer, 1, &region);
+    recordHostBarrier(commandBuffer, offset, size);
+
+    m_slots[m_currentSlot].requests.push_back({offset, size, nullptr, promise});
+    return future;
+}
+
+void ReadbackQueue::readBuffer(
+    VkCommandBuffer commandBuffer,
+    VkBuffer srcBuffer,
+    VkDeviceSize srcOffset,
+    VkDeviceSize size,
+    Callback callback) {
+
+    VkDeviceSize offset = reserve(size, 16);
+
+    VkBufferCopy region{};
+    region.srcOffset = srcOffset;
+    region.dstOffset = offset;
+    region.size = size;
+    vkCmdCopyBuffer(commandBuffer, srcBuffer, m_slots[m_currentSlot].buffer, 1, &region);
+    recordHostBarrier(commandBuffer, offset, size);
+
+    m_slots[m_currentSlot].requests.push_back({offset, size, std::move(callback), nullptr});
+}
+
+void ReadbackQueue::readImage(
+    VkCommandBuffer commandBuffer,
+    VkImage image,
+    VkImageLayout imageLayout,
+    uint32_t width,
+    uint32_t height,
+    uint32_t bytesPerPixel,
+    Callback callback,
+    VkImageAspectFlags aspectMask,
+    uint32_t mipLevel,
+    uint32_t arrayLayer) {
+
+    VkDeviceSize size = static_cast<VkDeviceSize>(width) * height * bytesPerPixel;
+    // bufferOffset must be a multiple of 4 and of the texel size
+    VkDeviceSize offset = reserve(size, std::lcm<VkDeviceSize>(16, bytesPerPixel));
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = offset;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = aspectMask;
+    region.imageSubresource.mipLevel = mipLevel;
+    region.imageSubresource.baseArrayLayer = arrayLayer;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = {width, height, 1};
+
+    vkCmdCopyImageToBuffer(commandBuffer, image, imageLayout, m_slots[m_currentSlot].buffer, 1, &region);
+    recordHostBarrier(commandBuffer, offset, size);
+
+    m_slots[m_currentSlot].requests.push_back({offset, size, std::move(callback), nullptr});
+}
+
+uint32_t ReadbackQueue::onSlotComplete(Slot& slot) {
+    uint32_t delivered = 0;
+    if (!slot.requests.empty()) {
+        // One invalidate for the whole written range; no-op on HOST_COHERENT memory
+        if (vmaInvalidateAllocation(m_device->getAllocator(), slot.allocation, 0, slot.cursor) != VK_SUCCESS) {
+            throw std::runtime_error("failed to invalidate readback memory!");
+        }
+
+        for (auto& request : slot.requests) {
+            const uint8_t* src = static_cast<const uint8_t*>(slot.mappedData) + request.offset;
+            if (request.callback) {
+                request.callback(src, request.size);
+            }
+            if (request.promise) {
+                request.promise->set_value(std::vector<uint8_t>(src, src + request.size));
+            }
+            ++delivered;
+        }
+        slot.requests.clear();
+    }
+
+    slot.cursor = 0;
+    return delivered;
+}
+
+uint32_t ReadbackQueue::poll() {
+    uint32_t delivered = 0;
+    for (uint32_t i = 0; i < m_slots.size(); ++i) {
+        Slot& slot = m_slots[i];
+        // The current slot is still being recorded
+        if (i == m_currentSlot || slot.requests.empty() || slot.fence == VK_NULL_HANDLE) {
+            continue;
+        }
+        if (vkGetFenceStatus(m_device->getLogicalDevice(), slot.fence) == VK_SUCCESS) {
+            delivered += onSlotComplete(slot);
+        }
+    }
+    return delivered;
+}
+
+void ReadbackQueue::resolveAll() {
+    for (auto& slot : m_slots) {
+        onSlotComplete(slot);
+    }
+}
+
+VkDeviceSize ReadbackQueue::getRemainingCapacity() const {
+    return m_bytesPerFrame - m_slots[m_currentSlot].cursor;
+}
+
+} // namespace ev
@@ -12,15 +12,73 @@
 #include "EasyVulkan/Builders/SamplerBuilder.hpp"
 #include "EasyVulkan/Builders/ShaderModuleBuilder.hpp"
 #include "EasyVulkan/Utils/CommandUtils.hpp"
+#include "EasyVulkan/Utils/ResourceUtils.hpp"
 #include "EasyVulkan/Core/CommandPoolManager.hpp"
 #include "EasyVulkan/Utils/VulkanDebug.hpp"
+#include <cctype>
 #include <stdexcept>
 
 namespace ev {
 
+namespace {
+
+/**
+ * @brief Name prefixes recognised by ResourceManager::inferMemoryCategory
+ */
+struct CategoryPrefix {
+    const char* prefix;
+    MemoryCategory category;
+};
+
+const CategoryPrefix kCategoryPrefixes[] = {
+    {"texture", MemoryCategory::Textures},
+    {"tex", MemoryCategory::Textures},
+    {"mesh", MemoryCategory::Meshes},
+    {"vertex", MemoryCategory::Meshes},
+    {"index", MemoryCategory::Meshes},
+    {"geometry", MemoryCategory::Meshes},
+    {"vb", MemoryCategory::Meshes},
+    {"ib", MemoryCategory::Meshes},
+    {"rt", MemoryCategory::RenderTargets},
+    {"depth", MemoryCategory::RenderTargets},
+    {"gbuffer", MemoryCategory::RenderTargets},
+    {"attachment", MemoryCategory::RenderTargets},
+    {"staging", MemoryCategory::Staging},
+    {"uniform", MemoryCategory::Uniforms},
+    {"ubo", MemoryCategory::Uniforms},
+};
+
+MemoryCategory categoryFromBufferUsage(VkBufferUsageFlags usage) {
+    if (usage & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT)) {
+        return MemoryCategory::Meshes;
+    }
+    if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) {
+        return MemoryCategory::Uniforms;
+    }
+    if (usage == VK_BUFFER_USAGE_TRANSFER_SRC_BIT) {
+        return MemoryCategory::Staging;
+    }
+    return MemoryCategory::Other;
+}
+
+MemoryCategory categoryFromImageUsage(VkImageUsageFlags usage) {
+    if (usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                 VK_IMAGE_USAGE_STORAGE_BIT)) {
+        return MemoryCategory::RenderTargets;
+    }
+    if (usage & VK_IMAGE_USAGE_SAMPLED_BIT) {
+        return MemoryCategory::Textures;
+    }
+    return MemoryCategory::Other;
+}
+
+} // namespace
+
 ResourceManager::ResourceManager(VulkanDevice* device, VulkanContext* context)
     : m_device(device)
-    , m_context(context) {
+    , m_context(context)
+    , m_imageViewCache(std::make_unique<ImageViewCache>(device))
+    , m_samplerCache(std::make_unique<SamplerCache>(device)) {
 }
 
 ResourceManager::~ResourceManager() {
@@ -101,17 +159,36 @@ void ResourceManager::registerResource(const std::string& name, uint64_t handle,
 
 void ResourceManager::registerResource(const std::string& name, uint64_t handle,
                                 VmaAllocation allocation, VkDeviceSize size, 
-                                VkBufferUsageFlags usage, VkObjectType type) {
+                                VkBufferUsageFlags usage, VkObjectType type,
+                                MemoryCategory category) {
     if (name.empty()) {
         return;
     }
 
     if (type == VK_OBJECT_TYPE_BUFFER) {
+        if (category == MemoryCategory::Unspecified) {
+            category = inferMemoryCategory(name);
+        }
+        if (category == MemoryCategory::Unspecified) {
+            category = categoryFromBufferUsage(usage);
+        }
+
+        // Re-registering a name replaces the tracked entry, so drop its bytes first
+        auto existing = m_buffers.find(name);
+        if (existing != m_buffers.end()) {
+            untrackAllocation(existing->second.category, existing->second.allocationSize);
+        }
+
         BufferInfo bufferInfo;
         bufferInfo.buffer = reinterpret_cast<VkBuffer>(handle);
         bufferInfo.allocation = allocation;
         bufferInfo.size = size;
         bufferInfo.usage = usage;
+        bufferInfo.category = category;
+        bufferInfo.allocationSize = trackAllocation(category, allocation);
+        if (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) {
+            bufferInfo.deviceAddress = ResourceUtils::getBufferDeviceAddress(m_device, bufferInfo.buffer);
+        }
         m_buffers[name] = bufferInfo;
     } else {
         LogError("This kind of resource tracking should be done with this overload of registerResource(Supported types: Buffer)");
@@ -125,12 +202,25 @@ void ResourceManager::registerResource(const std::string& name, uint64_t handle,
 }
 
 void ResourceManager::registerResource(const std::string& name, uint64_t handle,
-    VkImageView imageView, VmaAllocation allocation,  uint32_t width, uint32_t height, VkImageLayout layout, VkObjectType type) {
+    VkImageView imageView, VmaAllocation allocation,  uint32_t width, uint32_t height, VkImageLayout layout, VkObjectType type,
+    VkImageUsageFlags usage, MemoryCategory category, VkFormat format) {
     if (name.empty()) {
         return;
     }
     switch (type) {
-        case VK_OBJECT_TYPE_IMAGE:
+        case VK_OBJECT_TYPE_IMAGE: {
+            if (category == MemoryCategory::Unspecified) {
+                category = inferMemoryCategory(name);
+            }
+            if (category == MemoryCategory::Unspecified) {
+                category = categoryFromImageUsage(usage);
+            }
+
+            auto existing = m_images.find(name);
+            if (existing != m_images.end()) {
+                untrackAllocation(existing->second.category, existing->second.allocationSize);
+            }
+
             ImageInfo imageInfo;
             imageInfo.image = reinterpret_cast<VkImage>(handle);
             imageInfo.imageView = imageView;
@@ -138,8 +228,12 @@ void ResourceManager::registerResource(const std::string& name, uint64_t handle,
             imageInfo.width = width;
             imageInfo.height = height;
             imageInfo.layout = layout;
+            imageInfo.format = format;
+            imageInfo.category = category;
+            imageInfo.allocationSize = trackAllocation(category, allocation);
             m_images[name] = imageInfo;
             break;
+        }
         default:
             LogError("This kind of resource tracking should be done with this overload of registerResource(Supported types: Image)");
             throw std::runtime_error("Unsupported resource type for VMA tracking(For Image)");
@@ -189,6 +283,15 @@ void ResourceManager::registerResource(const std::string& name, uint64_t primary
 }
 
 
+VkImageView ResourceManager::getImageView(const std::string& imageName, const ImageViewKey& key) {
+    auto it = m_images.find(imageName);
+    if (it == m_images.end()) {
+        LogError("Image not found for view lookup: " + imageName);
+        throw std::runtime_error("Image not found for view lookup: " + imageName);
+    }
+    return m_imageViewCache->getView(it->second.image, it->second.format, key);
+}
+
 bool ResourceManager::clearResource(const std::string& name, VkObjectType type) {
     if (name.empty()) {
         return false;
@@ -199,6 +302,8 @@ bool ResourceManager::clearResource(const std::string& name, VkObjectType type)
         // Single-handle resources
         case VK_OBJECT_TYPE_BUFFER:
             if (m_buffers.find(name) != m_buffers.end()) {
+                untrackAllocation(m_buffers[name].category, m_buffers[name].allocationSize);
+                m_device->cancelMappedFlush(m_buffers[name].allocation);
                 vmaDestroyBuffer(m_device->getAllocator(), m_buffers[name].buffer, m_buffers[name].allocation);
                 m_buffers.erase(name);
                 found = true;
@@ -256,6 +361,8 @@ bool ResourceManager::clearResource(const std::string& name, VkObjectType type)
             break;
         case VK_OBJECT_TYPE_IMAGE:
             if (m_images.find(name) != m_images.end()) {
+                untrackAllocation(m_images[name].category, m_images[name].allocationSize);
+                m_imageViewCache->releaseImage(m_images[name].image);
                 vkDestroyImageView(m_device->getLogicalDevice(), m_images[name].imageView, nullptr);
                 vmaDestroyImage(m_device->getAllocator(), m_images[name].image, m_images[name].allocation);
                 m_images.erase(name);
@@ -312,7 +419,10 @@ void ResourceManager::cleanup() {
         vkDestroySampler(device, pair.second, nullptr);
     }
     m_samplers.clear();
+    m_samplerCache->clear();
 
+    // Cached views go before the images they were created from
+    m_imageViewCache->clear();
     for (const auto& pair : m_images) {
         vkDestroyImageView(device, pair.second.imageView, nullptr);
         vmaDestroyImage(m_device->getAllocator(), pair.second.image, pair.second.allocation);
@@ -320,6 +430,7 @@ void ResourceManager::cleanup() {
     m_images.clear();
 
     for (const auto& pair : m_buffers) {
+        m_device->cancelMappedFlush(pair.second.allocation);
         vmaDestroyBuffer(m_device->getAllocator(), pair.second.buffer, pair.second.allocation);
     }
     m_buffers.clear();
@@ -375,6 +486,101 @@ void ResourceManager::destroyResource(uint64_t handle, VkObjectType type) {
     }
 }
 
+VkDeviceSize ResourceManager::trackAllocation(MemoryCategory category, VmaAllocation allocation) {
+    if (allocation == VK_NULL_HANDLE) {
+        return 0;
+    }
+
+    VmaAllocationInfo allocInfo{};
+    vmaGetAllocationInfo(m_device->getAllocator(), allocation, &allocInfo);
+
+    auto& counters = m_memoryCategoryCounters[static_cast<size_t>(category)];
+    uint64_t live = counters.liveBytes.fetch_add(allocInfo.size, std::memory_order_relaxed) + allocInfo.size;
+    counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Raise the high-water mark if this allocation pushed the category past it
+    uint64_t peak = counters.highWaterBytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !counters.highWaterBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+
+    return allocInfo.size;
+}
+
+void ResourceManager::untrackAllocation(MemoryCategory category, VkDeviceSize bytes) {
+    if (bytes == 0) {
+        return;
+    }
+
+    auto& counters = m_memoryCategoryCounters[static_cast<size_t>(category)];
+    counters.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    counters.allocationCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoryCategory ResourceManager::inferMemoryCategory(const std::string& name) {
+    for (const auto& entry : kCategoryPrefixes) {
+        size_t length = std::char_traits<char>::length(entry.prefix);
+        if (name.size() < length) {
+            continue;
+        }
+
+        bool matches = true;
+        for (size_t i = 0; i < length; ++i) {
+            if (std::tolower(static_cast<unsigned char>(name[i])) != entry.prefix[i]) {
+                matches = false;
+                break;
+            }
+        }
+
+        // Require a separator so that e.g. "IBL_irradiance" or "rtScene" are not taken for
+        // an index buffer or a render target; camelCase names fall back to the usage flags
+        if (matches && (name.size() == length ||
+                        !std::isalpha(static_cast<unsigned char>(name[length])))) {
+            return entry.category;
+        }
+    }
+    return MemoryCategory::Unspecified;
+}
+
+MemoryCategoryStats ResourceManager::getMemoryCategoryStats(MemoryCategory category) const {
+    const auto& counters = m_memoryCategoryCounters[static_cast<size_t>(category)];
+
+    MemoryCategoryStats stats;
+    stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+    stats.highWaterBytes = counters.highWaterBytes.load(std::memory_order_relaxed);
+    stats.allocationCount = counters.allocationCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::array<MemoryCategoryStats, static_cast<size_t>(MemoryCategory::Count)> ResourceManager::getAllMemoryCategoryStats() const {
+    std::array<MemoryCategoryStats, static_cast<size_t>(MemoryCategory::Count)> stats{};
+    for (size_t i = 0; i < stats.size(); ++i) {
+        stats[i] = getMemoryCategoryStats(static_cast<MemoryCategory>(i));
+    }
+    return stats;
+}
+
+void ResourceManager::resetMemoryCategoryHighWater() {
+    for (auto& counters : m_memoryCategoryCounters) {
+        counters.highWaterBytes.store(counters.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void ResourceManager::printMemoryCategoryUsage() const {
+    printf("\n===== MEMORY USAGE BY CATEGORY =====\n");
+    auto stats = getAllMemoryCategoryStats();
+    for (size_t i = 0; i < stats.size(); ++i) {
+        if (stats[i].highWaterBytes == 0) {
+            continue;
+        }
+        printf("%-12s: %0.1f MB live (peak %0.1f MB), %u allocations\n",
+               memoryCategoryName(static_cast<MemoryCategory>(i)),
+               (double)stats[i].liveBytes / (1024.0 * 1024.0),
+               (double)stats[i].highWaterBytes / (1024.0 * 1024.0),
+               stats[i].allocationCount);
+    }
+}
+
 std::vector<VmaBudget> ResourceManager::getMemoryBudget() const {
     VmaAllocator allocator = m_device->getAllocator();
     if (!allocator) {
@@ -650,6 +856,8 @@ void ResourceManager::printMemoryUsage(bool detailed) const {
                    (double)(budget.statistics.blockBytes - budget.statistics.allocationBytes) / (1024.0 * 1024.0));
         }
         
+        printMemoryCategoryUsage();
+
         // If detailed statistics are requested, print them
         if (detailed) {
             VmaTotalStatistics stats = getMemoryUsage();
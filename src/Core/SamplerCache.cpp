@@ -0,0 +1,187 @@
+#include "EasyVulkan/Core/SamplerCache.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+namespace ev {
+
+namespace {
+
+void hashCombine(size_t& seed, uint64_t value) {
+    seed ^= std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+// Equal floats must hash equally, so -0.0f is folded onto 0.0f
+uint64_t hashFloat(float value) {
+    return std::hash<float>{}(value == 0.0f ? 0.0f : value);
+}
+
+} // namespace
+
+SamplerKey SamplerKey::fromCreateInfo(const VkSamplerCreateInfo& createInfo) {
+    SamplerKey key;
+    key.flags = createInfo.flags;
+    key.magFilter = createInfo.magFilter;
+    key.minFilter = createInfo.minFilter;
+    key.mipmapMode = createInfo.mipmapMode;
+    key.addressModeU = createInfo.addressModeU;
+    key.addressModeV = createInfo.addressModeV;
+    key.addressModeW = createInfo.addressModeW;
+    key.mipLodBias = createInfo.mipLodBias;
+    key.anisotropyEnable = createInfo.anisotropyEnable;
+    key.maxAnisotropy = createInfo.maxAnisotropy;
+    key.compareEnable = createInfo.compareEnable;
+    key.compareOp = createInfo.compareOp;
+    key.minLod = createInfo.minLod;
+    key.maxLod = createInfo.maxLod;
+    key.borderColor = createInfo.borderColor;
+    key.unnormalizedCoordinates = createInfo.unnormalizedCoordinates;
+    return key;
+}
+
+VkSamplerCreateInfo SamplerKey::toCreateInfo() const {
+    VkSamplerCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    createInfo.flags = flags;
+    createInfo.magFilter = magFilter;
+    createInfo.minFilter = minFilter;
+    createInfo.mipmapMode = mipmapMode;
+    createInfo.addressModeU = addressModeU;
+    createInfo.addressModeV = addressModeV;
+    createInfo.addressModeW = addressModeW;
+    createInfo.mipLodBias = mipLodBias;
+    createInfo.anisotropyEnable = anisotropyEnable;
+    createInfo.maxAnisotropy = maxAnisotropy;
+    createInfo.compareEnable = compareEnable;
+    createInfo.compareOp = compareOp;
+    createInfo.minLod = minLod;
+    createInfo.maxLod = maxLod;
+    createInfo.borderColor = borderColor;
+    createInfo.unnormalizedCoordinates = unnormalizedCoordinates;
+    return createInfo;
+}
+
+bool SamplerKey::operator==(const SamplerKey& other) const {
+    return flags == other.flags &&
+           magFilter == other.magFilter &&
+           minFilter == other.minFilter &&
+           mipmapMode == other.mipmapMode &&
+           addressModeU == other.addressModeU &&
+           addressModeV == other.addressModeV &&
+           addressModeW == other.addressModeW &&
+           mipLodBias == other.mipLodBias &&
+           anisotropyEnable == other.anisotropyEnable &&
+           maxAnisotropy == other.maxAnisotropy &&
+           compareEnable == other.compareEnable &&
+           compareOp == other.compareOp &&
+           minLod == other.minLod &&
+           maxLod == other.maxLod &&
+           borderColor == other.borderColor &&
+           unnormalizedCoordinates == other.unnormalizedCoordinates;
+}
+
+size_t SamplerKeyHash::operator()(const SamplerKey& key) const {
+    size_t seed = 0;
+    hashCombine(seed, key.flags);
+    hashCombine(seed, (static_cast<uint64_t>(key.magFilter) << 32) | static_cast<uint32_t>(key.minFilter));
+    hashCombine(seed, (static_cast<uint64_t>(key.mipmapMode) << 32) | static_cast<uint32_t>(key.addressModeU));
+    hashCombine(seed, (static_cast<uint64_t>(key.addressModeV) << 32) | static_cast<uint32_t>(key.addressModeW));
+    hashCombine(seed, hashFloat(key.mipLodBias));
+    hashCombine(seed, (static_cast<uint64_t>(key.anisotropyEnable) << 32) | key.compareEnable);
+    hashCombine(seed, hashFloat(key.maxAnisotropy));
+    hashCombine(seed, (static_cast<uint64_t>(key.compareOp) << 32) | static_cast<uint32_t>(key.borderColor));
+    hashCombine(seed, hashFloat(key.minLod));
+    hashCombine(seed, hashFloat(key.maxLod));
+    hashCombine(seed, key.unnormalizedCoordinates);
+    return seed;
+}
+
+SamplerCache::SamplerCache(VulkanDevice* device)
+    : m_device(device) {
+    if (!m_device) {
+        throw std::runtime_error("SamplerCache requires a valid device");
+    }
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(m_device->getPhysicalDevice(), &properties);
+    m_samplerLimit = properties.limits.maxSamplerAllocationCount;
+}
+
+SamplerCache::~SamplerCache() {
+    clear();
+}
+
+VkSampler SamplerCache::acquire(const VkSamplerCreateInfo& createInfo) {
+    const SamplerKey key = SamplerKey::fromCreateInfo(createInfo);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        ++it->second.references;
+        return it->second.sampler;
+    }
+
+    if (m_entries.size() >= m_samplerLimit) {
+        LogWarning("Sampler cache holds " + std::to_string(m_entries.size()) +
+                   " samplers, at the device limit of " + std::to_string(m_samplerLimit));
+    }
+
+    Entry entry;
+    entry.sampler = createSampler(key);
+    entry.references = 1;
+    m_entries.emplace(key, entry);
+    m_keys.emplace(entry.sampler, key);
+    return entry.sampler;
+}
+
+bool SamplerCache::release(VkSampler sampler) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto keyIt = m_keys.find(sampler);
+    if (keyIt == m_keys.end()) {
+        return false;
+    }
+
+    auto entryIt = m_entries.find(keyIt->second);
+    if (--entryIt->second.references == 0) {
+        vkDestroySampler(m_device->getLogicalDevice(), sampler, nullptr);
+        m_entries.erase(entryIt);
+        m_keys.erase(keyIt);
+    }
+    return true;
+}
+
+void SamplerCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& pair : m_entries) {
+        vkDestroySampler(m_device->getLogicalDevice(), pair.second.sampler, nullptr);
+    }
+    m_entries.clear();
+    m_keys.clear();
+}
+
+size_t SamplerCache::getCachedSamplerCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+size_t SamplerCache::getReferenceCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& pair : m_entries) {
+        count += pair.second.references;
+    }
+    return count;
+}
+
+VkSampler SamplerCache::createSampler(const SamplerKey& key) {
+    const VkSamplerCreateInfo createInfo = key.toCreateInfo();
+
+    VkSampler sampler;
+    if (vkCreateSampler(m_device->getLogicalDevice(), &createInfo, nullptr, &sampler) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create shared sampler!");
+    }
+    return sampler;
+}
+
+} // namespace ev
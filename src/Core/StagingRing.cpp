@@ -0,0 +1,210 @@
+#include "EasyVulkan/Core/StagingRing.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+#include "EasyVulkan/Utils/FormatUtils.hpp"
+#include "EasyVulkan/Utils/ResourceUtils.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace ev {
+
+StagingRing::StagingRing(VulkanDevice* device, uint32_t framesInFlight, VkDeviceSize bytesPerFrame)
+    : m_device(device)
+    , m_bytesPerFrame(bytesPerFrame) {
+
+    if (!m_device) {
+        throw std::runtime_error("StagingRing requires a valid device");
+    }
+    if (framesInFlight == 0 || bytesPerFrame == 0) {
+        throw std::runtime_error("StagingRing needs at least one slot and a non-zero capacity");
+    }
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = bytesPerFrame;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    // Sequential writes let VMA pick write-combined memory
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                      VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    m_slots.resize(framesInFlight);
+    for (auto& slot : m_slots) {
+        VmaAllocationInfo info{};
+        if (vmaCreateBuffer(m_device->getAllocator(), &bufferInfo, &allocInfo,
+                            &slot.buffer, &slot.allocation, &info) != VK_SUCCESS) {
+            destroyBuffers();
+            throw std::runtime_error("failed to create staging ring buffer!");
+        }
+        slot.mappedData = info.pMappedData;
+    }
+}
+
+StagingRing::~StagingRing() {
+    destroyBuffers();
+}
+
+void StagingRing::destroyBuffers() {
+    for (auto& slot : m_slots) {
+        if (slot.buffer != VK_NULL_HANDLE) {
+            vmaDestroyBuffer(m_device->getAllocator(), slot.buffer, slot.allocation);
+            slot.buffer = VK_NULL_HANDLE;
+        }
+    }
+}
+
+void StagingRing::beginFrame(uint32_t frameIndex) {
+    m_currentSlot = frameIndex % static_cast<uint32_t>(m_slots.size());
+    Slot& slot = m_slots[m_currentSlot];
+
+    // The caller has waited on this slot's fence, so the GPU is done reading it
+    onSlotReset(slot);
+    slot.cursor = 0;
+}
+
+StagingAllocation StagingRing::allocate(VkDeviceSize size, VkDeviceSize alignment) {
+    Slot& slot = m_slots[m_currentSlot];
+
+    VkDeviceSize offset = (slot.cursor + alignment - 1) / alignment * alignment;
+    if (offset + size > m_bytesPerFrame) {
+        LogError("StagingRing slot capacity exceeded");
+        throw std::runtime_error("StagingRing slot capacity exceeded");
+    }
+    slot.cursor = offset + size;
+
+    StagingAllocation allocation;
+    allocation.buffer = slot.buffer;
+    allocation.offset = offset;
+    allocation.size = size;
+    allocation.mappedData = static_cast<uint8_t*>(slot.mappedData) + offset;
+    return allocation;
+}
+
+bool StagingRing::canAllocate(VkDeviceSize size, VkDeviceSize alignment) const {
+    const VkDeviceSize offset = (m_slots[m_currentSlot].cursor + alignment - 1) / alignment * alignment;
+    return offset + size <= m_bytesPerFrame;
+}
+
+void StagingRing::flush(const StagingAllocation& allocation) {
+    if (vmaFlushAllocation(m_device->getAllocator(), m_slots[m_currentSlot].allocation,
+                           allocation.offset, allocation.size) != VK_SUCCESS) {
+        throw std::runtime_error("failed to flush staging ring memory!");
+    }
+}
+
+VkDeviceSize StagingRing::updateImage(
+    VkCommandBuffer commandBuffer,
+    const ImageUpdateTarget& target,
+    const std::vector<VkRect2D>& dirtyRects) {
+
+    if (!target.pixels) {
+        throw std::runtime_error("image update has no source pixels");
+    }
+    const FormatInfo formatInfo = FormatUtils::getFormatInfo(target.format);
+    if (formatInfo.bytesPerBlock == 0) {
+        throw std::runtime_error("unsupported format for image update: " + std::to_string(target.format));
+    }
+
+    const uint32_t blockWidth = formatInfo.blockWidth;
+    const uint32_t blockHeight = formatInfo.blockHeight;
+    const uint32_t rowLength = target.rowLength ? target.rowLength : target.extent.width;
+    const VkDeviceSize srcRowPitch = FormatUtils::getRowPitch(target.format, rowLength);
+    const VkDeviceSize alignment = FormatUtils::getCopyOffsetAlignment(target.format);
+
+    // Clip, snap to blocks and measure every rectangle first so one reservation covers all
+    std::vector<VkBufferImageCopy> copies;
+    copies.reserve(dirtyRects.size());
+    VkDeviceSize packedSize = 0;
+    for (const VkRect2D& rect : dirtyRects) {
+        const int64_t x0 = std::max<int64_t>(rect.offset.x, 0);
+        const int64_t y0 = std::max<int64_t>(rect.offset.y, 0);
+        const int64_t x1 = std::min<int64_t>(static_cast<int64_t>(rect.offset.x) + rect.extent.width, target.extent.width);
+        const int64_t y1 = std::min<int64_t>(static_cast<int64_t>(rect.offset.y) + rect.extent.height, target.extent.height);
+        if (x0 >= x1 || y0 >= y1) {
+            continue;
+        }
+
+        // Block-compressed copies must start on a block and end on a block or the level edge
+        const uint32_t left = static_cast<uint32_t>(x0) / blockWidth * blockWidth;
+        const uint32_t top = static_cast<uint32_t>(y0) / blockHeight * blockHeight;
+        const uint32_t right = std::min((static_cast<uint32_t>(x1) + blockWidth - 1) / blockWidth * blockWidth, target.extent.width);
+        const uint32_t bottom = std::min((static_cast<uint32_t>(y1) + blockHeight - 1) / blockHeight * blockHeight, target.extent.height);
+
+        VkBufferImageCopy copy{};
+        packedSize = (packedSize + alignment - 1) / alignment * alignment;
+        copy.bufferOffset = packedSize;
+        copy.bufferRowLength = (right - left + blockWidth - 1) / blockWidth * blockWidth;
+        copy.bufferImageHeight = 0;
+        copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy.imageSubresource.mipLevel = target.mipLevel;
+        copy.imageSubresource.baseArrayLayer = target.arrayLayer;
+        copy.imageSubresource.layerCount = 1;
+        copy.imageOffset = {static_cast<int32_t>(left), static_cast<int32_t>(top), 0};
+        copy.imageExtent = {right - left, bottom - top, 1};
+        copies.push_back(copy);
+
+        packedSize += FormatUtils::getImageSize(target.format, right - left, bottom - top);
+    }
+    if (copies.empty()) {
+        return 0;
+    }
+
+    // Pack the rectangles row by row; bufferOffsets become absolute once reserved
+    StagingAllocation allocation = allocate(packedSize, alignment);
+    const uint8_t* src = static_cast<const uint8_t*>(target.pixels);
+    uint8_t* dst = static_cast<uint8_t*>(allocation.mappedData);
+    for (VkBufferImageCopy& copy : copies) {
+        const VkDeviceSize rowBytes = FormatUtils::getRowPitch(target.format, copy.imageExtent.width);
+        const uint32_t blockRows = (copy.imageExtent.height + blockHeight - 1) / blockHeight;
+        const uint8_t* srcRow = src + (copy.imageOffset.y / blockHeight) * srcRowPitch +
+                                (copy.imageOffset.x / blockWidth) * formatInfo.bytesPerBlock;
+        uint8_t* dstRow = dst + copy.bufferOffset;
+        for (uint32_t row = 0; row < blockRows; ++row) {
+            std::memcpy(dstRow, srcRow, static_cast<size_t>(rowBytes));
+            srcRow += srcRowPitch;
+            dstRow += rowBytes;
+        }
+        copy.bufferOffset += allocation.offset;
+    }
+    flush(allocation);
+
+    // Only the updated subresource changes layout
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = target.layout;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = target.image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, target.mipLevel, 1, target.arrayLayer, 1};
+
+    VkPipelineStageFlags layoutStage;
+    VkAccessFlags layoutAccess;
+    ResourceUtils::getLayoutStageAndAccess(target.layout, layoutStage, layoutAccess);
+
+    barrier.srcAccessMask = layoutAccess;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, layoutStage, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    vkCmdCopyBufferToImage(commandBuffer, allocation.buffer, target.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(copies.size()), copies.data());
+
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = target.layout;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = layoutAccess;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, layoutStage,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    return packedSize;
+}
+
+VkDeviceSize StagingRing::getRemainingCapacity() const {
+    return m_bytesPerFrame - m_slots[m_currentSlot].cursor;
+}
+
+} // namespace ev
@@ -0,0 +1,326 @@
+#include "EasyVulkan/Core/TextureLoader.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+#include "EasyVulkan/Core/VulkanContext.hpp"
+#include "EasyVulkan/Core/CommandPoolManager.hpp"
+#include "EasyVulkan/Builders/ImageBuilder.hpp"
+#include "EasyVulkan/Utils/FormatUtils.hpp"
+#include "EasyVulkan/Utils/ResourceUtils.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+
+namespace ev {
+
+namespace {
+
+constexpr uint8_t kKTX2Identifier[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+constexpr size_t kKTX2HeaderSize = 80;     ///< Identifier, header and index
+constexpr size_t kKTX2LevelEntrySize = 24; ///< Three uint64 per level
+
+// Data Format Descriptor values (Khronos Data Format Specification)
+constexpr uint8_t kDFDModelETC1S = 163;
+constexpr uint8_t kDFDModelUASTC = 166;
+constexpr uint8_t kDFDTransferSRGB = 2;
+constexpr uint8_t kDFDChannelUASTCRGBA = 3;
+
+uint32_t readU32(const std::vector<uint8_t>& data, size_t offset) {
+    uint32_t value;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+uint64_t readU64(const std::vector<uint8_t>& data, size_t offset) {
+    uint64_t value;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+// True if [offset, offset + length) lies inside a buffer of the given size; never overflows
+bool isRangeInBounds(uint64_t offset, uint64_t length, size_t size) {
+    return offset <= size && length <= size - offset;
+}
+
+/**
+ * @brief UNORM/sRGB pair of a candidate upload format
+ */
+struct FormatCandidate {
+    VkFormat unorm;
+    VkFormat srgb;
+};
+
+} // namespace
+
+TextureLoader::TextureLoader(VulkanDevice* device, VulkanContext* context)
+    : m_device(device)
+    , m_context(context) {
+
+    if (!m_device || !m_context) {
+        throw std::runtime_error("TextureLoader requires a valid device and context");
+    }
+}
+
+KTX2Texture TextureLoader::parseKTX2(std::vector<uint8_t> fileData) {
+    if (fileData.size() < kKTX2HeaderSize ||
+        std::memcmp(fileData.data(), kKTX2Identifier, sizeof(kKTX2Identifier)) != 0) {
+        throw std::runtime_error("not a KTX2 file");
+    }
+
+    KTX2Texture texture;
+    texture.vkFormat = static_cast<VkFormat>(readU32(fileData, 12));
+    texture.typeSize = readU32(fileData, 16);
+    texture.width = readU32(fileData, 20);
+    texture.height = std::max(readU32(fileData, 24), 1u);
+    texture.depth = std::max(readU32(fileData, 28), 1u);
+    texture.layerCount = std::max(readU32(fileData, 32), 1u);
+    texture.faceCount = readU32(fileData, 36);
+    texture.levelCount = std::max(readU32(fileData, 40), 1u);
+    texture.supercompression = static_cast<KTX2Supercompression>(readU32(fileData, 44));
+
+    const uint32_t dfdByteOffset = readU32(fileData, 48);
+    const uint32_t dfdByteLength = readU32(fileData, 52);
+    texture.sgdByteOffset = readU64(fileData, 64);
+    texture.sgdByteLength = readU64(fileData, 72);
+
+    if (texture.width == 0 || (texture.faceCount != 1 && texture.faceCount != 6)) {
+        throw std::runtime_error("invalid KTX2 dimensions");
+    }
+    if (!isRangeInBounds(texture.sgdByteOffset, texture.sgdByteLength, fileData.size())) {
+        throw std::runtime_error("KTX2 global data out of bounds");
+    }
+
+    // Level index
+    if (kKTX2HeaderSize + texture.levelCount * kKTX2LevelEntrySize > fileData.size()) {
+        throw std::runtime_error("KTX2 level index out of bounds");
+    }
+    texture.levels.resize(texture.levelCount);
+    for (uint32_t level = 0; level < texture.levelCount; ++level) {
+        const size_t entry = kKTX2HeaderSize + level * kKTX2LevelEntrySize;
+        KTX2Level& info = texture.levels[level];
+        info.byteOffset = readU64(fileData, entry);
+        info.byteLength = readU64(fileData, entry + 8);
+        info.uncompressedByteLength = readU64(fileData, entry + 16);
+        if (!isRangeInBounds(info.byteOffset, info.byteLength, fileData.size())) {
+            throw std::runtime_error("KTX2 level " + std::to_string(level) + " out of bounds");
+        }
+    }
+
+    // Basic Data Format Descriptor block: color model, transfer function and samples
+    uint8_t colorModel = 0;
+    uint32_t sampleCount = 0;
+    uint8_t firstChannel = 0;
+    if (dfdByteLength >= 4 + 24 && isRangeInBounds(dfdByteOffset, dfdByteLength, fileData.size())) {
+        const size_t block = dfdByteOffset + 4;
+        const uint16_t blockSize = static_cast<uint16_t>(readU32(fileData, block + 4) >> 16);
+        colorModel = fileData[block + 8];
+        texture.srgb = fileData[block + 10] == kDFDTransferSRGB;
+        sampleCount = blockSize >= 24 ? (blockSize - 24) / 16 : 0;
+        if (sampleCount > 0 && block + 24 + 16 <= fileData.size()) {
+            firstChannel = fileData[block + 24 + 3] & 0x0F;
+        }
+    }
+
+    if (texture.vkFormat != VK_FORMAT_UNDEFINED) {
+        texture.payload = KTX2Payload::Native;
+    } else if (texture.supercompression == KTX2Supercompression::BasisLZ || colorModel == kDFDModelETC1S) {
+        texture.payload = KTX2Payload::ETC1S;
+        // ETC1S stores alpha as a second (AAA) slice
+        texture.hasAlpha = sampleCount > 1;
+    } else if (colorModel == kDFDModelUASTC) {
+        texture.payload = KTX2Payload::UASTC;
+        texture.hasAlpha = firstChannel == kDFDChannelUASTCRGBA;
+    } else {
+        throw std::runtime_error("unsupported KTX2 payload (undefined vkFormat, color model " +
+                                 std::to_string(colorModel) + ")");
+    }
+
+    if (texture.payload == KTX2Payload::Native) {
+        texture.srgb = FormatUtils::isSrgb(texture.vkFormat);
+    }
+
+    texture.fileData = std::move(fileData);
+    return texture;
+}
+
+KTX2Texture TextureLoader::readKTX2File(const std::string& filename) {
+    std::ifstream file(filename, std::ios::ate | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open file: " + filename);
+    }
+
+    std::vector<uint8_t> fileData(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(fileData.data()), static_cast<std::streamsize>(fileData.size()));
+
+    return parseKTX2(std::move(fileData));
+}
+
+VkFormat TextureLoader::selectFormat(const KTX2Texture& texture) const {
+    const VkFormatFeatureFlags features = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                          VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+    if (texture.payload == KTX2Payload::Native) {
+        if (!FormatUtils::isFormatSupported(m_device, texture.vkFormat, features)) {
+            throw std::runtime_error("KTX2 format " + std::to_string(texture.vkFormat) + " is not supported by the device");
+        }
+        if (texture.supercompression != KTX2Supercompression::None &&
+            (!m_transcoder || !m_transcoder->supports(texture, texture.vkFormat))) {
+            throw std::runtime_error("KTX2 file is supercompressed but no transcoder handles it");
+        }
+        return texture.vkFormat;
+    }
+
+    if (!m_transcoder) {
+        throw std::runtime_error("KTX2 file holds a Basis Universal payload but no transcoder is set");
+    }
+
+    // Desktop BC first, then mobile ASTC/ETC2, then uncompressed as the last resort
+    std::vector<FormatCandidate> candidates;
+    if (texture.hasAlpha) {
+        candidates = {
+            {VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_BC7_SRGB_BLOCK},
+            {VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_ASTC_4x4_SRGB_BLOCK},
+            {VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK, VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK},
+            {VK_FORMAT_BC3_UNORM_BLOCK, VK_FORMAT_BC3_SRGB_BLOCK},
+            {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB}};
+    } else if (texture.payload == KTX2Payload::ETC1S) {
+        // ETC1S quality does not benefit from BC7; prefer the 8-byte block formats
+        candidates = {
+            {VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_BC1_RGB_SRGB_BLOCK},
+            {VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK, VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK},
+            {VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_BC7_SRGB_BLOCK},
+            {VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_ASTC_4x4_SRGB_BLOCK},
+            {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB}};
+    } else {
+        candidates = {
+            {VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_BC7_SRGB_BLOCK},
+            {VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_ASTC_4x4_SRGB_BLOCK},
+            {VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK, VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK},
+            {VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_BC1_RGB_SRGB_BLOCK},
+            {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB}};
+    }
+
+    for (const FormatCandidate& candidate : candidates) {
+        VkFormat format = texture.srgb ? candidate.srgb : candidate.unorm;
+        if (FormatUtils::isFormatSupported(m_device, format, features) &&
+            m_transcoder->supports(texture, format)) {
+            return format;
+        }
+    }
+
+    throw std::runtime_error("no transcode target format is supported by both the device and the transcoder");
+}
+
+std::vector<std::vector<uint8_t>> TextureLoader::transcodeLevels(
+    const KTX2Texture& texture,
+    VkFormat target) const {
+
+    if (!m_transcoder) {
+        throw std::runtime_error("no texture transcoder set");
+    }
+
+    // Levels are independent; the smallest ones finish almost immediately
+    std::vector<std::future<std::vector<uint8_t>>> jobs;
+    jobs.reserve(texture.levelCount);
+    for (uint32_t level = 0; level < texture.levelCount; ++level) {
+        jobs.push_back(std::async(std::launch::async, [this, &texture, level, target]() {
+            return m_transcoder->transcodeLevel(texture, level, target);
+        }));
+    }
+
+    const uint32_t imageCount = texture.layerCount * texture.faceCount;
+    std::vector<std::vector<uint8_t>> levels;
+    levels.reserve(texture.levelCount);
+    for (uint32_t level = 0; level < texture.levelCount; ++level) {
+        levels.push_back(jobs[level].get());
+
+        const VkDeviceSize expected = FormatUtils::getImageSize(
+            target,
+            std::max(texture.width >> level, 1u),
+            std::max(texture.height >> level, 1u),
+            std::max(texture.depth >> level, 1u)) * imageCount;
+        if (levels.back().size() < expected) {
+            throw std::runtime_error("transcoded KTX2 level " + std::to_string(level) + " is too small");
+        }
+    }
+    return levels;
+}
+
+ImageInfo TextureLoader::loadKTX2(
+    const std::string& filename,
+    const std::string& name,
+    VkImageLayout finalLayout) {
+
+    return uploadKTX2(readKTX2File(filename), name, finalLayout);
+}
+
+ImageInfo TextureLoader::uploadKTX2(
+    const KTX2Texture& texture,
+    const std::string& name,
+    VkImageLayout finalLayout) {
+
+    const VkFormat format = selectFormat(texture);
+    const bool transcode = texture.payload != KTX2Payload::Native ||
+                           texture.supercompression != KTX2Supercompression::None;
+
+    std::vector<std::vector<uint8_t>> transcoded;
+    if (transcode) {
+        transcoded = transcodeLevels(texture, format);
+    }
+
+    const uint32_t imageCount = texture.layerCount * texture.faceCount;
+
+    ImageBuilder builder(m_device, m_context);
+    builder.setFormat(format)
+        .setImageType(texture.depth > 1 ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D)
+        .setExtent(texture.width, texture.height, texture.depth)
+        .setMipLevels(texture.levelCount)
+        .setArrayLayers(imageCount)
+        .setUsage(VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)
+        .setMemoryCategory(MemoryCategory::Textures);
+    if (texture.faceCount == 6) {
+        builder.setCreateFlags(VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT);
+    }
+    ImageInfo imageInfo = builder.build(name);
+
+    // One region per level covering all layers and faces (KTX2 order matches Vulkan's)
+    std::vector<ImageUploadRegion> regions(texture.levelCount);
+    for (uint32_t level = 0; level < texture.levelCount; ++level) {
+        ImageUploadRegion& region = regions[level];
+        region.mipLevel = level;
+        region.baseArrayLayer = 0;
+        region.layerCount = imageCount;
+        region.extent = {
+            std::max(texture.width >> level, 1u),
+            std::max(texture.height >> level, 1u),
+            std::max(texture.depth >> level, 1u)};
+
+        if (transcode) {
+            region.data = transcoded[level].data();
+        } else {
+            const VkDeviceSize expected = FormatUtils::getImageSize(
+                format, region.extent.width, region.extent.height, region.extent.depth) * imageCount;
+            if (texture.levels[level].byteLength < expected) {
+                throw std::runtime_error("KTX2 level " + std::to_string(level) + " is truncated");
+            }
+            region.data = texture.getLevelData(level);
+        }
+    }
+
+    ResourceUtils::uploadImageRegions(
+        m_device,
+        m_context->getCommandPoolManager()->getSingleTimeCommandPool(),
+        imageInfo.image,
+        format,
+        regions,
+        imageInfo.layout,
+        finalLayout);
+    imageInfo.layout = finalLayout;
+
+    return imageInfo;
+}
+
+} // namespace ev
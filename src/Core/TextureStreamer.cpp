@@ -0,0 +1,543 @@
+#include "EasyVulkan/Core/TextureStreamer.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+#include "EasyVulkan/Core/VulkanContext.hpp"
+#include "EasyVulkan/Core/CommandPoolManager.hpp"
+#include "EasyVulkan/Core/MipGenerator.hpp"
+#include "EasyVulkan/Core/ReadbackQueue.hpp"
+#include "EasyVulkan/Core/StagingRing.hpp"
+#include "EasyVulkan/Core/ThreadPool.hpp"
+#include "EasyVulkan/Utils/CommandUtils.hpp"
+#include "EasyVulkan/Utils/FormatUtils.hpp"
+#include "EasyVulkan/Utils/MemoryUtils.hpp"
+#include "EasyVulkan/Utils/ResourceUtils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace ev {
+
+namespace {
+
+VkDeviceSize getLevelSize(const StreamingTextureDesc& desc, uint32_t level) {
+    return FormatUtils::getImageSize(
+        desc.format,
+        std::max(desc.width >> level, 1u),
+        std::max(desc.height >> level, 1u));
+}
+
+void recordFeedbackBarrier(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize size,
+    VkPipelineStageFlags srcStage,
+    VkAccessFlags srcAccess,
+    VkPipelineStageFlags dstStage,
+    VkAccessFlags dstAccess) {
+
+    VkBufferMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = buffer;
+    barrier.offset = 0;
+    barrier.size = size;
+
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+constexpr VkPipelineStageFlags kFeedbackShaderStages =
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+} // namespace
+
+TextureStreamer::TextureStreamer(
+    VulkanDevice* device,
+    VulkanContext* context,
+    const TextureStreamerConfig& config,
+    ThreadPool* pool)
+    : m_device(device)
+    , m_context(context)
+    , m_config(config)
+    , m_pool(pool)
+    , m_self(std::make_shared<TextureStreamer*>(this)) {
+
+    if (!m_device || !m_context) {
+        throw std::runtime_error("TextureStreamer requires a valid device and context");
+    }
+    if (m_config.framesInFlight == 0 || m_config.uploadBudgetPerFrame == 0 ||
+        m_config.maxPendingLoads == 0 || m_config.maxTextures == 0) {
+        throw std::runtime_error("TextureStreamer limits must be non-zero");
+    }
+
+    m_staging = std::make_unique<StagingRing>(m_device, m_config.framesInFlight, m_config.uploadBudgetPerFrame);
+
+    const VkDeviceSize feedbackSize = static_cast<VkDeviceSize>(m_config.maxTextures) * sizeof(uint32_t);
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = feedbackSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                       VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                       VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    if (vmaCreateBuffer(m_device->getAllocator(), &bufferInfo, &allocInfo,
+                        &m_feedbackBuffer, &m_feedbackAllocation, nullptr) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create texture feedback buffer!");
+    }
+
+    // Start with "no request" in every entry; the destructor won't run if this throws
+    try {
+        VkCommandPool commandPool = m_context->getCommandPoolManager()->getSingleTimeCommandPool();
+        VkCommandBuffer commandBuffer = CommandUtils::beginSingleTimeCommands(m_device, commandPool);
+        vkCmdFillBuffer(commandBuffer, m_feedbackBuffer, 0, feedbackSize, UINT32_MAX);
+        recordFeedbackBarrier(commandBuffer, m_feedbackBuffer, feedbackSize,
+                              VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                              kFeedbackShaderStages, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+        CommandUtils::endSingleTimeCommands(m_device, commandPool, commandBuffer);
+    } catch (...) {
+        vmaDestroyBuffer(m_device->getAllocator(), m_feedbackBuffer, m_feedbackAllocation);
+        throw;
+    }
+}
+
+TextureStreamer::~TextureStreamer() {
+    // Feedback readbacks still queued must not call into a destroyed streamer
+    m_self.reset();
+
+    for (auto& texture : m_textures) {
+        if (texture.load.valid()) {
+            texture.load.wait();
+        }
+        if (texture.alive) {
+            vkDestroyImageView(m_device->getLogicalDevice(), texture.view, nullptr);
+            vmaDestroyImage(m_device->getAllocator(), texture.image, texture.allocation);
+        }
+    }
+    collectRetired(true);
+
+    if (m_feedbackBuffer != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(m_device->getAllocator(), m_feedbackBuffer, m_feedbackAllocation);
+    }
+}
+
+VkImageView TextureStreamer::createView(const Texture& texture, uint32_t baseMip) const {
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = texture.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = texture.desc.format;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.baseMipLevel = baseMip;
+    viewInfo.subresourceRange.levelCount = texture.mipLevels - baseMip;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    VkImageView view;
+    if (vkCreateImageView(m_device->getLogicalDevice(), &viewInfo, nullptr, &view) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create streaming texture view!");
+    }
+    return view;
+}
+
+StreamingTextureHandle TextureStreamer::createTexture(const StreamingTextureDesc& desc) {
+    if (desc.format == VK_FORMAT_UNDEFINED || desc.width == 0 || desc.height == 0 || !desc.loadLevel) {
+        throw std::runtime_error("Invalid streaming texture description");
+    }
+
+    Texture texture;
+    texture.desc = desc;
+    const uint32_t fullChain = MipGenerator::calculateMipLevels(desc.width, desc.height);
+    texture.mipLevels = desc.mipLevels ? std::min(desc.mipLevels, fullChain) : fullChain;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = desc.format;
+    imageInfo.extent = {desc.width, desc.height, 1};
+    imageInfo.mipLevels = texture.mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    if (vmaCreateImage(m_device->getAllocator(), &imageInfo, &allocInfo,
+                       &texture.image, &texture.allocation, nullptr) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create streaming texture '" + desc.name + "'!");
+    }
+
+    try {
+        // The tail is every level no larger than tailMaxDimension, and at least the last one
+        uint32_t tailStart = texture.mipLevels - 1;
+        while (tailStart > 0 &&
+               std::max(desc.width >> (tailStart - 1), desc.height >> (tailStart - 1)) <= m_config.tailMaxDimension) {
+            --tailStart;
+        }
+
+        std::vector<std::vector<uint8_t>> levelData;
+        std::vector<ImageUploadRegion> regions;
+        levelData.reserve(texture.mipLevels - tailStart);
+        for (uint32_t level = tailStart; level < texture.mipLevels; ++level) {
+            levelData.push_back(desc.loadLevel(level));
+            if (levelData.back().size() < getLevelSize(desc, level)) {
+                throw std::runtime_error("Level " + std::to_string(level) + " of streaming texture '" +
+                                         desc.name + "' is too small");
+            }
+
+            ImageUploadRegion region;
+            region.data = levelData.back().data();
+            region.mipLevel = level;
+            region.extent = {std::max(desc.width >> level, 1u), std::max(desc.height >> level, 1u), 1};
+            regions.push_back(region);
+        }
+
+        // Every level, resident or not, stays in SHADER_READ_ONLY_OPTIMAL from here on
+        ResourceUtils::uploadImageRegions(
+            m_device,
+            m_context->getCommandPoolManager()->getSingleTimeCommandPool(),
+            texture.image,
+            desc.format,
+            regions,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+        texture.residentMip = tailStart;
+        texture.desiredMip = tailStart;
+        texture.view = createView(texture, tailStart);
+    } catch (...) {
+        vmaDestroyImage(m_device->getAllocator(), texture.image, texture.allocation);
+        throw;
+    }
+    texture.alive = true;
+
+    StreamingTextureHandle handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        texture.generation = m_textures[handle].generation;
+        m_textures[handle] = std::move(texture);
+    } else {
+        handle = static_cast<StreamingTextureHandle>(m_textures.size());
+        m_textures.push_back(std::move(texture));
+    }
+
+    if (handle >= m_config.maxTextures) {
+        LogWarning("Streaming texture '" + desc.name + "' has no GPU feedback entry; use CPU requests",
+                   __FILE__, __LINE__);
+    }
+    return handle;
+}
+
+void TextureStreamer::destroyTexture(StreamingTextureHandle handle) {
+    Texture& texture = getTexture(handle);
+
+    if (texture.load.valid()) {
+        texture.load.wait();
+    }
+
+    Retired retired;
+    retired.frame = m_frameCount;
+    retired.view = texture.view;
+    retired.image = texture.image;
+    retired.allocation = texture.allocation;
+    m_retired.push_back(retired);
+
+    // Feedback recorded for the old texture must not reach the next one in this slot
+    const uint32_t generation = texture.generation + 1;
+    texture = Texture{};
+    texture.generation = generation;
+    m_freeHandles.push_back(handle);
+}
+
+void TextureStreamer::requestMip(StreamingTextureHandle handle, uint32_t mipLevel) {
+    Texture& texture = getTexture(handle);
+    texture.requestedMip = std::min(texture.requestedMip, mipLevel);
+}
+
+void TextureStreamer::requestScreenSize(StreamingTextureHandle handle, float screenPixels, float bias) {
+    const Texture& texture = getTexture(handle);
+    requestMip(handle, computeDesiredMip(texture.desc.width, texture.desc.height, screenPixels, bias));
+}
+
+uint32_t TextureStreamer::computeDesiredMip(uint32_t width, uint32_t height, float screenPixels, float bias) {
+    const float texels = static_cast<float>(std::max(width, height));
+    if (screenPixels <= 0.0f) {
+        return UINT32_MAX;
+    }
+    const float level = std::floor(std::log2(texels / screenPixels) + bias);
+    return level <= 0.0f ? 0 : static_cast<uint32_t>(level);
+}
+
+float TextureStreamer::getPriority(const Texture& texture) const {
+    return static_cast<float>(texture.residentMip) - static_cast<float>(texture.desiredMip);
+}
+
+void TextureStreamer::update(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+    ++m_frameCount;
+    collectRetired(false);
+    m_stats = {};
+
+    // Fold this frame's requests into the desired levels
+    std::vector<StreamingTextureHandle> candidates;
+    for (StreamingTextureHandle handle = 0; handle < m_textures.size(); ++handle) {
+        Texture& texture = m_textures[handle];
+        if (!texture.alive) {
+            continue;
+        }
+        if (texture.requestedMip != UINT32_MAX) {
+            texture.desiredMip = std::min(texture.requestedMip, texture.mipLevels - 1);
+            texture.requestedMip = UINT32_MAX;
+        }
+        if (texture.desiredMip < texture.residentMip) {
+            ++m_stats.texturesWaiting;
+        }
+        if (texture.desiredMip < texture.residentMip || texture.loadingMip != UINT32_MAX) {
+            candidates.push_back(handle);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [this](StreamingTextureHandle a, StreamingTextureHandle b) {
+        return getPriority(m_textures[a]) > getPriority(m_textures[b]);
+    });
+
+    // Copy finished loads into the frame's ring slot until the budget is spent
+    m_staging->beginFrame(frameIndex);
+    for (StreamingTextureHandle handle : candidates) {
+        Texture& texture = m_textures[handle];
+        if (texture.loadingMip == UINT32_MAX ||
+            texture.load.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            continue;
+        }
+
+        const uint32_t level = texture.loadingMip;
+        const VkDeviceSize size = getLevelSize(texture.desc, level);
+        const VkDeviceSize alignment = FormatUtils::getCopyOffsetAlignment(texture.desc.format);
+
+        // A level larger than the whole budget gets its own staging buffer and the frame
+        const bool oversized = size > m_config.uploadBudgetPerFrame;
+        if (oversized ? m_staging->getRemainingCapacity() != m_config.uploadBudgetPerFrame
+                      : !m_staging->canAllocate(size, alignment)) {
+            continue;
+        }
+
+        texture.loadingMip = UINT32_MAX;
+        std::vector<uint8_t> data = texture.load.get();
+        if (data.size() < size) {
+            throw std::runtime_error("Level " + std::to_string(level) + " of streaming texture '" +
+                                     texture.desc.name + "' is too small");
+        }
+
+        if (oversized) {
+            Retired retired;
+            retired.frame = m_frameCount;
+            retired.buffer = ResourceUtils::createBuffer(m_device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &retired.allocation);
+            m_retired.push_back(retired);
+
+            std::memcpy(MemoryUtils::getMappedData(m_device, retired.allocation), data.data(), static_cast<size_t>(size));
+            vmaFlushAllocation(m_device->getAllocator(), retired.allocation, 0, size);
+            recordLevelUpload(commandBuffer, handle, level, retired.buffer, 0);
+        } else {
+            StagingAllocation range = m_staging->allocate(size, alignment);
+            std::memcpy(range.mappedData, data.data(), static_cast<size_t>(size));
+            m_staging->flush(range);
+            recordLevelUpload(commandBuffer, handle, level, range.buffer, range.offset);
+        }
+
+        m_stats.bytesUploaded += size;
+        ++m_stats.levelsUploaded;
+        if (oversized || m_staging->getRemainingCapacity() == 0) {
+            break;
+        }
+    }
+
+    // Start the next level of the neediest textures
+    uint32_t pendingLoads = 0;
+    for (const auto& texture : m_textures) {
+        pendingLoads += texture.loadingMip != UINT32_MAX ? 1 : 0;
+    }
+    for (StreamingTextureHandle handle : candidates) {
+        if (pendingLoads >= m_config.maxPendingLoads) {
+            break;
+        }
+        Texture& texture = m_textures[handle];
+        if (texture.loadingMip != UINT32_MAX || texture.desiredMip >= texture.residentMip) {
+            continue;
+        }
+
+        // Levels arrive coarse to fine so the resident range stays contiguous
+        const uint32_t level = texture.residentMip - 1;
+        auto loadLevel = texture.desc.loadLevel;
+        if (m_pool) {
+            texture.load = m_pool->submit([loadLevel, level]() { return loadLevel(level); });
+        } else {
+            texture.load = std::async(std::launch::async, [loadLevel, level]() { return loadLevel(level); });
+        }
+        texture.loadingMip = level;
+        ++pendingLoads;
+    }
+    m_stats.pendingLoads = pendingLoads;
+}
+
+void TextureStreamer::recordLevelUpload(
+    VkCommandBuffer commandBuffer,
+    StreamingTextureHandle handle,
+    uint32_t level,
+    VkBuffer buffer,
+    VkDeviceSize offset) {
+
+    Texture& texture = m_textures[handle];
+    const uint32_t width = std::max(texture.desc.width >> level, 1u);
+    const uint32_t height = std::max(texture.desc.height >> level, 1u);
+
+    // Only the new level changes layout; resident levels keep being sampled
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = texture.image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1};
+
+    VkPipelineStageFlags shaderStage;
+    VkAccessFlags shaderAccess;
+    ResourceUtils::getLayoutStageAndAccess(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, shaderStage, shaderAccess);
+
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, shaderStage, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkBufferImageCopy copy{};
+    copy.bufferOffset = offset;
+    copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+    copy.imageExtent = {width, height, 1};
+    vkCmdCopyBufferToImage(commandBuffer, buffer, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = shaderAccess;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, shaderStage,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    // Frames still in flight may sample through the old view
+    Retired retired;
+    retired.frame = m_frameCount;
+    retired.view = texture.view;
+    m_retired.push_back(retired);
+
+    texture.view = createView(texture, level);
+    texture.residentMip = level;
+
+    if (m_viewChanged) {
+        m_viewChanged(handle, texture.view);
+    }
+}
+
+void TextureStreamer::recordFeedback(VkCommandBuffer commandBuffer, ReadbackQueue& readback) {
+    const uint32_t entryCount = std::min(static_cast<uint32_t>(m_textures.size()), m_config.maxTextures);
+    if (entryCount == 0) {
+        return;
+    }
+    const VkDeviceSize size = static_cast<VkDeviceSize>(entryCount) * sizeof(uint32_t);
+
+    recordFeedbackBarrier(commandBuffer, m_feedbackBuffer, size,
+                          kFeedbackShaderStages, VK_ACCESS_SHADER_WRITE_BIT,
+                          VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+    // Handles are shader indices, so slot reuse is detected through the generations
+    std::vector<uint32_t> generations(entryCount);
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        generations[i] = m_textures[i].generation;
+    }
+
+    std::weak_ptr<TextureStreamer*> self = m_self;
+    readback.readBuffer(commandBuffer, m_feedbackBuffer, 0, size,
+        [self, generations = std::move(generations)](const void* data, VkDeviceSize bytes) {
+            const std::shared_ptr<TextureStreamer*> streamer = self.lock();
+            if (!streamer) {
+                return;
+            }
+            std::vector<Texture>& textures = (*streamer)->m_textures;
+            const uint32_t* wantedMips = static_cast<const uint32_t*>(data);
+            const size_t count = std::min({static_cast<size_t>(bytes / sizeof(uint32_t)),
+                                           textures.size(), generations.size()});
+            for (size_t i = 0; i < count; ++i) {
+                if (wantedMips[i] != UINT32_MAX && textures[i].alive &&
+                    textures[i].generation == generations[i]) {
+                    (*streamer)->requestMip(static_cast<StreamingTextureHandle>(i), wantedMips[i]);
+                }
+            }
+        });
+
+    // Clear for the next frame once the copy has read the values
+    recordFeedbackBarrier(commandBuffer, m_feedbackBuffer, size,
+                          VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                          VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    vkCmdFillBuffer(commandBuffer, m_feedbackBuffer, 0, size, UINT32_MAX);
+    recordFeedbackBarrier(commandBuffer, m_feedbackBuffer, size,
+                          VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                          kFeedbackShaderStages, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+}
+
+void TextureStreamer::collectRetired(bool all) {
+    auto it = m_retired.begin();
+    while (it != m_retired.end()) {
+        if (!all && m_frameCount < it->frame + m_config.framesInFlight) {
+            ++it;
+            continue;
+        }
+        if (it->view != VK_NULL_HANDLE) {
+            vkDestroyImageView(m_device->getLogicalDevice(), it->view, nullptr);
+        }
+        if (it->image != VK_NULL_HANDLE) {
+            vmaDestroyImage(m_device->getAllocator(), it->image, it->allocation);
+        }
+        if (it->buffer != VK_NULL_HANDLE) {
+            vmaDestroyBuffer(m_device->getAllocator(), it->buffer, it->allocation);
+        }
+        it = m_retired.erase(it);
+    }
+}
+
+const TextureStreamer::Texture& TextureStreamer::getTexture(StreamingTextureHandle handle) const {
+    if (handle >= m_textures.size() || !m_textures[handle].alive) {
+        throw std::runtime_error("Invalid streaming texture handle");
+    }
+    return m_textures[handle];
+}
+
+TextureStreamer::Texture& TextureStreamer::getTexture(StreamingTextureHandle handle) {
+    if (handle >= m_textures.size() || !m_textures[handle].alive) {
+        throw std::runtime_error("Invalid streaming texture handle");
+    }
+    return m_textures[handle];
+}
+
+VkImage TextureStreamer::getImage(StreamingTextureHandle handle) const {
+    return getTexture(handle).image;
+}
+
+VkImageView TextureStreamer::getImageView(StreamingTextureHandle handle) const {
+    return getTexture(handle).view;
+}
+
+uint32_t TextureStreamer::getResidentMip(StreamingTextureHandle handle) const {
+    return getTexture(handle).residentMip;
+}
+
+} // namespace ev
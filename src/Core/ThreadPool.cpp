@@ -0,0 +1,79 @@
+#include "EasyVulkan/Core/ThreadPool.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace ev {
+
+ThreadPool::ThreadPool(uint32_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    m_workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(uint32_t count, const std::function<void(uint32_t begin, uint32_t end)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    // A few chunks per worker keeps the load balanced when rows cost differently
+    const uint32_t chunkCount = std::min(count, getThreadCount() * 4);
+    const uint32_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    std::vector<std::future<void>> chunks;
+    chunks.reserve(chunkCount);
+    for (uint32_t begin = 0; begin < count; begin += chunkSize) {
+        const uint32_t end = std::min(begin + chunkSize, count);
+        chunks.push_back(submit([&body, begin, end]() { body(begin, end); }));
+    }
+
+    // Every chunk must finish before body goes out of scope, even if one throws
+    std::exception_ptr firstError;
+    for (auto& chunk : chunks) {
+        try {
+            chunk.get();
+        } catch (...) {
+            if (!firstError) {
+                firstError = std::current_exception();
+            }
+        }
+    }
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+} // namespace ev
@@ -0,0 +1,103 @@
+#include "EasyVulkan/Core/UniformRing.hpp"
+#include "EasyVulkan/Core/VulkanDevice.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace ev {
+
+namespace {
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+UniformRing::UniformRing(VulkanDevice* device, uint32_t framesInFlight, VkDeviceSize bytesPerFrame, VkDeviceSize range)
+    : m_device(device)
+    , m_slotCount(framesInFlight)
+    , m_bytesPerFrame(bytesPerFrame)
+    , m_range(range) {
+
+    if (!m_device) {
+        throw std::runtime_error("UniformRing requires a valid device");
+    }
+    if (framesInFlight == 0 || bytesPerFrame == 0 || range == 0) {
+        throw std::runtime_error("UniformRing needs at least one slot, a non-zero capacity and range");
+    }
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(m_device->getPhysicalDevice(), &properties);
+    m_alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 1);
+
+    // Slots start on aligned offsets, and every element fits a whole range
+    m_range = alignUp(m_range, m_alignment);
+    if (m_range > properties.limits.maxUniformBufferRange) {
+        throw std::runtime_error("UniformRing range exceeds maxUniformBufferRange once aligned");
+    }
+    m_bytesPerFrame = alignUp(std::max(m_bytesPerFrame, m_range), m_alignment);
+
+    // push() hands out dynamic offsets as uint32_t
+    if (m_bytesPerFrame > std::numeric_limits<uint32_t>::max() / m_slotCount) {
+        throw std::runtime_error("UniformRing size exceeds the 32-bit dynamic offset range");
+    }
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = m_bytesPerFrame * m_slotCount;
+    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    // Written once per frame, read by the GPU: VMA may pick device-local host-visible memory
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                      VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo info{};
+    if (vmaCreateBuffer(m_device->getAllocator(), &bufferInfo, &allocInfo,
+                        &m_buffer, &m_allocation, &info) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create uniform ring buffer!");
+    }
+    m_mappedData = static_cast<uint8_t*>(info.pMappedData);
+}
+
+UniformRing::~UniformRing() {
+    if (m_buffer != VK_NULL_HANDLE) {
+        m_device->cancelMappedFlush(m_allocation);
+        vmaDestroyBuffer(m_device->getAllocator(), m_buffer, m_allocation);
+    }
+}
+
+void UniformRing::beginFrame(uint32_t frameIndex) {
+    // The caller has waited on this slot's fence, so the GPU is done reading it
+    m_currentSlot = frameIndex % m_slotCount;
+    onSlotReset(m_currentSlot, m_cursor);
+    m_cursor = 0;
+}
+
+uint32_t UniformRing::push(const void* data, VkDeviceSize size) {
+    if (size > m_range) {
+        throw std::runtime_error("uniform data of " + std::to_string(size) +
+                                 " bytes exceeds the ring's descriptor range");
+    }
+
+    // The descriptor reads a whole range from the offset, so that much must fit
+    const VkDeviceSize offset = alignUp(m_cursor, m_alignment);
+    if (offset + m_range > m_bytesPerFrame) {
+        LogError("UniformRing slot capacity exceeded");
+        throw std::runtime_error("UniformRing slot capacity exceeded");
+    }
+    m_cursor = offset + size;
+
+    const VkDeviceSize absoluteOffset = static_cast<VkDeviceSize>(m_currentSlot) * m_bytesPerFrame + offset;
+    std::memcpy(m_mappedData + absoluteOffset, data, static_cast<size_t>(size));
+    m_device->queueMappedFlush(m_allocation, absoluteOffset, size);
+
+    return static_cast<uint32_t>(absoluteOffset);
+}
+
+} // namespace ev
@@ -0,0 +1,455 @@
+#include "EasyVulkan/Core/VisibilityCuller.hpp"
+#include "EasyVulkan/Core/ThreadPool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(EV_SIMD_SSE2) && defined(__AVX2__)
+#include <immintrin.h>
+#define EV_SIMD_AVX2 1
+#endif
+
+namespace ev {
+
+namespace {
+
+constexpr uint32_t InvalidSlot = std::numeric_limits<uint32_t>::max();
+
+// Distances below this count as "at the camera" for LOD selection
+constexpr float MinLodDistance = 1e-4f;
+
+// Smallest slot range worth handing to a worker
+constexpr uint32_t MinChunkSize = 1024;
+
+/**
+ * @brief Plane coefficients splatted for the kernels
+ */
+struct PlaneTerms {
+    float nx, ny, nz, w;    // Inward normal and distance
+    float ax, ay, az;       // |normal|, projects the box extents onto the normal
+};
+
+std::array<PlaneTerms, 6> makePlaneTerms(const Frustum& frustum) {
+    std::array<PlaneTerms, 6> terms;
+    for (size_t p = 0; p < 6; ++p) {
+        const Vec4f& plane = frustum.planes[p];
+        terms[p] = {plane.x, plane.y, plane.z, plane.w,
+                    std::fabs(plane.x), std::fabs(plane.y), std::fabs(plane.z)};
+    }
+    return terms;
+}
+
+uint8_t selectLod(float pixelSize, const std::vector<float>& thresholds, uint8_t lodCount) {
+    uint32_t lod = 0;
+    while (lod < thresholds.size() && pixelSize < thresholds[lod]) {
+        ++lod;
+    }
+    return static_cast<uint8_t>(std::min<uint32_t>(lod, lodCount - 1u));
+}
+
+} // namespace
+
+Frustum Frustum::fromMatrix(const Mat4f& viewProjection) {
+    alignas(16) float m[16];
+    viewProjection.store(m);
+    // Row r of the column-major matrix
+    auto row = [&m](int r) { return Vec4f(m[r], m[4 + r], m[8 + r], m[12 + r]); };
+    const Vec4f r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum frustum;
+    frustum.planes = {r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2};
+    for (Vec4f& plane : frustum.planes) {
+        const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f) {
+            plane = plane * (1.0f / length);
+        }
+    }
+    return frustum;
+}
+
+bool Frustum::intersects(const BoundingVolume& volume) const {
+    for (const Vec4f& plane : planes) {
+        const float distance = plane.x * volume.center.x + plane.y * volume.center.y +
+                               plane.z * volume.center.z + plane.w;
+        const float boxReach = std::fabs(plane.x) * volume.extents.x + std::fabs(plane.y) * volume.extents.y +
+                               std::fabs(plane.z) * volume.extents.z;
+        if (distance + std::min(volume.radius, boxReach) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+CullView CullView::create(const Mat4f& view, const Mat4f& projection, const Vec3f& position, float viewportHeight) {
+    CullView result;
+    result.frustum = Frustum::fromMatrix(projection * view);
+    result.position = position;
+    // projection[1][1] is cot(fovY / 2); a sphere of radius r at distance d spans
+    // about 2r / d * cot / 2 of the viewport height
+    result.pixelScale = std::fabs(projection.data()[5]) * viewportHeight;
+    return result;
+}
+
+VisibilityCuller::VisibilityCuller(ThreadPool* pool) : m_pool(pool) {}
+
+uint32_t VisibilityCuller::addObject(const BoundingVolume& bounds, uint32_t lodCount) {
+    if (lodCount == 0 || lodCount > CullResult::MaxLodCount) {
+        throw std::runtime_error("VisibilityCuller: lodCount must be between 1 and " +
+                                 std::to_string(CullResult::MaxLodCount));
+    }
+
+    uint32_t handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        handle = static_cast<uint32_t>(m_handleSlots.size());
+        m_handleSlots.push_back(InvalidSlot);
+    }
+
+    const uint32_t slot = getObjectCount();
+    m_centerX.push_back(0.0f);
+    m_centerY.push_back(0.0f);
+    m_centerZ.push_back(0.0f);
+    m_extentX.push_back(0.0f);
+    m_extentY.push_back(0.0f);
+    m_extentZ.push_back(0.0f);
+    m_radius.push_back(0.0f);
+    m_lodCount.push_back(static_cast<uint8_t>(lodCount));
+    m_slotHandles.push_back(handle);
+    m_handleSlots[handle] = slot;
+    storeBounds(slot, bounds);
+    return handle;
+}
+
+void VisibilityCuller::updateObject(uint32_t handle, const BoundingVolume& bounds) {
+    storeBounds(slotOf(handle), bounds);
+}
+
+void VisibilityCuller::removeObject(uint32_t handle) {
+    const uint32_t slot = slotOf(handle);
+    const uint32_t last = getObjectCount() - 1;
+
+    // Move the last object into the hole so the arrays stay dense
+    if (slot != last) {
+        m_centerX[slot] = m_centerX[last];
+        m_centerY[slot] = m_centerY[last];
+        m_centerZ[slot] = m_centerZ[last];
+        m_extentX[slot] = m_extentX[last];
+        m_extentY[slot] = m_extentY[last];
+        m_extentZ[slot] = m_extentZ[last];
+        m_radius[slot] = m_radius[last];
+        m_lodCount[slot] = m_lodCount[last];
+        m_slotHandles[slot] = m_slotHandles[last];
+        m_handleSlots[m_slotHandles[slot]] = slot;
+    }
+
+    m_centerX.pop_back();
+    m_centerY.pop_back();
+    m_centerZ.pop_back();
+    m_extentX.pop_back();
+    m_extentY.pop_back();
+    m_extentZ.pop_back();
+    m_radius.pop_back();
+    m_lodCount.pop_back();
+    m_slotHandles.pop_back();
+
+    m_handleSlots[handle] = InvalidSlot;
+    m_freeHandles.push_back(handle);
+}
+
+void VisibilityCuller::setLodThresholds(const std::vector<float>& pixelSizes) {
+    if (pixelSizes.size() >= CullResult::MaxLodCount) {
+        throw std::runtime_error("VisibilityCuller: at most " + std::to_string(CullResult::MaxLodCount - 1) +
+                                 " LOD thresholds are supported");
+    }
+    m_lodThresholds = pixelSizes;
+    std::sort(m_lodThresholds.begin(), m_lodThresholds.end(), std::greater<float>());
+}
+
+void VisibilityCuller::cull(const CullView& view, CullResult& result) {
+    for (auto& list : result.lods) {
+        list.clear();
+    }
+    result.visibleCount = 0;
+
+    const uint32_t objectCount = getObjectCount();
+    if (objectCount == 0) {
+        return;
+    }
+
+    // Chunk sizes are multiples of 8 so only the last chunk runs the scalar tail
+    uint32_t chunkCount = 1;
+    if (m_pool && objectCount >= m_parallelThreshold) {
+        chunkCount = std::clamp(objectCount / MinChunkSize, 1u, m_pool->getThreadCount() * 4);
+    }
+    const uint32_t chunkSize = ((objectCount + chunkCount - 1) / chunkCount + 7) & ~7u;
+    chunkCount = (objectCount + chunkSize - 1) / chunkSize;
+
+    if (m_chunks.size() < chunkCount) {
+        m_chunks.resize(chunkCount);
+    }
+    for (uint32_t c = 0; c < chunkCount; ++c) {
+        if (m_chunks[c].slots.size() < chunkSize) {
+            m_chunks[c].slots.resize(chunkSize);
+            m_chunks[c].lods.resize(chunkSize);
+        }
+    }
+
+    auto cullChunks = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t c = begin; c < end; ++c) {
+            const uint32_t first = c * chunkSize;
+            cullRange(view, first, std::min(first + chunkSize, objectCount), m_chunks[c]);
+        }
+    };
+    if (chunkCount > 1) {
+        m_pool->parallelFor(chunkCount, cullChunks);
+    } else {
+        cullChunks(0, 1);
+    }
+
+    // Chunks are merged in slot order, so the lists do not depend on scheduling
+    for (uint32_t c = 0; c < chunkCount; ++c) {
+        const Chunk& chunk = m_chunks[c];
+        for (uint32_t i = 0; i < chunk.count; ++i) {
+            result.lods[chunk.lods[i]].push_back(m_slotHandles[chunk.slots[i]]);
+        }
+        result.visibleCount += chunk.count;
+    }
+}
+
+void VisibilityCuller::cullRange(const CullView& view, uint32_t begin, uint32_t end, Chunk& chunk) const {
+    const std::array<PlaneTerms, 6> planes = makePlaneTerms(view.frustum);
+    const float* cx = m_centerX.data();
+    const float* cy = m_centerY.data();
+    const float* cz = m_centerZ.data();
+    const float* ex = m_extentX.data();
+    const float* ey = m_extentY.data();
+    const float* ez = m_extentZ.data();
+    const float* radius = m_radius.data();
+
+    uint32_t* outSlots = chunk.slots.data();
+    uint8_t* outLods = chunk.lods.data();
+    uint32_t count = 0;
+
+    auto emit = [&](uint32_t slot, float pixelSize) {
+        outSlots[count] = slot;
+        outLods[count] = selectLod(pixelSize, m_lodThresholds, m_lodCount[slot]);
+        ++count;
+    };
+
+    uint32_t i = begin;
+
+#if defined(EV_SIMD_AVX2)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 camX = _mm256_set1_ps(view.position.x);
+        const __m256 camY = _mm256_set1_ps(view.position.y);
+        const __m256 camZ = _mm256_set1_ps(view.position.z);
+        const __m256 pixelScale = _mm256_set1_ps(view.pixelScale);
+        const __m256 minDistance = _mm256_set1_ps(MinLodDistance);
+        const __m256 minPixelSize = _mm256_set1_ps(m_minPixelSize);
+        alignas(32) float sizes[8];
+
+        for (; i + 8 <= end; i += 8) {
+            const __m256 x = _mm256_loadu_ps(cx + i);
+            const __m256 y = _mm256_loadu_ps(cy + i);
+            const __m256 z = _mm256_loadu_ps(cz + i);
+            const __m256 hx = _mm256_loadu_ps(ex + i);
+            const __m256 hy = _mm256_loadu_ps(ey + i);
+            const __m256 hz = _mm256_loadu_ps(ez + i);
+            const __m256 r = _mm256_loadu_ps(radius + i);
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (const PlaneTerms& p : planes) {
+#if defined(__FMA__)
+                const __m256 distance = _mm256_fmadd_ps(_mm256_set1_ps(p.nz), z,
+                    _mm256_fmadd_ps(_mm256_set1_ps(p.ny), y,
+                        _mm256_fmadd_ps(_mm256_set1_ps(p.nx), x, _mm256_set1_ps(p.w))));
+                const __m256 boxReach = _mm256_fmadd_ps(_mm256_set1_ps(p.az), hz,
+                    _mm256_fmadd_ps(_mm256_set1_ps(p.ay), hy, _mm256_mul_ps(_mm256_set1_ps(p.ax), hx)));
+#else
+                const __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.nx), x), _mm256_mul_ps(_mm256_set1_ps(p.ny), y)),
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.nz), z), _mm256_set1_ps(p.w)));
+                const __m256 boxReach = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.ax), hx), _mm256_mul_ps(_mm256_set1_ps(p.ay), hy)),
+                    _mm256_mul_ps(_mm256_set1_ps(p.az), hz));
+#endif
+                const __m256 reach = _mm256_min_ps(r, boxReach);
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, reach), zero, _CMP_GE_OQ));
+            }
+            if (_mm256_movemask_ps(inside) == 0) {
+                continue;
+            }
+
+            const __m256 dx = _mm256_sub_ps(x, camX);
+            const __m256 dy = _mm256_sub_ps(y, camY);
+            const __m256 dz = _mm256_sub_ps(z, camZ);
+            const __m256 distanceSquared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                                         _mm256_mul_ps(dz, dz));
+            const __m256 distance = _mm256_max_ps(_mm256_sqrt_ps(distanceSquared), minDistance);
+            const __m256 size = _mm256_div_ps(_mm256_mul_ps(r, pixelScale), distance);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(size, minPixelSize, _CMP_GE_OQ));
+
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(inside));
+            _mm256_store_ps(sizes, size);
+            while (mask != 0) {
+                const int lane = std::countr_zero(mask);
+                emit(i + lane, sizes[lane]);
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+#if defined(EV_SIMD_SSE2)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 camX = _mm_set1_ps(view.position.x);
+        const __m128 camY = _mm_set1_ps(view.position.y);
+        const __m128 camZ = _mm_set1_ps(view.position.z);
+        const __m128 pixelScale = _mm_set1_ps(view.pixelScale);
+        const __m128 minDistance = _mm_set1_ps(MinLodDistance);
+        const __m128 minPixelSize = _mm_set1_ps(m_minPixelSize);
+        alignas(16) float sizes[4];
+
+        for (; i + 4 <= end; i += 4) {
+            const __m128 x = _mm_loadu_ps(cx + i);
+            const __m128 y = _mm_loadu_ps(cy + i);
+            const __m128 z = _mm_loadu_ps(cz + i);
+            const __m128 hx = _mm_loadu_ps(ex + i);
+            const __m128 hy = _mm_loadu_ps(ey + i);
+            const __m128 hz = _mm_loadu_ps(ez + i);
+            const __m128 r = _mm_loadu_ps(radius + i);
+
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (const PlaneTerms& p : planes) {
+                const __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.nx), x), _mm_mul_ps(_mm_set1_ps(p.ny), y)),
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.nz), z), _mm_set1_ps(p.w)));
+                const __m128 boxReach = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.ax), hx), _mm_mul_ps(_mm_set1_ps(p.ay), hy)),
+                    _mm_mul_ps(_mm_set1_ps(p.az), hz));
+                const __m128 reach = _mm_min_ps(r, boxReach);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, reach), zero));
+            }
+            if (_mm_movemask_ps(inside) == 0) {
+                continue;
+            }
+
+            const __m128 dx = _mm_sub_ps(x, camX);
+            const __m128 dy = _mm_sub_ps(y, camY);
+            const __m128 dz = _mm_sub_ps(z, camZ);
+            const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                                      _mm_mul_ps(dz, dz));
+            const __m128 distance = _mm_max_ps(_mm_sqrt_ps(distanceSquared), minDistance);
+            const __m128 size = _mm_div_ps(_mm_mul_ps(r, pixelScale), distance);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(size, minPixelSize));
+
+            const int mask = _mm_movemask_ps(inside);
+            _mm_store_ps(sizes, size);
+            for (int lane = 0; lane < 4; ++lane) {
+                if (mask & (1 << lane)) {
+                    emit(i + lane, sizes[lane]);
+                }
+            }
+        }
+    }
+#elif defined(EV_SIMD_NEON)
+    {
+        const float32x4_t camX = vdupq_n_f32(view.position.x);
+        const float32x4_t camY = vdupq_n_f32(view.position.y);
+        const float32x4_t camZ = vdupq_n_f32(view.position.z);
+        const float32x4_t minDistance = vdupq_n_f32(MinLodDistance);
+        const float32x4_t minPixelSize = vdupq_n_f32(m_minPixelSize);
+        alignas(16) float sizes[4];
+        alignas(16) uint32_t lanes[4];
+
+        for (; i + 4 <= end; i += 4) {
+            const float32x4_t x = vld1q_f32(cx + i);
+            const float32x4_t y = vld1q_f32(cy + i);
+            const float32x4_t z = vld1q_f32(cz + i);
+            const float32x4_t hx = vld1q_f32(ex + i);
+            const float32x4_t hy = vld1q_f32(ey + i);
+            const float32x4_t hz = vld1q_f32(ez + i);
+            const float32x4_t r = vld1q_f32(radius + i);
+
+            uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+            for (const PlaneTerms& p : planes) {
+                const float32x4_t distance =
+                    vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(p.w), x, p.nx), y, p.ny), z, p.nz);
+                const float32x4_t boxReach = vfmaq_n_f32(vfmaq_n_f32(vmulq_n_f32(hx, p.ax), hy, p.ay), hz, p.az);
+                const float32x4_t reach = vminq_f32(r, boxReach);
+                inside = vandq_u32(inside, vcgezq_f32(vaddq_f32(distance, reach)));
+            }
+            if (vmaxvq_u32(inside) == 0) {
+                continue;
+            }
+
+            const float32x4_t dx = vsubq_f32(x, camX);
+            const float32x4_t dy = vsubq_f32(y, camY);
+            const float32x4_t dz = vsubq_f32(z, camZ);
+            const float32x4_t distanceSquared = vfmaq_f32(vfmaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+            const float32x4_t distance = vmaxq_f32(vsqrtq_f32(distanceSquared), minDistance);
+            const float32x4_t size = vdivq_f32(vmulq_n_f32(r, view.pixelScale), distance);
+            inside = vandq_u32(inside, vcgeq_f32(size, minPixelSize));
+
+            vst1q_f32(sizes, size);
+            vst1q_u32(lanes, inside);
+            for (int lane = 0; lane < 4; ++lane) {
+                if (lanes[lane] != 0) {
+                    emit(i + lane, sizes[lane]);
+                }
+            }
+        }
+    }
+#endif
+
+    for (; i < end; ++i) {
+        bool inside = true;
+        for (const PlaneTerms& p : planes) {
+            const float distance = p.nx * cx[i] + p.ny * cy[i] + p.nz * cz[i] + p.w;
+            const float boxReach = p.ax * ex[i] + p.ay * ey[i] + p.az * ez[i];
+            inside = inside && distance + std::min(radius[i], boxReach) >= 0.0f;
+        }
+        if (!inside) {
+            continue;
+        }
+
+        const float dx = cx[i] - view.position.x;
+        const float dy = cy[i] - view.position.y;
+        const float dz = cz[i] - view.position.z;
+        const float distance = std::max(std::sqrt(dx * dx + dy * dy + dz * dz), MinLodDistance);
+        const float size = radius[i] * view.pixelScale / distance;
+        if (size >= m_minPixelSize) {
+            emit(i, size);
+        }
+    }
+
+    chunk.count = count;
+}
+
+void VisibilityCuller::storeBounds(uint32_t slot, const BoundingVolume& bounds) {
+    m_centerX[slot] = bounds.center.x;
+    m_centerY[slot] = bounds.center.y;
+    m_centerZ[slot] = bounds.center.z;
+    m_extentX[slot] = bounds.extents.x;
+    m_extentY[slot] = bounds.extents.y;
+    m_extentZ[slot] = bounds.extents.z;
+    m_radius[slot] = bounds.radius;
+}
+
+uint32_t VisibilityCuller::slotOf(uint32_t handle) const {
+    if (handle >= m_handleSlots.size() || m_handleSlots[handle] == InvalidSlot) {
+        throw std::runtime_error("VisibilityCuller: unknown object handle " + std::to_string(handle));
+    }
+    return m_handleSlots[handle];
+}
+
+} // namespace ev
@@ -178,10 +178,103 @@ void VulkanDevice::createLogicalDevice() {
                      m_additionalExtensions.begin(), 
                      m_additionalExtensions.end());
 
+    // Optional features, chained into VkDeviceCreateInfo::pNext when supported
+    void* featureChain = nullptr;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(m_physicalDevice, &properties);
+
+    VkPhysicalDeviceMemoryPriorityFeaturesEXT memoryPriorityFeatures{};
+    memoryPriorityFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT;
+    if (isDeviceExtensionSupported(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME)) {
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &memoryPriorityFeatures;
+        vkGetPhysicalDeviceFeatures2(m_physicalDevice, &features2);
+
+        if (memoryPriorityFeatures.memoryPriority) {
+            enableExtension(extensions, VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME);
+            memoryPriorityFeatures.pNext = featureChain;
+            featureChain = &memoryPriorityFeatures;
+            m_memoryPriorityEnabled = true;
+        }
+    }
 
+    // Buffer device address is core since Vulkan 1.2; older devices need the KHR extension
+    VkPhysicalDeviceBufferDeviceAddressFeatures bufferDeviceAddressFeatures{};
+    bufferDeviceAddressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+    {
+        const bool core = properties.apiVersion >= VK_API_VERSION_1_2;
+        if (core || isDeviceExtensionSupported(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME)) {
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &bufferDeviceAddressFeatures;
+            vkGetPhysicalDeviceFeatures2(m_physicalDevice, &features2);
+
+            if (bufferDeviceAddressFeatures.bufferDeviceAddress) {
+                if (!core) {
+                    enableExtension(extensions, VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
+                }
+                // Capture/replay and multi-device addresses are not needed
+                bufferDeviceAddressFeatures.bufferDeviceAddressCaptureReplay = VK_FALSE;
+                bufferDeviceAddressFeatures.bufferDeviceAddressMultiDevice = VK_FALSE;
+                bufferDeviceAddressFeatures.pNext = featureChain;
+                featureChain = &bufferDeviceAddressFeatures;
+                m_bufferDeviceAddressEnabled = true;
+            }
+        }
+    }
+
+    // vkCmdDraw*IndirectCount: core entry points since Vulkan 1.2, enabled through the
+    // KHR extension so no VkPhysicalDeviceVulkan12Features has to join the chain above
+    if (properties.apiVersion >= VK_API_VERSION_1_2 &&
+        isDeviceExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME)) {
+        enableExtension(extensions, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+        m_drawIndirectCountEnabled = true;
+    }
+
+#if defined(VK_EXT_host_image_copy)
+    VkPhysicalDeviceHostImageCopyFeaturesEXT hostImageCopyFeatures{};
+    hostImageCopyFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+    if (isDeviceExtensionSupported(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME)) {
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &hostImageCopyFeatures;
+        vkGetPhysicalDeviceFeatures2(m_physicalDevice, &features2);
+
+        if (hostImageCopyFeatures.hostImageCopy) {
+            enableExtension(extensions, VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME);
+            // Dependencies, core since Vulkan 1.3
+            if (isDeviceExtensionSupported(VK_KHR_COPY_COMMANDS_2_EXTENSION_NAME)) {
+                enableExtension(extensions, VK_KHR_COPY_COMMANDS_2_EXTENSION_NAME);
+            }
+            if (isDeviceExtensionSupported(VK_KHR_FORMAT_FEATURE_FLAGS_2_EXTENSION_NAME)) {
+                enableExtension(extensions, VK_KHR_FORMAT_FEATURE_FLAGS_2_EXTENSION_NAME);
+            }
+            hostImageCopyFeatures.pNext = featureChain;
+            featureChain = &hostImageCopyFeatures;
+            m_hostImageCopyEnabled = true;
+
+            // Layouts a host copy may write in; queried as count, then list
+            VkPhysicalDeviceHostImageCopyPropertiesEXT hostImageCopyProperties{};
+            hostImageCopyProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_PROPERTIES_EXT;
+            VkPhysicalDeviceProperties2 properties2{};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &hostImageCopyProperties;
+            vkGetPhysicalDeviceProperties2(m_physicalDevice, &properties2);
+
+            m_hostImageCopyDstLayouts.resize(hostImageCopyProperties.copyDstLayoutCount);
+            hostImageCopyProperties.pCopyDstLayouts = m_hostImageCopyDstLayouts.data();
+            hostImageCopyProperties.copySrcLayoutCount = 0;
+            vkGetPhysicalDeviceProperties2(m_physicalDevice, &properties2);
+            m_hostImageCopyDstLayouts.resize(hostImageCopyProperties.copyDstLayoutCount);
+        }
+    }
+#endif
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = featureChain;
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pEnabledFeatures = &m_deviceFeatures;
@@ -283,6 +376,113 @@ std::vector<const char*> VulkanDevice::getRequiredDeviceExtensions() {
     return deviceExtensions;
 }
 
+bool VulkanDevice::isDeviceExtensionSupported(const char* extensionName) {
+    if (m_supportedExtensions.empty()) {
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &extensionCount, nullptr);
+
+        std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+        for (const auto& extension : availableExtensions) {
+            m_supportedExtensions.insert(extension.extensionName);
+        }
+    }
+    return m_supportedExtensions.count(extensionName) > 0;
+}
+
+void VulkanDevice::enableExtension(std::vector<const char*>& extensions, const char* extensionName) {
+    for (const char* enabled : extensions) {
+        if (std::string(enabled) == extensionName) {
+            return;
+        }
+    }
+    extensions.push_back(extensionName);
+}
+
+bool VulkanDevice::isHostImageCopyLayoutSupported(VkImageLayout layout) const {
+    for (VkImageLayout supported : m_hostImageCopyDstLayouts) {
+        if (supported == layout) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void VulkanDevice::queueMappedFlush(VmaAllocation allocation, VkDeviceSize offset, VkDeviceSize size) {
+    if (allocation == VK_NULL_HANDLE || size == 0) {
+        return;
+    }
+
+    VkMemoryPropertyFlags memFlags = 0;
+    vmaGetAllocationMemoryProperties(m_allocator, allocation, &memFlags);
+    if (memFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_pendingFlushMutex);
+    auto it = m_pendingFlushIndex.find(allocation);
+    if (it == m_pendingFlushIndex.end()) {
+        m_pendingFlushIndex[allocation] = m_pendingFlushAllocations.size();
+        m_pendingFlushAllocations.push_back(allocation);
+        m_pendingFlushOffsets.push_back(offset);
+        m_pendingFlushSizes.push_back(size);
+        return;
+    }
+
+    // Grow the pending range so it covers both the old and the new write
+    size_t index = it->second;
+    VkDeviceSize begin = std::min(m_pendingFlushOffsets[index], offset);
+    VkDeviceSize end = std::max(m_pendingFlushOffsets[index] + m_pendingFlushSizes[index], offset + size);
+    m_pendingFlushOffsets[index] = begin;
+    m_pendingFlushSizes[index] = end - begin;
+}
+
+void VulkanDevice::cancelMappedFlush(VmaAllocation allocation) {
+    std::lock_guard<std::mutex> lock(m_pendingFlushMutex);
+    auto it = m_pendingFlushIndex.find(allocation);
+    if (it == m_pendingFlushIndex.end()) {
+        return;
+    }
+
+    // Swap-remove and fix up the index of the entry that was moved
+    size_t index = it->second;
+    size_t last = m_pendingFlushAllocations.size() - 1;
+    if (index != last) {
+        m_pendingFlushAllocations[index] = m_pendingFlushAllocations[last];
+        m_pendingFlushOffsets[index] = m_pendingFlushOffsets[last];
+        m_pendingFlushSizes[index] = m_pendingFlushSizes[last];
+        m_pendingFlushIndex[m_pendingFlushAllocations[index]] = index;
+    }
+    m_pendingFlushAllocations.pop_back();
+    m_pendingFlushOffsets.pop_back();
+    m_pendingFlushSizes.pop_back();
+    m_pendingFlushIndex.erase(allocation);
+}
+
+void VulkanDevice::flushMappedRanges() {
+    std::lock_guard<std::mutex> lock(m_pendingFlushMutex);
+    if (m_pendingFlushAllocations.empty()) {
+        return;
+    }
+
+    VkResult result = vmaFlushAllocations(
+        m_allocator,
+        static_cast<uint32_t>(m_pendingFlushAllocations.size()),
+        m_pendingFlushAllocations.data(),
+        m_pendingFlushOffsets.data(),
+        m_pendingFlushSizes.data());
+
+    m_pendingFlushIndex.clear();
+    m_pendingFlushAllocations.clear();
+    m_pendingFlushOffsets.clear();
+    m_pendingFlushSizes.clear();
+
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("failed to flush mapped memory ranges!");
+    }
+}
+
 void VulkanDevice::setupAllocator(bool enableMemoryBudget) {
     VmaAllocatorCreateInfo allocatorInfo{};
     allocatorInfo.physicalDevice = m_physicalDevice;
@@ -292,7 +492,17 @@ void VulkanDevice::setupAllocator(bool enableMemoryBudget) {
     
     // Enable memory budget extension for better memory usage tracking
     if(enableMemoryBudget) {
-        allocatorInfo.flags = VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+        allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    }
+
+    // Let VmaAllocationCreateInfo::priority reach the driver
+    if (m_memoryPriorityEnabled) {
+        allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_PRIORITY_BIT;
+    }
+
+    // Allocations of SHADER_DEVICE_ADDRESS buffers need VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT
+    if (m_bufferDeviceAddressEnabled) {
+        allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
     }
 
     if (vmaCreateAllocator(&allocatorInfo, &m_allocator) != VK_SUCCESS) {
@@ -0,0 +1,506 @@
+#include "EasyVulkan/Utils/BlockCompression.hpp"
+#include "EasyVulkan/Core/ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EV_BC_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define EV_BC_NEON 1
+#endif
+
+namespace ev {
+namespace BlockCompression {
+
+namespace {
+
+/// BC7 4-bit index interpolation weights (out of 64)
+constexpr std::array<int, 16> kBC7Weights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/**
+ * @brief Per-channel minimum and maximum of the 16 texels of a block
+ */
+void computeBounds(const uint8_t* rgba, uint8_t minColor[4], uint8_t maxColor[4]) {
+#if defined(EV_BC_SSE2)
+    __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba));
+    __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + 16));
+    __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + 32));
+    __m128i row3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + 48));
+
+    __m128i lo = _mm_min_epu8(_mm_min_epu8(row0, row1), _mm_min_epu8(row2, row3));
+    __m128i hi = _mm_max_epu8(_mm_max_epu8(row0, row1), _mm_max_epu8(row2, row3));
+
+    // Fold four texels per register down to one
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 0, 3, 2)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 0, 3, 2)));
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    const uint32_t packedMin = static_cast<uint32_t>(_mm_cvtsi128_si32(lo));
+    const uint32_t packedMax = static_cast<uint32_t>(_mm_cvtsi128_si32(hi));
+    std::memcpy(minColor, &packedMin, 4);
+    std::memcpy(maxColor, &packedMax, 4);
+#elif defined(EV_BC_NEON)
+    const uint8x16x4_t rows = vld1q_u8_x4(rgba);
+    uint8x16_t lo = vminq_u8(vminq_u8(rows.val[0], rows.val[1]), vminq_u8(rows.val[2], rows.val[3]));
+    uint8x16_t hi = vmaxq_u8(vmaxq_u8(rows.val[0], rows.val[1]), vmaxq_u8(rows.val[2], rows.val[3]));
+
+    uint8x8_t lo8 = vmin_u8(vget_low_u8(lo), vget_high_u8(lo));
+    uint8x8_t hi8 = vmax_u8(vget_low_u8(hi), vget_high_u8(hi));
+    lo8 = vmin_u8(lo8, vext_u8(lo8, lo8, 4));
+    hi8 = vmax_u8(hi8, vext_u8(hi8, hi8, 4));
+
+    const uint32_t packedMin = vget_lane_u32(vreinterpret_u32_u8(lo8), 0);
+    const uint32_t packedMax = vget_lane_u32(vreinterpret_u32_u8(hi8), 0);
+    std::memcpy(minColor, &packedMin, 4);
+    std::memcpy(maxColor, &packedMax, 4);
+#else
+    for (int c = 0; c < 4; ++c) {
+        minColor[c] = 255;
+        maxColor[c] = 0;
+    }
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            minColor[c] = std::min(minColor[c], rgba[i * 4 + c]);
+            maxColor[c] = std::max(maxColor[c], rgba[i * 4 + c]);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Dot products (texel - base) . dir for the 16 texels of a block
+ */
+void projectBlock(const uint8_t* rgba, const int16_t base[4], const int16_t dir[4], int32_t dots[16]) {
+#if defined(EV_BC_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i base16 = _mm_set_epi16(base[3], base[2], base[1], base[0], base[3], base[2], base[1], base[0]);
+    const __m128i dir16 = _mm_set_epi16(dir[3], dir[2], dir[1], dir[0], dir[3], dir[2], dir[1], dir[0]);
+
+    for (int i = 0; i < 16; i += 4) {
+        const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + i * 4));
+        const __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(texels, zero), base16);
+        const __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(texels, zero), base16);
+
+        // madd yields (rg, ba) partial sums per texel; add the pairs
+        __m128i sumLo = _mm_madd_epi16(lo, dir16);
+        __m128i sumHi = _mm_madd_epi16(hi, dir16);
+        sumLo = _mm_add_epi32(sumLo, _mm_shuffle_epi32(sumLo, _MM_SHUFFLE(2, 3, 0, 1)));
+        sumHi = _mm_add_epi32(sumHi, _mm_shuffle_epi32(sumHi, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        alignas(16) int32_t lanes[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sumLo);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes + 4), sumHi);
+        dots[i + 0] = lanes[0];
+        dots[i + 1] = lanes[2];
+        dots[i + 2] = lanes[4];
+        dots[i + 3] = lanes[6];
+    }
+#elif defined(EV_BC_NEON)
+    const int16x4_t base4 = vld1_s16(base);
+    const int16x4_t dir4 = vld1_s16(dir);
+
+    for (int i = 0; i < 16; i += 2) {
+        const int16x8_t texels = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(rgba + i * 4)));
+        const int16x4_t first = vsub_s16(vget_low_s16(texels), base4);
+        const int16x4_t second = vsub_s16(vget_high_s16(texels), base4);
+        dots[i + 0] = vaddvq_s32(vmull_s16(first, dir4));
+        dots[i + 1] = vaddvq_s32(vmull_s16(second, dir4));
+    }
+#else
+    for (int i = 0; i < 16; ++i) {
+        int32_t sum = 0;
+        for (int c = 0; c < 4; ++c) {
+            sum += (static_cast<int32_t>(rgba[i * 4 + c]) - base[c]) * dir[c];
+        }
+        dots[i] = sum;
+    }
+#endif
+}
+
+/**
+ * @brief Picks the bounding-box diagonal that follows the block's main color axis
+ * @details Channels whose covariance with the channel of largest range is negative
+ *          have their endpoints swapped, then both endpoints are inset by 1/16 of
+ *          the range to reduce the error of the extreme texels.
+ */
+void selectDiagonal(const uint8_t* rgba, uint32_t channelCount, uint8_t e0[4], uint8_t e1[4]) {
+    uint8_t minColor[4];
+    uint8_t maxColor[4];
+    computeBounds(rgba, minColor, maxColor);
+
+    uint32_t reference = 0;
+    for (uint32_t c = 1; c < channelCount; ++c) {
+        if (maxColor[c] - minColor[c] > maxColor[reference] - minColor[reference]) {
+            reference = c;
+        }
+    }
+
+    int32_t mean[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            mean[c] += rgba[i * 4 + c];
+        }
+    }
+
+    int32_t covariance[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        const int32_t ref = rgba[i * 4 + reference] * 16 - mean[reference];
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            covariance[c] += (rgba[i * 4 + c] * 16 - mean[c]) * ref;
+        }
+    }
+
+    for (uint32_t c = 0; c < 4; ++c) {
+        if (c >= channelCount) {
+            e0[c] = e1[c] = 255;
+            continue;
+        }
+        const int inset = (maxColor[c] - minColor[c]) >> 4;
+        const uint8_t lo = static_cast<uint8_t>(minColor[c] + inset);
+        const uint8_t hi = static_cast<uint8_t>(maxColor[c] - inset);
+        if (covariance[c] < 0) {
+            e0[c] = lo;
+            e1[c] = hi;
+        } else {
+            e0[c] = hi;
+            e1[c] = lo;
+        }
+    }
+}
+
+uint16_t packRGB565(const uint8_t color[4]) {
+    const uint32_t r = (color[0] * 31u + 127u) / 255u;
+    const uint32_t g = (color[1] * 63u + 127u) / 255u;
+    const uint32_t b = (color[2] * 31u + 127u) / 255u;
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void unpackRGB565(uint16_t packed, int16_t color[4]) {
+    const int r = (packed >> 11) & 0x1f;
+    const int g = (packed >> 5) & 0x3f;
+    const int b = packed & 0x1f;
+    color[0] = static_cast<int16_t>((r << 3) | (r >> 2));
+    color[1] = static_cast<int16_t>((g << 2) | (g >> 4));
+    color[2] = static_cast<int16_t>((b << 3) | (b >> 2));
+    color[3] = 0;
+}
+
+/**
+ * @brief Writes count bits of value into a little-endian bit stream
+ */
+void writeBits(uint8_t* out, uint32_t& bitOffset, uint32_t value, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i, ++bitOffset) {
+        if (value & (1u << i)) {
+            out[bitOffset >> 3] |= static_cast<uint8_t>(1u << (bitOffset & 7));
+        }
+    }
+}
+
+/**
+ * @brief Quantizes an endpoint to 7 bits per channel plus the p-bit with the lower error
+ */
+void quantizeBC7Endpoint(const uint8_t color[4], uint8_t quantized[4], uint32_t& pBit) {
+    int bestError = -1;
+    for (uint32_t p = 0; p < 2; ++p) {
+        uint8_t candidate[4];
+        int error = 0;
+        for (int c = 0; c < 4; ++c) {
+            const int q = std::clamp((color[c] - static_cast<int>(p) + 1) >> 1, 0, 127);
+            candidate[c] = static_cast<uint8_t>(q);
+            const int diff = ((q << 1) | static_cast<int>(p)) - color[c];
+            error += diff * diff;
+        }
+        if (bestError < 0 || error < bestError) {
+            bestError = error;
+            pBit = p;
+            std::memcpy(quantized, candidate, 4);
+        }
+    }
+}
+
+/**
+ * @brief Copies the 4x4 block at (blockX, blockY), replicating edge texels
+ */
+void gatherBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t block[64]) {
+    for (uint32_t y = 0; y < 4; ++y) {
+        const uint32_t srcY = std::min(blockY * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint32_t srcX = std::min(blockX * 4 + x, width - 1);
+            std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<size_t>(srcY) * width + srcX) * 4, 4);
+        }
+    }
+}
+
+float srgbToLinear(float value) {
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float linearToSrgb(float value) {
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+} // namespace
+
+VkFormat toVkFormat(BlockFormat format, bool srgb) {
+    switch (format) {
+        case BlockFormat::BC1:
+            return srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+        case BlockFormat::BC4:
+            return VK_FORMAT_BC4_UNORM_BLOCK;
+        case BlockFormat::BC5:
+            return VK_FORMAT_BC5_UNORM_BLOCK;
+        case BlockFormat::BC7:
+            return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+uint32_t getBlockSize(BlockFormat format) {
+    return (format == BlockFormat::BC1 || format == BlockFormat::BC4) ? 8 : 16;
+}
+
+VkDeviceSize getCompressedSize(BlockFormat format, uint32_t width, uint32_t height) {
+    const VkDeviceSize blocksX = (width + 3) / 4;
+    const VkDeviceSize blocksY = (height + 3) / 4;
+    return blocksX * blocksY * getBlockSize(format);
+}
+
+void encodeBlockBC1(const uint8_t* rgba, uint8_t* out) {
+    uint8_t e0[4];
+    uint8_t e1[4];
+    selectDiagonal(rgba, 3, e0, e1);
+
+    uint16_t color0 = packRGB565(e0);
+    uint16_t color1 = packRGB565(e1);
+    // color0 > color1 selects the opaque four-color mode
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    std::memset(out, 0, 8);
+    out[0] = static_cast<uint8_t>(color0 & 0xff);
+    out[1] = static_cast<uint8_t>(color0 >> 8);
+    out[2] = static_cast<uint8_t>(color1 & 0xff);
+    out[3] = static_cast<uint8_t>(color1 >> 8);
+    if (color0 == color1) {
+        return;
+    }
+
+    int16_t base[4];
+    int16_t end[4];
+    unpackRGB565(color0, base);
+    unpackRGB565(color1, end);
+    const int16_t dir[4] = {
+        static_cast<int16_t>(end[0] - base[0]),
+        static_cast<int16_t>(end[1] - base[1]),
+        static_cast<int16_t>(end[2] - base[2]),
+        0};
+    const int32_t lengthSq = dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2];
+
+    int32_t dots[16];
+    projectBlock(rgba, base, dir, dots);
+
+    // Palette order is c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1
+    static constexpr uint32_t kStepToIndex[4] = {0, 2, 3, 1};
+    uint32_t indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int32_t step = std::clamp((dots[i] * 6 + lengthSq) / (2 * lengthSq), 0, 3);
+        indices |= kStepToIndex[step] << (i * 2);
+    }
+    std::memcpy(out + 4, &indices, 4);
+}
+
+void encodeBlockBC4(const uint8_t* rgba, uint32_t channel, uint8_t* out) {
+    uint8_t maxValue = 0;
+    uint8_t minValue = 255;
+    for (int i = 0; i < 16; ++i) {
+        maxValue = std::max(maxValue, rgba[i * 4 + channel]);
+        minValue = std::min(minValue, rgba[i * 4 + channel]);
+    }
+
+    std::memset(out, 0, 8);
+    // alpha0 > alpha1 selects the eight-value mode
+    out[0] = maxValue;
+    out[1] = minValue;
+    if (maxValue == minValue) {
+        return;
+    }
+
+    const int range = maxValue - minValue;
+    uint32_t bitOffset = 16;
+    for (int i = 0; i < 16; ++i) {
+        // Steps from min (0) to max (7) map to indices 1, 7, 6, ... 2, 0
+        const int step = ((rgba[i * 4 + channel] - minValue) * 14 + range) / (2 * range);
+        const uint32_t index = step == 7 ? 0 : step == 0 ? 1 : static_cast<uint32_t>(8 - step);
+        writeBits(out, bitOffset, index, 3);
+    }
+}
+
+void encodeBlockBC5(const uint8_t* rgba, uint8_t* out) {
+    encodeBlockBC4(rgba, 0, out);
+    encodeBlockBC4(rgba, 1, out + 8);
+}
+
+void encodeBlockBC7(const uint8_t* rgba, uint8_t* out) {
+    uint8_t e0[4];
+    uint8_t e1[4];
+    selectDiagonal(rgba, 4, e0, e1);
+
+    uint8_t q0[4];
+    uint8_t q1[4];
+    uint32_t p0 = 0;
+    uint32_t p1 = 0;
+    quantizeBC7Endpoint(e0, q0, p0);
+    quantizeBC7Endpoint(e1, q1, p1);
+
+    int16_t base[4];
+    int16_t dir[4];
+    int32_t lengthSq = 0;
+    for (int c = 0; c < 4; ++c) {
+        base[c] = static_cast<int16_t>((q0[c] << 1) | p0);
+        dir[c] = static_cast<int16_t>(((q1[c] << 1) | p1) - base[c]);
+        lengthSq += dir[c] * dir[c];
+    }
+
+    uint32_t indices[16] = {};
+    if (lengthSq > 0) {
+        int32_t dots[16];
+        projectBlock(rgba, base, dir, dots);
+        for (int i = 0; i < 16; ++i) {
+            const int32_t weight = std::clamp((dots[i] * 128 + lengthSq) / (2 * lengthSq), 0, 64);
+            uint32_t best = 0;
+            for (uint32_t w = 1; w < 16; ++w) {
+                if (std::abs(kBC7Weights[w] - weight) < std::abs(kBC7Weights[best] - weight)) {
+                    best = w;
+                }
+            }
+            indices[i] = best;
+        }
+    }
+
+    // The anchor index is stored without its high bit; swap endpoints to clear it
+    if (indices[0] & 8) {
+        std::swap(q0, q1);
+        std::swap(p0, p1);
+        for (auto& index : indices) {
+            index = 15 - index;
+        }
+    }
+
+    std::memset(out, 0, 16);
+    uint32_t bitOffset = 0;
+    writeBits(out, bitOffset, 1u << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        writeBits(out, bitOffset, q0[c], 7);
+        writeBits(out, bitOffset, q1[c], 7);
+    }
+    writeBits(out, bitOffset, p0, 1);
+    writeBits(out, bitOffset, p1, 1);
+    writeBits(out, bitOffset, indices[0], 3);
+    for (int i = 1; i < 16; ++i) {
+        writeBits(out, bitOffset, indices[i], 4);
+    }
+}
+
+void compressImage(
+    const uint8_t* rgba,
+    uint32_t width,
+    uint32_t height,
+    BlockFormat format,
+    uint8_t* out,
+    ThreadPool* pool) {
+    if (!rgba || !out || width == 0 || height == 0) {
+        throw std::runtime_error("Invalid image passed to block compression");
+    }
+
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const uint32_t blockSize = getBlockSize(format);
+
+    auto encodeRows = [&](uint32_t beginRow, uint32_t endRow) {
+        uint8_t block[64];
+        for (uint32_t by = beginRow; by < endRow; ++by) {
+            uint8_t* dst = out + static_cast<size_t>(by) * blocksX * blockSize;
+            for (uint32_t bx = 0; bx < blocksX; ++bx, dst += blockSize) {
+                gatherBlock(rgba, width, height, bx, by, block);
+                switch (format) {
+                    case BlockFormat::BC1: encodeBlockBC1(block, dst); break;
+                    case BlockFormat::BC4: encodeBlockBC4(block, 0, dst); break;
+                    case BlockFormat::BC5: encodeBlockBC5(block, dst); break;
+                    case BlockFormat::BC7: encodeBlockBC7(block, dst); break;
+                }
+            }
+        }
+    };
+
+    if (pool && blocksY > 1) {
+        pool->parallelFor(blocksY, encodeRows);
+    } else {
+        encodeRows(0, blocksY);
+    }
+}
+
+std::vector<uint8_t> compressImage(
+    const uint8_t* rgba,
+    uint32_t width,
+    uint32_t height,
+    BlockFormat format,
+    ThreadPool* pool) {
+    std::vector<uint8_t> out(static_cast<size_t>(getCompressedSize(format, width, height)));
+    compressImage(rgba, width, height, format, out.data(), pool);
+    return out;
+}
+
+void downsampleRGBA8(
+    const uint8_t* rgba,
+    uint32_t width,
+    uint32_t height,
+    bool srgb,
+    std::vector<uint8_t>& out) {
+    static const std::array<float, 256> kToLinear = []() {
+        std::array<float, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            table[i] = srgbToLinear(i / 255.0f);
+        }
+        return table;
+    }();
+
+    const uint32_t dstWidth = std::max(width / 2, 1u);
+    const uint32_t dstHeight = std::max(height / 2, 1u);
+    out.resize(static_cast<size_t>(dstWidth) * dstHeight * 4);
+
+    for (uint32_t y = 0; y < dstHeight; ++y) {
+        const uint32_t y0 = std::min(y * 2, height - 1);
+        const uint32_t y1 = std::min(y * 2 + 1, height - 1);
+        for (uint32_t x = 0; x < dstWidth; ++x) {
+            const uint32_t x0 = std::min(x * 2, width - 1);
+            const uint32_t x1 = std::min(x * 2 + 1, width - 1);
+            const uint8_t* texels[4] = {
+                rgba + (static_cast<size_t>(y0) * width + x0) * 4,
+                rgba + (static_cast<size_t>(y0) * width + x1) * 4,
+                rgba + (static_cast<size_t>(y1) * width + x0) * 4,
+                rgba + (static_cast<size_t>(y1) * width + x1) * 4};
+            uint8_t* dst = out.data() + (static_cast<size_t>(y) * dstWidth + x) * 4;
+
+            for (int c = 0; c < 4; ++c) {
+                if (srgb && c < 3) {
+                    const float linear = (kToLinear[texels[0][c]] + kToLinear[texels[1][c]] +
+                                          kToLinear[texels[2][c]] + kToLinear[texels[3][c]]) * 0.25f;
+                    dst[c] = static_cast<uint8_t>(std::lround(std::clamp(linearToSrgb(linear), 0.0f, 1.0f) * 255.0f));
+                } else {
+                    dst[c] = static_cast<uint8_t>((texels[0][c] + texels[1][c] + texels[2][c] + texels[3][c] + 2) / 4);
+                }
+            }
+        }
+    }
+}
+
+} // namespace BlockCompression
+} // namespace ev
@@ -40,6 +40,9 @@ void endSingleTimeCommands(
         throw std::runtime_error("failed to record command buffer!");
     }
 
+    // Make pending host writes (e.g. staging data) visible before the GPU reads them
+    device->flushMappedRanges();
+
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.commandBufferCount = 1;
@@ -383,6 +386,73 @@ void drawIndexed(
     vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
+void drawIndirect(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    uint32_t drawCount,
+    uint32_t stride) {
+
+    validateCommandBuffer(commandBuffer);
+    vkCmdDrawIndirect(commandBuffer, buffer, offset, drawCount, stride);
+}
+
+void drawIndexedIndirect(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    uint32_t drawCount,
+    uint32_t stride) {
+
+    validateCommandBuffer(commandBuffer);
+    vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, drawCount, stride);
+}
+
+void drawIndirectCount(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkBuffer countBuffer,
+    VkDeviceSize countBufferOffset,
+    uint32_t maxDrawCount,
+    uint32_t stride) {
+
+    validateCommandBuffer(commandBuffer);
+    vkCmdDrawIndirectCount(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+void drawIndexedIndirectCount(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkBuffer countBuffer,
+    VkDeviceSize countBufferOffset,
+    uint32_t maxDrawCount,
+    uint32_t stride) {
+
+    validateCommandBuffer(commandBuffer);
+    vkCmdDrawIndexedIndirectCount(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+void dispatch(
+    VkCommandBuffer commandBuffer,
+    uint32_t groupCountX,
+    uint32_t groupCountY,
+    uint32_t groupCountZ) {
+
+    validateCommandBuffer(commandBuffer);
+    vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+}
+
+void dispatchIndirect(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset) {
+
+    validateCommandBuffer(commandBuffer);
+    vkCmdDispatchIndirect(commandBuffer, buffer, offset);
+}
+
 void beginRenderPass(
     VkCommandBuffer commandBuffer,
     const VkRenderPassBeginInfo& renderPassBegin,
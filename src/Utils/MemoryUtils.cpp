@@ -24,34 +24,89 @@ uint32_t findMemoryType(
     throw std::runtime_error("failed to find suitable memory type!");
 }
 
+bool isHostVisible(
+    VulkanDevice* device,
+    VmaAllocation allocation) {
+    
+    VkMemoryPropertyFlags memFlags = 0;
+    vmaGetAllocationMemoryProperties(device->getAllocator(), allocation, &memFlags);
+    return (memFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+}
+
+void* getMappedData(
+    VulkanDevice* device,
+    VmaAllocation allocation) {
+    
+    VmaAllocationInfo allocInfo;
+    vmaGetAllocationInfo(device->getAllocator(), allocation, &allocInfo);
+    return allocInfo.pMappedData;
+}
+
 void mapAndCopyData(
     VulkanDevice* device,
     VmaAllocation allocation,
     const void* data,
-    VkDeviceSize size) {
+    VkDeviceSize size,
+    VkDeviceSize offset) {
     
+    if (!data || size == 0) {
+        throw std::runtime_error("invalid data or data size!");
+    }
+
+    // Persistently mapped: write through the cached pointer, skipping map/unmap.
+    // Flushed right away since the caller owns the allocation's lifetime.
+    if (void* mappedData = getMappedData(device, allocation)) {
+        memcpy(static_cast<char*>(mappedData) + offset, data, static_cast<size_t>(size));
+        if (vmaFlushAllocation(device->getAllocator(), allocation, offset, size) != VK_SUCCESS) {
+            throw std::runtime_error("failed to flush memory!");
+        }
+        return;
+    }
+
     void* mappedData;
     if (vmaMapMemory(device->getAllocator(), allocation, &mappedData) != VK_SUCCESS) {
         throw std::runtime_error("failed to map memory!");
     }
 
-    memcpy(mappedData, data, static_cast<size_t>(size));
+    memcpy(static_cast<char*>(mappedData) + offset, data, static_cast<size_t>(size));
+    VkResult result = vmaFlushAllocation(device->getAllocator(), allocation, offset, size);
     vmaUnmapMemory(device->getAllocator(), allocation);
+
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("failed to flush memory!");
+    }
 }
 
 void mapAndRetrieveData(
     VulkanDevice* device,
     VmaAllocation allocation,
     void* data,
-    VkDeviceSize size) {
+    VkDeviceSize size,
+    VkDeviceSize offset) {
     
-    void* mappedData;
-    if (vmaMapMemory(device->getAllocator(), allocation, &mappedData) != VK_SUCCESS) {
+    if (!data || size == 0) {
+        throw std::runtime_error("invalid data or data size!");
+    }
+
+    void* mappedData = getMappedData(device, allocation);
+    bool persistent = mappedData != nullptr;
+    if (!persistent && vmaMapMemory(device->getAllocator(), allocation, &mappedData) != VK_SUCCESS) {
         throw std::runtime_error("failed to map memory!");
     }
 
-    memcpy(data, mappedData, static_cast<size_t>(size));
-    vmaUnmapMemory(device->getAllocator(), allocation);
+    // Make GPU writes visible to the host (no-op for HOST_COHERENT memory)
+    VkResult result = vmaInvalidateAllocation(device->getAllocator(), allocation, offset, size);
+    if (result == VK_SUCCESS) {
+        memcpy(data, static_cast<const char*>(mappedData) + offset, static_cast<size_t>(size));
+    }
+
+    if (!persistent) {
+        vmaUnmapMemory(device->getAllocator(), allocation);
+    }
+
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("failed to invalidate memory!");
+    }
 }
 
 VkMemoryRequirements getBufferMemoryRequirements(
@@ -0,0 +1,582 @@
+#include "EasyVulkan/Utils/PixelConversion.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EV_PC_SSE2 1
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define EV_PC_SSSE3 1
+#endif
+#if defined(__AVX2__) || defined(__F16C__)
+#include <immintrin.h>
+#endif
+#if defined(__AVX2__)
+#define EV_PC_AVX2 1
+#endif
+#if defined(__F16C__)
+#define EV_PC_F16C 1
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define EV_PC_NEON 1
+#endif
+
+namespace ev {
+namespace PixelConversion {
+
+namespace {
+
+/// Pixels converted per chunk when several kernels are chained
+constexpr size_t kChunkPixels = 256;
+
+/// Entries of the linear -> sRGB table
+constexpr uint32_t kSrgbTableSize = 16384;
+
+uint32_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bitsToFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+const uint8_t* getLinearToSrgbTable() {
+    static const std::array<uint8_t, kSrgbTableSize> table = [] {
+        std::array<uint8_t, kSrgbTableSize> values{};
+        for (uint32_t i = 0; i < kSrgbTableSize; ++i) {
+            const double linear = static_cast<double>(i) / (kSrgbTableSize - 1);
+            const double srgb = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+            values[i] = static_cast<uint8_t>(std::lround(srgb * 255.0));
+        }
+        return values;
+    }();
+    return table.data();
+}
+
+const float* getSrgbToLinearTable() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> values{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            const double srgb = i / 255.0;
+            values[i] = static_cast<float>(srgb <= 0.04045 ? srgb / 12.92 : std::pow((srgb + 0.055) / 1.055, 2.4));
+        }
+        return values;
+    }();
+    return table.data();
+}
+
+uint32_t clampToIndex(float value, float scale) {
+    // NaN and negatives map to 0
+    const float clamped = value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+    return static_cast<uint32_t>(clamped * scale + 0.5f);
+}
+
+uint32_t swizzlePixel(uint32_t pixel) {
+    const uint32_t redBlue = pixel & 0x00FF00FFu;
+    return (pixel & 0xFF00FF00u) | (redBlue << 16) | (redBlue >> 16);
+}
+
+uint8_t divideBy255(uint32_t value) {
+    value += 128;
+    return static_cast<uint8_t>((value + (value >> 8)) >> 8);
+}
+
+#if defined(EV_PC_SSE2) && !defined(EV_PC_F16C)
+/**
+ * @brief Four floats to half floats (round to nearest even), sign-extended to 32 bits
+ */
+__m128i float32ToFloat16SSE2(__m128 value) {
+    const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i halfOverflow = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i nanBit = _mm_set1_epi32(0x200);
+    const __m128i infinity = _mm_set1_epi32(0x7C00);
+    const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+    const __m128 sign = _mm_and_ps(_mm_castsi128_ps(signMask), value);
+    const __m128 absolute = _mm_xor_ps(value, sign);
+    const __m128i absoluteBits = _mm_castps_si128(absolute);
+
+    const __m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+    const __m128i isRegular = _mm_cmpgt_epi32(halfOverflow, absoluteBits);
+    const __m128i special = _mm_or_si128(_mm_and_si128(isNan, nanBit), infinity);
+    const __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absoluteBits);
+
+    // Subnormal results: let the FPU round the mantissa
+    const __m128 subnormalSum = _mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic));
+    const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(subnormalSum), subnormalMagic);
+
+    // Normal results: rebias the exponent and round to nearest even
+    const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteBits, 31 - 13), 31);
+    const __m128i rounded = _mm_sub_epi32(_mm_add_epi32(absoluteBits, normalBias), mantissaOdd);
+    const __m128i normal = _mm_srli_epi32(rounded, 13);
+
+    const __m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+    const __m128i result = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, special));
+    return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+#endif
+
+/**
+ * @brief Multiplies RGBA float pixels by their alpha
+ */
+void premultiplyAlpha32F(const float* src, float* dst, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const float alpha = src[i * 4 + 3];
+        dst[i * 4 + 0] = src[i * 4 + 0] * alpha;
+        dst[i * 4 + 1] = src[i * 4 + 1] * alpha;
+        dst[i * 4 + 2] = src[i * 4 + 2] * alpha;
+        dst[i * 4 + 3] = alpha;
+    }
+}
+
+bool isRGBA8(VkFormat format) {
+    return format == VK_FORMAT_R8G8B8A8_UNORM || format == VK_FORMAT_R8G8B8A8_SRGB;
+}
+
+bool isBGRA8(VkFormat format) {
+    return format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SRGB;
+}
+
+bool isSrgb(VkFormat format) {
+    return format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_B8G8R8A8_SRGB;
+}
+
+/**
+ * @brief Converts 8-bit sources to 8-bit destinations, at most kChunkPixels at a time
+ */
+void convertChunk8(const uint8_t* src, SourcePixelFormat srcFormat, uint8_t* dst, VkFormat dstFormat,
+                   size_t pixelCount, bool premultiplyAlpha) {
+    using Kernel = void (*)(const uint8_t*, uint8_t*, size_t);
+    Kernel kernels[3];
+    size_t kernelCount = 0;
+
+    if (srcFormat == SourcePixelFormat::RGB8) {
+        kernels[kernelCount++] = rgb8ToRgba8;
+    } else if (premultiplyAlpha) {
+        kernels[kernelCount++] = premultiplyAlpha8;
+    }
+    if ((srcFormat == SourcePixelFormat::BGRA8) != isBGRA8(dstFormat)) {
+        kernels[kernelCount++] = swizzleRedBlue8;
+    }
+
+    if (kernelCount == 0) {
+        std::memcpy(dst, src, pixelCount * 4);
+        return;
+    }
+
+    // Intermediate results stay in a cache-resident chunk; only the last kernel writes dst
+    alignas(16) uint8_t scratch[kChunkPixels * 4];
+    const uint8_t* current = src;
+    for (size_t i = 0; i < kernelCount; ++i) {
+        uint8_t* output = i + 1 == kernelCount ? dst : scratch;
+        kernels[i](current, output, pixelCount);
+        current = output;
+    }
+}
+
+bool isFloat(VkFormat format) {
+    return format == VK_FORMAT_R32G32B32A32_SFLOAT || format == VK_FORMAT_R16G16B16A16_SFLOAT;
+}
+
+/**
+ * @brief Decodes sRGB-encoded 8-bit sources to float destinations, at most kChunkPixels at a time
+ */
+void convertChunk8ToFloat(const uint8_t* src, SourcePixelFormat srcFormat, uint8_t* dst, VkFormat dstFormat,
+                          size_t pixelCount, bool premultiplyAlpha) {
+    // Bring the source to RGBA8 order first; the sRGB decode expects it
+    alignas(16) uint8_t rgba[kChunkPixels * 4];
+    if (srcFormat == SourcePixelFormat::RGB8) {
+        rgb8ToRgba8(src, rgba, pixelCount);
+        src = rgba;
+    } else if (srcFormat == SourcePixelFormat::BGRA8) {
+        swizzleRedBlue8(src, rgba, pixelCount);
+        src = rgba;
+    }
+
+    // Float32 results go straight to dst once no kernel follows; premultiply in linear space
+    const bool toFloat32 = dstFormat == VK_FORMAT_R32G32B32A32_SFLOAT;
+    alignas(16) float linear[kChunkPixels * 4];
+    srgb8ToLinear(src, toFloat32 && !premultiplyAlpha ? reinterpret_cast<float*>(dst) : linear, pixelCount);
+    if (premultiplyAlpha) {
+        premultiplyAlpha32F(linear, toFloat32 ? reinterpret_cast<float*>(dst) : linear, pixelCount);
+    }
+    if (!toFloat32) {
+        float32ToFloat16(linear, reinterpret_cast<uint16_t*>(dst), pixelCount * 4);
+    }
+}
+
+/**
+ * @brief Converts RGBA32F sources, at most kChunkPixels at a time
+ */
+void convertChunk32F(const float* src, uint8_t* dst, VkFormat dstFormat, size_t pixelCount, bool premultiplyAlpha) {
+    alignas(16) float premultiplied[kChunkPixels * 4];
+    if (premultiplyAlpha) {
+        premultiplyAlpha32F(src, premultiplied, pixelCount);
+        src = premultiplied;
+    }
+
+    switch (dstFormat) {
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            std::memcpy(dst, src, pixelCount * 16);
+            return;
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+            float32ToFloat16(src, reinterpret_cast<uint16_t*>(dst), pixelCount * 4);
+            return;
+        default:
+            break;
+    }
+
+    uint8_t* output = dst;
+    alignas(16) uint8_t swizzled[kChunkPixels * 4];
+    if (isBGRA8(dstFormat)) {
+        output = swizzled;
+    }
+    if (isSrgb(dstFormat)) {
+        linearToSrgb8(src, output, pixelCount);
+    } else {
+        floatToUnorm8(src, output, pixelCount * 4);
+    }
+    if (output != dst) {
+        swizzleRedBlue8(output, dst, pixelCount);
+    }
+}
+
+uint32_t getDestinationPixelSize(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_R32G32B32A32_SFLOAT: return 16;
+        case VK_FORMAT_R16G16B16A16_SFLOAT: return 8;
+        default: return 4;
+    }
+}
+
+} // namespace
+
+uint32_t getPixelSize(SourcePixelFormat format) {
+    switch (format) {
+        case SourcePixelFormat::RGBA8:   return 4;
+        case SourcePixelFormat::BGRA8:   return 4;
+        case SourcePixelFormat::RGB8:    return 3;
+        case SourcePixelFormat::RGBA16F: return 8;
+        case SourcePixelFormat::RGBA32F: return 16;
+    }
+    return 0;
+}
+
+bool isSupported(SourcePixelFormat source, VkFormat destination, bool premultiplyAlpha) {
+    switch (source) {
+        case SourcePixelFormat::RGBA8:
+        case SourcePixelFormat::BGRA8:
+        case SourcePixelFormat::RGB8:
+            return isRGBA8(destination) || isBGRA8(destination) || isFloat(destination);
+        case SourcePixelFormat::RGBA32F:
+            return isRGBA8(destination) || isBGRA8(destination) ||
+                   destination == VK_FORMAT_R32G32B32A32_SFLOAT ||
+                   destination == VK_FORMAT_R16G16B16A16_SFLOAT;
+        case SourcePixelFormat::RGBA16F:
+            return destination == VK_FORMAT_R16G16B16A16_SFLOAT && !premultiplyAlpha;
+    }
+    return false;
+}
+
+void convert(
+    const void* src,
+    SourcePixelFormat srcFormat,
+    void* dst,
+    VkFormat dstFormat,
+    size_t pixelCount,
+    bool premultiplyAlpha) {
+
+    if (!isSupported(srcFormat, dstFormat, premultiplyAlpha)) {
+        throw std::runtime_error("unsupported pixel conversion to format " + std::to_string(dstFormat));
+    }
+
+    const uint8_t* source = static_cast<const uint8_t*>(src);
+    uint8_t* destination = static_cast<uint8_t*>(dst);
+    const uint32_t srcPixelSize = getPixelSize(srcFormat);
+    const uint32_t dstPixelSize = getDestinationPixelSize(dstFormat);
+
+    if (srcFormat == SourcePixelFormat::RGBA16F) {
+        std::memcpy(destination, source, pixelCount * srcPixelSize);
+        return;
+    }
+
+    for (size_t offset = 0; offset < pixelCount; offset += kChunkPixels) {
+        const size_t count = std::min(kChunkPixels, pixelCount - offset);
+        const uint8_t* chunkSrc = source + offset * srcPixelSize;
+        uint8_t* chunkDst = destination + offset * dstPixelSize;
+        if (srcFormat == SourcePixelFormat::RGBA32F) {
+            convertChunk32F(reinterpret_cast<const float*>(chunkSrc), chunkDst, dstFormat, count, premultiplyAlpha);
+        } else if (isFloat(dstFormat)) {
+            convertChunk8ToFloat(chunkSrc, srcFormat, chunkDst, dstFormat, count, premultiplyAlpha);
+        } else {
+            convertChunk8(chunkSrc, srcFormat, chunkDst, dstFormat, count, premultiplyAlpha);
+        }
+    }
+}
+
+void rgb8ToRgba8(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    size_t i = 0;
+#if defined(EV_PC_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    // Each load reads 16 bytes but consumes 12; stop while the over-read stays in bounds
+    for (; i + 6 <= pixelCount; i += 4) {
+        const __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+    }
+#elif defined(EV_PC_NEON)
+    for (; i + 16 <= pixelCount; i += 16) {
+        const uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgb.val[0];
+        rgba.val[1] = rgb.val[1];
+        rgba.val[2] = rgb.val[2];
+        rgba.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(dst + i * 4, rgba);
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        dst[i * 4 + 0] = src[i * 3 + 0];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 0xFF;
+    }
+}
+
+void swizzleRedBlue8(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    size_t i = 0;
+#if defined(EV_PC_AVX2)
+    const __m256i redBlueMask256 = _mm256_set1_epi32(0x00FF00FF);
+    for (; i + 8 <= pixelCount; i += 8) {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        const __m256i redBlue = _mm256_and_si256(pixels, redBlueMask256);
+        const __m256i swapped = _mm256_or_si256(
+            _mm256_andnot_si256(redBlueMask256, pixels),
+            _mm256_or_si256(_mm256_slli_epi32(redBlue, 16), _mm256_srli_epi32(redBlue, 16)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), swapped);
+    }
+#endif
+#if defined(EV_PC_SSE2)
+    const __m128i redBlueMask = _mm_set1_epi32(0x00FF00FF);
+    for (; i + 4 <= pixelCount; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m128i redBlue = _mm_and_si128(pixels, redBlueMask);
+        const __m128i swapped = _mm_or_si128(
+            _mm_andnot_si128(redBlueMask, pixels),
+            _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), swapped);
+    }
+#elif defined(EV_PC_NEON)
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x4_t pixels = vld4q_u8(src + i * 4);
+        const uint8x16_t red = pixels.val[0];
+        pixels.val[0] = pixels.val[2];
+        pixels.val[2] = red;
+        vst4q_u8(dst + i * 4, pixels);
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        uint32_t pixel;
+        std::memcpy(&pixel, src + i * 4, 4);
+        pixel = swizzlePixel(pixel);
+        std::memcpy(dst + i * 4, &pixel, 4);
+    }
+}
+
+void premultiplyAlpha8(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    size_t i = 0;
+#if defined(EV_PC_AVX2)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i alphaLanes = _mm256_set1_epi64x(static_cast<long long>(0xFFFF000000000000ull));
+        const __m256i opaque = _mm256_set1_epi64x(static_cast<long long>(0x00FF000000000000ull));
+        const __m256i bias = _mm256_set1_epi16(128);
+        auto multiply = [&](__m256i color) {
+            const __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            const __m256i factor = _mm256_or_si256(_mm256_andnot_si256(alphaLanes, alpha), opaque);
+            const __m256i product = _mm256_add_epi16(_mm256_mullo_epi16(color, factor), bias);
+            return _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
+        };
+        for (; i + 8 <= pixelCount; i += 8) {
+            const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+            const __m256i low = multiply(_mm256_unpacklo_epi8(pixels, zero));
+            const __m256i high = multiply(_mm256_unpackhi_epi8(pixels, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_packus_epi16(low, high));
+        }
+    }
+#endif
+#if defined(EV_PC_SSE2)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alphaLanes = _mm_set_epi32(static_cast<int>(0xFFFF0000u), 0, static_cast<int>(0xFFFF0000u), 0);
+        const __m128i opaque = _mm_set_epi32(0x00FF0000, 0, 0x00FF0000, 0);
+        const __m128i bias = _mm_set1_epi16(128);
+        auto multiply = [&](__m128i color) {
+            // Broadcast alpha over its pixel, keeping alpha itself times 255
+            const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            const __m128i factor = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), opaque);
+            // Exact round(x / 255) for x <= 255 * 255
+            const __m128i product = _mm_add_epi16(_mm_mullo_epi16(color, factor), bias);
+            return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+        };
+        for (; i + 4 <= pixelCount; i += 4) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            const __m128i low = multiply(_mm_unpacklo_epi8(pixels, zero));
+            const __m128i high = multiply(_mm_unpackhi_epi8(pixels, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(low, high));
+        }
+    }
+#elif defined(EV_PC_NEON)
+    for (; i + 8 <= pixelCount; i += 8) {
+        uint8x8x4_t pixels = vld4_u8(src + i * 4);
+        for (int channel = 0; channel < 3; ++channel) {
+            const uint16x8_t product = vmull_u8(pixels.val[channel], pixels.val[3]);
+            // Exact round(x / 255): (x + 128 + ((x + 128) >> 8)) >> 8
+            pixels.val[channel] = vraddhn_u16(product, vrshrq_n_u16(product, 8));
+        }
+        vst4_u8(dst + i * 4, pixels);
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        const uint32_t alpha = src[i * 4 + 3];
+        dst[i * 4 + 0] = divideBy255(src[i * 4 + 0] * alpha);
+        dst[i * 4 + 1] = divideBy255(src[i * 4 + 1] * alpha);
+        dst[i * 4 + 2] = divideBy255(src[i * 4 + 2] * alpha);
+        dst[i * 4 + 3] = static_cast<uint8_t>(alpha);
+    }
+}
+
+uint16_t float32ToFloat16(float value) {
+    uint32_t bits = floatBits(value);
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t half;
+    if (bits >= 0x47800000u) {
+        // Overflow to infinity, NaN stays (quiet) NaN
+        half = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    } else if (bits < 0x38800000u) {
+        // Subnormal or zero: the FPU rounds the mantissa
+        const uint32_t magic = ((127 - 15) + (23 - 10) + 1) << 23;
+        half = floatBits(bitsToFloat(bits) + bitsToFloat(magic)) - magic;
+    } else {
+        const uint32_t mantissaOdd = (bits >> 13) & 1u;
+        bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu;
+        bits += mantissaOdd;
+        half = bits >> 13;
+    }
+    return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+void float32ToFloat16(const float* src, uint16_t* dst, size_t count) {
+    size_t i = 0;
+#if defined(EV_PC_F16C)
+    for (; i + 8 <= count; i += 8) {
+        const __m128i low = _mm_cvtps_ph(_mm_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        const __m128i high = _mm_cvtps_ph(_mm_loadu_ps(src + i + 4), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi64(low, high));
+    }
+#elif defined(EV_PC_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        const __m128i low = float32ToFloat16SSE2(_mm_loadu_ps(src + i));
+        const __m128i high = float32ToFloat16SSE2(_mm_loadu_ps(src + i + 4));
+        // Results are sign-extended halves, so the signed pack is exact
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(low, high));
+    }
+#elif defined(EV_PC_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = float32ToFloat16(src[i]);
+    }
+}
+
+void floatToUnorm8(const float* src, uint8_t* dst, size_t count) {
+    size_t i = 0;
+#if defined(EV_PC_SSE2)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    auto toInt = [&](const float* values) {
+        // max(x, 0) returns 0 for NaN
+        const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(values), zero), one);
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half));
+    };
+    for (; i + 16 <= count; i += 16) {
+        const __m128i low = _mm_packs_epi32(toInt(src + i), toInt(src + i + 4));
+        const __m128i high = _mm_packs_epi32(toInt(src + i + 8), toInt(src + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(low, high));
+    }
+#elif defined(EV_PC_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    auto toInt = [&](const float* values) {
+        // vmaxnm returns 0 for NaN
+        const float32x4_t clamped = vminq_f32(vmaxnmq_f32(vld1q_f32(values), zero), one);
+        return vmovn_u32(vcvtq_u32_f32(vmlaq_n_f32(vdupq_n_f32(0.5f), clamped, 255.0f)));
+    };
+    for (; i + 8 <= count; i += 8) {
+        vst1_u8(dst + i, vmovn_u16(vcombine_u16(toInt(src + i), toInt(src + i + 4))));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = static_cast<uint8_t>(clampToIndex(src[i], 255.0f));
+    }
+}
+
+void linearToSrgb8(const float* src, uint8_t* dst, size_t pixelCount) {
+    const uint8_t* table = getLinearToSrgbTable();
+    const float tableScale = static_cast<float>(kSrgbTableSize - 1);
+    size_t i = 0;
+#if defined(EV_PC_SSE2)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    // Color channels index the table, alpha is scaled to 8 bits directly
+    const __m128 scale = _mm_setr_ps(tableScale, tableScale, tableScale, 255.0f);
+    for (; i < pixelCount; ++i) {
+        const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i * 4), zero), one);
+        alignas(16) int32_t index[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half)));
+        const uint32_t pixel = table[index[0]] | (table[index[1]] << 8) | (table[index[2]] << 16) |
+                               (static_cast<uint32_t>(index[3]) << 24);
+        std::memcpy(dst + i * 4, &pixel, 4);
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        const float* pixel = src + i * 4;
+        dst[i * 4 + 0] = table[clampToIndex(pixel[0], tableScale)];
+        dst[i * 4 + 1] = table[clampToIndex(pixel[1], tableScale)];
+        dst[i * 4 + 2] = table[clampToIndex(pixel[2], tableScale)];
+        dst[i * 4 + 3] = static_cast<uint8_t>(clampToIndex(pixel[3], 255.0f));
+    }
+}
+
+void srgb8ToLinear(const uint8_t* src, float* dst, size_t pixelCount) {
+    const float* table = getSrgbToLinearTable();
+    for (size_t i = 0; i < pixelCount; ++i) {
+        dst[i * 4 + 0] = table[src[i * 4 + 0]];
+        dst[i * 4 + 1] = table[src[i * 4 + 1]];
+        dst[i * 4 + 2] = table[src[i * 4 + 2]];
+        dst[i * 4 + 3] = src[i * 4 + 3] * (1.0f / 255.0f);
+    }
+}
+
+} // namespace PixelConversion
+} // namespace ev
@@ -1,6 +1,8 @@
 #include "EasyVulkan/Utils/ResourceUtils.hpp"
 
 #include "EasyVulkan/Utils/CommandUtils.hpp"
+#include "EasyVulkan/Utils/FormatUtils.hpp"
+#include "EasyVulkan/Utils/MemoryUtils.hpp"
 #include <fstream>
 #include <stdexcept>
 
@@ -39,6 +41,14 @@ VkBuffer createBuffer(VulkanDevice *device, VkDeviceSize size,
   return buffer;
 }
 
+void destroyBuffer(VulkanDevice *device, VkBuffer buffer,
+                   VmaAllocation allocation) {
+  if (allocation != VK_NULL_HANDLE) {
+    device->cancelMappedFlush(allocation);
+  }
+  vmaDestroyBuffer(device->getAllocator(), buffer, allocation);
+}
+
 VkImage createImage(VulkanDevice *device, uint32_t width, uint32_t height,
                     VkFormat format, VkImageTiling tiling,
                     VkImageUsageFlags usage, VkMemoryPropertyFlags properties,
@@ -159,11 +169,8 @@ void uploadDataToImage(VulkanDevice* device, VkCommandPool commandPool, VkImage
         &stagingAllocation
     );
 
-    // Copy data to staging buffer
-    void* mappedData;
-    vmaMapMemory(device->getAllocator(), stagingAllocation, &mappedData);
-    memcpy(mappedData, data, static_cast<size_t>(dataSize));
-    vmaUnmapMemory(device->getAllocator(), stagingAllocation);
+    // Copy data to the (persistently mapped) staging buffer
+    MemoryUtils::mapAndCopyData(device, stagingAllocation, data, dataSize);
 
     // Transition image layout for transfer
     transitionImageLayoutWithoutCommandBuffer(
@@ -177,21 +184,6 @@ void uploadDataToImage(VulkanDevice* device, VkCommandPool commandPool, VkImage
     // Copy buffer to image
     VkCommandBuffer commandBuffer = CommandUtils::beginSingleTimeCommands(device, commandPool);
 
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {
-        static_cast<uint32_t>(dataSize / 4),  // Assuming RGBA format
-        1,
-        1
-    };
-
     CommandUtils::copyBufferToImage(
         device,
         commandBuffer,
@@ -214,7 +206,99 @@ void uploadDataToImage(VulkanDevice* device, VkCommandPool commandPool, VkImage
     );
 
     // Cleanup staging buffer
-    vmaDestroyBuffer(device->getAllocator(), stagingBuffer, stagingAllocation);
+    destroyBuffer(device, stagingBuffer, stagingAllocation);
+}
+
+void uploadImageRegions(VulkanDevice* device,
+                        VkCommandPool commandPool,
+                        VkImage image,
+                        VkFormat format,
+                        const std::vector<ImageUploadRegion>& regions,
+                        VkImageLayout oldLayout,
+                        VkImageLayout newLayout) {
+    if (regions.empty()) {
+        throw std::runtime_error("no image regions to upload");
+    }
+    const FormatInfo formatInfo = FormatUtils::getFormatInfo(format);
+    if (formatInfo.bytesPerBlock == 0) {
+        throw std::runtime_error("unsupported format for image upload: " + std::to_string(format));
+    }
+    const VkDeviceSize alignment = FormatUtils::getCopyOffsetAlignment(format);
+
+    // Lay the regions out back to back at block-aligned offsets
+    std::vector<VkBufferImageCopy> copies(regions.size());
+    std::vector<VkDeviceSize> sizes(regions.size());
+    VkDeviceSize stagingSize = 0;
+    for (size_t i = 0; i < regions.size(); ++i) {
+        const ImageUploadRegion& region = regions[i];
+        if (!region.data) {
+            throw std::runtime_error("image upload region has no data");
+        }
+        stagingSize = (stagingSize + alignment - 1) / alignment * alignment;
+        sizes[i] = FormatUtils::getCopyFootprint(format, region.extent, region.rowLength,
+                                                 region.imageHeight, region.layerCount);
+
+        VkBufferImageCopy& copy = copies[i];
+        copy.bufferOffset = stagingSize;
+        copy.bufferRowLength = region.rowLength;
+        copy.bufferImageHeight = region.imageHeight;
+        copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy.imageSubresource.mipLevel = region.mipLevel;
+        copy.imageSubresource.baseArrayLayer = region.baseArrayLayer;
+        copy.imageSubresource.layerCount = region.layerCount;
+        copy.imageOffset = region.offset;
+        copy.imageExtent = region.extent;
+
+        stagingSize += sizes[i];
+    }
+
+    VmaAllocation stagingAllocation;
+    VkBuffer stagingBuffer = createBuffer(
+        device,
+        stagingSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+        &stagingAllocation
+    );
+    for (size_t i = 0; i < regions.size(); ++i) {
+        MemoryUtils::mapAndCopyData(device, stagingAllocation, regions[i].data, sizes[i], copies[i].bufferOffset);
+    }
+
+    VkCommandBuffer commandBuffer = CommandUtils::beginSingleTimeCommands(device, commandPool);
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+    VkPipelineStageFlags srcStage;
+    getLayoutStageAndAccess(oldLayout, srcStage, barrier.srcAccessMask);
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, srcStage, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(copies.size()), copies.data());
+
+    VkPipelineStageFlags dstStage;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = newLayout;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    getLayoutStageAndAccess(newLayout, dstStage, barrier.dstAccessMask);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    CommandUtils::endSingleTimeCommands(device, commandPool, commandBuffer);
+
+    destroyBuffer(device, stagingBuffer, stagingAllocation);
 }
 
 void uploadDataToBuffer(VkBuffer buffer, 
@@ -223,20 +307,71 @@ void uploadDataToBuffer(VkBuffer buffer,
                        const void* data,
                        VkDeviceSize dataSize,
                        VkDeviceSize offset) {
-    void* mapped = nullptr;
-    vmaMapMemory(device->getAllocator(), *allocation, &mapped);
-    
-    char* destAddr = static_cast<char*>(mapped) + offset;
-    memcpy(destAddr, data, static_cast<size_t>(dataSize));
-    
-    vmaUnmapMemory(device->getAllocator(), *allocation);
+    MemoryUtils::mapAndCopyData(device, *allocation, data, dataSize, offset);
+}
+bool uploadDataToDeviceBuffer(VulkanDevice* device,
+                              VkCommandPool commandPool,
+                              VkBuffer buffer,
+                              VmaAllocation allocation,
+                              const void* data,
+                              VkDeviceSize dataSize,
+                              VkDeviceSize offset) {
+    if (!data || dataSize == 0) {
+        throw std::runtime_error("Invalid data or data size");
+    }
+
+    // ReBAR / UMA: the destination is mappable, write straight into it
+    // Flushed here rather than queued: the caller may destroy the buffer
+    // before the next submit
+    if (MemoryUtils::isHostVisible(device, allocation)) {
+        if (vmaCopyMemoryToAllocation(device->getAllocator(), data, allocation,
+                                      offset, dataSize) != VK_SUCCESS) {
+            throw std::runtime_error("failed to write buffer memory!");
+        }
+        return true;
+    }
+
+    VmaAllocation stagingAllocation;
+    VkBuffer stagingBuffer = createBuffer(
+        device,
+        dataSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+        &stagingAllocation
+    );
+    MemoryUtils::mapAndCopyData(device, stagingAllocation, data, dataSize);
+
+    VkCommandBuffer commandBuffer = CommandUtils::beginSingleTimeCommands(device, commandPool);
+    CommandUtils::copyBuffer(device, commandBuffer, stagingBuffer, buffer, dataSize, 0, offset);
+    CommandUtils::endSingleTimeCommands(device, commandPool, commandBuffer);
+
+    destroyBuffer(device, stagingBuffer, stagingAllocation);
+    return false;
 }
+
 // Upload data to a buffer at a specific offset
 void uploadDataToMappedBuffer(VkBuffer buffer,VulkanDevice* device,VmaAllocation* allocation,const void* data,VkDeviceSize dataSize,VkDeviceSize offset){
     VmaAllocationInfo allocInfo;
     vmaGetAllocationInfo(device->getAllocator(), *allocation, &allocInfo);
+    if (!allocInfo.pMappedData) {
+        throw std::runtime_error("buffer is not persistently mapped");
+    }
     char* destAddr = static_cast<char*>(allocInfo.pMappedData) + offset;
     memcpy(destAddr, data, static_cast<size_t>(dataSize));
+    if (vmaFlushAllocation(device->getAllocator(), *allocation, offset, dataSize) != VK_SUCCESS) {
+        throw std::runtime_error("failed to flush buffer data!");
+    }
+}
+
+VkDeviceAddress getBufferDeviceAddress(VulkanDevice* device, VkBuffer buffer) {
+    if (!device->isBufferDeviceAddressEnabled()) {
+        throw std::runtime_error("bufferDeviceAddress is not enabled on this device");
+    }
+
+    VkBufferDeviceAddressInfo addressInfo{};
+    addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    addressInfo.buffer = buffer;
+    return vkGetBufferDeviceAddress(device->getLogicalDevice(), &addressInfo);
 }
     
 
@@ -455,12 +590,12 @@ void transitionImageLayoutWithInfo(
     barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.image = imageInfo.image;
 
-    // Set up the subresource range for the entire image
+    // Set up the subresource range for the entire image, including all mips and layers
     barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
     barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
+    barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
 
     // Determine pipeline stages and access masks based on old and new layouts
     VkPipelineStageFlags sourceStage;
@@ -549,5 +684,55 @@ void transitionImageLayoutWithInfo(
     imageInfo.layout = newLayout;
 }
 
+void getLayoutStageAndAccess(
+    VkImageLayout layout,
+    VkPipelineStageFlags& outStage,
+    VkAccessFlags& outAccess)
+{
+    switch (layout) {
+        case VK_IMAGE_LAYOUT_UNDEFINED:
+            outStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+            outAccess = 0;
+            break;
+        case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+            outStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            outAccess = VK_ACCESS_TRANSFER_READ_BIT;
+            break;
+        case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+            outStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            outAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
+            break;
+        case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+            outStage = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            outAccess = VK_ACCESS_SHADER_READ_BIT;
+            break;
+        case VK_IMAGE_LAYOUT_GENERAL:
+            outStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            outAccess = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            break;
+        case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+            outStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            outAccess = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            break;
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+            outStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                       VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            outAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            break;
+        case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+            outStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+            outAccess = 0;
+            break;
+        default:
+            outStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            outAccess = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            break;
+    }
+}
+
 } // namespace ResourceUtils
 } // namespace ev
\ No newline at end of file
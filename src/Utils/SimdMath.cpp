@@ -0,0 +1,264 @@
+#include "EasyVulkan/Utils/SimdMath.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(EV_SIMD_SSE2) && defined(__AVX2__)
+#include <immintrin.h>
+#define EV_SIMD_AVX2 1
+#endif
+
+namespace ev {
+
+Mat4f Mat4f::rotation(const Quatf& rotation) {
+    alignas(16) float q[4];
+    rotation.xyzw.store(q);
+    const float x = q[0], y = q[1], z = q[2], w = q[3];
+    const float xx = x * x, yy = y * y, zz = z * z;
+    const float xy = x * y, xz = x * z, yz = y * z;
+    const float wx = w * x, wy = w * y, wz = w * z;
+
+    return Mat4f(Vec4a(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f),
+                 Vec4a(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f),
+                 Vec4a(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f),
+                 Vec4a(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+Mat4f Mat4f::compose(const Vec3<float>& translation, const Quatf& rotation, const Vec3<float>& scale) {
+    Mat4f result = Mat4f::rotation(rotation);
+    result.columns[0] *= scale.x;
+    result.columns[1] *= scale.y;
+    result.columns[2] *= scale.z;
+    result.columns[3] = Vec4a(translation, 1.0f);
+    return result;
+}
+
+Mat4f Mat4f::perspective(float fovY, float aspect, float zNear, float zFar) {
+    const float f = 1.0f / std::tan(fovY * 0.5f);
+    const float depth = 1.0f / (zNear - zFar);
+    return Mat4f(Vec4a(f / aspect, 0.0f, 0.0f, 0.0f),
+                 Vec4a(0.0f, -f, 0.0f, 0.0f),
+                 Vec4a(0.0f, 0.0f, zFar * depth, -1.0f),
+                 Vec4a(0.0f, 0.0f, zNear * zFar * depth, 0.0f));
+}
+
+Mat4f Mat4f::orthographic(float left, float right, float bottom, float top, float zNear, float zFar) {
+    const float width = 1.0f / (right - left);
+    const float height = 1.0f / (top - bottom);
+    const float depth = 1.0f / (zFar - zNear);
+    return Mat4f(Vec4a(2.0f * width, 0.0f, 0.0f, 0.0f),
+                 Vec4a(0.0f, -2.0f * height, 0.0f, 0.0f),
+                 Vec4a(0.0f, 0.0f, -depth, 0.0f),
+                 Vec4a(-(right + left) * width, (top + bottom) * height, -zNear * depth, 1.0f));
+}
+
+Mat4f Mat4f::lookAt(const Vec3<float>& eye, const Vec3<float>& target, const Vec3<float>& up) {
+    const Vec4a eyePosition(eye, 0.0f);
+    const Vec4a forward = (Vec4a(target, 0.0f) - eyePosition).normalized3();
+    const Vec4a side = Vec4a::cross3(forward, Vec4a(up, 0.0f)).normalized3();
+    const Vec4a cameraUp = Vec4a::cross3(side, forward);
+
+    // Rows of the rotation are side, up and -forward (all with w = 0)
+    Mat4f result = Mat4f(side, cameraUp, -forward, Vec4a(0.0f, 0.0f, 0.0f, 1.0f)).transposed();
+    result.columns[3] = Vec4a(-Vec4a::dot3(side, eyePosition), -Vec4a::dot3(cameraUp, eyePosition),
+                              Vec4a::dot3(forward, eyePosition), 1.0f);
+    return result;
+}
+
+Mat4f Mat4f::transposed() const {
+#if defined(EV_SIMD_SSE2)
+    __m128 c0 = columns[0].v, c1 = columns[1].v, c2 = columns[2].v, c3 = columns[3].v;
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    return Mat4f(Vec4a(c0), Vec4a(c1), Vec4a(c2), Vec4a(c3));
+#elif defined(EV_SIMD_NEON)
+    const float32x4x2_t low = vzipq_f32(columns[0].v, columns[2].v);  // c0.x c2.x c0.y c2.y | c0.z c2.z c0.w c2.w
+    const float32x4x2_t high = vzipq_f32(columns[1].v, columns[3].v); // c1.x c3.x c1.y c3.y | c1.z c3.z c1.w c3.w
+    const float32x4x2_t rows01 = vzipq_f32(low.val[0], high.val[0]);
+    const float32x4x2_t rows23 = vzipq_f32(low.val[1], high.val[1]);
+    return Mat4f(Vec4a(rows01.val[0]), Vec4a(rows01.val[1]), Vec4a(rows23.val[0]), Vec4a(rows23.val[1]));
+#else
+    alignas(16) float m[16];
+    store(m);
+    return Mat4f(Vec4a(m[0], m[4], m[8], m[12]), Vec4a(m[1], m[5], m[9], m[13]),
+                 Vec4a(m[2], m[6], m[10], m[14]), Vec4a(m[3], m[7], m[11], m[15]));
+#endif
+}
+
+Mat4f Mat4f::inverse() const {
+    alignas(16) float m[16];
+    store(m);
+
+    // Cofactor expansion through 2x2 sub-determinants of the lower and upper halves
+    const float s0 = m[0] * m[5] - m[4] * m[1];
+    const float s1 = m[0] * m[6] - m[4] * m[2];
+    const float s2 = m[0] * m[7] - m[4] * m[3];
+    const float s3 = m[1] * m[6] - m[5] * m[2];
+    const float s4 = m[1] * m[7] - m[5] * m[3];
+    const float s5 = m[2] * m[7] - m[6] * m[3];
+
+    const float c5 = m[10] * m[15] - m[14] * m[11];
+    const float c4 = m[9] * m[15] - m[13] * m[11];
+    const float c3 = m[9] * m[14] - m[13] * m[10];
+    const float c2 = m[8] * m[15] - m[12] * m[11];
+    const float c1 = m[8] * m[14] - m[12] * m[10];
+    const float c0 = m[8] * m[13] - m[12] * m[9];
+
+    const float determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (determinant == 0.0f || !std::isfinite(determinant)) {
+        return Mat4f();
+    }
+    const float inv = 1.0f / determinant;
+
+    alignas(16) float r[16];
+    r[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * inv;
+    r[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * inv;
+    r[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * inv;
+    r[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * inv;
+
+    r[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * inv;
+    r[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * inv;
+    r[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * inv;
+    r[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * inv;
+
+    r[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * inv;
+    r[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * inv;
+    r[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * inv;
+    r[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * inv;
+
+    r[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * inv;
+    r[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * inv;
+    r[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * inv;
+    r[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * inv;
+    return Mat4f::load(r);
+}
+
+Quatf Quatf::slerp(const Quatf& a, const Quatf& b, float t) {
+    float cosTheta = Vec4a::dot(a.xyzw, b.xyzw);
+    Vec4a target = b.xyzw;
+    if (cosTheta < 0.0f) {
+        cosTheta = -cosTheta;
+        target = -target;
+    }
+    // Nearly parallel: sin(theta) vanishes, the linear path is exact enough
+    if (cosTheta > 0.9995f) {
+        return Quatf(Vec4a::lerp(a.xyzw, target, t).normalized());
+    }
+
+    const float theta = std::acos(cosTheta);
+    const float invSin = 1.0f / std::sin(theta);
+    const float weightA = std::sin((1.0f - t) * theta) * invSin;
+    const float weightB = std::sin(t * theta) * invSin;
+    return Quatf(Vec4a::multiplyAdd(a.xyzw, Vec4a::splat(weightA), target * weightB));
+}
+
+namespace SimdMath {
+
+namespace {
+
+/// Shared body of transformPoints / transformVectors; w is 1 or 0
+void transform(const Mat4f& matrix, const float* x, const float* y, const float* z,
+               float* outX, float* outY, float* outZ, size_t count, float w) {
+    alignas(16) float m[16];
+    matrix.store(m);
+    // Translation contributes m[12..14] * w
+    const float tx = m[12] * w, ty = m[13] * w, tz = m[14] * w;
+    size_t i = 0;
+
+#if defined(EV_SIMD_AVX2)
+    {
+        const __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+        const __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+        const __m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+        const __m256 t0 = _mm256_set1_ps(tx), t1 = _mm256_set1_ps(ty), t2 = _mm256_set1_ps(tz);
+        for (; i + 8 <= count; i += 8) {
+            const __m256 px = _mm256_loadu_ps(x + i);
+            const __m256 py = _mm256_loadu_ps(y + i);
+            const __m256 pz = _mm256_loadu_ps(z + i);
+#if defined(__FMA__)
+            const __m256 rx = _mm256_fmadd_ps(m8, pz, _mm256_fmadd_ps(m4, py, _mm256_fmadd_ps(m0, px, t0)));
+            const __m256 ry = _mm256_fmadd_ps(m9, pz, _mm256_fmadd_ps(m5, py, _mm256_fmadd_ps(m1, px, t1)));
+            const __m256 rz = _mm256_fmadd_ps(m10, pz, _mm256_fmadd_ps(m6, py, _mm256_fmadd_ps(m2, px, t2)));
+#else
+            const __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, px), _mm256_mul_ps(m4, py)),
+                                            _mm256_add_ps(_mm256_mul_ps(m8, pz), t0));
+            const __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, px), _mm256_mul_ps(m5, py)),
+                                            _mm256_add_ps(_mm256_mul_ps(m9, pz), t1));
+            const __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m2, px), _mm256_mul_ps(m6, py)),
+                                            _mm256_add_ps(_mm256_mul_ps(m10, pz), t2));
+#endif
+            _mm256_storeu_ps(outX + i, rx);
+            _mm256_storeu_ps(outY + i, ry);
+            _mm256_storeu_ps(outZ + i, rz);
+        }
+    }
+#endif
+
+#if defined(EV_SIMD_SSE2)
+    {
+        const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+        const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+        const __m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+        const __m128 t0 = _mm_set1_ps(tx), t1 = _mm_set1_ps(ty), t2 = _mm_set1_ps(tz);
+        for (; i + 4 <= count; i += 4) {
+            const __m128 px = _mm_loadu_ps(x + i);
+            const __m128 py = _mm_loadu_ps(y + i);
+            const __m128 pz = _mm_loadu_ps(z + i);
+            const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, px), _mm_mul_ps(m4, py)),
+                                         _mm_add_ps(_mm_mul_ps(m8, pz), t0));
+            const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, px), _mm_mul_ps(m5, py)),
+                                         _mm_add_ps(_mm_mul_ps(m9, pz), t1));
+            const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, px), _mm_mul_ps(m6, py)),
+                                         _mm_add_ps(_mm_mul_ps(m10, pz), t2));
+            _mm_storeu_ps(outX + i, rx);
+            _mm_storeu_ps(outY + i, ry);
+            _mm_storeu_ps(outZ + i, rz);
+        }
+    }
+#elif defined(EV_SIMD_NEON)
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t px = vld1q_f32(x + i);
+        const float32x4_t py = vld1q_f32(y + i);
+        const float32x4_t pz = vld1q_f32(z + i);
+        const float32x4_t rx = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(tx), px, m[0]), py, m[4]), pz, m[8]);
+        const float32x4_t ry = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(ty), px, m[1]), py, m[5]), pz, m[9]);
+        const float32x4_t rz = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(tz), px, m[2]), py, m[6]), pz, m[10]);
+        vst1q_f32(outX + i, rx);
+        vst1q_f32(outY + i, ry);
+        vst1q_f32(outZ + i, rz);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float px = x[i], py = y[i], pz = z[i];
+        outX[i] = m[0] * px + m[4] * py + m[8] * pz + tx;
+        outY[i] = m[1] * px + m[5] * py + m[9] * pz + ty;
+        outZ[i] = m[2] * px + m[6] * py + m[10] * pz + tz;
+    }
+}
+
+} // namespace
+
+void transformPoints(const Mat4f& matrix, const float* x, const float* y, const float* z,
+                     float* outX, float* outY, float* outZ, size_t count) {
+    transform(matrix, x, y, z, outX, outY, outZ, count, 1.0f);
+}
+
+void transformVectors(const Mat4f& matrix, const float* x, const float* y, const float* z,
+                      float* outX, float* outY, float* outZ, size_t count) {
+    transform(matrix, x, y, z, outX, outY, outZ, count, 0.0f);
+}
+
+void transformPoints(const Mat4f& matrix, const Vec3<float>* points, Vec3<float>* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = matrix.transformPoint(points[i]);
+    }
+}
+
+void multiply(const Mat4f& left, const Mat4f* right, Mat4f* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = left * right[i];
+    }
+}
+
+} // namespace SimdMath
+} // namespace ev
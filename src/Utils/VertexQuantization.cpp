@@ -0,0 +1,345 @@
+#include "EasyVulkan/Utils/VertexQuantization.hpp"
+#include "EasyVulkan/Utils/PixelConversion.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EV_VQ_SSE2 1
+#endif
+
+namespace ev {
+namespace VertexQuantization {
+
+namespace {
+
+/// Positions normalized per chunk before conversion
+constexpr size_t kChunkVertices = 256;
+
+float clampSigned(float value) {
+    // NaN maps to -1, like the SIMD path
+    return value > -1.0f ? (value < 1.0f ? value : 1.0f) : -1.0f;
+}
+
+float clampUnsigned(float value) {
+    return value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+}
+
+template<typename T>
+const T& at(const void* base, size_t stride, size_t index) {
+    return *reinterpret_cast<const T*>(static_cast<const uint8_t*>(base) + index * stride);
+}
+
+template<typename T>
+T& at(void* base, size_t stride, size_t index) {
+    return *reinterpret_cast<T*>(static_cast<uint8_t*>(base) + index * stride);
+}
+
+#if defined(EV_VQ_SSE2)
+/// Loads x, y, z without touching the bytes after them
+__m128 loadVec3(const Vec3f& value) {
+    const __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&value.x)));
+    return _mm_movelh_ps(xy, _mm_load_ss(&value.z));
+}
+
+__m128 loadVec2(const Vec2f& value) {
+    return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&value.x)));
+}
+
+/// Scatters the four 32-bit lanes of a register to strided destinations
+void storeLanes(__m128i value, void* dst, size_t stride, size_t index) {
+    for (int lane = 0; lane < 4; ++lane) {
+        const int32_t bits = _mm_cvtsi128_si32(value);
+        std::memcpy(static_cast<uint8_t*>(dst) + (index + lane) * stride, &bits, sizeof(bits));
+        value = _mm_srli_si128(value, 4);
+    }
+}
+#endif
+
+/// Writes (position - offset) / scale with w = 1 as four floats per vertex
+void normalizePositions(const void* src, size_t srcStride, float* dst, size_t count,
+                        const PositionQuantization& quantization) {
+    const float invX = 1.0f / quantization.scale.x;
+    const float invY = 1.0f / quantization.scale.y;
+    const float invZ = 1.0f / quantization.scale.z;
+    size_t i = 0;
+#if defined(EV_VQ_SSE2)
+    const __m128 offset = _mm_setr_ps(quantization.offset.x, quantization.offset.y, quantization.offset.z, 0.0f);
+    const __m128 invScale = _mm_setr_ps(invX, invY, invZ, 0.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 wOne = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    for (; i < count; ++i) {
+        __m128 value = _mm_mul_ps(_mm_sub_ps(loadVec3(at<Vec3f>(src, srcStride, i)), offset), invScale);
+        value = _mm_min_ps(_mm_max_ps(value, minusOne), one);
+        _mm_storeu_ps(dst + i * 4, _mm_add_ps(value, wOne));
+    }
+#endif
+    for (; i < count; ++i) {
+        const Vec3f& position = at<Vec3f>(src, srcStride, i);
+        dst[i * 4 + 0] = clampSigned((position.x - quantization.offset.x) * invX);
+        dst[i * 4 + 1] = clampSigned((position.y - quantization.offset.y) * invY);
+        dst[i * 4 + 2] = clampSigned((position.z - quantization.offset.z) * invZ);
+        dst[i * 4 + 3] = 1.0f;
+    }
+}
+
+void packHalfPositions(const void* src, size_t srcStride, void* dst, size_t dstStride, size_t count,
+                       const PositionQuantization& quantization) {
+    float normalized[kChunkVertices * 4];
+    uint16_t halves[kChunkVertices * 4];
+    for (size_t first = 0; first < count; first += kChunkVertices) {
+        const size_t chunk = std::min(kChunkVertices, count - first);
+        normalizePositions(static_cast<const uint8_t*>(src) + first * srcStride, srcStride,
+                           normalized, chunk, quantization);
+        PixelConversion::float32ToFloat16(normalized, halves, chunk * 4);
+        for (size_t i = 0; i < chunk; ++i) {
+            std::memcpy(&at<Half4>(dst, dstStride, first + i), halves + i * 4, sizeof(Half4));
+        }
+    }
+}
+
+void packSnormPositions(const void* src, size_t srcStride, void* dst, size_t dstStride, size_t count,
+                        const PositionQuantization& quantization) {
+    float normalized[kChunkVertices * 4];
+    int16_t snorms[kChunkVertices * 4];
+    for (size_t first = 0; first < count; first += kChunkVertices) {
+        const size_t chunk = std::min(kChunkVertices, count - first);
+        normalizePositions(static_cast<const uint8_t*>(src) + first * srcStride, srcStride,
+                           normalized, chunk, quantization);
+        size_t i = 0;
+#if defined(EV_VQ_SSE2)
+        const __m128 scale = _mm_set1_ps(32767.0f);
+        for (; i + 8 <= chunk * 4; i += 8) {
+            const __m128i low = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(normalized + i), scale));
+            const __m128i high = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(normalized + i + 4), scale));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(snorms + i), _mm_packs_epi32(low, high));
+        }
+#endif
+        for (; i < chunk * 4; ++i) {
+            snorms[i] = static_cast<int16_t>(std::lrint(normalized[i] * 32767.0f));
+        }
+        for (size_t v = 0; v < chunk; ++v) {
+            std::memcpy(&at<Snorm16x4>(dst, dstStride, first + v), snorms + v * 4, sizeof(Snorm16x4));
+        }
+    }
+}
+
+void packOctahedralNormals(const void* src, size_t srcStride, void* dst, size_t dstStride, size_t count) {
+    size_t i = 0;
+#if defined(EV_VQ_SSE2)
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 tiny = _mm_set1_ps(1e-30f);
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    for (; i + 4 <= count; i += 4) {
+        // Four normals at a time, transposed to x/y/z registers
+        __m128 x = loadVec3(at<Vec3f>(src, srcStride, i + 0));
+        __m128 y = loadVec3(at<Vec3f>(src, srcStride, i + 1));
+        __m128 z = loadVec3(at<Vec3f>(src, srcStride, i + 2));
+        __m128 w = loadVec3(at<Vec3f>(src, srcStride, i + 3));
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)),
+                                      _mm_andnot_ps(signMask, z));
+        const __m128 inv = _mm_div_ps(one, _mm_max_ps(sum, tiny));
+        const __m128 px = _mm_mul_ps(x, inv);
+        const __m128 py = _mm_mul_ps(y, inv);
+
+        // Lower hemisphere folds over the diagonals
+        const __m128 signX = _mm_or_ps(_mm_and_ps(px, signMask), one);
+        const __m128 signY = _mm_or_ps(_mm_and_ps(py, signMask), one);
+        const __m128 foldX = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, py)), signX);
+        const __m128 foldY = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, px)), signY);
+        const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+        __m128 ox = _mm_or_ps(_mm_and_ps(lower, foldX), _mm_andnot_ps(lower, px));
+        __m128 oy = _mm_or_ps(_mm_and_ps(lower, foldY), _mm_andnot_ps(lower, py));
+        ox = _mm_min_ps(_mm_max_ps(ox, minusOne), one);
+        oy = _mm_min_ps(_mm_max_ps(oy, minusOne), one);
+
+        // x0..x3 y0..y3 -> x0 y0 x1 y1 ...
+        const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(ox, scale)),
+                                               _mm_cvtps_epi32(_mm_mul_ps(oy, scale)));
+        storeLanes(_mm_unpacklo_epi16(packed, _mm_srli_si128(packed, 8)), dst, dstStride, i);
+    }
+#endif
+    for (; i < count; ++i) {
+        at<Snorm16x2>(dst, dstStride, i) = encodeOctahedral(at<Vec3f>(src, srcStride, i));
+    }
+}
+
+void packUnormTexCoords(const void* src, size_t srcStride, void* dst, size_t dstStride, size_t count) {
+    size_t i = 0;
+#if defined(EV_VQ_SSE2)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(65535.0f);
+    const __m128i bias = _mm_set1_epi32(32768);
+    const __m128i unbias = _mm_set1_epi16(static_cast<short>(0x8000));
+    for (; i + 4 <= count; i += 4) {
+        __m128 low = _mm_movelh_ps(loadVec2(at<Vec2f>(src, srcStride, i + 0)),
+                                   loadVec2(at<Vec2f>(src, srcStride, i + 1)));
+        __m128 high = _mm_movelh_ps(loadVec2(at<Vec2f>(src, srcStride, i + 2)),
+                                    loadVec2(at<Vec2f>(src, srcStride, i + 3)));
+        low = _mm_mul_ps(_mm_min_ps(_mm_max_ps(low, zero), one), scale);
+        high = _mm_mul_ps(_mm_min_ps(_mm_max_ps(high, zero), one), scale);
+
+        // SSE2 has no unsigned 32 -> 16 pack: shift into signed range and back
+        const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(_mm_cvtps_epi32(low), bias),
+                                               _mm_sub_epi32(_mm_cvtps_epi32(high), bias));
+        storeLanes(_mm_xor_si128(packed, unbias), dst, dstStride, i);
+    }
+#endif
+    for (; i < count; ++i) {
+        const Vec2f& texCoord = at<Vec2f>(src, srcStride, i);
+        Unorm16x2& out = at<Unorm16x2>(dst, dstStride, i);
+        out.x = static_cast<uint16_t>(std::lrint(clampUnsigned(texCoord.x) * 65535.0f));
+        out.y = static_cast<uint16_t>(std::lrint(clampUnsigned(texCoord.y) * 65535.0f));
+    }
+}
+
+void packUnormColors(const void* src, size_t srcStride, void* dst, size_t dstStride, size_t count) {
+    size_t i = 0;
+#if defined(EV_VQ_SSE2)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128i colors[4];
+        for (int c = 0; c < 4; ++c) {
+            const __m128 value = _mm_loadu_ps(&at<Vec4f>(src, srcStride, i + c).x);
+            colors[c] = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(value, zero), one), scale));
+        }
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(colors[0], colors[1]),
+                                                _mm_packs_epi32(colors[2], colors[3]));
+        storeLanes(packed, dst, dstStride, i);
+    }
+#endif
+    for (; i < count; ++i) {
+        const Vec4f& color = at<Vec4f>(src, srcStride, i);
+        Unorm8x4& out = at<Unorm8x4>(dst, dstStride, i);
+        out.x = static_cast<uint8_t>(std::lrint(clampUnsigned(color.x) * 255.0f));
+        out.y = static_cast<uint8_t>(std::lrint(clampUnsigned(color.y) * 255.0f));
+        out.z = static_cast<uint8_t>(std::lrint(clampUnsigned(color.z) * 255.0f));
+        out.w = static_cast<uint8_t>(std::lrint(clampUnsigned(color.w) * 255.0f));
+    }
+}
+
+} // namespace
+
+PositionQuantization computePositionQuantization(const Vertex* vertices, size_t count) {
+    PositionQuantization quantization;
+    if (count == 0) {
+        return quantization;
+    }
+
+    Vec3f minimum = vertices[0].position;
+    Vec3f maximum = vertices[0].position;
+    for (size_t i = 1; i < count; ++i) {
+        const Vec3f& position = vertices[i].position;
+        minimum = Vec3f(std::min(minimum.x, position.x), std::min(minimum.y, position.y), std::min(minimum.z, position.z));
+        maximum = Vec3f(std::max(maximum.x, position.x), std::max(maximum.y, position.y), std::max(maximum.z, position.z));
+    }
+
+    const Vec3f center = (minimum + maximum) * 0.5f;
+    const Vec3f extent = (maximum - minimum) * 0.5f;
+    quantization.offset = Vec4f(center, 0.0f);
+    // A flat axis stores 0 everywhere; any non-zero scale dequantizes it
+    quantization.scale = Vec4f(extent.x > 0.0f ? extent.x : 1.0f,
+                               extent.y > 0.0f ? extent.y : 1.0f,
+                               extent.z > 0.0f ? extent.z : 1.0f,
+                               0.0f);
+    return quantization;
+}
+
+Snorm16x2 encodeOctahedral(const Vec3f& normal) {
+    const float sum = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    const float inv = 1.0f / std::max(sum, 1e-30f);
+    float x = normal.x * inv;
+    float y = normal.y * inv;
+    if (normal.z < 0.0f) {
+        const float foldX = (1.0f - std::fabs(y)) * std::copysign(1.0f, x);
+        const float foldY = (1.0f - std::fabs(x)) * std::copysign(1.0f, y);
+        x = foldX;
+        y = foldY;
+    }
+
+    Snorm16x2 encoded;
+    encoded.x = static_cast<int16_t>(std::lrint(clampSigned(x) * 32767.0f));
+    encoded.y = static_cast<int16_t>(std::lrint(clampSigned(y) * 32767.0f));
+    return encoded;
+}
+
+Vec3f decodeOctahedral(const Snorm16x2& encoded) {
+    // SNORM decoding as the vertex fetch does it: -32768 also means -1
+    const float x = std::max(encoded.x / 32767.0f, -1.0f);
+    const float y = std::max(encoded.y / 32767.0f, -1.0f);
+    Vec3f normal(x, y, 1.0f - std::fabs(x) - std::fabs(y));
+    const float t = std::max(-normal.z, 0.0f);
+    normal.x += normal.x >= 0.0f ? -t : t;
+    normal.y += normal.y >= 0.0f ? -t : t;
+    return normal.normalized();
+}
+
+Vec3f dequantizePosition(const Snorm16x4& position, const PositionQuantization& quantization) {
+    return Vec3f(std::max(position.x / 32767.0f, -1.0f) * quantization.scale.x + quantization.offset.x,
+                 std::max(position.y / 32767.0f, -1.0f) * quantization.scale.y + quantization.offset.y,
+                 std::max(position.z / 32767.0f, -1.0f) * quantization.scale.z + quantization.offset.z);
+}
+
+void packPositions(const Vec3f* src, Half4* dst, size_t count, const PositionQuantization& quantization) {
+    packHalfPositions(src, sizeof(Vec3f), dst, sizeof(Half4), count, quantization);
+}
+
+void packPositions(const Vec3f* src, Snorm16x4* dst, size_t count, const PositionQuantization& quantization) {
+    packSnormPositions(src, sizeof(Vec3f), dst, sizeof(Snorm16x4), count, quantization);
+}
+
+void packNormals(const Vec3f* src, Snorm16x2* dst, size_t count) {
+    packOctahedralNormals(src, sizeof(Vec3f), dst, sizeof(Snorm16x2), count);
+}
+
+void packTexCoords(const Vec2f* src, Unorm16x2* dst, size_t count) {
+    packUnormTexCoords(src, sizeof(Vec2f), dst, sizeof(Unorm16x2), count);
+}
+
+void packColors(const Vec4f* src, Unorm8x4* dst, size_t count) {
+    packUnormColors(src, sizeof(Vec4f), dst, sizeof(Unorm8x4), count);
+}
+
+void packVertices(const Vertex* src, CompactVertex* dst, size_t count, const PositionQuantization& quantization) {
+    if (count == 0) {
+        return;
+    }
+    packHalfPositions(&src->position, sizeof(Vertex), &dst->position, sizeof(CompactVertex), count, quantization);
+    packOctahedralNormals(&src->normal, sizeof(Vertex), &dst->normal, sizeof(CompactVertex), count);
+    packUnormTexCoords(&src->texCoord, sizeof(Vertex), &dst->texCoord, sizeof(CompactVertex), count);
+    packUnormColors(&src->color, sizeof(Vertex), &dst->color, sizeof(CompactVertex), count);
+}
+
+void packVertices(const Vertex* src, QuantizedVertex* dst, size_t count, const PositionQuantization& quantization) {
+    if (count == 0) {
+        return;
+    }
+    packSnormPositions(&src->position, sizeof(Vertex), &dst->position, sizeof(QuantizedVertex), count, quantization);
+    packOctahedralNormals(&src->normal, sizeof(Vertex), &dst->normal, sizeof(QuantizedVertex), count);
+    packUnormTexCoords(&src->texCoord, sizeof(Vertex), &dst->texCoord, sizeof(QuantizedVertex), count);
+    packUnormColors(&src->color, sizeof(Vertex), &dst->color, sizeof(QuantizedVertex), count);
+}
+
+void packVertexStreams(const Vertex* src, QuantizedPosition* positions, CompactAttributes* attributes,
+                       size_t count, const PositionQuantization& quantization) {
+    if (count == 0) {
+        return;
+    }
+    packSnormPositions(&src->position, sizeof(Vertex), &positions->position, sizeof(QuantizedPosition), count, quantization);
+    packOctahedralNormals(&src->normal, sizeof(Vertex), &attributes->normal, sizeof(CompactAttributes), count);
+    packUnormTexCoords(&src->texCoord, sizeof(Vertex), &attributes->texCoord, sizeof(CompactAttributes), count);
+    packUnormColors(&src->color, sizeof(Vertex), &attributes->color, sizeof(CompactAttributes), count);
+}
+
+} // namespace VertexQuantization
+} // namespace ev